@@ -0,0 +1,196 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Benchmarks of the kernel on the Linux simulator                           |
+ |___________________________________________________________________________*/
+
+#include <stdio.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * Scheduling simulation of many periodic tasks, the cost of a delay against
+ * the number of delayed tasks.
+ *
+ * For every count of delayedCOUNTS[] that many tasks wake up with periods of
+ * delayedMIN_PERIOD to delayedMAX_PERIOD ticks, staggered so a few of them wake
+ * on every tick, and delay until their next period. A task of the lowest
+ * priority counts loops with the core that is left, against a run without the
+ * periodic tasks this gives the time the kernel spends per wake up: the tick
+ * that unblocks the task, the switches to and from it and the insertion of the
+ * task back in the delayed tasks.
+ *
+ * Built with configUSE_DELAYED_TASK_HEAP 0 the delayed tasks are the sorted
+ * list, with 1 the binary heap. The results are JSON lines,
+ * {"record":"config",...} first and then one {"record":"result","tasks":<n>,...}
+ * per count with the wake ups per second, the share of the core they take and
+ * the nanoseconds per wake up.
+ */
+
+#define delayedMIN_PERIOD               16U
+#define delayedMAX_PERIOD               48U
+#define delayedWARM_UP_MS               200U
+#define delayedRUN_MS                   2000U
+#define delayedSTACK_SIZE               configMINIMAL_STACK_SIZE
+#define delayedBACKGROUND_PRIORITY      tskIDLE_PRIORITY
+#define delayedTASK_PRIORITY            ( tskIDLE_PRIORITY + 1 )
+#define delayedCONTROL_PRIORITY         ( tskIDLE_PRIORITY + 2 )
+
+static const uint32_t ulCounts[] = { 10, 150, 1000, 2000 };
+
+static volatile uint64_t ullBackgroundLoops = 0;
+static volatile uint64_t ullWakes = 0;
+
+/**
+ * @brief Monotonic time of the host.
+ *
+ * @return the time in nanoseconds
+ */
+static uint64_t prvNow(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return ((uint64_t)xNow.tv_sec * 1000000000ULL) + (uint64_t)xNow.tv_nsec;
+}
+
+/**
+ * @brief Count loops, the share of the core left by the kernel.
+ *
+ * @param pvParameters    not used
+ */
+static void prvBackgroundTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;) {
+        ullBackgroundLoops++;
+    }
+}
+
+/**
+ * @brief Periodic task, wakes up once per period and delays again.
+ *
+ * @param pvParameters    the period in ticks
+ */
+static void prvPeriodicTask(void *pvParameters)
+{
+    const TickType_t xPeriod = (TickType_t)(uintptr_t)pvParameters;
+    TickType_t xLastWake = xTaskGetTickCount();
+
+    for (;;) {
+        xTaskDelayUntil(&xLastWake, xPeriod);
+        ullWakes++;
+    }
+}
+
+/**
+ * @brief Loops of the background task per second over a delay of the caller.
+ *
+ * @param ulMilliseconds  the time to measure
+ * @param pullWakes       receives the wake ups per second in the same time
+ * @return the loops per second
+ */
+static uint64_t prvMeasure(uint32_t ulMilliseconds, uint64_t *pullWakes)
+{
+    const uint64_t ullLoops = ullBackgroundLoops;
+    const uint64_t ullWakesStart = ullWakes;
+    const uint64_t ullStart = prvNow();
+    uint64_t ullElapsed;
+
+    vTaskDelay(pdMS_TO_TICKS(ulMilliseconds));
+    ullElapsed = prvNow() - ullStart;
+
+    *pullWakes = ((ullWakes - ullWakesStart) * 1000000000ULL) / ullElapsed;
+    return ((ullBackgroundLoops - ullLoops) * 1000000000ULL) / ullElapsed;
+}
+
+/**
+ * @brief Run the simulation for every count of tasks, then stop the
+ * scheduler.
+ *
+ * @param pvParameters    not used
+ */
+static void prvControlTask(void *pvParameters)
+{
+    static TaskHandle_t xTasks[2000];
+    uint64_t ullIdleRate, ullRate, ullWakesPerSecond;
+
+    (void)pvParameters;
+
+    ullIdleRate = prvMeasure(delayedRUN_MS, &ullWakesPerSecond);
+    configASSERT(ullIdleRate > 0);
+
+    for (size_t xCount = 0; xCount < sizeof(ulCounts) / sizeof(ulCounts[0]); xCount++) {
+        const uint32_t ulTasks = ulCounts[xCount];
+        double dKernelShare;
+
+        configASSERT(ulTasks <= sizeof(xTasks) / sizeof(xTasks[0]));
+        for (uint32_t ulTask = 0; ulTask < ulTasks; ulTask++) {
+            const TickType_t xPeriod = delayedMIN_PERIOD + ((ulTask * 7U) % (delayedMAX_PERIOD - delayedMIN_PERIOD + 1U));
+
+            if (xTaskCreate(prvPeriodicTask, "periodic", delayedSTACK_SIZE, (void *)(uintptr_t)xPeriod,
+                            delayedTASK_PRIORITY, &xTasks[ulTask]) != pdPASS) {
+                configASSERT(pdFALSE);
+            }
+        }
+
+        /* the tasks start together, they spread over their periods first */
+        vTaskDelay(pdMS_TO_TICKS(delayedWARM_UP_MS));
+        ullRate = prvMeasure(delayedRUN_MS, &ullWakesPerSecond);
+        dKernelShare = (ullRate < ullIdleRate) ? (1.0 - ((double)ullRate / (double)ullIdleRate)) : 0.0;
+
+        printf("{\"record\":\"result\",\"tasks\":%lu,\"wakes_s\":%llu,\"kernel_pct\":%.1f,\"ns_per_wake\":%.0f}\n",
+               (unsigned long)ulTasks, (unsigned long long)ullWakesPerSecond, dKernelShare * 100.0,
+               (ullWakesPerSecond > 0) ? ((dKernelShare * 1e9) / (double)ullWakesPerSecond) : 0.0);
+        fflush(stdout);
+
+        for (uint32_t ulTask = 0; ulTask < ulTasks; ulTask++) {
+            vTaskDelete(xTasks[ulTask]);
+        }
+        /* the idle task frees the deleted tasks */
+        vTaskDelay(pdMS_TO_TICKS(delayedWARM_UP_MS));
+    }
+
+    vTaskEndScheduler();
+}
+
+/**
+ * @brief Create the background and the control task.
+ *
+ */
+int main(void)
+{
+    printf("{\"record\":\"config\",\"delayed_task_heap\":%d,\"tick_rate_hz\":%lu,\"min_period\":%u,\"max_period\":%u,\"run_ms\":%u}\n",
+           (int)configUSE_DELAYED_TASK_HEAP, (unsigned long)configTICK_RATE_HZ,
+           delayedMIN_PERIOD, delayedMAX_PERIOD, delayedRUN_MS);
+    fflush(stdout);
+
+    xTaskCreate(prvBackgroundTask, "background", configMINIMAL_STACK_SIZE, NULL, delayedBACKGROUND_PRIORITY, NULL);
+    xTaskCreate(prvControlTask, "control", configMINIMAL_STACK_SIZE * 4, NULL, delayedCONTROL_PRIORITY, NULL);
+    vTaskStartScheduler();
+
+    return 0;
+}
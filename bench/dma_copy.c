@@ -0,0 +1,358 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Benchmarks of the kernel on the Linux simulator                           |
+ |___________________________________________________________________________*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/prctl.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+
+/*
+ * CPU copies against copies offloaded to a simulated DMA engine.
+ *
+ * The engine is a host thread, a bus master next to the simulated core. It
+ * copies the data and raises its completion interrupt with
+ * vPortRaiseInterrupt() once the transfer time of the model has passed,
+ * dmaBYTES_PER_US by default or the rate given as the first argument. The
+ * default is the RP2040 channel, one word per cycle at 125 MHz. The copying
+ * task waits the way pvPortDmaCopy() does on the target, it sleeps on the
+ * notification index of configDMA_COPY_NOTIFY_INDEX or spins on the
+ * completion flag below configDMA_COPY_BLOCK_THRESHOLD.
+ *
+ * A task of lower priority counts loops in the background, its rate against a
+ * run without copies is the share of the core left to the application. The
+ * results are JSON lines, {"record":"config",...} first and then one
+ * {"record":"result","mode":"cpu|dma_spin|dma_block",...} per mode and copy
+ * size with the byte rate, the core left and, for the offloaded copies, the
+ * median time from the end of the modelled transfer to the return of the
+ * copy, the cost of the completion interrupt and of the wake up. The host
+ * preempting the process stretches some completions by milliseconds and lowers
+ * the offloaded byte rates, the median is the figure to compare.
+ */
+
+#define dmaBYTES_PER_US                 500UL
+#define dmaNOTIFY_INDEX                 1
+#define dmaRUN_NS                       200000000ULL
+#define dmaMAX_SIZE                     ( 256UL * 1024UL )
+#define dmaMAX_SAMPLES                  32768UL
+
+#if ( configTASK_NOTIFICATION_ARRAY_ENTRIES <= dmaNOTIFY_INDEX )
+    #error The copying task sleeps on notification index 1, build the benchmark with options_dma_copy.h.
+#endif
+
+#define dmaCOPY_PRIORITY                ( tskIDLE_PRIORITY + 2 )
+#define dmaBACKGROUND_PRIORITY          ( tskIDLE_PRIORITY + 1 )
+
+/* the ways a copy is made */
+typedef enum {
+    dmaMODE_CPU,
+    dmaMODE_SPIN,
+    dmaMODE_BLOCK
+} DmaMode_t;
+
+/* transfer handed to the engine */
+typedef struct {
+    void *pvDest;
+    const void *pvSrc;
+    size_t xLength;
+    uint64_t ullDoneNs;             /* end of the modelled transfer */
+} DmaTransfer_t;
+
+static const char *const pcModeNames[] = { "cpu", "dma_spin", "dma_block" };
+static const size_t xSizes[] = { 64, 1024, 16384, dmaMAX_SIZE };
+
+static unsigned long ulBytesPerUs = dmaBYTES_PER_US;
+static uint8_t ucSource[dmaMAX_SIZE];
+static uint8_t ucDestination[dmaMAX_SIZE];
+
+static DmaTransfer_t xTransfer;
+static sem_t xEngineRequest;
+static volatile uint32_t ulEngineStop = 0;
+static volatile uint32_t ulTransferDone = 0;
+static TaskHandle_t volatile xWaitingTask = NULL;
+
+static volatile uint64_t ullBackgroundLoops = 0;
+static uint32_t ulCompletionNs[dmaMAX_SAMPLES];
+
+/**
+ * @brief Monotonic time of the host.
+ *
+ * @return the time in nanoseconds
+ */
+static uint64_t prvNow(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return ((uint64_t)xNow.tv_sec * 1000000000ULL) + (uint64_t)xNow.tv_nsec;
+}
+
+/**
+ * @brief Order of the completion times for qsort().
+ *
+ */
+static int prvCompareSamples(const void *pvA, const void *pvB)
+{
+    const uint32_t ulA = *(const uint32_t *)pvA;
+    const uint32_t ulB = *(const uint32_t *)pvB;
+
+    return (ulA > ulB) - (ulA < ulB);
+}
+
+/**
+ * @brief Completion interrupt of the engine, wakes the task waiting for the
+ * transfer.
+ *
+ */
+static void prvDmaCompleteHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    ulTransferDone = 1;
+    if (xWaitingTask != NULL) {
+        vTaskNotifyGiveIndexedFromISR(xWaitingTask, dmaNOTIFY_INDEX, &xHigherPriorityTaskWoken);
+        if (xHigherPriorityTaskWoken != pdFALSE) {
+            portYIELD_FROM_ISR();
+        }
+    }
+}
+
+/**
+ * @brief Host thread of the engine, one transfer at a time.
+ *
+ * @param pvParameters    not used
+ * @return NULL
+ */
+static void *prvEngineThread(void *pvParameters)
+{
+    struct sched_param xParam = { .sched_priority = sched_get_priority_min(SCHED_FIFO) };
+    sigset_t xSignals;
+
+    (void)pvParameters;
+
+    /* the tick and the interrupts belong to the simulated core */
+    sigfillset(&xSignals);
+    pthread_sigmask(SIG_BLOCK, &xSignals, NULL);
+
+    /* The hardware does not wait for the host to schedule it, with a real time
+    priority the engine preempts the simulated core even on a single CPU. The
+    timer slack would otherwise delay every completion by tens of microseconds.
+    Without the privileges the results include the latency of the host. */
+    pthread_setschedparam(pthread_self(), SCHED_FIFO, &xParam);
+    prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+
+    for (;;) {
+        struct timespec xDone;
+
+        while (sem_wait(&xEngineRequest) != 0) {
+        }
+        if (ulEngineStop != 0) {
+            return NULL;
+        }
+
+        memcpy(xTransfer.pvDest, xTransfer.pvSrc, xTransfer.xLength);
+        xDone.tv_sec = (time_t)(xTransfer.ullDoneNs / 1000000000ULL);
+        xDone.tv_nsec = (long)(xTransfer.ullDoneNs % 1000000000ULL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &xDone, NULL) != 0) {
+        }
+
+        vPortRaiseInterrupt(prvDmaCompleteHandler);
+    }
+}
+
+/**
+ * @brief Copy through the engine, the caller sleeps or spins until the
+ * completion interrupt.
+ *
+ * @param pvDest      destination
+ * @param pvSrc       source
+ * @param xLength     bytes to copy
+ * @param xBlock      pdTRUE to sleep on the notification, pdFALSE to spin
+ * @return the end of the modelled transfer
+ */
+static uint64_t prvDmaCopy(void *pvDest, const void *pvSrc, size_t xLength, BaseType_t xBlock)
+{
+    uint32_t ulMask;
+
+    xTransfer.pvDest = pvDest;
+    xTransfer.pvSrc = pvSrc;
+    xTransfer.xLength = xLength;
+    xTransfer.ullDoneNs = prvNow() + (((uint64_t)xLength * 1000ULL) / ulBytesPerUs);
+    ulTransferDone = 0;
+    xWaitingTask = (xBlock != pdFALSE) ? xTaskGetCurrentTaskHandle() : NULL;
+
+    /* the channel is started with the core masked, like the target claims it */
+    ulMask = ulSetInterruptMaskFromISR();
+    sem_post(&xEngineRequest);
+    vClearInterruptMaskFromISR(ulMask);
+
+    if (xBlock != pdFALSE) {
+        ulTaskNotifyTakeIndexed(dmaNOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+    } else {
+        while (ulTransferDone == 0) {
+        }
+    }
+    return xTransfer.ullDoneNs;
+}
+
+/**
+ * @brief Count loops, the share of the core left by the copies.
+ *
+ * @param pvParameters    not used
+ */
+static void prvBackgroundTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;) {
+        ullBackgroundLoops++;
+    }
+}
+
+/**
+ * @brief Copy blocks of one size for dmaRUN_NS and print the result.
+ *
+ * @param xMode           how the blocks are copied
+ * @param xSize           size of a block
+ * @param ullIdleRate     background loops per second without copies
+ */
+static void prvRun(DmaMode_t xMode, size_t xSize, uint64_t ullIdleRate)
+{
+    const uint64_t ullLoopsStart = ullBackgroundLoops;
+    const uint64_t ullStart = prvNow();
+    uint64_t ullNow = ullStart;
+    uint64_t ullBytes = 0;
+    uint64_t ullCopies = 0;
+    uint64_t ullLoops, ullElapsed;
+    uint32_t ulSamples = 0;
+    uint32_t ulMedian = 0;
+
+    while ((ullNow - ullStart) < dmaRUN_NS) {
+        if (xMode == dmaMODE_CPU) {
+            memcpy(ucDestination, ucSource, xSize);
+            ullNow = prvNow();
+        } else {
+            const uint64_t ullDone = prvDmaCopy(ucDestination, ucSource, xSize, (xMode == dmaMODE_BLOCK) ? pdTRUE : pdFALSE);
+
+            ullNow = prvNow();
+            if (ulSamples < dmaMAX_SAMPLES) {
+                ulCompletionNs[ulSamples++] = (uint32_t)(ullNow - ullDone);
+            }
+        }
+        configASSERT(memcmp(ucDestination, ucSource, xSize) == 0);
+        ullBytes += xSize;
+        ullCopies++;
+    }
+    ullLoops = ullBackgroundLoops - ullLoopsStart;
+    ullElapsed = ullNow - ullStart;
+    if (ulSamples > 0) {
+        qsort(ulCompletionNs, ulSamples, sizeof(ulCompletionNs[0]), prvCompareSamples);
+        ulMedian = ulCompletionNs[ulSamples / 2];
+    }
+
+    printf("{\"record\":\"result\",\"mode\":\"%s\",\"size\":%lu,\"copies\":%llu,\"mb_s\":%llu,"
+           "\"core_left_pct\":%llu,\"completion_ns\":%llu}\n",
+           pcModeNames[xMode], (unsigned long)xSize, (unsigned long long)ullCopies,
+           (unsigned long long)((ullBytes * 1000ULL) / ullElapsed),
+           (unsigned long long)(((ullLoops * 1000000000ULL) / ullElapsed) * 100ULL / ullIdleRate),
+           (unsigned long long)ulMedian);
+}
+
+/**
+ * @brief Measure the background rate, then every mode and size.
+ *
+ * @param pvParameters    not used
+ */
+static void prvCopyTask(void *pvParameters)
+{
+    uint64_t ullLoops, ullIdleRate;
+
+    (void)pvParameters;
+
+    for (size_t xByte = 0; xByte < sizeof(ucSource); xByte++) {
+        ucSource[xByte] = (uint8_t)(xByte * 31U);
+    }
+
+    /* the core is all left to the background task while this one sleeps */
+    ullLoops = ullBackgroundLoops;
+    vTaskDelay(pdMS_TO_TICKS(dmaRUN_NS / 1000000ULL));
+    ullIdleRate = ((ullBackgroundLoops - ullLoops) * 1000000000ULL) / dmaRUN_NS;
+    if (ullIdleRate == 0) {
+        ullIdleRate = 1;
+    }
+
+    for (size_t xSize = 0; xSize < sizeof(xSizes) / sizeof(xSizes[0]); xSize++) {
+        for (DmaMode_t xMode = dmaMODE_CPU; xMode <= dmaMODE_BLOCK; xMode++) {
+            prvRun(xMode, xSizes[xSize], ullIdleRate);
+        }
+    }
+
+    vTaskEndScheduler();
+}
+
+/**
+ * @brief Start the engine and the tasks of the benchmark.
+ *
+ */
+int main(int argc, char *argv[])
+{
+    pthread_t xEngine;
+
+    if (argc > 1) {
+        ulBytesPerUs = strtoul(argv[1], NULL, 0);
+        if (ulBytesPerUs == 0) {
+            fprintf(stderr, "dma_copy: the rate is in bytes per microsecond\n");
+            return 1;
+        }
+    }
+
+    printf("{\"record\":\"config\",\"dma_bytes_per_us\":%lu,\"run_ms\":%llu}\n",
+           ulBytesPerUs, (unsigned long long)(dmaRUN_NS / 1000000ULL));
+    fflush(stdout);
+
+    sem_init(&xEngineRequest, 0, 0);
+    if (pthread_create(&xEngine, NULL, prvEngineThread, NULL) != 0) {
+        fprintf(stderr, "dma_copy: cannot start the engine\n");
+        return 1;
+    }
+
+    xTaskCreate(prvBackgroundTask, "background", configMINIMAL_STACK_SIZE, NULL, dmaBACKGROUND_PRIORITY, NULL);
+    xTaskCreate(prvCopyTask, "copy", configMINIMAL_STACK_SIZE * 4, NULL, dmaCOPY_PRIORITY, NULL);
+    vTaskStartScheduler();
+
+    ulEngineStop = 1;
+    sem_post(&xEngineRequest);
+    pthread_join(xEngine, NULL);
+    return 0;
+}
@@ -0,0 +1,445 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Benchmarks of the kernel on the Linux simulator                           |
+ |___________________________________________________________________________*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * Replay of allocation traces on the heap selected by configHEAP_IMPLEMENTATION.
+ *
+ * Without arguments three synthetic workloads are replayed, every argument is
+ * otherwise the file of a recorded trace. A trace has one operation per line,
+ * "m <id> <size>" for an allocation and "f <id>" for the free of the block
+ * allocated with the same id, lines starting with '#' are ignored. The trace
+ * of a target is recorded with the address of the block as the id:
+ *
+ * #define traceMALLOC( pvAddress, uiSize )    printf( "m %p %u\n", pvAddress, ( unsigned ) uiSize )
+ * #define traceFREE( pvAddress, uiSize )      printf( "f %p\n", pvAddress )
+ *
+ * The results are JSON lines, {"record":"config",...} first and then one
+ * {"record":"result","trace":"<name>",...} per trace with the allocations that
+ * failed, the average, 99.9th percentile and longest malloc and free times, the
+ * lowest free heap and the worst fragmentation seen, 100 * (1 - largest free
+ * block / free heap). On the simulator the longest times are those of the
+ * host preempting the process, the percentile is the figure to compare.
+ */
+
+#define replayMAX_LIVE                  8192UL
+#define replayTABLE_SIZE                ( replayMAX_LIVE * 2UL )
+#define replaySAMPLE_PERIOD             64UL
+#define replaySYNTHETIC_OPERATIONS      200000UL
+#define replayLINE_LENGTH               128
+
+/* one operation of a trace, a size of 0 frees the block */
+typedef struct {
+    uint64_t ullId;
+    uint32_t ulSize;
+} ReplayEvent_t;
+
+/* a live block of the replay, found by the id of the trace */
+typedef struct {
+    uint64_t ullId;
+    void *pvBlock;
+} ReplayLiveBlock_t;
+
+/* shape of a synthetic workload */
+typedef struct {
+    const char *pcName;
+    uint32_t ulMinSize;
+    uint32_t ulMaxSize;
+    uint32_t ulLongLivedPermille;   /* allocations kept until the end of the trace */
+} ReplayWorkload_t;
+
+static const ReplayWorkload_t xWorkloads[] = {
+    { "messages", 16, 256, 0 },
+    { "mixed_lifetime", 32, 2048, 50 },
+    { "buffers", 64, 4096, 10 },
+};
+
+static ReplayLiveBlock_t xLiveBlocks[replayTABLE_SIZE];
+static ReplayEvent_t *pxEvents;
+static size_t xEventCount;
+static size_t xEventCapacity;
+static uint32_t ulSeed = 1;
+static uint32_t ulMallocFailures;
+static uint32_t *pulMallocTimes;
+static uint32_t *pulFreeTimes;
+
+#if ( configHEAP_IMPLEMENTATION == 5 )
+static uint8_t ucHeap[configTOTAL_HEAP_SIZE];
+#endif
+
+/**
+ * @brief Count the failed allocations instead of ending the program.
+ *
+ */
+void vApplicationMallocFailedHook(void)
+{
+    ulMallocFailures++;
+}
+
+/**
+ * @brief Small deterministic pseudo random generator.
+ *
+ */
+static uint32_t prvRandom(uint32_t ulRange)
+{
+    ulSeed = (ulSeed * 1103515245UL) + 12345UL;
+    return (ulSeed >> 8) % ulRange;
+}
+
+/**
+ * @brief Monotonic time in nanoseconds.
+ *
+ */
+static uint64_t prvNow(void)
+{
+    struct timespec xTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &xTime);
+    return ((uint64_t)xTime.tv_sec * 1000000000ULL) + (uint64_t)xTime.tv_nsec;
+}
+
+/**
+ * @brief Append one operation to the trace.
+ *
+ */
+static void prvAddEvent(uint64_t ullId, uint32_t ulSize)
+{
+    if (xEventCount == xEventCapacity) {
+        xEventCapacity = (xEventCapacity == 0) ? 4096 : xEventCapacity * 2;
+        pxEvents = realloc(pxEvents, xEventCapacity * sizeof(ReplayEvent_t));
+        if (pxEvents == NULL) {
+            fprintf(stderr, "heap_replay: out of host memory\n");
+            exit(1);
+        }
+    }
+
+    pxEvents[xEventCount].ullId = ullId;
+    pxEvents[xEventCount].ulSize = ulSize;
+    xEventCount++;
+}
+
+/**
+ * @brief Build a synthetic trace that keeps the heap about three quarters full.
+ *
+ * Blocks are freed in random order. The long lived ones, at most a quarter of
+ * the live bytes, are only freed at the end of the trace so they pin the
+ * memory around them.
+ */
+static void prvGenerateTrace(const ReplayWorkload_t *pxWorkload)
+{
+    static uint64_t ullLive[replayMAX_LIVE];
+    static uint32_t ulLiveSize[replayMAX_LIVE];
+    static uint64_t ullLongLived[replayMAX_LIVE];
+    const uint32_t ulTargetBytes = (configTOTAL_HEAP_SIZE * 3UL) / 4UL;
+    uint32_t ulLive = 0, ulLongLived = 0, ulLiveBytes = 0, ulLongLivedBytes = 0;
+    uint64_t ullNextId = 1;
+
+    xEventCount = 0;
+    for (uint32_t ulOperation = 0; ulOperation < replaySYNTHETIC_OPERATIONS; ulOperation++) {
+        uint32_t ulSize = pxWorkload->ulMinSize + prvRandom(pxWorkload->ulMaxSize - pxWorkload->ulMinSize + 1UL);
+
+        if (((ulLive + ulLongLived) < replayMAX_LIVE) && ((ulLiveBytes + ulSize) < ulTargetBytes) && ((ulLive == 0) || (prvRandom(2) == 0))) {
+            prvAddEvent(ullNextId, ulSize);
+            ulLiveBytes += ulSize;
+            if ((prvRandom(1000) < pxWorkload->ulLongLivedPermille) && ((ulLongLivedBytes + ulSize) < (ulTargetBytes / 4UL))) {
+                ullLongLived[ulLongLived++] = ullNextId;
+                ulLongLivedBytes += ulSize;
+            } else {
+                ullLive[ulLive] = ullNextId;
+                ulLiveSize[ulLive] = ulSize;
+                ulLive++;
+            }
+            ullNextId++;
+        } else if (ulLive > 0) {
+            uint32_t ulIndex = prvRandom(ulLive);
+
+            prvAddEvent(ullLive[ulIndex], 0);
+            ulLiveBytes -= ulLiveSize[ulIndex];
+            ulLive--;
+            ullLive[ulIndex] = ullLive[ulLive];
+            ulLiveSize[ulIndex] = ulLiveSize[ulLive];
+        }
+    }
+
+    while (ulLive > 0) {
+        prvAddEvent(ullLive[--ulLive], 0);
+    }
+    while (ulLongLived > 0) {
+        prvAddEvent(ullLongLived[--ulLongLived], 0);
+    }
+}
+
+/**
+ * @brief Read a recorded trace.
+ *
+ * @return pdPASS if the file could be read
+ */
+static BaseType_t prvLoadTrace(const char *pcFile)
+{
+    char cLine[replayLINE_LENGTH];
+    FILE *pxFile = fopen(pcFile, "r");
+
+    if (pxFile == NULL) {
+        return pdFAIL;
+    }
+
+    xEventCount = 0;
+    while (fgets(cLine, sizeof(cLine), pxFile) != NULL) {
+        char *pcEnd;
+        uint64_t ullId;
+
+        if ((cLine[0] != 'm') && (cLine[0] != 'f')) {
+            continue;
+        }
+
+        ullId = strtoull(&cLine[1], &pcEnd, 0);
+        if (cLine[0] == 'm') {
+            uint32_t ulSize = (uint32_t)strtoul(pcEnd, NULL, 0);
+
+            /* a zero size allocation does not change the heap */
+            if (ulSize > 0) {
+                prvAddEvent(ullId, ulSize);
+            }
+        } else {
+            prvAddEvent(ullId, 0);
+        }
+    }
+
+    fclose(pxFile);
+    return pdPASS;
+}
+
+/**
+ * @brief Order the operation times.
+ *
+ */
+static int prvCompareTimes(const void *pvA, const void *pvB)
+{
+    const uint32_t ulA = *(const uint32_t *)pvA, ulB = *(const uint32_t *)pvB;
+
+    return (ulA > ulB) - (ulA < ulB);
+}
+
+/**
+ * @brief 99.9th percentile of the operation times.
+ *
+ */
+static uint32_t prvPercentile(uint32_t *pulTimes, uint32_t ulCount)
+{
+    if (ulCount == 0) {
+        return 0;
+    }
+
+    qsort(pulTimes, ulCount, sizeof(uint32_t), prvCompareTimes);
+    return pulTimes[((uint64_t)ulCount * 999ULL) / 1000ULL];
+}
+
+/**
+ * @brief Find the slot of a live block, or the free slot it would take.
+ *
+ */
+static ReplayLiveBlock_t *prvFindLiveBlock(uint64_t ullId)
+{
+    uint32_t ulIndex = (uint32_t)((ullId * 0x9e3779b97f4a7c15ULL) >> 40) % replayTABLE_SIZE;
+
+    while ((xLiveBlocks[ulIndex].pvBlock != NULL) && (xLiveBlocks[ulIndex].ullId != ullId)) {
+        ulIndex = (ulIndex + 1UL) % replayTABLE_SIZE;
+    }
+
+    return &xLiveBlocks[ulIndex];
+}
+
+/**
+ * @brief Remove a live block, the blocks that follow it in its probe sequence
+ * are moved back so the lookups do not need tombstones.
+ *
+ */
+static void prvRemoveLiveBlock(ReplayLiveBlock_t *pxSlot)
+{
+    uint32_t ulHole = (uint32_t)(pxSlot - xLiveBlocks);
+    uint32_t ulIndex = ulHole;
+
+    xLiveBlocks[ulHole].pvBlock = NULL;
+    for (;;) {
+        uint32_t ulHome;
+
+        ulIndex = (ulIndex + 1UL) % replayTABLE_SIZE;
+        if (xLiveBlocks[ulIndex].pvBlock == NULL) {
+            return;
+        }
+
+        /* a block can move back to the hole only if its home is not between them */
+        ulHome = (uint32_t)((xLiveBlocks[ulIndex].ullId * 0x9e3779b97f4a7c15ULL) >> 40) % replayTABLE_SIZE;
+        if (((ulIndex > ulHole) && ((ulHome <= ulHole) || (ulHome > ulIndex))) ||
+            ((ulIndex < ulHole) && ((ulHome <= ulHole) && (ulHome > ulIndex)))) {
+            xLiveBlocks[ulHole] = xLiveBlocks[ulIndex];
+            xLiveBlocks[ulIndex].pvBlock = NULL;
+            ulHole = ulIndex;
+        }
+    }
+}
+
+/**
+ * @brief Replay the trace on the kernel heap and write its result.
+ *
+ */
+static void prvReplay(const char *pcName)
+{
+    uint64_t ullMallocTotal = 0, ullMallocMax = 0, ullFreeTotal = 0, ullFreeMax = 0;
+    uint32_t ulMallocs = 0, ulFrees = 0, ulFailed = 0, ulUnknown = 0, ulWorstFragmentation = 0;
+    HeapStats_t xStats;
+
+    memset(xLiveBlocks, 0, sizeof(xLiveBlocks));
+    ulMallocFailures = 0;
+    pulMallocTimes = realloc(pulMallocTimes, (xEventCount + 1) * sizeof(uint32_t));
+    pulFreeTimes = realloc(pulFreeTimes, (xEventCount + 1) * sizeof(uint32_t));
+    if ((pulMallocTimes == NULL) || (pulFreeTimes == NULL)) {
+        fprintf(stderr, "heap_replay: out of host memory\n");
+        exit(1);
+    }
+
+    for (size_t xEvent = 0; xEvent < xEventCount; xEvent++) {
+        ReplayLiveBlock_t *pxSlot = prvFindLiveBlock(pxEvents[xEvent].ullId);
+        uint64_t ullStart, ullTime;
+
+        if (pxEvents[xEvent].ulSize > 0) {
+            void *pvBlock;
+
+            /* the id of a block whose free was not recorded is taken again */
+            if (pxSlot->pvBlock != NULL) {
+                ulUnknown++;
+                continue;
+            }
+
+            ullStart = prvNow();
+            pvBlock = pvPortMalloc(pxEvents[xEvent].ulSize);
+            ullTime = prvNow() - ullStart;
+            ullMallocTotal += ullTime;
+            ullMallocMax = (ullTime > ullMallocMax) ? ullTime : ullMallocMax;
+            pulMallocTimes[ulMallocs++] = (uint32_t)ullTime;
+
+            if (pvBlock == NULL) {
+                ulFailed++;
+                continue;
+            }
+            pxSlot->ullId = pxEvents[xEvent].ullId;
+            pxSlot->pvBlock = pvBlock;
+        } else {
+            /* the allocation failed or was not recorded */
+            if (pxSlot->pvBlock == NULL) {
+                ulUnknown++;
+                continue;
+            }
+
+            ullStart = prvNow();
+            vPortFree(pxSlot->pvBlock);
+            ullTime = prvNow() - ullStart;
+            ullFreeTotal += ullTime;
+            ullFreeMax = (ullTime > ullFreeMax) ? ullTime : ullFreeMax;
+            pulFreeTimes[ulFrees++] = (uint32_t)ullTime;
+
+            prvRemoveLiveBlock(pxSlot);
+        }
+
+        if ((xEvent % replaySAMPLE_PERIOD) == 0) {
+            vPortGetHeapStats(&xStats);
+            if (xStats.xAvailableHeapSpaceInBytes > 0) {
+                uint32_t ulFragmentation = 100UL - (uint32_t)((xStats.xSizeOfLargestFreeBlockInBytes * 100ULL) / xStats.xAvailableHeapSpaceInBytes);
+
+                ulWorstFragmentation = (ulFragmentation > ulWorstFragmentation) ? ulFragmentation : ulWorstFragmentation;
+            }
+        }
+    }
+
+    /* the blocks the trace never freed */
+    for (uint32_t ulIndex = 0; ulIndex < replayTABLE_SIZE; ulIndex++) {
+        if (xLiveBlocks[ulIndex].pvBlock != NULL) {
+            vPortFree(xLiveBlocks[ulIndex].pvBlock);
+            xLiveBlocks[ulIndex].pvBlock = NULL;
+        }
+    }
+    vPortGetHeapStats(&xStats);
+
+    printf("{\"record\":\"result\",\"trace\":\"%s\",\"mallocs\":%lu,\"frees\":%lu,\"failed\":%lu,\"skipped\":%lu,"
+           "\"avg_malloc_ns\":%llu,\"p999_malloc_ns\":%lu,\"max_malloc_ns\":%llu,"
+           "\"avg_free_ns\":%llu,\"p999_free_ns\":%lu,\"max_free_ns\":%llu,"
+           "\"min_ever_free\":%lu,\"worst_fragmentation_pct\":%lu,\"free_blocks_after\":%lu}\n",
+           pcName, (unsigned long)ulMallocs, (unsigned long)ulFrees, (unsigned long)ulFailed, (unsigned long)ulUnknown,
+           (unsigned long long)(ullMallocTotal / ((ulMallocs > 0) ? ulMallocs : 1)),
+           (unsigned long)prvPercentile(pulMallocTimes, ulMallocs), (unsigned long long)ullMallocMax,
+           (unsigned long long)(ullFreeTotal / ((ulFrees > 0) ? ulFrees : 1)),
+           (unsigned long)prvPercentile(pulFreeTimes, ulFrees), (unsigned long long)ullFreeMax,
+           (unsigned long)xStats.xMinimumEverFreeBytesRemaining, (unsigned long)ulWorstFragmentation,
+           (unsigned long)xStats.xNumberOfFreeBlocks);
+}
+
+/**
+ * @brief Replay the synthetic workloads or the traces given as arguments.
+ *
+ */
+int main(int argc, char *argv[])
+{
+#if ( configHEAP_IMPLEMENTATION == 5 )
+    const HeapRegion_t xRegions[] = {
+        { ucHeap, sizeof(ucHeap), 0 },
+        { NULL, 0, 0 }
+    };
+
+    vPortDefineHeapRegions(xRegions);
+#elif ( configHEAP_IMPLEMENTATION == 3 )
+    #error The newlib heap keeps no statistics, select heap_5.c or heap_6.c.
+#endif
+
+    printf("{\"record\":\"config\",\"heap\":%d,\"heap_size\":%lu}\n",
+           (int)configHEAP_IMPLEMENTATION, (unsigned long)configTOTAL_HEAP_SIZE);
+
+    if (argc < 2) {
+        for (size_t xWorkload = 0; xWorkload < sizeof(xWorkloads) / sizeof(xWorkloads[0]); xWorkload++) {
+            prvGenerateTrace(&xWorkloads[xWorkload]);
+            prvReplay(xWorkloads[xWorkload].pcName);
+        }
+    } else {
+        for (int iArg = 1; iArg < argc; iArg++) {
+            if (prvLoadTrace(argv[iArg]) != pdPASS) {
+                fprintf(stderr, "heap_replay: cannot read %s\n", argv[iArg]);
+                return 1;
+            }
+            prvReplay(argv[iArg]);
+        }
+    }
+
+    free(pxEvents);
+    free(pulMallocTimes);
+    free(pulFreeTimes);
+    return 0;
+}
@@ -0,0 +1,59 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Rhealstone style kernel benchmarks                                        |
+ |___________________________________________________________________________*/
+
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+#include "rhealstone.h"
+
+/**
+ * @brief Write one result line to stdout.
+ *
+ * @param pcLine  the line, without the terminator
+ */
+static void prvOutput(const char *pcLine)
+{
+    puts(pcLine);
+    fflush(stdout);
+}
+
+/**
+ * @brief Run the benchmarks on the Linux simulator, the results are written to
+ * stdout and the process ends after the last one.
+ *
+ */
+int main(void)
+{
+    if (xRhealstoneStart(prvOutput, vPortRunAsInterrupt, NULL, vTaskEndScheduler) != pdPASS) {
+        fprintf(stderr, "rhealstone: not enough memory to start the benchmarks\n");
+        return 1;
+    }
+
+    vTaskStartScheduler();
+    return 0;
+}
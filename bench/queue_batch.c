@@ -0,0 +1,239 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Benchmarks of the kernel on the Linux simulator                           |
+ |___________________________________________________________________________*/
+
+#include <stdio.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "port.h"
+
+/*
+ * Throughput of the batch queue functions against the single item path.
+ *
+ * The same number of 32 bit items is moved through a queue in bursts of
+ * batchBURSTS[] items, once with an xQueueSend()/xQueueReceive() per item and
+ * once with one batch call per burst, in three scenarios:
+ *
+ * - loopback: a task posts a burst and receives it back, the cost of the
+ *   functions alone, without any task switch.
+ * - fan_in: a task posts bursts to a task of higher priority blocked on the
+ *   queue, the single path wakes the receiver for every item.
+ * - isr_fan_in: the bursts are posted by a simulated interrupt with the
+ *   FromISR functions, the receiver runs once the interrupt returns.
+ *
+ * The results are JSON lines, {"record":"config",...} first and then one
+ * {"record":"result",...} per scenario and burst with the nanoseconds per item
+ * of both paths and the speedup of the batch.
+ */
+
+#define batchITEMS                      262144UL
+#define batchQUEUE_LENGTH               128
+#define batchCONSUMER_PRIORITY          ( tskIDLE_PRIORITY + 2 )
+#define batchPRODUCER_PRIORITY          ( tskIDLE_PRIORITY + 1 )
+
+/* the scenarios of the benchmark */
+typedef enum {
+    batchLOOPBACK,
+    batchFAN_IN,
+    batchISR_FAN_IN
+} BatchScenario_t;
+
+static const char *const pcScenarioNames[] = { "loopback", "fan_in", "isr_fan_in" };
+static const UBaseType_t uxBursts[] = { 1, 4, 16, 64 };
+
+static QueueHandle_t xQueue;
+static TaskHandle_t xProducerTask;
+
+/* path and burst of the run, read by the receiver and the interrupt */
+static volatile BaseType_t xUseBatch;
+static volatile UBaseType_t uxBurst;
+static volatile uint32_t ulExpected;
+static uint32_t ulItems[batchQUEUE_LENGTH];
+
+/**
+ * @brief Monotonic time of the host.
+ *
+ * @return the time in nanoseconds
+ */
+static uint64_t prvNow(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return ((uint64_t)xNow.tv_sec * 1000000000ULL) + (uint64_t)xNow.tv_nsec;
+}
+
+/**
+ * @brief Simulated interrupt, posts a burst with the FromISR functions.
+ *
+ */
+static void prvBurstInterrupt(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if (xUseBatch != pdFALSE) {
+        xQueueSendBatchFromISR(xQueue, ulItems, uxBurst, &xHigherPriorityTaskWoken);
+    } else {
+        for (UBaseType_t uxItem = 0; uxItem < uxBurst; uxItem++) {
+            xQueueSendFromISR(xQueue, &ulItems[uxItem], &xHigherPriorityTaskWoken);
+        }
+    }
+    if (xHigherPriorityTaskWoken != pdFALSE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * @brief Receiver of the fan in scenarios, tells the producer once all the
+ * items of the run arrived.
+ *
+ * @param pvParameters    not used
+ */
+static void prvConsumerTask(void *pvParameters)
+{
+    uint32_t ulBuffer[batchQUEUE_LENGTH];
+    uint32_t ulReceived = 0;
+
+    (void)pvParameters;
+
+    for (;;) {
+        if (xUseBatch != pdFALSE) {
+            ulReceived += (uint32_t)xQueueReceiveBatch(xQueue, ulBuffer, batchQUEUE_LENGTH, portMAX_DELAY);
+        } else if (xQueueReceive(xQueue, ulBuffer, portMAX_DELAY) == pdPASS) {
+            ulReceived++;
+        }
+
+        if (ulReceived == ulExpected) {
+            ulReceived = 0;
+            xTaskNotifyGive(xProducerTask);
+        }
+    }
+}
+
+/**
+ * @brief Move batchITEMS items through the queue.
+ *
+ * @param xScenario   the scenario
+ * @param xBatch      pdTRUE for the batch functions
+ * @return the nanoseconds per item
+ */
+static double prvRun(BatchScenario_t xScenario, BaseType_t xBatch)
+{
+    uint32_t ulBuffer[batchQUEUE_LENGTH];
+    uint64_t ullStart;
+
+    xUseBatch = xBatch;
+    ulExpected = batchITEMS;
+
+    ullStart = prvNow();
+    for (uint32_t ulSent = 0; ulSent < batchITEMS; ulSent += uxBurst) {
+        if (xScenario == batchISR_FAN_IN) {
+            vPortRunAsInterrupt(prvBurstInterrupt);
+        } else if (xBatch != pdFALSE) {
+            xQueueSendBatch(xQueue, ulItems, uxBurst, portMAX_DELAY);
+        } else {
+            for (UBaseType_t uxItem = 0; uxItem < uxBurst; uxItem++) {
+                xQueueSend(xQueue, &ulItems[uxItem], portMAX_DELAY);
+            }
+        }
+
+        if (xScenario == batchLOOPBACK) {
+            if (xBatch != pdFALSE) {
+                xQueueReceiveBatch(xQueue, ulBuffer, uxBurst, 0);
+            } else {
+                for (UBaseType_t uxItem = 0; uxItem < uxBurst; uxItem++) {
+                    xQueueReceive(xQueue, ulBuffer, 0);
+                }
+            }
+        }
+    }
+    if (xScenario != batchLOOPBACK) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+
+    return (double)(prvNow() - ullStart) / (double)batchITEMS;
+}
+
+/**
+ * @brief Run every scenario and burst, then stop the scheduler.
+ *
+ * @param pvParameters    not used
+ */
+static void prvProducerTask(void *pvParameters)
+{
+    TaskHandle_t xConsumer;
+
+    (void)pvParameters;
+
+    for (BatchScenario_t xScenario = batchLOOPBACK; xScenario <= batchISR_FAN_IN; xScenario++) {
+        /* the loopback has no receiver, the items come back to the producer */
+        xConsumer = NULL;
+        if (xScenario != batchLOOPBACK) {
+            xTaskCreate(prvConsumerTask, "consumer", configMINIMAL_STACK_SIZE * 4, NULL, batchCONSUMER_PRIORITY, &xConsumer);
+        }
+
+        for (size_t xBurst = 0; xBurst < sizeof(uxBursts) / sizeof(uxBursts[0]); xBurst++) {
+            double dSingle, dBatch;
+
+            uxBurst = uxBursts[xBurst];
+            dSingle = prvRun(xScenario, pdFALSE);
+            dBatch = prvRun(xScenario, pdTRUE);
+
+            printf("{\"record\":\"result\",\"scenario\":\"%s\",\"burst\":%lu,"
+                   "\"single_ns_per_item\":%.1f,\"batch_ns_per_item\":%.1f,\"speedup\":%.2f}\n",
+                   pcScenarioNames[xScenario], (unsigned long)uxBurst, dSingle, dBatch, dSingle / dBatch);
+        }
+
+        if (xConsumer != NULL) {
+            vTaskDelete(xConsumer);
+        }
+    }
+
+    vTaskEndScheduler();
+}
+
+/**
+ * @brief Create the queue and the producer.
+ *
+ */
+int main(void)
+{
+    for (uint32_t ulItem = 0; ulItem < batchQUEUE_LENGTH; ulItem++) {
+        ulItems[ulItem] = ulItem;
+    }
+
+    printf("{\"record\":\"config\",\"items\":%lu,\"queue_length\":%d,\"item_size\":%u}\n",
+           (unsigned long)batchITEMS, batchQUEUE_LENGTH, (unsigned)sizeof(uint32_t));
+
+    xQueue = xQueueCreate(batchQUEUE_LENGTH, sizeof(uint32_t));
+    configASSERT(xQueue != NULL);
+    xTaskCreate(prvProducerTask, "producer", configMINIMAL_STACK_SIZE * 4, NULL, batchPRODUCER_PRIORITY, &xProducerTask);
+    vTaskStartScheduler();
+
+    return 0;
+}
@@ -0,0 +1,517 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Rhealstone style kernel benchmarks                                        |
+ |___________________________________________________________________________*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "rhealstone.h"
+
+#if ( configGENERATE_RUN_TIME_STATS != 1 )
+    #error The benchmarks are timed with the run time counter, set configGENERATE_RUN_TIME_STATS to 1.
+#endif
+
+#if ( configMAX_PRIORITIES < 5 )
+    #error The benchmarks need configMAX_PRIORITIES of at least 5.
+#endif
+
+#if ( configUSE_MUTEXES != 1 ) || ( INCLUDE_vTaskSuspend != 1 )
+    #error The benchmarks need configUSE_MUTEXES and INCLUDE_vTaskSuspend set to 1.
+#endif
+
+/* the control task is above all the workers */
+#define rhealstoneCONTROL_PRIORITY      ( configMAX_PRIORITIES - 1 )
+#define rhealstoneHIGH_PRIORITY         ( configMAX_PRIORITIES - 2 )
+#define rhealstoneMEDIUM_PRIORITY       ( configMAX_PRIORITIES - 3 )
+#define rhealstoneLOW_PRIORITY          ( configMAX_PRIORITIES - 4 )
+
+#define rhealstoneMAX_WORKERS           3
+#define rhealstoneSTACK_SIZE            ( configMINIMAL_STACK_SIZE * 2 )
+#define rhealstoneLINE_LENGTH           192
+
+/* the run time counter counts microseconds on all the ports */
+typedef configRUN_TIME_COUNTER_TYPE RhealstoneTime_t;
+
+static RhealstoneOutputFunction_t pxOutputFunction;
+static RhealstoneInterruptFunction_t pxInterruptFunction;
+static RhealstoneCycleFunction_t pxCycleFunction;
+static RhealstoneDoneFunction_t pxDoneFunction;
+
+static TaskHandle_t xControlTask;
+static TaskHandle_t xWorkers[rhealstoneMAX_WORKERS];
+static UBaseType_t uxWorkerCount;
+static volatile UBaseType_t uxWorkersDone;
+static volatile RhealstoneTime_t ulEndTime;
+
+/* objects used by the workers */
+static SemaphoreHandle_t xSemaphore;
+static SemaphoreHandle_t xMutex;
+static SemaphoreHandle_t xIsrSemaphore;
+static QueueHandle_t xRequestQueue;
+static QueueHandle_t xReplyQueue;
+static volatile BaseType_t xUseSemaphore;
+static volatile RhealstoneTime_t ulRaiseTime;
+static volatile RhealstoneTime_t ulLatencyTotal;
+static volatile RhealstoneTime_t ulLatencyMax;
+static volatile uint32_t ulSwitchStart;
+static volatile BaseType_t xSwitchStamped;
+static volatile uint32_t ulSwitchSamples;
+static volatile uint32_t ulSwitchTotal;
+static volatile uint32_t ulSwitchMin;
+static volatile uint32_t ulSwitchMax;
+
+/**
+ * @brief Write one line of the results.
+ *
+ */
+static void prvWriteLine(const char *pcFormat, ...) __attribute__((format(printf, 1, 2)));
+static void prvWriteLine(const char *pcFormat, ...)
+{
+    char cLine[rhealstoneLINE_LENGTH];
+    va_list xArgs;
+
+    va_start(xArgs, pcFormat);
+    vsnprintf(cLine, sizeof(cLine), pcFormat, xArgs);
+    va_end(xArgs);
+
+    pxOutputFunction(cLine);
+}
+
+/**
+ * @brief Write the result of one benchmark.
+ *
+ * @param pcName      name of the benchmark
+ * @param ulTotal     time of all the operations, in microseconds
+ * @param ulOps       number of operations
+ * @param pcExtra     more fields of the record, starting with a comma, or ""
+ */
+static void prvWriteResult(const char *pcName, RhealstoneTime_t ulTotal, uint32_t ulOps, const char *pcExtra)
+{
+    prvWriteLine("{\"record\":\"result\",\"benchmark\":\"%s\",\"iterations\":%lu,\"total_us\":%llu,\"ns_per_op\":%llu%s}",
+                 pcName, (unsigned long)rhealstoneITERATIONS, (unsigned long long)ulTotal,
+                 ((unsigned long long)ulTotal * 1000ULL) / ulOps, pcExtra);
+}
+
+/**
+ * @brief Create a worker task, it runs once the control task blocks.
+ *
+ * @param pxCode      function of the worker
+ * @param uxPriority  priority of the worker
+ */
+static void prvCreateWorker(TaskFunction_t pxCode, UBaseType_t uxPriority)
+{
+    BaseType_t xResult = xTaskCreate(pxCode, "bench", rhealstoneSTACK_SIZE, NULL, uxPriority, &xWorkers[uxWorkerCount]);
+
+    configASSERT(xResult == pdPASS);
+    (void)xResult;
+    uxWorkerCount++;
+}
+
+/**
+ * @brief Run the workers created since the last call and wait for all of them
+ * to finish.
+ *
+ * @return time from the start of the workers to the end of the last one
+ */
+static RhealstoneTime_t prvRunWorkers(void)
+{
+    RhealstoneTime_t ulStartTime;
+
+    uxWorkersDone = 0;
+    ulStartTime = portGET_RUN_TIME_COUNTER_VALUE();
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    while (uxWorkerCount > 0) {
+        uxWorkerCount--;
+        vTaskDelete(xWorkers[uxWorkerCount]);
+    }
+
+    return ulEndTime - ulStartTime;
+}
+
+/**
+ * @brief End of a worker, the last one takes the end time and wakes the
+ * control task that deletes the workers.
+ *
+ */
+static void prvWorkerDone(void)
+{
+    taskENTER_CRITICAL();
+    {
+        uxWorkersDone++;
+        if (uxWorkersDone == uxWorkerCount) {
+            ulEndTime = portGET_RUN_TIME_COUNTER_VALUE();
+            xTaskNotifyGive(xControlTask);
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    vTaskSuspend(NULL);
+}
+
+/**
+ * @brief Task switch and semaphore shuffle worker. With xUseSemaphore the
+ * semaphore is held across the first yield, the other worker blocks on it.
+ *
+ */
+static void prvYieldTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (uint32_t ulIteration = 0; ulIteration < rhealstoneITERATIONS; ulIteration++) {
+        if (xUseSemaphore) {
+            xSemaphoreTake(xSemaphore, portMAX_DELAY);
+        }
+        taskYIELD();
+        if (xUseSemaphore) {
+            xSemaphoreGive(xSemaphore);
+        }
+        taskYIELD();
+    }
+
+    prvWorkerDone();
+}
+
+/**
+ * @brief Preemption worker, suspended until the low priority worker resumes it.
+ *
+ */
+static void prvPreemptHighTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (uint32_t ulIteration = 0; ulIteration < rhealstoneITERATIONS; ulIteration++) {
+        vTaskSuspend(NULL);
+    }
+
+    prvWorkerDone();
+}
+
+/**
+ * @brief Preemption worker, resumes the high priority worker.
+ *
+ */
+static void prvPreemptLowTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (uint32_t ulIteration = 0; ulIteration < rhealstoneITERATIONS; ulIteration++) {
+        vTaskResume(xWorkers[0]);
+    }
+
+    prvWorkerDone();
+}
+
+/**
+ * @brief Round trip worker, sends a request and waits for the reply.
+ *
+ */
+static void prvClientTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (uint32_t ulIteration = 0; ulIteration < rhealstoneITERATIONS; ulIteration++) {
+        uint32_t ulReply;
+
+        xQueueSend(xRequestQueue, &ulIteration, portMAX_DELAY);
+        xQueueReceive(xReplyQueue, &ulReply, portMAX_DELAY);
+        configASSERT(ulReply == ulIteration);
+    }
+
+    prvWorkerDone();
+}
+
+/**
+ * @brief Round trip worker, returns every request as the reply.
+ *
+ */
+static void prvServerTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (uint32_t ulIteration = 0; ulIteration < rhealstoneITERATIONS; ulIteration++) {
+        uint32_t ulRequest;
+
+        xQueueReceive(xRequestQueue, &ulRequest, portMAX_DELAY);
+        xQueueSend(xReplyQueue, &ulRequest, portMAX_DELAY);
+    }
+
+    prvWorkerDone();
+}
+
+/**
+ * @brief Deadlock break worker, takes the mutex held by the low priority worker.
+ *
+ */
+static void prvDeadlockHighTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (uint32_t ulIteration = 0; ulIteration < rhealstoneITERATIONS; ulIteration++) {
+        vTaskSuspend(NULL);
+        xSemaphoreTake(xMutex, portMAX_DELAY);
+        xSemaphoreGive(xMutex);
+    }
+
+    prvWorkerDone();
+}
+
+/**
+ * @brief Deadlock break worker, ready while the high priority worker waits for
+ * the mutex. Only the priority inheritance lets the low priority worker run.
+ *
+ */
+static void prvDeadlockMediumTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (uint32_t ulIteration = 0; ulIteration < rhealstoneITERATIONS; ulIteration++) {
+        vTaskSuspend(NULL);
+        vTaskResume(xWorkers[0]);
+    }
+
+    prvWorkerDone();
+}
+
+/**
+ * @brief Deadlock break worker, holds the mutex while the others run.
+ *
+ */
+static void prvDeadlockLowTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (uint32_t ulIteration = 0; ulIteration < rhealstoneITERATIONS; ulIteration++) {
+        xSemaphoreTake(xMutex, portMAX_DELAY);
+        vTaskResume(xWorkers[1]);
+        xSemaphoreGive(xMutex);
+    }
+
+    prvWorkerDone();
+}
+
+/**
+ * @brief Interrupt of the latency benchmark, wakes the high priority worker.
+ *
+ */
+static void prvLatencyInterruptHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    xSemaphoreGiveFromISR(xIsrSemaphore, &xHigherPriorityTaskWoken);
+    if (xHigherPriorityTaskWoken != pdFALSE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * @brief Latency worker, measures the time from the raise of the interrupt to
+ * its own wake up.
+ *
+ */
+static void prvLatencyHighTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (uint32_t ulIteration = 0; ulIteration < rhealstoneITERATIONS; ulIteration++) {
+        RhealstoneTime_t ulLatency;
+
+        xSemaphoreTake(xIsrSemaphore, portMAX_DELAY);
+        ulLatency = portGET_RUN_TIME_COUNTER_VALUE() - ulRaiseTime;
+        ulLatencyTotal += ulLatency;
+        if (ulLatency > ulLatencyMax) {
+            ulLatencyMax = ulLatency;
+        }
+    }
+
+    prvWorkerDone();
+}
+
+/**
+ * @brief Latency worker, raises the interrupt.
+ *
+ */
+static void prvLatencyLowTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (uint32_t ulIteration = 0; ulIteration < rhealstoneITERATIONS; ulIteration++) {
+        ulRaiseTime = portGET_RUN_TIME_COUNTER_VALUE();
+        pxInterruptFunction(prvLatencyInterruptHandler);
+    }
+
+    prvWorkerDone();
+}
+
+/**
+ * @brief Switch cycles worker, stamps the cycle counter before every yield and
+ * measures the switch from the stamp of the other worker once it runs again.
+ *
+ */
+static void prvSwitchCyclesTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (uint32_t ulIteration = 0; ulIteration < rhealstoneITERATIONS; ulIteration++) {
+        uint32_t ulCycles;
+
+        ulSwitchStart = pxCycleFunction();
+        xSwitchStamped = pdTRUE;
+        taskYIELD();
+        ulCycles = pxCycleFunction() - ulSwitchStart;
+
+        /* the other worker did not stamp when it started or ended */
+        if (xSwitchStamped) {
+            xSwitchStamped = pdFALSE;
+            ulSwitchSamples++;
+            ulSwitchTotal += ulCycles;
+            if (ulCycles < ulSwitchMin) {
+                ulSwitchMin = ulCycles;
+            }
+            if (ulCycles > ulSwitchMax) {
+                ulSwitchMax = ulCycles;
+            }
+        }
+    }
+
+    xSwitchStamped = pdFALSE;
+    prvWorkerDone();
+}
+
+/**
+ * @brief Control task, runs the benchmarks one after the other.
+ *
+ */
+static void prvControlTask(void *pvParameters)
+{
+    RhealstoneTime_t ulTotal, ulBaseline;
+    char cExtra[32];
+
+    (void)pvParameters;
+
+    prvWriteLine("{\"record\":\"config\",\"tick_rate_hz\":%lu,\"max_priorities\":%d,\"cores\":%d,"
+                 "\"port_optimised_task_selection\":%d,\"delayed_task_heap\":%d,\"priority_event_lists\":%d,"
+                 "\"timer_wheel\":%d,\"iterations\":%lu}",
+                 (unsigned long)configTICK_RATE_HZ, (int)configMAX_PRIORITIES, (int)configNUMBER_OF_CORES,
+                 (int)configUSE_PORT_OPTIMISED_TASK_SELECTION, (int)configUSE_DELAYED_TASK_HEAP,
+                 (int)configUSE_PRIORITY_EVENT_LISTS, (int)configUSE_TIMER_WHEEL, (unsigned long)rhealstoneITERATIONS);
+
+    /* two yields per iteration and worker, each one switches to the other worker */
+    xUseSemaphore = pdFALSE;
+    prvCreateWorker(prvYieldTask, rhealstoneMEDIUM_PRIORITY);
+    prvCreateWorker(prvYieldTask, rhealstoneMEDIUM_PRIORITY);
+    ulBaseline = prvRunWorkers();
+    prvWriteResult("task_switch", ulBaseline, rhealstoneITERATIONS * 4UL, "");
+
+    /* resume, preemption and the switch back once the worker suspends itself */
+    prvCreateWorker(prvPreemptHighTask, rhealstoneHIGH_PRIORITY);
+    prvCreateWorker(prvPreemptLowTask, rhealstoneLOW_PRIORITY);
+    ulTotal = prvRunWorkers();
+    prvWriteResult("preemption", ulTotal, rhealstoneITERATIONS, "");
+
+    /* the same loop as the task switch, each worker blocks once per iteration
+    on the semaphore held by the other */
+    xUseSemaphore = pdTRUE;
+    prvCreateWorker(prvYieldTask, rhealstoneMEDIUM_PRIORITY);
+    prvCreateWorker(prvYieldTask, rhealstoneMEDIUM_PRIORITY);
+    ulTotal = prvRunWorkers();
+    prvWriteResult("semaphore_shuffle", (ulTotal > ulBaseline) ? ulTotal - ulBaseline : 0, rhealstoneITERATIONS * 2UL, "");
+
+    prvCreateWorker(prvServerTask, rhealstoneMEDIUM_PRIORITY);
+    prvCreateWorker(prvClientTask, rhealstoneMEDIUM_PRIORITY);
+    ulTotal = prvRunWorkers();
+    prvWriteResult("queue_round_trip", ulTotal, rhealstoneITERATIONS, "");
+
+    prvCreateWorker(prvDeadlockHighTask, rhealstoneHIGH_PRIORITY);
+    prvCreateWorker(prvDeadlockMediumTask, rhealstoneMEDIUM_PRIORITY);
+    prvCreateWorker(prvDeadlockLowTask, rhealstoneLOW_PRIORITY);
+    ulTotal = prvRunWorkers();
+    prvWriteResult("deadlock_break", ulTotal, rhealstoneITERATIONS, "");
+
+    if (pxInterruptFunction != NULL) {
+        ulLatencyTotal = 0;
+        ulLatencyMax = 0;
+        prvCreateWorker(prvLatencyHighTask, rhealstoneHIGH_PRIORITY);
+        prvCreateWorker(prvLatencyLowTask, rhealstoneLOW_PRIORITY);
+        (void)prvRunWorkers();
+        snprintf(cExtra, sizeof(cExtra), ",\"max_us\":%llu", (unsigned long long)ulLatencyMax);
+        prvWriteResult("isr_latency", ulLatencyTotal, rhealstoneITERATIONS, cExtra);
+    }
+
+    if (pxCycleFunction != NULL) {
+        xSwitchStamped = pdFALSE;
+        ulSwitchSamples = 0;
+        ulSwitchTotal = 0;
+        ulSwitchMin = UINT32_MAX;
+        ulSwitchMax = 0;
+        prvCreateWorker(prvSwitchCyclesTask, rhealstoneMEDIUM_PRIORITY);
+        prvCreateWorker(prvSwitchCyclesTask, rhealstoneMEDIUM_PRIORITY);
+        (void)prvRunWorkers();
+        prvWriteLine("{\"record\":\"cycles\",\"benchmark\":\"switch_cycles\",\"samples\":%lu,\"avg_cycles\":%lu,"
+                     "\"min_cycles\":%lu,\"max_cycles\":%lu}",
+                     (unsigned long)ulSwitchSamples, (unsigned long)(ulSwitchTotal / ((ulSwitchSamples > 0) ? ulSwitchSamples : 1UL)),
+                     (unsigned long)ulSwitchMin, (unsigned long)ulSwitchMax);
+    }
+
+    if (pxDoneFunction != NULL) {
+        pxDoneFunction();
+    }
+
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Start the benchmarks.
+ *
+ * @param pxOutput            writes the result lines
+ * @param pxRaiseInterrupt    executes the interrupt of isr_latency, may be NULL
+ * @param pxCycleCounter      reads the cycle counter of switch_cycles, may be NULL
+ * @param pxDone              called after the last result, may be NULL
+ * @return pdPASS if the benchmark task was created
+ */
+BaseType_t xRhealstoneStart(RhealstoneOutputFunction_t pxOutput, RhealstoneInterruptFunction_t pxRaiseInterrupt,
+                            RhealstoneCycleFunction_t pxCycleCounter, RhealstoneDoneFunction_t pxDone)
+{
+    pxOutputFunction = pxOutput;
+    pxInterruptFunction = pxRaiseInterrupt;
+    pxCycleFunction = pxCycleCounter;
+    pxDoneFunction = pxDone;
+
+    xSemaphore = xSemaphoreCreateBinary();
+    xMutex = xSemaphoreCreateMutex();
+    xIsrSemaphore = xSemaphoreCreateBinary();
+    xRequestQueue = xQueueCreate(1, sizeof(uint32_t));
+    xReplyQueue = xQueueCreate(1, sizeof(uint32_t));
+    if ((xSemaphore == NULL) || (xMutex == NULL) || (xIsrSemaphore == NULL) || (xRequestQueue == NULL) || (xReplyQueue == NULL)) {
+        return pdFAIL;
+    }
+    xSemaphoreGive(xSemaphore);
+
+    return xTaskCreate(prvControlTask, "rhealstone", rhealstoneSTACK_SIZE * 2, NULL, rhealstoneCONTROL_PRIORITY, &xControlTask);
+}
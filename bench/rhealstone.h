@@ -0,0 +1,106 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Rhealstone style kernel benchmarks                                        |
+ |___________________________________________________________________________*/
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Every benchmark is repeated this many times, the results are averages. */
+#ifndef rhealstoneITERATIONS
+    #define rhealstoneITERATIONS        10000UL
+#endif
+
+/* write one line of the results, the line terminator is added by the function */
+typedef void (*RhealstoneOutputFunction_t)(const char *pcLine);
+
+/* execute the handler as an interrupt of the core that runs the benchmarks */
+typedef void (*RhealstoneInterruptFunction_t)(void (*pxHandler)(void));
+
+/* free running count of the processor cycles, it may wrap */
+typedef uint32_t (*RhealstoneCycleFunction_t)(void);
+
+/* called once all the results are written */
+typedef void (*RhealstoneDoneFunction_t)(void);
+
+/**
+ * Start the benchmarks. They run in a task at configMAX_PRIORITIES - 1 with
+ * the worker tasks below it, the other tasks of the application only disturb
+ * the results if they have a higher priority than the workers.
+ *
+ * The results are JSON lines. The first line is the configuration of the
+ * kernel: {"record":"config",...}. Each benchmark then writes
+ * {"record":"result","benchmark":"<name>","iterations":N,"total_us":T,"ns_per_op":P}
+ * - task_switch: one context switch between two tasks that yield
+ * - preemption: a task resumes a higher priority task that suspends itself
+ * - semaphore_shuffle: take of a semaphore held by another task of the same
+ *   priority, the yield overhead is subtracted
+ * - queue_round_trip: a message to a task and its reply through two queues
+ * - deadlock_break: a high priority task takes a mutex held by a low priority
+ *   task while a medium priority task is ready
+ * - isr_latency: from the raise of an interrupt that gives a semaphore to the
+ *   task blocked on it running, with "max_us" as the longest one. Only when
+ *   pxRaiseInterrupt is not NULL.
+ *
+ * With a cycle counter one more record follows,
+ * {"record":"cycles","benchmark":"switch_cycles","samples":N,"avg_cycles":A,"min_cycles":L,"max_cycles":H}
+ * - switch_cycles: from a task calling taskYIELD() to the other task running,
+ *   one sample per switch. The samples the tick interrupts fall into are
+ *   included, they show as the maximum.
+ *
+ * @param pxOutput            writes the result lines
+ * @param pxRaiseInterrupt    executes the interrupt of isr_latency, may be NULL
+ * @param pxCycleCounter      reads the cycle counter of switch_cycles, may be NULL
+ * @param pxDone              called after the last result, may be NULL
+ * @return pdPASS if the benchmark task was created
+ */
+BaseType_t xRhealstoneStart(RhealstoneOutputFunction_t pxOutput, RhealstoneInterruptFunction_t pxRaiseInterrupt,
+                            RhealstoneCycleFunction_t pxCycleCounter, RhealstoneDoneFunction_t pxDone);
+
+/**
+ * Raise a spare NVIC interrupt that executes the handler, the interrupt
+ * function of the benchmarks on the RP2040 (bench/rhealstone_rp2040.c).
+ *
+ * @param pxHandler   the interrupt handler
+ */
+void vRhealstoneRaiseInterrupt(void (*pxHandler)(void));
+
+/**
+ * Count of the processor cycles built from the tick count and the SysTick,
+ * the cycle counter of the benchmarks on the RP2040 (bench/rhealstone_rp2040.c).
+ * The SysTick must run with its normal reload value, not with the tickless idle.
+ *
+ * @return cycles since the scheduler started, modulo 2^32
+ */
+uint32_t ulRhealstoneCycleCount(void);
+
+#ifdef __cplusplus
+}
+#endif
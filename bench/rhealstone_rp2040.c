@@ -0,0 +1,97 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Rhealstone style kernel benchmarks                                        |
+ |___________________________________________________________________________*/
+
+#include "picortos.h"
+#include "cmsis_rp2040.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rhealstone.h"
+
+/* RP2040 has 26 interrupts, the NVIC lines above them are free for software use */
+#ifndef rhealstoneIRQn
+    #define rhealstoneIRQn              ( ( IRQn_Type ) 31 )
+#endif
+
+/* handler executed by the spare interrupt */
+static void (*volatile pxRaisedHandler)(void) = NULL;
+
+/**
+ * @brief Handler of the spare interrupt.
+ *
+ */
+static void prvSpareInterruptHandler(void)
+{
+    pxRaisedHandler();
+}
+
+/**
+ * @brief Raise a spare NVIC interrupt that executes the handler.
+ *
+ * The interrupt is installed on the first call, directly in the vector table
+ * so the interrupt run time statistics are not involved. It has the priority
+ * of the SysTick, the FromISR API is available to the handler.
+ *
+ * @param pxHandler   the interrupt handler
+ */
+void vRhealstoneRaiseInterrupt(void (*pxHandler)(void))
+{
+    if (pxRaisedHandler == NULL) {
+        NVIC_SetVector(rhealstoneIRQn, (uint32_t)prvSpareInterruptHandler);
+        NVIC_SetPriority(rhealstoneIRQn, configSysTick_INTERRUPT_PRIORITY);
+        NVIC_ClearPendingIRQ(rhealstoneIRQn);
+        NVIC_EnableIRQ(rhealstoneIRQn);
+    }
+
+    pxRaisedHandler = pxHandler;
+    __DSB();
+    NVIC_SetPendingIRQ(rhealstoneIRQn);
+    __DSB();
+    __ISB();
+}
+
+/**
+ * @brief Count of the processor cycles built from the tick count and the SysTick.
+ *
+ * The Cortex-M0+ has no cycle counter. The SysTick counts the cycles of the
+ * current tick down from its reload value, the tick count is read around it
+ * and the read is repeated when a tick interrupt came in between.
+ *
+ * @return cycles since the scheduler started, modulo 2^32
+ */
+uint32_t ulRhealstoneCycleCount(void)
+{
+    const uint32_t ulCyclesPerTick = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+    TickType_t xTicks;
+    uint32_t ulValue;
+
+    do {
+        xTicks = xTaskGetTickCount();
+        ulValue = SysTick->VAL;
+    } while (xTicks != xTaskGetTickCount());
+
+    return ((uint32_t)xTicks * ulCyclesPerTick) + ((ulCyclesPerTick - 1UL) - ulValue);
+}
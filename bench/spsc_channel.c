@@ -0,0 +1,273 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Benchmarks of the kernel on the Linux simulator                           |
+ |___________________________________________________________________________*/
+
+#include <stdio.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "spsc_channel.h"
+#include "port.h"
+
+/*
+ * Item rate of the SPSC channels against the queues.
+ *
+ * The same number of 32 bit items goes through a channel and through a queue
+ * of the same length, with every scenario:
+ *
+ * - loopback: a task sends an item and receives it back, the fast path alone.
+ * - pipeline: a producer and a consumer task of the same priority, each side
+ *   blocks once the channel is full or empty.
+ * - isr: a simulated interrupt sends spscISR_BURST items with the FromISR
+ *   functions, a task receives them.
+ * - cross_core: with configNUMBER_OF_CORES 2 the producer runs on core 0 and
+ *   the consumer on core 1.
+ *
+ * The results are JSON lines, {"record":"config",...} first and then one
+ * {"record":"result","scenario":"<name>",...} per scenario with the items per
+ * second of both objects and the ratio, to compare against the 3x target.
+ */
+
+#define spscITEMS                       4194304UL
+#define spscLENGTH                      64
+#define spscISR_BURST                   16
+#define spscPRIORITY                    ( tskIDLE_PRIORITY + 1 )
+
+#if ( configUSE_SPSC_CHANNELS != 1 )
+    #error The benchmark measures the SPSC channels, build it with options_spsc.h.
+#endif
+
+/* the functions of one kind of channel */
+typedef struct {
+    const char *pcName;
+    BaseType_t (*pxSend)(void *pvChannel, const void *pvItem, TickType_t xTicksToWait);
+    BaseType_t (*pxReceive)(void *pvChannel, void *pvBuffer, TickType_t xTicksToWait);
+    BaseType_t (*pxSendFromISR)(void *pvChannel, const void *pvItem, BaseType_t *pxWoken);
+} ChannelFunctions_t;
+
+/* the scenarios of the benchmark */
+typedef enum {
+    spscLOOPBACK,
+    spscPIPELINE,
+    spscISR,
+    spscCROSS_CORE
+} SpscScenario_t;
+
+static const char *const pcScenarioNames[] = { "loopback", "pipeline", "isr", "cross_core" };
+
+static const ChannelFunctions_t *pxFunctions;
+static void *pvChannel;
+static TaskHandle_t xControlTask;
+
+/**
+ * @brief Monotonic time of the host.
+ *
+ * @return the time in nanoseconds
+ */
+static uint64_t prvNow(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return ((uint64_t)xNow.tv_sec * 1000000000ULL) + (uint64_t)xNow.tv_nsec;
+}
+
+static BaseType_t prvQueueSend(void *pvQueue, const void *pvItem, TickType_t xTicksToWait)
+{
+    return xQueueSend((QueueHandle_t)pvQueue, pvItem, xTicksToWait);
+}
+
+static BaseType_t prvQueueReceive(void *pvQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+    return xQueueReceive((QueueHandle_t)pvQueue, pvBuffer, xTicksToWait);
+}
+
+static BaseType_t prvQueueSendFromISR(void *pvQueue, const void *pvItem, BaseType_t *pxWoken)
+{
+    return xQueueSendFromISR((QueueHandle_t)pvQueue, pvItem, pxWoken);
+}
+
+static BaseType_t prvSpscSend(void *pvSpsc, const void *pvItem, TickType_t xTicksToWait)
+{
+    return xSpscChannelSend((SpscChannelHandle_t)pvSpsc, pvItem, xTicksToWait);
+}
+
+static BaseType_t prvSpscReceive(void *pvSpsc, void *pvBuffer, TickType_t xTicksToWait)
+{
+    return xSpscChannelReceive((SpscChannelHandle_t)pvSpsc, pvBuffer, xTicksToWait);
+}
+
+static BaseType_t prvSpscSendFromISR(void *pvSpsc, const void *pvItem, BaseType_t *pxWoken)
+{
+    return xSpscChannelSendFromISR((SpscChannelHandle_t)pvSpsc, pvItem, pxWoken);
+}
+
+static const ChannelFunctions_t xQueueFunctions = { "queue", prvQueueSend, prvQueueReceive, prvQueueSendFromISR };
+static const ChannelFunctions_t xSpscFunctions = { "spsc", prvSpscSend, prvSpscReceive, prvSpscSendFromISR };
+
+/**
+ * @brief Simulated interrupt, sends a burst of items.
+ *
+ */
+static void prvBurstInterrupt(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    for (uint32_t ulItem = 0; ulItem < spscISR_BURST; ulItem++) {
+        configASSERT(pxFunctions->pxSendFromISR(pvChannel, &ulItem, &xHigherPriorityTaskWoken) == pdPASS);
+    }
+    if (xHigherPriorityTaskWoken != pdFALSE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * @brief Consumer of the pipeline scenarios, checks the order of the items
+ * and tells the control task once all of them arrived.
+ *
+ * @param pvParameters    not used
+ */
+static void prvConsumerTask(void *pvParameters)
+{
+    uint32_t ulItem;
+
+    (void)pvParameters;
+
+    for (uint32_t ulExpected = 0; ulExpected < spscITEMS; ulExpected++) {
+        configASSERT(pxFunctions->pxReceive(pvChannel, &ulItem, portMAX_DELAY) == pdPASS);
+        configASSERT(ulItem == ulExpected);
+    }
+
+    xTaskNotifyGive(xControlTask);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Move spscITEMS items through the channel of pxFunctions.
+ *
+ * Inlined with the functions of each object, so the loops call them directly.
+ *
+ * @param pxRunFunctions  the functions of the channel
+ * @param xScenario       the scenario
+ * @return the items per second
+ */
+static inline __attribute__((always_inline)) uint64_t prvRun(const ChannelFunctions_t *pxRunFunctions, SpscScenario_t xScenario)
+{
+    uint64_t ullStart, ullElapsed;
+    uint32_t ulItem;
+
+    ullStart = prvNow();
+    switch (xScenario) {
+    case spscLOOPBACK:
+        for (uint32_t ulSent = 0; ulSent < spscITEMS; ulSent++) {
+            pxRunFunctions->pxSend(pvChannel, &ulSent, 0);
+            pxRunFunctions->pxReceive(pvChannel, &ulItem, 0);
+        }
+        break;
+
+    case spscISR:
+        for (uint32_t ulSent = 0; ulSent < spscITEMS; ulSent += spscISR_BURST) {
+            vPortRunAsInterrupt(prvBurstInterrupt);
+            for (uint32_t ulReceived = 0; ulReceived < spscISR_BURST; ulReceived++) {
+                pxRunFunctions->pxReceive(pvChannel, &ulItem, 0);
+            }
+        }
+        break;
+
+    default:
+        {
+            TaskHandle_t xConsumer;
+
+            xTaskCreate(prvConsumerTask, "consumer", configMINIMAL_STACK_SIZE * 4, NULL, spscPRIORITY, &xConsumer);
+#if ( configNUMBER_OF_CORES > 1 )
+            vTaskCoreAffinitySet(xConsumer, (UBaseType_t)1 << ((xScenario == spscCROSS_CORE) ? 1 : 0));
+#endif
+            for (uint32_t ulSent = 0; ulSent < spscITEMS; ulSent++) {
+                pxRunFunctions->pxSend(pvChannel, &ulSent, portMAX_DELAY);
+            }
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+        break;
+    }
+    ullElapsed = prvNow() - ullStart;
+
+    return ((uint64_t)spscITEMS * 1000000000ULL) / ((ullElapsed > 0) ? ullElapsed : 1);
+}
+
+/**
+ * @brief Run every scenario on both objects, then stop the scheduler.
+ *
+ * @param pvParameters    not used
+ */
+static void prvControlTask(void *pvParameters)
+{
+    QueueHandle_t xQueue = xQueueCreate(spscLENGTH, sizeof(uint32_t));
+    SpscChannelHandle_t xSpsc = xSpscChannelCreate(spscLENGTH, sizeof(uint32_t));
+    SpscScenario_t xLast = spscISR;
+
+    (void)pvParameters;
+    configASSERT((xQueue != NULL) && (xSpsc != NULL));
+
+#if ( configNUMBER_OF_CORES > 1 )
+    /* the producer stays on core 0, the consumer goes where the scenario says */
+    vTaskCoreAffinitySet(NULL, (UBaseType_t)1 << 0);
+    xLast = spscCROSS_CORE;
+#endif
+
+    for (SpscScenario_t xScenario = spscLOOPBACK; xScenario <= xLast; xScenario++) {
+        uint64_t ullQueueRate, ullSpscRate;
+
+        pxFunctions = &xQueueFunctions;
+        pvChannel = xQueue;
+        ullQueueRate = prvRun(&xQueueFunctions, xScenario);
+
+        pxFunctions = &xSpscFunctions;
+        pvChannel = xSpsc;
+        ullSpscRate = prvRun(&xSpscFunctions, xScenario);
+
+        printf("{\"record\":\"result\",\"scenario\":\"%s\",\"queue_items_s\":%llu,\"spsc_items_s\":%llu,\"ratio\":%.2f}\n",
+               pcScenarioNames[xScenario], (unsigned long long)ullQueueRate, (unsigned long long)ullSpscRate,
+               (double)ullSpscRate / (double)ullQueueRate);
+    }
+
+    vTaskEndScheduler();
+}
+
+/**
+ * @brief Create the control task.
+ *
+ */
+int main(void)
+{
+    printf("{\"record\":\"config\",\"items\":%lu,\"length\":%d,\"item_size\":%u,\"cores\":%d}\n",
+           (unsigned long)spscITEMS, spscLENGTH, (unsigned)sizeof(uint32_t), (int)configNUMBER_OF_CORES);
+
+    xTaskCreate(prvControlTask, "control", configMINIMAL_STACK_SIZE * 4, NULL, spscPRIORITY, &xControlTask);
+    vTaskStartScheduler();
+
+    return 0;
+}
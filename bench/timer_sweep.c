@@ -0,0 +1,215 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Benchmarks of the kernel on the Linux simulator                           |
+ |___________________________________________________________________________*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/*
+ * Latency of the timer commands against the number of active timers.
+ *
+ * For every count of sweepCOUNTS[] that many timers are started with random
+ * periods of sweepMIN_PERIOD to sweepMAX_PERIOD ticks, long enough that none
+ * expires during the measurement. Random timers are then stopped, started and
+ * reset sweepOPERATIONS times each. The benchmark task runs below the timer
+ * service task, every command is processed before the call returns, so the
+ * time of the call includes the insertion of the timer in the active timers.
+ *
+ * Built with configUSE_TIMER_WHEEL 0 the active timers are the sorted list,
+ * with 1 the timing wheel. The results are JSON lines, {"record":"config",...}
+ * first and then one {"record":"result","timers":<n>,...} per count with the
+ * median and 99th percentile nanoseconds of each command. The ticks and the
+ * host preempting the process make the longest calls, they are left out.
+ */
+
+#define sweepOPERATIONS                 4096UL
+#define sweepMIN_PERIOD                 pdMS_TO_TICKS(10000)
+#define sweepMAX_PERIOD                 pdMS_TO_TICKS(60000)
+#define sweepPRIORITY                   ( configTIMER_TASK_PRIORITY - 1 )
+
+/* the timer commands that are measured */
+typedef enum {
+    sweepSTOP,
+    sweepSTART,
+    sweepRESET,
+    sweepCOMMANDS
+} SweepCommand_t;
+
+static const uint32_t ulCounts[] = { 10, 100, 1000, 10000 };
+
+static uint32_t ulSamples[sweepCOMMANDS][sweepOPERATIONS];
+static uint32_t ulRandom = 0x2545f491UL;
+
+/**
+ * @brief Monotonic time of the host.
+ *
+ * @return the time in nanoseconds
+ */
+static uint64_t prvNow(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return ((uint64_t)xNow.tv_sec * 1000000000ULL) + (uint64_t)xNow.tv_nsec;
+}
+
+/**
+ * @brief Pseudo random numbers, the same sequence on every run.
+ *
+ * @return the next number of the xorshift sequence
+ */
+static uint32_t prvRandom(void)
+{
+    ulRandom ^= ulRandom << 13;
+    ulRandom ^= ulRandom >> 17;
+    ulRandom ^= ulRandom << 5;
+    return ulRandom;
+}
+
+/**
+ * @brief Order of the samples for qsort().
+ *
+ */
+static int prvCompareSamples(const void *pvA, const void *pvB)
+{
+    const uint32_t ulA = *(const uint32_t *)pvA;
+    const uint32_t ulB = *(const uint32_t *)pvB;
+
+    return (ulA > ulB) - (ulA < ulB);
+}
+
+/**
+ * @brief Percentile of the samples of a command.
+ *
+ * @param pulSamples      the sweepOPERATIONS samples, sorted
+ * @param ulPercent       the percentile
+ * @return the sample below which ulPercent of the samples fall
+ */
+static unsigned long prvPercentile(const uint32_t *pulSamples, uint32_t ulPercent)
+{
+    return (unsigned long)pulSamples[(sweepOPERATIONS * ulPercent) / 100UL];
+}
+
+/**
+ * @brief Timers of the benchmark never expire.
+ *
+ */
+static void prvTimerCallback(TimerHandle_t xTimer)
+{
+    (void)xTimer;
+    configASSERT(pdFALSE);
+}
+
+/**
+ * @brief Measure the commands with ulCount active timers.
+ *
+ * @param ulCount     number of active timers
+ */
+static void prvSweep(uint32_t ulCount)
+{
+    TimerHandle_t *pxTimers = pvPortMalloc(ulCount * sizeof(TimerHandle_t));
+
+    configASSERT(pxTimers != NULL);
+    for (uint32_t ulTimer = 0; ulTimer < ulCount; ulTimer++) {
+        const TickType_t xPeriod = sweepMIN_PERIOD + (prvRandom() % (sweepMAX_PERIOD - sweepMIN_PERIOD));
+
+        pxTimers[ulTimer] = xTimerCreate("sweep", xPeriod, pdFALSE, NULL, prvTimerCallback);
+        configASSERT(pxTimers[ulTimer] != NULL);
+        xTimerStart(pxTimers[ulTimer], portMAX_DELAY);
+    }
+
+    for (uint32_t ulOperation = 0; ulOperation < sweepOPERATIONS; ulOperation++) {
+        TimerHandle_t xTimer = pxTimers[prvRandom() % ulCount];
+        uint64_t ullStart;
+
+        ullStart = prvNow();
+        xTimerStop(xTimer, portMAX_DELAY);
+        ulSamples[sweepSTOP][ulOperation] = (uint32_t)(prvNow() - ullStart);
+
+        ullStart = prvNow();
+        xTimerStart(xTimer, portMAX_DELAY);
+        ulSamples[sweepSTART][ulOperation] = (uint32_t)(prvNow() - ullStart);
+
+        xTimer = pxTimers[prvRandom() % ulCount];
+        ullStart = prvNow();
+        xTimerReset(xTimer, portMAX_DELAY);
+        ulSamples[sweepRESET][ulOperation] = (uint32_t)(prvNow() - ullStart);
+    }
+
+    for (uint32_t ulTimer = 0; ulTimer < ulCount; ulTimer++) {
+        xTimerDelete(pxTimers[ulTimer], portMAX_DELAY);
+    }
+    vPortFree(pxTimers);
+
+    for (SweepCommand_t xCommand = sweepSTOP; xCommand < sweepCOMMANDS; xCommand++) {
+        qsort(ulSamples[xCommand], sweepOPERATIONS, sizeof(ulSamples[xCommand][0]), prvCompareSamples);
+    }
+
+    printf("{\"record\":\"result\",\"timers\":%lu,"
+           "\"stop_p50_ns\":%lu,\"stop_p99_ns\":%lu,"
+           "\"start_p50_ns\":%lu,\"start_p99_ns\":%lu,"
+           "\"reset_p50_ns\":%lu,\"reset_p99_ns\":%lu}\n",
+           (unsigned long)ulCount,
+           prvPercentile(ulSamples[sweepSTOP], 50), prvPercentile(ulSamples[sweepSTOP], 99),
+           prvPercentile(ulSamples[sweepSTART], 50), prvPercentile(ulSamples[sweepSTART], 99),
+           prvPercentile(ulSamples[sweepRESET], 50), prvPercentile(ulSamples[sweepRESET], 99));
+}
+
+/**
+ * @brief Sweep the counts of active timers, then stop the scheduler.
+ *
+ * @param pvParameters    not used
+ */
+static void prvSweepTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (size_t xCount = 0; xCount < sizeof(ulCounts) / sizeof(ulCounts[0]); xCount++) {
+        prvSweep(ulCounts[xCount]);
+    }
+
+    vTaskEndScheduler();
+}
+
+/**
+ * @brief Create the benchmark task.
+ *
+ */
+int main(void)
+{
+    printf("{\"record\":\"config\",\"timer_wheel\":%d,\"operations\":%lu,\"min_period\":%lu,\"max_period\":%lu}\n",
+           (int)configUSE_TIMER_WHEEL, (unsigned long)sweepOPERATIONS,
+           (unsigned long)sweepMIN_PERIOD, (unsigned long)sweepMAX_PERIOD);
+
+    xTaskCreate(prvSweepTask, "sweep", configMINIMAL_STACK_SIZE * 4, NULL, sweepPRIORITY, NULL);
+    vTaskStartScheduler();
+
+    return 0;
+}
@@ -58,6 +58,12 @@
 /* Application specific configuration options. */
 #include "FreeRTOSConfig.h"
 
+/* The number of cores the scheduler runs tasks on.  Must be known before the
+ * port layer is included as the port provides the multicore primitives. */
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES    1
+#endif
+
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
@@ -355,6 +361,118 @@
 
 #endif /* configUSE_TIMERS */
 
+/* The active software timers are kept in a list sorted by expiry time unless
+ * configUSE_TIMER_WHEEL is 1, in which case they are kept in a hierarchical
+ * timing wheel of configTIMER_WHEEL_LEVELS levels of 32 slots each.  Starting,
+ * stopping and resetting a timer is then O(1) regardless of how many timers are
+ * active, at the cost of 32 lists per level. */
+#ifndef configUSE_TIMER_WHEEL
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+#ifndef configTIMER_WHEEL_LEVELS
+    #define configTIMER_WHEEL_LEVELS    4
+#endif
+
+#if ( configUSE_TIMER_WHEEL == 1 )
+    #if ( configTIMER_WHEEL_LEVELS < 1 )
+        #error configTIMER_WHEEL_LEVELS must be at least 1
+    #endif
+
+    #if ( ( configUSE_16_BIT_TICKS == 1 ) && ( configTIMER_WHEEL_LEVELS > 3 ) )
+        #error configTIMER_WHEEL_LEVELS must not be greater than 3 when configUSE_16_BIT_TICKS is 1
+    #endif
+
+    #if ( configTIMER_WHEEL_LEVELS > 6 )
+        #error configTIMER_WHEEL_LEVELS must not be greater than 6
+    #endif
+#endif /* configUSE_TIMER_WHEEL */
+
+/* When configUSE_ISR_TIMERS is 1 a software timer can be moved out of the timer
+ * service task with vTimerSetISRContext().  Its callback is then called from
+ * xTaskIncrementTick(), within the tick interrupt, and is timed against a budget
+ * with the run time statistics counter. */
+#ifndef configUSE_ISR_TIMERS
+    #define configUSE_ISR_TIMERS    0
+#endif
+
+#if ( configUSE_ISR_TIMERS == 1 )
+    #if ( configUSE_TIMERS == 0 )
+        #error configUSE_ISR_TIMERS requires configUSE_TIMERS to be set to 1
+    #endif
+
+    #if ( configGENERATE_RUN_TIME_STATS == 0 )
+        #error configUSE_ISR_TIMERS requires configGENERATE_RUN_TIME_STATS to be set to 1, the callbacks are timed with the run time counter
+    #endif
+#endif /* configUSE_ISR_TIMERS */
+
+/* The delayed tasks are kept in a list sorted by wake time unless
+ * configUSE_DELAYED_TASK_HEAP is 1, in which case they are ordered by a binary
+ * heap of configDELAYED_TASK_HEAP_LENGTH entries.  Blocking with a timeout is
+ * then O(log n) in the number of delayed tasks instead of O(n).  Every task,
+ * the idle and timer tasks included, holds one entry, a task create function
+ * fails once configDELAYED_TASK_HEAP_LENGTH tasks exist. */
+#ifndef configUSE_DELAYED_TASK_HEAP
+    #define configUSE_DELAYED_TASK_HEAP    0
+#endif
+
+#ifndef configDELAYED_TASK_HEAP_LENGTH
+    #define configDELAYED_TASK_HEAP_LENGTH    32
+#endif
+
+#if ( ( configUSE_DELAYED_TASK_HEAP == 1 ) && ( configDELAYED_TASK_HEAP_LENGTH < 1 ) )
+    #error configDELAYED_TASK_HEAP_LENGTH must be at least 1
+#endif
+
+/* The tasks blocked on a queue are kept in a single list sorted by priority
+ * unless configUSE_PRIORITY_EVENT_LISTS is 1, in which case each queue keeps one
+ * list per priority and a bitmap of the priorities that have waiting tasks.
+ * Blocking on a queue is then O(1) in the number of waiting tasks, at the cost
+ * of configMAX_PRIORITIES lists for each direction of every queue. */
+#ifndef configUSE_PRIORITY_EVENT_LISTS
+    #define configUSE_PRIORITY_EVENT_LISTS    0
+#endif
+
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    #if ( configMAX_PRIORITIES > 32 )
+        #error configMAX_PRIORITIES must not be greater than 32 when configUSE_PRIORITY_EVENT_LISTS is 1
+    #endif
+
+    #if ( configUSE_CO_ROUTINES == 1 )
+        #error configUSE_PRIORITY_EVENT_LISTS cannot be used with co-routines
+    #endif
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+
+/* When configUSE_TASK_LATENCY_STATS is 1 every task records how long it waits
+ * between being added to a ready list and being switched in, in units of the
+ * run time statistics counter, in a histogram of configTASK_LATENCY_BUCKETS
+ * log2 buckets.  See vTaskGetLatencyStats(). */
+#ifndef configUSE_TASK_LATENCY_STATS
+    #define configUSE_TASK_LATENCY_STATS    0
+#endif
+
+#ifndef configTASK_LATENCY_BUCKETS
+    #define configTASK_LATENCY_BUCKETS    16
+#endif
+
+#if ( configUSE_TASK_LATENCY_STATS == 1 )
+    #if ( configGENERATE_RUN_TIME_STATS == 0 )
+        #error configUSE_TASK_LATENCY_STATS requires configGENERATE_RUN_TIME_STATS to be set to 1, the latencies are measured with the run time counter
+    #endif
+
+    #if ( configTASK_LATENCY_BUCKETS < 2 )
+        #error configTASK_LATENCY_BUCKETS must be at least 2
+    #endif
+#endif /* configUSE_TASK_LATENCY_STATS */
+
+/* When configUSE_QUEUE_STATS is 1 every queue, semaphore and stream buffer
+ * counts the data moved through it, its fill level high water mark, the number
+ * of times and the time tasks blocked on it and the failed non-blocking sends.
+ * See vQueueGetStats(), vStreamBufferGetStats() and uxQueueGetRegistryStats(). */
+#ifndef configUSE_QUEUE_STATS
+    #define configUSE_QUEUE_STATS    0
+#endif
+
 #ifndef portSET_INTERRUPT_MASK_FROM_ISR
     #define portSET_INTERRUPT_MASK_FROM_ISR()    0
 #endif
@@ -389,6 +507,12 @@
     #define configUSE_MINI_LIST_ITEM    1
 #endif
 
+/* Copy of the items of the queues and of the data of the stream buffers, a
+ * port may provide a faster implementation for the large copies. */
+#ifndef portMEMCPY
+    #define portMEMCPY( pvDest, pvSrc, xLength )    memcpy( ( pvDest ), ( pvSrc ), ( xLength ) )
+#endif
+
 #ifndef portPOINTER_SIZE_TYPE
     #define portPOINTER_SIZE_TYPE    uint32_t
 #endif
@@ -663,6 +787,10 @@
     #define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue )
 #endif
 
+#ifndef traceTIMER_BUDGET_EXCEEDED
+    #define traceTIMER_BUDGET_EXCEEDED( pxTimer, xCallbackTime )
+#endif
+
 #ifndef traceMALLOC
     #define traceMALLOC( pvAddress, uiSize )
 #endif
@@ -917,6 +1045,54 @@
     #define portASSERT_IF_IN_ISR()
 #endif
 
+#if ( configNUMBER_OF_CORES > 1 )
+    #ifndef portGET_CORE_ID
+        #error portGET_CORE_ID is required in SMP
+    #endif
+
+    #ifndef portYIELD_CORE
+        #error portYIELD_CORE is required in SMP
+    #endif
+
+    #ifndef portCHECK_IF_IN_ISR
+        #error portCHECK_IF_IN_ISR is required in SMP
+    #endif
+
+    #ifndef portGET_TASK_LOCK
+        #error portGET_TASK_LOCK is required in SMP
+    #endif
+
+    #ifndef portRELEASE_TASK_LOCK
+        #error portRELEASE_TASK_LOCK is required in SMP
+    #endif
+
+    #ifndef portGET_ISR_LOCK
+        #error portGET_ISR_LOCK is required in SMP
+    #endif
+
+    #ifndef portRELEASE_ISR_LOCK
+        #error portRELEASE_ISR_LOCK is required in SMP
+    #endif
+
+    #ifndef portGET_CRITICAL_NESTING_COUNT
+        #error portGET_CRITICAL_NESTING_COUNT is required in SMP
+    #endif
+
+    #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+        #error portCRITICAL_NESTING_IN_TCB must be 0 in SMP - the nesting count is kept per core by the port
+    #endif
+
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        #error The SMP scheduler walks the ready priorities using portGET_HIGHEST_PRIORITY - set configUSE_PORT_OPTIMISED_TASK_SELECTION to 1
+    #endif
+#endif /* if ( configNUMBER_OF_CORES > 1 ) */
+
+/* When configUSE_PASSIVE_IDLE_HOOK is 1 the passive idle tasks of the cores
+ * other than core 0 call vApplicationPassiveIdleHook() on every iteration. */
+#ifndef configUSE_PASSIVE_IDLE_HOOK
+    #define configUSE_PASSIVE_IDLE_HOOK    0
+#endif
+
 #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
     #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
 #endif
@@ -925,12 +1101,68 @@
     #define configAPPLICATION_ALLOCATED_HEAP    0
 #endif
 
+/* Selects the file implementing pvPortMalloc() and vPortFree(), all heap
+ * implementations are built and the others compile to nothing. */
+#ifndef configHEAP_IMPLEMENTATION
+    #define configHEAP_IMPLEMENTATION    3
+#endif
+
+/* Number of region classes known to heap_5.c, the class pvPortMalloc() tries
+ * first and the class task stacks are allocated from when
+ * configSTACK_ALLOCATION_FROM_SEPARATE_HEAP is 1. */
+#ifndef configHEAP_REGION_CLASSES
+    #define configHEAP_REGION_CLASSES    1
+#endif
+
+#ifndef configHEAP_DEFAULT_CLASS
+    #define configHEAP_DEFAULT_CLASS    0
+#endif
+
+#ifndef configHEAP_STACK_CLASS
+    #define configHEAP_STACK_CLASS    configHEAP_DEFAULT_CLASS
+#endif
+
+#ifndef configUSE_OBJECT_POOLS
+    #define configUSE_OBJECT_POOLS    0
+#endif
+
+#ifndef configTASK_POOL_SIZE
+    #define configTASK_POOL_SIZE    0
+#endif
+
+#ifndef configQUEUE_POOL_SIZE
+    #define configQUEUE_POOL_SIZE    0
+#endif
+
+#ifndef configTIMER_POOL_SIZE
+    #define configTIMER_POOL_SIZE    0
+#endif
+
+#ifndef configEVENT_GROUP_POOL_SIZE
+    #define configEVENT_GROUP_POOL_SIZE    0
+#endif
+
 #ifndef configUSE_TASK_NOTIFICATIONS
     #define configUSE_TASK_NOTIFICATIONS    1
 #endif
 
+#ifndef configUSE_SPSC_CHANNELS
+    #define configUSE_SPSC_CHANNELS    0
+#endif
+
+/* The notification index used to wake a task blocked on an SPSC channel.  A
+ * channel may consume notifications sent to this index, so it is kept apart
+ * from index 0, which is left to the application. */
+#ifndef configSPSC_CHANNEL_NOTIFY_INDEX
+    #define configSPSC_CHANNEL_NOTIFY_INDEX    1
+#endif
+
 #ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
-    #define configTASK_NOTIFICATION_ARRAY_ENTRIES    1
+    #if ( configUSE_SPSC_CHANNELS == 1 )
+        #define configTASK_NOTIFICATION_ARRAY_ENTRIES    ( configSPSC_CHANNEL_NOTIFY_INDEX + 1 )
+    #else
+        #define configTASK_NOTIFICATION_ARRAY_ENTRIES    1
+    #endif
 #endif
 
 #if configTASK_NOTIFICATION_ARRAY_ENTRIES < 1
@@ -1240,6 +1472,14 @@ typedef struct xSTATIC_LIST
     #endif
 } StaticList_t;
 
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    typedef struct xSTATIC_PRIORITY_EVENT_LIST
+    {
+        UBaseType_t uxDummy1;
+        StaticList_t xDummy2[ configMAX_PRIORITIES ];
+    } StaticPriorityEventList_t;
+#endif
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -1263,6 +1503,10 @@ typedef struct xSTATIC_TCB
     UBaseType_t uxDummy5;
     void * pxDummy6;
     uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ];
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xDummy23;
+        UBaseType_t uxDummy24[ 2 ];
+    #endif
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
         void * pxDummy8;
     #endif
@@ -1301,6 +1545,14 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+        UBaseType_t uxDummy25;
+    #endif
+    #if ( configUSE_TASK_LATENCY_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy26[ 3 ];
+        uint32_t ulDummy27[ configTASK_LATENCY_BUCKETS + 1 ];
+        BaseType_t xDummy28;
+    #endif
 } StaticTask_t;
 
 /*
@@ -1327,7 +1579,11 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy2;
     } u;
 
-    StaticList_t xDummy3[ 2 ];
+    #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+        StaticPriorityEventList_t xDummy3[ 2 ];
+    #else
+        StaticList_t xDummy3[ 2 ];
+    #endif
     UBaseType_t uxDummy4[ 3 ];
     uint8_t ucDummy5[ 2 ];
 
@@ -1343,6 +1599,10 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        uint32_t ulDummy10[ 10 ];
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1398,6 +1658,10 @@ typedef struct xSTATIC_TIMER
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy7;
     #endif
+    #if ( configUSE_ISR_TIMERS == 1 )
+        configRUN_TIME_COUNTER_TYPE xDummy9[ 2 ];
+        UBaseType_t uxDummy10;
+    #endif
     uint8_t ucDummy8;
 } StaticTimer_t;
 
@@ -1426,11 +1690,27 @@ typedef struct xSTATIC_STREAM_BUFFER
     #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
         void * pvDummy5[ 2 ];
     #endif
+    #if ( configUSE_QUEUE_STATS == 1 )
+        uint32_t ulDummy6[ 10 ];
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with StaticStreamBuffer_t, the StaticSpscChannel_t structure has the
+ * size and alignment of the SPSC channel structure, so an application can
+ * allocate the memory of a channel itself.
+ */
+typedef struct xSTATIC_SPSC_CHANNEL
+{
+    UBaseType_t uxDummy1[ 4 ];
+    void * pvDummy2[ 3 ];
+    UBaseType_t uxDummy3[ 4 ];
+    uint8_t ucDummy4;
+} StaticSpscChannel_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
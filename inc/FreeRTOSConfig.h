@@ -44,6 +44,7 @@
 #define configSUPPORT_STATIC_ALLOCATION          0
 #define configSUPPORT_DYNAMIC_ALLOCATION         1
 #define configUSE_IDLE_HOOK                      0
+#define configUSE_PASSIVE_IDLE_HOOK              0
 #define configUSE_TICK_HOOK                      0
 #define configUSE_MALLOC_FAILED_HOOK             1
 #define configCHECK_FOR_STACK_OVERFLOW           2
@@ -61,6 +62,77 @@
 #define configUSE_COUNTING_SEMAPHORES            1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
 
+/* Task notifications. Index 0 is left to the application, the port wakes the
+tasks it blocks through the indexes above it, one per facility:
+configDMA_COPY_NOTIFY_INDEX (1), configCORE_MAILBOX_NOTIFY_INDEX (2) and
+configHR_TIMER_NOTIFY_INDEX (3) and configSPSC_CHANNEL_NOTIFY_INDEX (4).
+configTASK_NOTIFICATION_ARRAY_ENTRIES is left to portmacro.h, which sizes the
+array for the facilities that are enabled. */
+
+/* Memory allocation. configHEAP_IMPLEMENTATION selects the heap: 3 forwards to
+the newlib malloc (heap_3.c), 5 uses the SRAM regions passed to
+vPortDefineHeapRegions() (heap_5.c), 6 is the constant time two level segregated
+fit allocator (heap_6.c) working on configTOTAL_HEAP_SIZE bytes. */
+#define configHEAP_IMPLEMENTATION                3
+#define configTOTAL_HEAP_SIZE                    ( (size_t) ( 128 * 1024 ) )
+
+/* heap_5.c region classes, one per kind of RP2040 SRAM (see portHEAP_CLASS_*).
+pvPortMalloc() takes memory from the striped SRAM first, task stacks come from
+the scratch banks when configSTACK_ALLOCATION_FROM_SEPARATE_HEAP is 1. */
+#define configHEAP_REGION_CLASSES                3
+#define configHEAP_DEFAULT_CLASS                 portHEAP_CLASS_STRIPED
+#define configHEAP_STACK_CLASS                   portHEAP_CLASS_SCRATCH
+
+/* Fixed size pools for the kernel objects. When configUSE_OBJECT_POOLS is 1 the
+control structures of the tasks, queues, timers and event groups created at run
+time are taken from pools of the given sizes, the heap is used once a pool is
+exhausted. */
+#define configUSE_OBJECT_POOLS                   0
+#define configTASK_POOL_SIZE                     8
+#define configQUEUE_POOL_SIZE                    8
+#define configTIMER_POOL_SIZE                    4
+#define configEVENT_GROUP_POOL_SIZE              4
+
+/* Single producer, single consumer channels. A task blocked on a channel sleeps
+on its own notification index, see configSPSC_CHANNEL_NOTIFY_INDEX. */
+#define configUSE_SPSC_CHANNELS                  0
+
+/* Number of cores the scheduler runs tasks on. Set to 2 to schedule tasks on
+both RP2040 cores. */
+#define configNUMBER_OF_CORES                    1
+
+/* Tickless idle. When set to 1 the tick is stopped while the system is idle and
+the core sleeps until the RP2040 timer alarm configTICKLESS_TIMER_ALARM fires. */
+#define configUSE_TICKLESS_IDLE                  0
+#define configTICKLESS_TIMER_ALARM               0
+
+/* Delayed task heap. When configUSE_DELAYED_TASK_HEAP is 1 the tasks blocked
+with a timeout are ordered by wake time in a binary heap instead of a sorted
+list, so blocking costs O(log n) however many tasks are delayed. The heap holds
+one of its configDELAYED_TASK_HEAP_LENGTH entries for every task, xTaskCreate()
+returns errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY once all of them are taken. */
+#define configUSE_DELAYED_TASK_HEAP              0
+#define configDELAYED_TASK_HEAP_LENGTH           32
+
+/* Priority event lists. When configUSE_PRIORITY_EVENT_LISTS is 1 the tasks
+blocked on a queue wait in one list per priority instead of a single list
+sorted by priority, so blocking and waking a task take the same time however
+many tasks wait on the queue. Every queue grows by two sets of
+configMAX_PRIORITIES lists. */
+#define configUSE_PRIORITY_EVENT_LISTS           0
+
+/* Scheduling latency. When configUSE_TASK_LATENCY_STATS is 1 every task keeps
+a histogram of the time from being made ready to running, in microseconds, see
+vTaskGetLatencyStats(). Each task grows by configTASK_LATENCY_BUCKETS words. */
+#define configUSE_TASK_LATENCY_STATS             0
+#define configTASK_LATENCY_BUCKETS               16
+
+/* Queue statistics. When configUSE_QUEUE_STATS is 1 every queue, semaphore and
+stream buffer counts the data sent and received, its high water mark, the time
+its senders and receivers spent blocked and the failed non-blocking sends, see
+uxQueueGetRegistryStats(). Each queue and stream buffer grows by ten words. */
+#define configUSE_QUEUE_STATS                    0
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES                    0
 #define configMAX_CO_ROUTINE_PRIORITIES          2
@@ -71,6 +143,19 @@
 #define configTIMER_QUEUE_LENGTH                 10
 #define configTIMER_TASK_STACK_DEPTH             ( (uint16_t) 128 )
 
+/* Timing wheel for the software timers. When configUSE_TIMER_WHEEL is 1 the
+active timers are kept in configTIMER_WHEEL_LEVELS levels of 32 slots, each
+level covers 32 times the range of the one below it. Timers further away than
+the wheel covers wait in an overflow list until they come into range. */
+#define configUSE_TIMER_WHEEL                    0
+#define configTIMER_WHEEL_LEVELS                 4
+
+/* Timers run from the tick interrupt. When configUSE_ISR_TIMERS is 1 a timer
+moved there with vTimerSetISRContext() has its callback called from the tick
+interrupt instead of the timer service task. Each callback is timed with the run
+time counter, see vTimerGetISRCallbackStats(). */
+#define configUSE_ISR_TIMERS                     0
+
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 #define INCLUDE_vTaskPrioritySet                 1
@@ -90,6 +175,70 @@ to exclude the API function. */
 #define configSVCall_INTERRUPT_PRIORITY          0
 #define configPendSV_INTERRUPT_PRIORITY          3
 #define configSysTick_INTERRUPT_PRIORITY         3
+#define configSIO_FIFO_INTERRUPT_PRIORITY        3
+
+/* The Cortex-M0+ has no BASEPRI. When configUSE_NVIC_PRIORITY_MASKING is 1 the
+kernel emulates it by disabling in the NVIC only the interrupts with a priority
+value at or above configMAX_SYSCALL_INTERRUPT_PRIORITY, the ones allowed to call
+the FreeRTOS API. Interrupts with a lower value are not held off by the kernel
+and must not call the API. */
+#define configUSE_NVIC_PRIORITY_MASKING          0
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY     1
+
+/* Multicore kernel lock statistics. When set to 1 the number of acquisitions,
+the contention and the hold time of the SIO spinlocks used by the kernel are
+recorded, see vPortGetSpinlockStats(). */
+#define configUSE_SPINLOCK_STATS                 0
+
+/* Critical section profiling. When set to 1 the time the interrupts stay masked
+by every outermost taskENTER_CRITICAL() is measured and charged to its call site,
+up to configCRITICAL_SECTION_SITES sites, see ulPortGetCriticalSectionStats(). */
+#define configUSE_CRITICAL_SECTION_STATS         0
+#define configCRITICAL_SECTION_SITES             32
+
+/* Run time statistics. The 64-bit RP2040 timer counts the time of the tasks in
+microseconds, see uxTaskGetRunTimeSnapshot(). When configUSE_ISR_RUN_TIME_STATS
+is 1 the interrupts installed with vPortSetInterruptHandler() are timed as well,
+see vPortGetIsrRunTimeStats(). */
+#define configGENERATE_RUN_TIME_STATS            1
+#define configRUN_TIME_COUNTER_TYPE              uint64_t
+#define configUSE_ISR_RUN_TIME_STATS             0
+
+/* Bulk copies. When configUSE_DMA_COPY is 1 the queue items and stream buffer
+data of configDMA_COPY_THRESHOLD bytes or more are copied by the DMA channel
+configDMA_COPY_CHANNEL, reserved for the kernel. A task copying at least
+configDMA_COPY_BLOCK_THRESHOLD bytes outside of a critical section sleeps until
+the copy completes, it is woken through the task notification index
+configDMA_COPY_NOTIFY_INDEX, see configTASK_NOTIFICATION_ARRAY_ENTRIES. */
+#define configUSE_DMA_COPY                       0
+#define configDMA_COPY_CHANNEL                   11
+#define configDMA_COPY_IRQ                       1
+#define configDMA_COPY_THRESHOLD                 64
+#define configDMA_COPY_BLOCK_THRESHOLD           1024
+
+/* Inter-core mailboxes. When set to 1 xPortMailboxSend() and xPortMailboxReceive()
+pass fixed size messages between the cores through rings in shared memory, the
+SIO FIFO carries the doorbells that wake a receiving task on the other core. With
+configNUMBER_OF_CORES 1 core 1 may run outside of the scheduler and exchange
+messages with the tasks of core 0. Up to configCORE_MAILBOX_COUNT mailboxes are
+registered, a blocked receiver is woken through the task notification index
+configCORE_MAILBOX_NOTIFY_INDEX. */
+#define configUSE_CORE_MAILBOX                   0
+#define configCORE_MAILBOX_COUNT                 4
+
+/* High resolution timers. When configUSE_HR_TIMERS is 1 any number of
+microsecond timers, see vPortHrTimerStart(), are expired by the RP2040 timer
+alarm configHR_TIMER_ALARM independently of the tick. A task waiting in
+vPortHrTimerDelay() is woken through the task notification index
+configHR_TIMER_NOTIFY_INDEX. */
+#define configUSE_HR_TIMERS                      0
+#define configHR_TIMER_ALARM                     1
+
+/* Trace recorder. When set to 1 the kernel trace hooks record timestamped
+binary events into a ring of configTRACE_BUFFER_EVENTS entries per core, see
+xPortTraceRings and tools/trace2perfetto.py. */
+#define configUSE_TRACE_RECORDER                 0
+#define configTRACE_BUFFER_EVENTS                1024
 
 #endif /* FREERTOS_CONFIG_H */
 
@@ -178,6 +178,27 @@ typedef struct xLIST
     listSECOND_LIST_INTEGRITY_CHECK_VALUE     /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+/*
+ * Definition of the event list used when configUSE_PRIORITY_EVENT_LISTS is 1.
+ * The tasks waiting for the event are held in one list per priority, in the
+ * order they started waiting, and bit n of uxWaitingPriorities is set when
+ * xWaiters[ n ] holds a task.  Adding a waiter and finding the highest priority
+ * waiter then take the same time however many tasks are waiting.
+ *
+ * A waiter that leaves through uxListRemove() (a timeout, or the task being
+ * deleted or suspended) does not clear its bit, the bit is cleared the next
+ * time the list of that priority is found empty.
+ */
+    typedef struct xPRIORITY_EVENT_LIST
+    {
+        volatile UBaseType_t uxWaitingPriorities; /*< Bit n set if tasks of priority n may be waiting. */
+        List_t xWaiters[ configMAX_PRIORITIES ];  /*< The waiting tasks, one list per priority. */
+    } PriorityEventList_t;
+
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+
 /*
  * Access macro to set the owner of a list item.  The owner of a list item
  * is the object (usually a TCB) that contains the list item.
@@ -494,6 +515,38 @@ void vListInsertEnd( List_t * const pxList,
  */
 UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+/*
+ * Must be called before a priority event list is used.  Initialises the list
+ * of every priority.
+ *
+ * @param pxEventList Pointer to the event list being initialised.
+ */
+    void vListInitialisePriorityEventList( PriorityEventList_t * const pxEventList ) PRIVILEGED_FUNCTION;
+
+/*
+ * Find the list holding the highest priority tasks waiting on a priority event
+ * list.  The first task in that list is the next one to receive the event.
+ *
+ * @param pxEventList The event list being queried.
+ *
+ * @return The list of the highest priority waiting tasks, or NULL if no task
+ * is waiting.
+ */
+    List_t * pxListGetHighestPriorityWaiters( PriorityEventList_t * const pxEventList ) PRIVILEGED_FUNCTION;
+
+/*
+ * Check whether any task is waiting on a priority event list.
+ *
+ * @param pxEventList The event list being queried.
+ *
+ * @return pdTRUE if no task is waiting, otherwise pdFALSE.
+ */
+    #define listPRIORITY_EVENT_LIST_IS_EMPTY( pxEventList )    ( ( pxListGetHighestPriorityWaiters( pxEventList ) == NULL ) ? pdTRUE : pdFALSE )
+
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -641,6 +641,61 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceiveFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken ) \
     xStreamBufferReceiveFromISR( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxHigherPriorityTaskWoken ) )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendReserve( MessageBufferHandle_t xMessageBuffer,
+ *                                   size_t xDataLengthBytes,
+ *                                   StreamBufferRegion_t * const pxRegion,
+ *                                   TickType_t xTicksToWait );
+ * size_t xMessageBufferSendCommit( MessageBufferHandle_t xMessageBuffer,
+ *                                  size_t xDataLengthBytes );
+ * size_t xMessageBufferSendCommitFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                         size_t xDataLengthBytes,
+ *                                         BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Zero copy send.  Space for a message of up to xDataLengthBytes is reserved
+ * and returned in *pxRegion, possibly in two parts if it wraps past the end of
+ * the storage area.  Committing writes the length of the message and makes it
+ * available to the reader, see xStreamBufferSendReserve() and
+ * xStreamBufferSendCommit().
+ */
+#define xMessageBufferSendReserve( xMessageBuffer, xDataLengthBytes, pxRegion, xTicksToWait ) \
+    xStreamBufferSendReserve( ( xMessageBuffer ), ( xDataLengthBytes ), ( pxRegion ), ( xTicksToWait ) )
+
+#define xMessageBufferSendCommit( xMessageBuffer, xDataLengthBytes ) \
+    xStreamBufferSendCommit( ( xMessageBuffer ), ( xDataLengthBytes ) )
+
+#define xMessageBufferSendCommitFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) \
+    xStreamBufferSendCommitFromISR( ( xMessageBuffer ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceivePeek( MessageBufferHandle_t xMessageBuffer,
+ *                                   StreamBufferRegion_t * const pxRegion,
+ *                                   TickType_t xTicksToWait );
+ * size_t xMessageBufferReceiveRelease( MessageBufferHandle_t xMessageBuffer );
+ * size_t xMessageBufferReceiveReleaseFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                             BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Zero copy receive.  The next message is returned in place in *pxRegion and
+ * stays in the buffer until it is released, see xStreamBufferReceivePeek() and
+ * xStreamBufferReceiveRelease().
+ */
+#define xMessageBufferReceivePeek( xMessageBuffer, pxRegion, xTicksToWait ) \
+    xStreamBufferReceivePeek( ( xMessageBuffer ), ( pxRegion ), ( xTicksToWait ) )
+
+#define xMessageBufferReceiveRelease( xMessageBuffer ) \
+    xStreamBufferReceiveRelease( ( xMessageBuffer ), 0 )
+
+#define xMessageBufferReceiveReleaseFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) \
+    xStreamBufferReceiveReleaseFromISR( ( xMessageBuffer ), 0, ( pxHigherPriorityTaskWoken ) )
+
 /**
  * message_buffer.h
  *
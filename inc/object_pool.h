@@ -0,0 +1,117 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include object_pool.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * When configUSE_OBJECT_POOLS is 1 the kernel takes the control structures of
+ * the dynamically created tasks, queues, timers and event groups from fixed
+ * size pools instead of the heap.  The pools are sized at compile time with
+ * configTASK_POOL_SIZE, configQUEUE_POOL_SIZE, configTIMER_POOL_SIZE and
+ * configEVENT_GROUP_POOL_SIZE, taking and returning an object runs in constant
+ * time and does not fragment the heap.  Once a pool is exhausted the objects
+ * are allocated from the heap again, so the create API functions behave as
+ * before.
+ *
+ * Only the control structures come from the pools, the stack of a task and the
+ * storage area of a queue are still allocated with pvPortMalloc().
+ */
+
+/**
+ * object_pool.h
+ *
+ * The kernel objects that have a pool.
+ */
+typedef enum
+{
+    eObjectPoolTask = 0,   /* TCBs, configTASK_POOL_SIZE entries. */
+    eObjectPoolQueue,      /* Queues, semaphores and mutexes, configQUEUE_POOL_SIZE entries. */
+    eObjectPoolTimer,      /* Software timers, configTIMER_POOL_SIZE entries. */
+    eObjectPoolEventGroup, /* Event groups, configEVENT_GROUP_POOL_SIZE entries. */
+    eObjectPoolCount
+} eObjectPool;
+
+/**
+ * object_pool.h
+ *
+ * Used to pass information about a pool out of vObjectPoolGetStats().
+ */
+typedef struct xOBJECT_POOL_STATS
+{
+    UBaseType_t uxCapacity;        /* The number of objects the pool can hold. */
+    UBaseType_t uxInUse;           /* The number of objects currently taken from the pool. */
+    UBaseType_t uxMaximumInUse;    /* The highest value uxInUse has had since the system booted. */
+    UBaseType_t uxHeapAllocations; /* The number of objects that were allocated from the heap because the pool was empty. */
+} ObjectPoolStats_t;
+
+/**
+ * object_pool.h
+ *
+ * Used by the kernel to take an object of xSize bytes from a pool, falling
+ * back to pvPortMalloc() when the pool is empty.  Not intended for use by the
+ * application.
+ */
+void * pvObjectPoolAllocate( eObjectPool ePool,
+                             size_t xSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * object_pool.h
+ *
+ * Used by the kernel to return an object obtained from
+ * pvObjectPoolAllocate(), objects that came from the heap are passed on to
+ * vPortFree().  Not intended for use by the application.
+ */
+void vObjectPoolFree( eObjectPool ePool,
+                      void * pv ) PRIVILEGED_FUNCTION;
+
+/**
+ * object_pool.h
+ *
+ * Fills pxStats with the usage of the given pool.
+ */
+void vObjectPoolGetStats( eObjectPool ePool,
+                          ObjectPoolStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* OBJECT_POOL_H */
@@ -131,11 +131,14 @@
 #endif /* if ( portUSING_MPU_WRAPPERS == 1 ) */
 
 /* Used by heap_5.c to define the start address and size of each memory region
- * that together comprise the total FreeRTOS heap space. */
+ * that together comprise the total FreeRTOS heap space.  The class groups the
+ * regions pvPortMallocFromClass() can allocate from, a region table that
+ * leaves it out puts every region in class 0. */
 typedef struct HeapRegion
 {
     uint8_t * pucStartAddress;
     size_t xSizeInBytes;
+    UBaseType_t uxRegionClass;
 } HeapRegion_t;
 
 /* Used to pass information about the heap out of vPortGetHeapStats(). */
@@ -163,6 +166,19 @@ typedef struct xHeapStats
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/*
+ * Used by heap_5.c to allocate from the regions of a single class.  Unlike
+ * pvPortMalloc() there is no fall back to the other classes, NULL is returned
+ * when the class has no free block large enough.
+ */
+void * pvPortMallocFromClass( size_t xSize,
+                              UBaseType_t uxRegionClass ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used by heap_5.c to return the free bytes left in the regions of one class.
+ */
+size_t xPortGetFreeHeapSizeOfClass( UBaseType_t uxRegionClass ) PRIVILEGED_FUNCTION;
+
 /*
  * Returns a HeapStats_t structure filled with information about the current
  * heap state.
@@ -885,6 +885,107 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueSendBatch(
+ *                              QueueHandle_t xQueue,
+ *                              const void * const pvItemsToQueue,
+ *                              const UBaseType_t uxItemCount,
+ *                              TickType_t xTicksToWait
+ *                            );
+ * @endcode
+ *
+ * Post several items to the back of a queue.  The items are copied in a
+ * single critical section, the tasks waiting for data are woken together and
+ * the calling task yields at most once, so moving a batch of items costs
+ * little more than moving a single item.
+ *
+ * As many items as there is room for are posted, the function only blocks
+ * when the queue is full.  It must not be used on a mutex or from an
+ * interrupt service routine, see xQueueSendBatchFromISR() for an alternative
+ * that may be used in an ISR.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items.  The size
+ * of every item was defined when the queue was created.
+ *
+ * @param uxItemCount The number of items in pvItemsToQueue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already be
+ * full.  The call will return immediately if this is set to 0.
+ *
+ * @return The number of items posted, from 0 if the queue stayed full to
+ * uxItemCount if there was room for all of them.
+ *
+ * Example usage:
+ * @code{c}
+ * void vATask( void *pvParameters )
+ * {
+ * uint16_t usSamples[ 16 ];
+ * UBaseType_t uxSent = 0;
+ *
+ *  // ... Fill usSamples.
+ *
+ *  // Post all the samples, blocking whenever the queue is full.
+ *  while( uxSent < 16 )
+ *  {
+ *      uxSent += xQueueSendBatch( xQueue, &( usSamples[ uxSent ] ), 16 - uxSent, portMAX_DELAY );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueSendBatch xQueueSendBatch
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendBatch( QueueHandle_t xQueue,
+                             const void * const pvItemsToQueue,
+                             const UBaseType_t uxItemCount,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueReceiveBatch(
+ *                                 QueueHandle_t xQueue,
+ *                                 void * const pvBuffer,
+ *                                 const UBaseType_t uxMaxItems,
+ *                                 TickType_t xTicksToWait
+ *                               );
+ * @endcode
+ *
+ * Receive several items from a queue in a single critical section.  The items
+ * are received by copy, in the order they were posted, so the buffer must
+ * have room for uxMaxItems items.  The tasks waiting for space are woken
+ * together and the calling task yields at most once.
+ *
+ * All the items available, up to uxMaxItems, are received.  The function only
+ * blocks when the queue is empty.  It must not be used on a mutex or from an
+ * interrupt service routine, see xQueueReceiveBatchFromISR().
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will
+ * be copied.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time
+ * of the call.  The call will return immediately if this is set to 0.
+ *
+ * @return The number of items received, 0 if the queue stayed empty.
+ *
+ * \defgroup xQueueReceiveBatch xQueueReceiveBatch
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveBatch( QueueHandle_t xQueue,
+                                void * const pvBuffer,
+                                const UBaseType_t uxMaxItems,
+                                TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * @code{c}
@@ -1418,6 +1519,78 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                                  void * const pvBuffer,
                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueSendBatchFromISR(
+ *                                     QueueHandle_t xQueue,
+ *                                     const void * const pvItemsToQueue,
+ *                                     const UBaseType_t uxItemCount,
+ *                                     BaseType_t *pxHigherPriorityTaskWoken
+ *                                   );
+ * @endcode
+ *
+ * Version of xQueueSendBatch() that can be used from an interrupt service
+ * routine.  As many items as there is room for are posted, the function never
+ * blocks.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items.
+ *
+ * @param uxItemCount The number of items in pvItemsToQueue.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueSendBatchFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if posting the items unblocked a task
+ * with a priority higher than the currently running task.  A context switch
+ * should then be requested before the interrupt is exited.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup xQueueSendBatchFromISR xQueueSendBatchFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendBatchFromISR( QueueHandle_t xQueue,
+                                    const void * const pvItemsToQueue,
+                                    const UBaseType_t uxItemCount,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueReceiveBatchFromISR(
+ *                                        QueueHandle_t xQueue,
+ *                                        void * const pvBuffer,
+ *                                        const UBaseType_t uxMaxItems,
+ *                                        BaseType_t *pxHigherPriorityTaskWoken
+ *                                      );
+ * @endcode
+ *
+ * Version of xQueueReceiveBatch() that can be used from an interrupt service
+ * routine.  All the items available, up to uxMaxItems, are received, the
+ * function never blocks.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will
+ * be copied.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if removing the items
+ * unblocked a task with a priority higher than the currently running task.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveBatchFromISR xQueueReceiveBatchFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveBatchFromISR( QueueHandle_t xQueue,
+                                       void * const pvBuffer,
+                                       const UBaseType_t uxMaxItems,
+                                       BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from within an ISR, or within a critical section.
@@ -1540,6 +1713,95 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
     const char * pcQueueGetName( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 #endif
 
+#if ( configUSE_QUEUE_STATS == 1 )
+
+/* Traffic through a queue, semaphore or stream buffer.  For a stream buffer
+ * every successful write or read counts as one item and the high water mark
+ * is in bytes, including the length of the messages of a message buffer. */
+    typedef struct xQUEUE_STATS
+    {
+        uint32_t ulItemsSent;           /* Number of items sent, a semaphore give counts as one item. */
+        uint32_t ulItemsReceived;       /* Number of items received, peeking does not count. */
+        uint32_t ulBytesSent;           /* Number of bytes copied in. */
+        uint32_t ulBytesReceived;       /* Number of bytes copied out. */
+        uint32_t ulHighWaterMark;       /* Highest number of items held at once. */
+        uint32_t ulSendBlocks;          /* Number of times a sender blocked because there was no space. */
+        uint32_t ulReceiveBlocks;       /* Number of times a receiver blocked because there was no data. */
+        uint32_t ulSendBlockedTicks;    /* Ticks spent blocked by the senders. */
+        uint32_t ulReceiveBlockedTicks; /* Ticks spent blocked by the receivers. */
+        uint32_t ulFailedSends;         /* Sends without a block time, including the ones from interrupts, that stored nothing. */
+    } QueueStats_t;
+
+/**
+ * queue. h
+ * @code{c}
+ * void vQueueGetStats( QueueHandle_t xQueue, QueueStats_t * pxStats );
+ * void vQueueResetStats( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * configUSE_QUEUE_STATS must be defined as 1 for these functions to be
+ * available.
+ *
+ * A queue that never gets near its length wastes RAM, a queue with failed
+ * sends or blocked senders is too short or is not read often enough.  The
+ * statistics start from zero when the queue is created, resetting them starts
+ * the high water mark from the current number of items.
+ *
+ * @param xQueue The handle of the queue, semaphore or mutex.
+ *
+ * @param pxStats The statistics of the queue are copied here.
+ */
+    void vQueueGetStats( QueueHandle_t xQueue,
+                         QueueStats_t * pxStats ) PRIVILEGED_FUNCTION;
+    void vQueueResetStats( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_STATS */
+
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATS == 1 ) )
+
+/* One object of the queue registry, used with uxQueueGetRegistryStats(). */
+    typedef struct xQUEUE_REGISTRY_STATS
+    {
+        const char * pcName;        /* The name given when the object was added to the registry. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        void * pvHandle;            /* The QueueHandle_t or the StreamBufferHandle_t of the object. */
+        BaseType_t xIsStreamBuffer; /* pdTRUE for a stream or message buffer, pdFALSE for a queue, semaphore or mutex. */
+        size_t xCapacity;           /* The length of a queue in items, of a stream buffer in bytes. */
+        QueueStats_t xStats;        /* The statistics of the object. */
+    } QueueRegistryStats_t;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueGetRegistryStats( QueueRegistryStats_t * const pxRegistryStats, const UBaseType_t uxArraySize );
+ * @endcode
+ *
+ * configUSE_QUEUE_STATS must be defined as 1 and configQUEUE_REGISTRY_SIZE
+ * must be greater than 0 for this function to be available.
+ *
+ * Collects the statistics of every queue, semaphore, mutex and stream buffer
+ * added to the registry with vQueueAddToRegistry() or
+ * vStreamBufferAddToRegistry().  The objects must not be deleted while the
+ * statistics are collected.
+ *
+ * @param pxRegistryStats Array that receives one entry per registered object.
+ *
+ * @param uxArraySize The number of entries in pxRegistryStats, at most
+ * configQUEUE_REGISTRY_SIZE are used.
+ *
+ * @return The number of entries written to pxRegistryStats.
+ */
+    UBaseType_t uxQueueGetRegistryStats( QueueRegistryStats_t * const pxRegistryStats,
+                                         const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Use vStreamBufferAddToRegistry() instead of calling
+ * this function directly.
+ */
+    void vQueueAddStreamBufferToRegistry( void * pvStreamBuffer,
+                                          const char * pcStreamBufferName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+#endif /* ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATS == 1 ) */
+
 /*
  * Generic version of the function used to create a queue using dynamic memory
  * allocation.  This is called by other functions and macros that create other
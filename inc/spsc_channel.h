@@ -0,0 +1,292 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * SPSC channels pass fixed size items from exactly one writer to exactly one
+ * reader.  The writer and the reader may be two tasks, a task and an
+ * interrupt, or two tasks or interrupts running on different cores.
+ *
+ * Each side of the channel owns one index into the storage area and only
+ * ever writes its own index, so sending and receiving an item needs neither a
+ * critical section nor an atomic read-modify-write, only memory barriers that
+ * order the item copy against the index update.  The scheduler is only
+ * involved when a task has to block because the channel is full or empty, the
+ * blocked task is then woken with a direct to task notification on index
+ * configSPSC_CHANNEL_NOTIFY_INDEX.
+ *
+ * ***NOTE***:  As with stream buffers it is not safe to have more than one
+ * writer or more than one reader.  Use a queue if there are several of
+ * either.
+ */
+
+#ifndef SPSC_CHANNEL_H
+#define SPSC_CHANNEL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include spsc_channel.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which SPSC channels are referenced.  For example, a call to
+ * xSpscChannelCreate() returns a SpscChannelHandle_t variable that can then be
+ * used as a parameter to xSpscChannelSend(), xSpscChannelReceive(), etc.
+ */
+struct SpscChannelDef_t;
+typedef struct SpscChannelDef_t * SpscChannelHandle_t;
+
+/**
+ * spsc_channel.h
+ *
+ * @code{c}
+ * SpscChannelHandle_t xSpscChannelCreate( UBaseType_t uxChannelLength,
+ *                                         UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new SPSC channel and returns a handle by which it can be
+ * referenced.  The memory for the channel structure and its storage area is
+ * allocated with pvPortMalloc().  configSUPPORT_DYNAMIC_ALLOCATION must be set
+ * to 1 or left undefined in FreeRTOSConfig.h for xSpscChannelCreate() to be
+ * available.
+ *
+ * @param uxChannelLength The maximum number of items the channel can hold at
+ * any one time.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @return If the channel is created successfully then a handle to the created
+ * channel is returned.  If the memory required to create the channel could
+ * not be allocated then NULL is returned.
+ *
+ * \defgroup xSpscChannelCreate xSpscChannelCreate
+ * \ingroup SpscChannelManagement
+ */
+SpscChannelHandle_t xSpscChannelCreate( UBaseType_t uxChannelLength,
+                                        UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_channel.h
+ *
+ * @code{c}
+ * SpscChannelHandle_t xSpscChannelCreateStatic( UBaseType_t uxChannelLength,
+ *                                               UBaseType_t uxItemSize,
+ *                                               uint8_t *pucChannelStorage,
+ *                                               StaticSpscChannel_t *pxStaticChannel );
+ * @endcode
+ *
+ * Creates a new SPSC channel using memory provided by the application.
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xSpscChannelCreateStatic() to be available.
+ *
+ * @param uxChannelLength The maximum number of items the channel can hold at
+ * any one time.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @param pucChannelStorage Must point to a uint8_t array of at least
+ * ( uxChannelLength + 1 ) * uxItemSize bytes.  One slot is always kept free so
+ * a full channel can be told apart from an empty one.
+ *
+ * @param pxStaticChannel Must point to a variable of type StaticSpscChannel_t,
+ * which will be used to hold the channel's data structure.
+ *
+ * @return If neither pucChannelStorage nor pxStaticChannel are NULL then a
+ * handle to the created channel is returned, otherwise NULL is returned.
+ *
+ * \defgroup xSpscChannelCreateStatic xSpscChannelCreateStatic
+ * \ingroup SpscChannelManagement
+ */
+SpscChannelHandle_t xSpscChannelCreateStatic( UBaseType_t uxChannelLength,
+                                              UBaseType_t uxItemSize,
+                                              uint8_t * const pucChannelStorage,
+                                              StaticSpscChannel_t * const pxStaticChannel ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_channel.h
+ *
+ * @code{c}
+ * void vSpscChannelDelete( SpscChannelHandle_t xChannel );
+ * @endcode
+ *
+ * Deletes a channel that was previously created.  If the channel was created
+ * dynamically then the memory it used is freed.  Neither side may be using or
+ * blocked on the channel when it is deleted.
+ *
+ * @param xChannel The handle of the channel to be deleted.
+ *
+ * \defgroup vSpscChannelDelete vSpscChannelDelete
+ * \ingroup SpscChannelManagement
+ */
+void vSpscChannelDelete( SpscChannelHandle_t xChannel ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_channel.h
+ *
+ * @code{c}
+ * BaseType_t xSpscChannelSend( SpscChannelHandle_t xChannel,
+ *                              const void *pvItemToSend,
+ *                              TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies an item into the channel.  Use xSpscChannelSendFromISR() to write to
+ * a channel from an interrupt service routine.
+ *
+ * @param xChannel The handle of the channel to which the item is sent.
+ *
+ * @param pvItemToSend A pointer to the item to copy into the channel.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for a free slot, should the channel be
+ * full.  The call returns immediately if this is 0.
+ *
+ * @return pdPASS if the item was sent, otherwise pdFAIL.
+ *
+ * \defgroup xSpscChannelSend xSpscChannelSend
+ * \ingroup SpscChannelManagement
+ */
+BaseType_t xSpscChannelSend( SpscChannelHandle_t xChannel,
+                             const void * pvItemToSend,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_channel.h
+ *
+ * @code{c}
+ * BaseType_t xSpscChannelSendFromISR( SpscChannelHandle_t xChannel,
+ *                                     const void *pvItemToSend,
+ *                                     BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xSpscChannelSend().  It never blocks.
+ *
+ * @param xChannel The handle of the channel to which the item is sent.
+ *
+ * @param pvItemToSend A pointer to the item to copy into the channel.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item woke a
+ * reader task with a priority above that of the interrupted task, a context
+ * switch should then be requested before the interrupt is exited.  Can be
+ * NULL.
+ *
+ * @return pdPASS if the item was sent, pdFAIL if the channel was full.
+ *
+ * \defgroup xSpscChannelSendFromISR xSpscChannelSendFromISR
+ * \ingroup SpscChannelManagement
+ */
+BaseType_t xSpscChannelSendFromISR( SpscChannelHandle_t xChannel,
+                                    const void * pvItemToSend,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_channel.h
+ *
+ * @code{c}
+ * BaseType_t xSpscChannelReceive( SpscChannelHandle_t xChannel,
+ *                                 void *pvBuffer,
+ *                                 TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the oldest item out of the channel.  Use xSpscChannelReceiveFromISR()
+ * to read from a channel in an interrupt service routine.
+ *
+ * @param xChannel The handle of the channel from which the item is received.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for an item, should the channel be
+ * empty.  The call returns immediately if this is 0.
+ *
+ * @return pdPASS if an item was received, otherwise pdFAIL.
+ *
+ * \defgroup xSpscChannelReceive xSpscChannelReceive
+ * \ingroup SpscChannelManagement
+ */
+BaseType_t xSpscChannelReceive( SpscChannelHandle_t xChannel,
+                                void * pvBuffer,
+                                TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_channel.h
+ *
+ * @code{c}
+ * BaseType_t xSpscChannelReceiveFromISR( SpscChannelHandle_t xChannel,
+ *                                        void *pvBuffer,
+ *                                        BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xSpscChannelReceive().  It never blocks.
+ *
+ * @param xChannel The handle of the channel from which the item is received.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item is copied.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the item woke a
+ * writer task with a priority above that of the interrupted task.  Can be
+ * NULL.
+ *
+ * @return pdPASS if an item was received, pdFAIL if the channel was empty.
+ *
+ * \defgroup xSpscChannelReceiveFromISR xSpscChannelReceiveFromISR
+ * \ingroup SpscChannelManagement
+ */
+BaseType_t xSpscChannelReceiveFromISR( SpscChannelHandle_t xChannel,
+                                       void * pvBuffer,
+                                       BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_channel.h
+ *
+ * @code{c}
+ * UBaseType_t uxSpscChannelMessagesWaiting( SpscChannelHandle_t xChannel );
+ * @endcode
+ *
+ * Returns the number of items in the channel.  The value is only a snapshot
+ * when the other side is active at the same time.
+ *
+ * @param xChannel The handle of the channel being queried.
+ *
+ * @return The number of items that can be received from the channel.
+ *
+ * \defgroup uxSpscChannelMessagesWaiting uxSpscChannelMessagesWaiting
+ * \ingroup SpscChannelManagement
+ */
+UBaseType_t uxSpscChannelMessagesWaiting( SpscChannelHandle_t xChannel ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( SPSC_CHANNEL_H ) */
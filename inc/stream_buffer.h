@@ -56,6 +56,12 @@
     #error "include FreeRTOS.h must appear in source files before include stream_buffer.h"
 #endif
 
+/* The statistics of a stream buffer use the same type as the ones of a
+ * queue. */
+#if ( configUSE_QUEUE_STATS == 1 )
+    #include "queue.h"
+#endif
+
 /* *INDENT-OFF* */
 #if defined( __cplusplus )
     extern "C" {
@@ -78,6 +84,19 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
                                                  BaseType_t xIsInsideISR,
                                                  BaseType_t * const pxHigherPriorityTaskWoken );
 
+/**
+ * Type used by the zero copy functions to describe a region of the storage
+ * area of a stream buffer.  A region that wraps past the end of the storage
+ * area is split in two parts, xSecondLength is zero when it does not.
+ */
+typedef struct StreamBufferRegion
+{
+    uint8_t * pucFirst;   /* Start of the first part of the region. */
+    size_t xFirstLength;  /* Length of the first part of the region. */
+    uint8_t * pucSecond;  /* Start of the part that wrapped, the start of the storage area. */
+    size_t xSecondLength; /* Length of the part that wrapped. */
+} StreamBufferRegion_t;
+
 /**
  * stream_buffer.h
  *
@@ -633,6 +652,168 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
                                     size_t xBufferLengthBytes,
                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+ *                                  size_t xDataLengthBytes,
+ *                                  StreamBufferRegion_t * const pxRegion,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Reserves space in a stream buffer so the data can be written in place, by
+ * the CPU or by a DMA channel, instead of being copied by xStreamBufferSend().
+ * Nothing is visible to the reader until xStreamBufferSendCommit() or
+ * xStreamBufferSendCommitFromISR() is called.
+ *
+ * The reserved space starts at the current write position, so a region that
+ * reaches the end of the storage area continues at its start.  Both parts are
+ * returned in *pxRegion.  A writer that needs contiguous memory can use the
+ * first part only and commit it, the next reservation then starts at the
+ * beginning of the storage area.
+ *
+ * For a stream buffer as much of xDataLengthBytes as fits is reserved.  For a
+ * message buffer the whole message is reserved or nothing, the space used to
+ * store the message length is taken into account and is not part of the
+ * region.
+ *
+ * Only one reservation may be outstanding, as with xStreamBufferSend() there
+ * must be a single writer.  Called with xTicksToWait set to zero the function
+ * does not block and can be used from an interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param xDataLengthBytes The number of bytes to reserve.
+ *
+ * @param pxRegion Set to the reserved region of the storage area.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for xDataLengthBytes of space.
+ *
+ * @return The number of bytes reserved, zero if there was no space.
+ *
+ * \defgroup xStreamBufferSendReserve xStreamBufferSendReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xDataLengthBytes,
+                                 StreamBufferRegion_t * const pxRegion,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+ *                                 size_t xDataLengthBytes );
+ * size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                        size_t xDataLengthBytes,
+ *                                        BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Makes the first xDataLengthBytes of the region returned by
+ * xStreamBufferSendReserve() available to the reader and unblocks a task
+ * waiting for data, the same as xStreamBufferSend() does once the data is
+ * copied.  Fewer bytes than were reserved may be committed, for a message
+ * buffer the committed length is the length of the message and zero cancels
+ * the reservation.
+ *
+ * @param xStreamBuffer The handle of the stream buffer written to.
+ *
+ * @param xDataLengthBytes The number of bytes written into the region.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if committing the data
+ * unblocked a task with a priority above the interrupted task, a context
+ * switch should then be requested before the interrupt is exited.
+ *
+ * @return The number of bytes committed.
+ *
+ * \defgroup xStreamBufferSendCommit xStreamBufferSendCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+                                size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                       size_t xDataLengthBytes,
+                                       BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceivePeek( StreamBufferHandle_t xStreamBuffer,
+ *                                  StreamBufferRegion_t * const pxRegion,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Returns the data waiting in a stream buffer in place, so it can be parsed
+ * or handed to a DMA channel instead of being copied by
+ * xStreamBufferReceive().  The data stays in the buffer until
+ * xStreamBufferReceiveRelease() or xStreamBufferReceiveReleaseFromISR() is
+ * called.
+ *
+ * For a stream buffer all the bytes available are returned, for a message
+ * buffer the next message.  Data that wraps past the end of the storage area
+ * is returned in two parts.
+ *
+ * As with xStreamBufferReceive() there must be a single reader.  Called with
+ * xTicksToWait set to zero the function does not block and can be used from an
+ * interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param pxRegion Set to the region of the storage area holding the data.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for data.
+ *
+ * @return The number of bytes in the region, zero if the buffer is empty.
+ *
+ * \defgroup xStreamBufferReceivePeek xStreamBufferReceivePeek
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceivePeek( StreamBufferHandle_t xStreamBuffer,
+                                 StreamBufferRegion_t * const pxRegion,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+ *                                     size_t xDataLengthBytes );
+ * size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                            size_t xDataLengthBytes,
+ *                                            BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Frees the first xDataLengthBytes of the region returned by
+ * xStreamBufferReceivePeek() and unblocks a task waiting for space, the same
+ * as xStreamBufferReceive() does once the data is copied.  A message buffer
+ * always releases the whole message and xDataLengthBytes is ignored.
+ *
+ * @param xStreamBuffer The handle of the stream buffer read from.
+ *
+ * @param xDataLengthBytes The number of bytes consumed.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if releasing the data
+ * unblocked a task with a priority above the interrupted task, a context
+ * switch should then be requested before the interrupt is exited.
+ *
+ * @return The number of bytes released.
+ *
+ * \defgroup xStreamBufferReceiveRelease xStreamBufferReceiveRelease
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           size_t xDataLengthBytes,
+                                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -879,6 +1060,63 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
                                                  BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer, QueueStats_t * pxStats );
+ * void vStreamBufferResetStats( StreamBufferHandle_t xStreamBuffer );
+ * @endcode
+ *
+ * configUSE_QUEUE_STATS must be defined as 1 for these functions to be
+ * available.
+ *
+ * Every successful write or read of a stream buffer counts as one item, the
+ * high water mark is the largest number of bytes held at once, including the
+ * lengths stored in front of the messages of a message buffer.  A send without
+ * a block time that could not store all its data counts as a failed send.
+ *
+ * The writer updates the send side of the statistics and the reader the
+ * receive side, so the statistics need no more locking than the stream buffer
+ * itself.
+ *
+ * @param xStreamBuffer The handle of the stream or message buffer.
+ *
+ * @param pxStats The statistics of the stream buffer are copied here.
+ *
+ * \defgroup vStreamBufferGetStats vStreamBufferGetStats
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_QUEUE_STATS == 1 )
+    void vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer,
+                                QueueStats_t * pxStats ) PRIVILEGED_FUNCTION;
+    void vStreamBufferResetStats( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferAddToRegistry( StreamBufferHandle_t xStreamBuffer, const char * pcStreamBufferName );
+ * void vStreamBufferUnregister( StreamBufferHandle_t xStreamBuffer );
+ * @endcode
+ *
+ * configUSE_QUEUE_STATS must be defined as 1 and configQUEUE_REGISTRY_SIZE
+ * must be greater than 0 for these macros to be available.
+ *
+ * Adds a stream or message buffer to the queue registry, or removes it, so
+ * its statistics are collected by uxQueueGetRegistryStats() together with the
+ * ones of the queues.  vStreamBufferDelete() removes the stream buffer from the
+ * registry.  As with vQueueAddToRegistry() only a pointer to the name is kept.
+ *
+ * \defgroup vStreamBufferAddToRegistry vStreamBufferAddToRegistry
+ * \ingroup StreamBufferManagement
+ */
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATS == 1 ) )
+    #define vStreamBufferAddToRegistry( xStreamBuffer, pcStreamBufferName )    vQueueAddStreamBufferToRegistry( ( void * ) ( xStreamBuffer ), ( pcStreamBufferName ) )
+    #define vStreamBufferUnregister( xStreamBuffer )                           vQueueUnregisterQueue( ( QueueHandle_t ) ( void * ) ( xStreamBuffer ) )
+#endif
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                  size_t xTriggerLevelBytes,
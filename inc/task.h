@@ -73,6 +73,9 @@
  * array. */
 #define tskDEFAULT_INDEX_TO_NOTIFY     ( 0 )
 
+/* Core affinity mask that allows a task to run on any core. */
+#define tskNO_AFFINITY                 ( ( UBaseType_t ) -1 )
+
 /**
  * task. h
  *
@@ -168,6 +171,15 @@ typedef struct xTASK_STATUS
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with the uxTaskGetRunTimeSnapshot() function to return the run time of
+ * each task in the system. */
+typedef struct xTASK_RUN_TIME
+{
+    TaskHandle_t xHandle;                         /* The handle of the task to which the rest of the information in the structure relates. */
+    UBaseType_t xTaskNumber;                      /* A number unique to the task. */
+    configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /* The total run time allocated to the task so far, as defined by the run time stats clock. */
+} TaskRunTime_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -208,7 +220,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskENTER_CRITICAL()               portENTER_CRITICAL()
-#define taskENTER_CRITICAL_FROM_ISR()      portSET_INTERRUPT_MASK_FROM_ISR()
+#if ( configNUMBER_OF_CORES == 1 )
+    #define taskENTER_CRITICAL_FROM_ISR()    portSET_INTERRUPT_MASK_FROM_ISR()
+#else
+    #define taskENTER_CRITICAL_FROM_ISR()    portENTER_CRITICAL_FROM_ISR()
+#endif
 
 /**
  * task. h
@@ -223,7 +239,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskEXIT_CRITICAL()                portEXIT_CRITICAL()
-#define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#if ( configNUMBER_OF_CORES == 1 )
+    #define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#else
+    #define taskEXIT_CRITICAL_FROM_ISR( x )    portEXIT_CRITICAL_FROM_ISR( x )
+#endif
 
 /**
  * task. h
@@ -1088,6 +1108,58 @@ void vTaskGetInfo( TaskHandle_t xTask,
 void vTaskPrioritySet( TaskHandle_t xTask,
                        UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask );
+ * @endcode
+ *
+ * Only available when configNUMBER_OF_CORES is greater than 1.
+ *
+ * Sets the core affinity mask for a task.  Bit n of the mask is set if the
+ * task is allowed to run on core n.  A task created with xTaskCreate() or
+ * xTaskCreateStatic() has the mask tskNO_AFFINITY and may run on any core.
+ *
+ * If the task is running on a core that the new mask excludes, that core is
+ * requested to yield before the function returns.
+ *
+ * @param xTask The handle of the task to set the core affinity mask for.
+ * Passing NULL will set the core affinity mask for the calling task.
+ *
+ * @param uxCoreAffinityMask A bitwise value that indicates the cores on
+ * which the task can run.  To pin the calling task to core 1:
+ * vTaskCoreAffinitySet( NULL, ( 1 << 1 ) );
+ *
+ * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+ * \ingroup TaskCtrl
+ */
+    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                               UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t vTaskCoreAffinityGet( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * Only available when configNUMBER_OF_CORES is greater than 1.
+ *
+ * Gets the core affinity mask for a task.
+ *
+ * @param xTask The handle of the task to get the core affinity mask for.
+ * Passing NULL will get the core affinity mask for the calling task.
+ *
+ * @return The core affinity mask, bit n of which is set if the task is
+ * allowed to run on core n.
+ *
+ * \defgroup vTaskCoreAffinityGet vTaskCoreAffinityGet
+ * \ingroup TaskCtrl
+ */
+    UBaseType_t vTaskCoreAffinityGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+
 /**
  * task. h
  * @code{c}
@@ -1681,6 +1753,30 @@ configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVIL
     void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
                                         StackType_t ** ppxIdleTaskStackBuffer,
                                         uint32_t * pulIdleTaskStackSize ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+    #if ( configNUMBER_OF_CORES > 1 )
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer, StackType_t ** ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex )
+ * @endcode
+ *
+ * This function is used to provide a statically allocated block of memory to
+ * FreeRTOS to hold the passive idle task of every core other than core 0.
+ * It is required when configSUPPORT_STATIC_ALLOCATION is set and
+ * configNUMBER_OF_CORES is greater than 1.
+ *
+ * @param ppxIdleTaskTCBBuffer A handle to a statically allocated TCB buffer
+ * @param ppxIdleTaskStackBuffer A handle to a statically allocated Stack buffer for the passive idle task
+ * @param pulIdleTaskStackSize A pointer to the number of elements that will fit in the allocated stack buffer
+ * @param xPassiveIdleTaskIndex The passive idle task index, from 0 to configNUMBER_OF_CORES - 2
+ */
+        void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                                   StackType_t ** ppxIdleTaskStackBuffer,
+                                                   uint32_t * pulIdleTaskStackSize,
+                                                   BaseType_t xPassiveIdleTaskIndex ); /*lint !e526 Symbol not defined as it is an application callback. */
+    #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 #endif
 
 /**
@@ -1708,6 +1804,19 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/**
+ * xTaskGetIdleTaskHandleForCore() is only available if
+ * INCLUDE_xTaskGetIdleTaskHandle is set to 1 in FreeRTOSConfig.h and
+ * configNUMBER_OF_CORES is greater than 1.
+ *
+ * Returns the handle of the idle task of core xCoreID.  The idle task of core
+ * 0 is the one returned by xTaskGetIdleTaskHandle().
+ */
+    TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
  * uxTaskGetSystemState() to be available.
@@ -1809,6 +1918,42 @@ UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
                                   const UBaseType_t uxArraySize,
                                   configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTime_t * const pxTaskRunTimeArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime );
+ * @endcode
+ *
+ * configUSE_TRACE_FACILITY and configGENERATE_RUN_TIME_STATS must be defined
+ * as 1 for this function to be available.
+ *
+ * uxTaskGetRunTimeSnapshot() is a lighter form of uxTaskGetSystemState() meant
+ * to be polled periodically.  It populates a TaskRunTime_t structure with only
+ * the handle, the number and the run time counter of each task in the system.
+ * The stack of the tasks is not inspected, so the time spent with the scheduler
+ * suspended grows only with the number of tasks.  The CPU load of a task over
+ * the polling period is the difference between two snapshots of its run time
+ * counter divided by the difference of the two *pulTotalRunTime values.
+ *
+ * @param pxTaskRunTimeArray A pointer to an array of TaskRunTime_t structures.
+ * The array must contain at least one structure for each task under the
+ * control of the RTOS, uxTaskGetNumberOfTasks() returns that number.
+ *
+ * @param uxArraySize The size of the array pointed to by pxTaskRunTimeArray.
+ *
+ * @param pulTotalRunTime If not NULL *pulTotalRunTime is set to the value of
+ * the run time stats clock at the time the snapshot was taken.
+ *
+ * @return The number of TaskRunTime_t structures populated, zero if the array
+ * is too small.
+ *
+ * \defgroup uxTaskGetRunTimeSnapshot uxTaskGetRunTimeSnapshot
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTime_t * const pxTaskRunTimeArray,
+                                      const UBaseType_t uxArraySize,
+                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -1957,6 +2102,49 @@ void vTaskGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_TASK_LATENCY_STATS == 1 )
+
+/* Scheduling latency of a task, used with vTaskGetLatencyStats(). */
+    typedef struct xTASK_LATENCY_STATS
+    {
+        uint32_t ulCount;                                   /* Number of times the task was switched in after being made ready. */
+        configRUN_TIME_COUNTER_TYPE ulTotalLatency;         /* Accumulated time from ready to running. */
+        configRUN_TIME_COUNTER_TYPE ulMaxLatency;           /* Longest time from ready to running. */
+        uint32_t ulHistogram[ configTASK_LATENCY_BUCKETS ]; /* Bucket 0 counts the zero latencies, bucket n the latencies from 2^(n-1) to 2^n - 1, the last bucket all the longer ones. */
+    } TaskLatencyStats_t;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetLatencyStats( TaskHandle_t xTask, TaskLatencyStats_t * pxLatencyStats );
+ * void vTaskResetLatencyStats( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_TASK_LATENCY_STATS must be defined as 1 for these functions to be
+ * available.
+ *
+ * Each task measures how long it waits between being added to a ready list,
+ * when it is unblocked, resumed or created, and being switched in.  The time
+ * is in the unit of portGET_RUN_TIME_COUNTER_VALUE().  A task preempted while
+ * running is not timed again until it blocks or is suspended and made ready.
+ *
+ * A task with a long wait at a high priority points at an interrupt or a
+ * critical section that holds off the scheduler, long waits spread over the
+ * tasks of one priority point at a priority level with too much work.
+ *
+ * @param xTask The handle of the task, or NULL for the calling task.
+ *
+ * @param pxLatencyStats The statistics of the task are copied here.
+ *
+ * \defgroup vTaskGetLatencyStats vTaskGetLatencyStats
+ * \ingroup TaskUtils
+ */
+    void vTaskGetLatencyStats( TaskHandle_t xTask,
+                               TaskLatencyStats_t * pxLatencyStats ) PRIVILEGED_FUNCTION;
+    void vTaskResetLatencyStats( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TASK_LATENCY_STATS */
+
 /**
  * task. h
  * @code{c}
@@ -3003,15 +3191,52 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEG
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * The equivalents of vTaskPlaceOnEventList(), vTaskPlaceOnEventListRestricted()
+ * and xTaskRemoveFromEventList() for the event lists that keep one list of
+ * waiting tasks per priority, used by the queues when
+ * configUSE_PRIORITY_EVENT_LISTS is 1.  The calling requirements are the same.
+ */
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    void vTaskPlaceOnPriorityEventList( PriorityEventList_t * const pxEventList,
+                                        const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    void vTaskPlaceOnPriorityEventListRestricted( PriorityEventList_t * const pxEventList,
+                                                  TickType_t xTicksToWait,
+                                                  const BaseType_t xWaitIndefinitely ) PRIVILEGED_FUNCTION;
+    BaseType_t xTaskRemoveFromPriorityEventList( PriorityEventList_t * const pxEventList ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
  * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
  *
  * Sets the pointer to the current TCB to the TCB of the highest priority task
- * that is ready to run.
+ * that is ready to run.  With configNUMBER_OF_CORES greater than 1 the port
+ * passes the ID of the core that is switching context.
+ */
+#if ( configNUMBER_OF_CORES == 1 )
+    portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+#else
+    portDONT_DISCARD void vTaskSwitchContext( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Called by xPortStartScheduler() with interrupts disabled, before the first
+ * task of any core starts.  The first tasks are switched in without
+ * vTaskSwitchContext(), so they are not timed, and the other ready tasks are
+ * timed from here, once the run time counter is running.
  */
-portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+#if ( configUSE_TASK_LATENCY_STATS == 1 )
+    void vTaskStartLatencyStats( void ) PRIVILEGED_FUNCTION;
+#endif
 
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
@@ -3024,6 +3249,14 @@ TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t xTaskGetCurrentTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * Return the handle of the task running on core xCoreID.
+ */
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Shortcut used by the queue implementation to prevent unnecessary call to
  * taskYIELD();
@@ -3109,6 +3342,19 @@ TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
  */
 void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * For internal use only.  The SMP critical section, which takes the inter-core
+ * kernel locks in addition to masking interrupts on the calling core.  These
+ * are what portENTER_CRITICAL() and friends map to in a multicore build.
+ */
+    void vTaskEnterCritical( void ) PRIVILEGED_FUNCTION;
+    void vTaskExitCritical( void ) PRIVILEGED_FUNCTION;
+    UBaseType_t vTaskEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+#endif
+
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
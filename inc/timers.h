@@ -1323,6 +1323,69 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_ISR_TIMERS == 1 )
+
+/**
+ * void vTimerSetISRContext( TimerHandle_t xTimer, configRUN_TIME_COUNTER_TYPE xCallbackBudget );
+ *
+ * Moves a timer from the timer service task to the tick interrupt.  The
+ * callback of the timer is then called from within the tick interrupt on the
+ * tick the timer expires on, without a command queue round trip and a context
+ * switch to the timer service task, which makes it suitable for high rate
+ * periodic work that has to run with little jitter.
+ *
+ * The callback runs in interrupt context with the kernel locked, so it must
+ * only call the interrupt safe API functions (those that end in "FromISR"), it
+ * must never block and it should be as short as possible as it delays the tick
+ * and every interrupt of the same or lower priority.  A task unblocked by the
+ * callback is switched to when the tick interrupt exits.
+ *
+ * Every execution of the callback is timed with the run time statistics counter
+ * (portGET_RUN_TIME_COUNTER_VALUE()).  An execution that takes longer than
+ * xCallbackBudget is counted as an overrun and reported through the
+ * traceTIMER_BUDGET_EXCEEDED() macro, see vTimerGetISRCallbackStats().
+ *
+ * The commands for the timer (xTimerStart(), xTimerStop(), xTimerReset(),
+ * xTimerChangePeriod(), xTimerDelete() and their FromISR versions) are applied
+ * straight away instead of being sent to the timer service task, they never
+ * block and always succeed.
+ *
+ * vTimerSetISRContext() must be called while the timer is dormant, before it
+ * is started for the first time.  A start command that only reached the timer
+ * command queue, because the scheduler was not running or was suspended, is
+ * applied to the tick interrupt once the timer service task receives it.
+ *
+ * configUSE_ISR_TIMERS must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * @param xTimer The handle of the timer being moved to the tick interrupt.
+ *
+ * @param xCallbackBudget The longest time, in run time counter units, one
+ * execution of the callback is expected to take.
+ */
+    void vTimerSetISRContext( TimerHandle_t xTimer,
+                              const configRUN_TIME_COUNTER_TYPE xCallbackBudget ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTimerGetISRCallbackStats( TimerHandle_t xTimer, configRUN_TIME_COUNTER_TYPE * pxLongestCallback, UBaseType_t * puxBudgetOverruns );
+ *
+ * Queries the execution time statistics of the callback of a timer moved to
+ * the tick interrupt with vTimerSetISRContext().
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @param pxLongestCallback Used to return the longest time, in run time counter
+ * units, an execution of the callback has taken so far.
+ *
+ * @param puxBudgetOverruns Used to return the number of executions of the
+ * callback that took longer than the budget set by vTimerSetISRContext().
+ */
+    void vTimerGetISRCallbackStats( TimerHandle_t xTimer,
+                                    configRUN_TIME_COUNTER_TYPE * const pxLongestCallback,
+                                    UBaseType_t * const puxBudgetOverruns ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_ISR_TIMERS */
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
@@ -1334,6 +1397,22 @@ BaseType_t xTimerGenericCommand( TimerHandle_t xTimer,
                                  BaseType_t * const pxHigherPriorityTaskWoken,
                                  const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_ISR_TIMERS == 1 )
+
+/*
+ * Called by xTaskIncrementTick() with the new tick count to call the callbacks
+ * of the ISR context timers that expire on that tick.
+ */
+    void vTimerProcessISRTimers( const TickType_t xTickCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the tickless idle code of tasks.c, returns the number of ticks
+ * from xTickCount to the expiry of the next ISR context timer, portMAX_DELAY if
+ * no ISR context timer is active.
+ */
+    TickType_t xTimerGetTicksToNextISRTimer( const TickType_t xTickCount ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_TRACE_FACILITY == 1 )
     void vTimerSetTimerNumber( TimerHandle_t xTimer,
                                UBaseType_t uxTimerNumber ) PRIVILEGED_FUNCTION;
@@ -53,10 +53,208 @@ extern void vPortYield(void);
 extern void vPortSVCHandler();
 extern void vPortPendSVHandler();
 extern void vPortSysTickHandler();
+extern void vPortTicklessAlarmHandler();
 
 /* start the first task */
 extern void vPortStartFirstTask(void);
 
+/* install an interrupt handler, through the run time dispatcher when enabled */
+extern void vPortSetInterruptHandler(int32_t xIRQn, void (*pxHandler)(void));
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+/* the 64-bit RP2040 timer is the run time counter, one count per microsecond */
+extern void vPortConfigureRunTimeCounter(void);
+extern uint64_t ulPortGetRunTimeCounterValue(void);
+
+#if ( configUSE_ISR_RUN_TIME_STATS == 1 )
+/* 16 system exceptions followed by the 26 RP2040 interrupts */
+#define portNUM_EXCEPTIONS              ( 16 + 26 )
+
+/* time spent in one interrupt handler, in microseconds */
+typedef struct {
+    uint32_t ulCount;           /* number of times the handler executed */
+    uint32_t ulMaxTime;         /* longest execution of the handler */
+    uint64_t ulTotalTime;       /* accumulated execution time, without the nested interrupts */
+} PortIsrRunTime_t;
+
+/* read and clear the interrupt statistics, indexed by exception number */
+extern void vPortGetIsrRunTimeStats(uint32_t ulCoreID, PortIsrRunTime_t *pxRunTimes);
+extern void vPortResetIsrRunTimeStats(void);
+#endif
+#endif
+
+#if ( configUSE_NVIC_PRIORITY_MASKING == 1 )
+/* mask only the interrupts that may call the kernel, see configMAX_SYSCALL_INTERRUPT_PRIORITY */
+extern void vPortUpdateKernelInterruptMask(void);
+extern uint32_t ulPortMaskKernelInterrupts(void);
+extern void vPortUnmaskKernelInterrupts(uint32_t ulMask);
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+/* critical nesting counters maintained by the kernel, one per core */
+extern uint32_t uxCriticalNestings[];
+
+/* recursive inter-core lock used by the kernel */
+extern void vPortRecursiveLock(uint32_t ulLockNum, int32_t xAcquire);
+
+#if ( configUSE_SPINLOCK_STATS == 1 )
+/* usage of one kernel lock, the times are in microseconds */
+typedef struct {
+    uint32_t ulAcquireCount;    /* outermost acquisitions of the lock */
+    uint32_t ulContendedCount;  /* acquisitions that had to wait for the other core */
+    uint32_t ulMaxHoldTime;     /* longest time the lock was held */
+    uint32_t ulTotalHoldTime;   /* accumulated time the lock was held */
+} PortSpinlockStats_t;
+
+/* read and clear the kernel lock statistics */
+extern void vPortGetSpinlockStats(uint32_t ulLockNum, PortSpinlockStats_t *pxStats);
+extern void vPortResetSpinlockStats(void);
+#endif
+
+/* yield the task running on the given core */
+extern void vPortYieldCore(int32_t xCoreID);
+
+/* inter-core doorbell handler */
+extern void vPortFifoHandler();
+
+/* start core 1 and let it enter the scheduler */
+extern void vPortLaunchCore1(void);
+#endif
+
+#if ( configUSE_CRITICAL_SECTION_STATS == 1 )
+/* buckets of the critical section histogram: 0 us, 1 us, 2-3 us, ... 64 us and more */
+#define portCRITICAL_SECTION_BUCKETS    8
+
+/* time the interrupts were masked by the critical sections of one call site, in microseconds */
+typedef struct {
+    uint32_t ulSite;            /* return address of the outermost vPortEnterCritical() call */
+    uint32_t ulCount;           /* number of critical sections */
+    uint32_t ulMaxTime;         /* longest critical section */
+    uint32_t ulTotalTime;       /* accumulated time of the critical sections */
+    uint32_t ulHistogram[portCRITICAL_SECTION_BUCKETS]; /* critical sections by length, log2 buckets */
+} PortCriticalSectionStats_t;
+
+/* called by vPortEnterCritical() and vPortExitCritical() with the interrupts masked */
+extern void vPortCriticalSectionEntered(uint32_t ulSite);
+extern void vPortCriticalSectionExited(void);
+
+/* read and clear the critical section statistics */
+extern uint32_t ulPortGetCriticalSectionStats(PortCriticalSectionStats_t *pxStats, uint32_t ulMaxSites, uint32_t *pulDropped);
+extern void vPortResetCriticalSectionStats(void);
+#endif
+
+#if ( configUSE_DMA_COPY == 1 )
+/* bulk copies of the queues and stream buffers through a reserved DMA channel */
+extern void vPortDmaCopyInit(void);
+extern void *pvPortDmaCopy(void *pvDest, const void *pvSrc, size_t xLength);
+#endif
+
+#if ( configUSE_CORE_MAILBOX == 1 )
+/* one direction of an inter-core mailbox, the messages are copied through a ring of slots */
+typedef struct {
+    volatile uint32_t ulHead;           /* next slot to write, changed only by the sender */
+    volatile uint32_t ulTail;           /* next slot to read, changed only by the receiver */
+    uint32_t ulSlots;                   /* slots in the ring, one more than the mailbox length */
+    uint32_t ulMessageSize;             /* size of one message in bytes */
+    uint8_t *pucStorage;                /* the ring, ulSlots * ulMessageSize bytes */
+    void * volatile pvWaitingTask;      /* receiving task blocked on the empty mailbox */
+    volatile uint32_t ulWaitingCore;    /* core the receiving task blocked on */
+} PortMailbox_t;
+
+/* fixed size messages between the cores, the FIFO carries the doorbells */
+extern int32_t xPortMailboxInit(PortMailbox_t *pxMailbox, uint8_t *pucStorage, uint32_t ulLength, uint32_t ulMessageSize);
+extern int32_t xPortMailboxSend(PortMailbox_t *pxMailbox, const void *pvMessage);
+extern int32_t xPortMailboxReceive(PortMailbox_t *pxMailbox, void *pvMessage, uint32_t ulTicksToWait);
+extern uint32_t ulPortMailboxMessagesWaiting(const PortMailbox_t *pxMailbox);
+
+/* wake the receivers after a doorbell, called by the FIFO interrupt */
+extern void vPortMailboxDoorbell(void);
+
+#if ( configNUMBER_OF_CORES == 1 )
+/* core 1 runs outside of the scheduler, the FIFO interrupt of core 0 takes the doorbells */
+extern void vPortMailboxStart(void);
+#endif
+#endif
+
+#if ( configUSE_HR_TIMERS == 1 )
+/* microsecond timer expired by the timer alarm interrupt, the active timers are linked in deadline order */
+typedef struct PortHrTimer {
+    struct PortHrTimer *pxNext;         /* next active timer to expire */
+    uint64_t ullDeadline;               /* time of the next expiry, in microseconds */
+    uint32_t ulPeriod;                  /* period in microseconds, 0 for a one-shot timer */
+    uint32_t ulMissed;                  /* expiries of a periodic timer skipped because they were late */
+    void (*pxCallback)(struct PortHrTimer *pxTimer);    /* called from the alarm interrupt, may be NULL */
+    void *pvTask;                       /* task notified on every expiry, may be NULL */
+    volatile uint32_t ulActive;         /* the timer is linked in the active list */
+} PortHrTimer_t;
+
+/* microsecond timers independent of the tick, multiplexed onto configHR_TIMER_ALARM */
+extern void vPortConfigureHrTimers(void);
+extern uint64_t ullPortHrTimerNow(void);
+extern void vPortHrTimerInit(PortHrTimer_t *pxTimer, void (*pxCallback)(PortHrTimer_t *pxTimer), void *pvTask);
+extern void vPortHrTimerStart(PortHrTimer_t *pxTimer, uint32_t ulDelay, uint32_t ulPeriod);
+extern void vPortHrTimerStartAt(PortHrTimer_t *pxTimer, uint64_t ullDeadline, uint32_t ulPeriod);
+extern void vPortHrTimerStop(PortHrTimer_t *pxTimer);
+extern void vPortHrTimerDelay(uint32_t ulDelay);
+extern void vPortHrTimerDelayUntil(uint64_t *pullPreviousWakeTime, uint32_t ulPeriod);
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+/* kernel events recorded in the trace rings, see portmacro.h */
+#define portTRACE_TASK_SWITCHED_IN      1
+#define portTRACE_TICK                  2
+#define portTRACE_TASK_CREATE           3
+#define portTRACE_TASK_NAME             4
+#define portTRACE_TASK_DELETE           5
+#define portTRACE_TASK_READY            6
+#define portTRACE_TASK_NOTIFY           7
+#define portTRACE_QUEUE_CREATE          8
+#define portTRACE_QUEUE_SEND            9
+#define portTRACE_QUEUE_RECEIVE         10
+#define portTRACE_QUEUE_SEND_FROM_ISR   11
+#define portTRACE_QUEUE_RECEIVE_FROM_ISR 12
+#define portTRACE_QUEUE_BLOCK_SEND      13
+#define portTRACE_QUEUE_BLOCK_RECEIVE   14
+#define portTRACE_TIMER_EXPIRED         15
+#define portTRACE_USER                  16
+
+/* "FRTR" at the start of each ring, found by the host decoder in a RAM dump */
+#define portTRACE_MAGIC                 0x52545246UL
+#define portTRACE_VERSION               1U
+
+/* one event: the low 32 bits of the 1 MHz timer, the event number in the top
+byte and a 24 bit parameter, an SRAM address offset or a value */
+typedef struct {
+    uint32_t ulTimestamp;
+    uint32_t ulEvent;
+} PortTraceEvent_t;
+
+/* ring written by one core, the oldest events are overwritten */
+typedef struct {
+    uint32_t ulMagic;
+    uint16_t usVersion;
+    uint16_t usCoreID;
+    uint32_t ulEventCount;      /* number of entries in xEvents, a power of two */
+    volatile uint32_t ulStopped;    /* no events are recorded while not zero */
+    volatile uint32_t ulHead;   /* number of events recorded since the last clear */
+    PortTraceEvent_t xEvents[configTRACE_BUFFER_EVENTS];
+} PortTraceRing_t;
+
+/* trace rings, one per core */
+extern PortTraceRing_t xPortTraceRings[];
+
+/* control of the trace rings */
+extern void vPortTraceStart(void);
+extern void vPortTraceStop(void);
+extern void vPortTraceClear(void);
+
+/* record the creation of a task with its name */
+extern void vPortTraceTaskCreate(const void *pxTCB, const char *pcName);
+
+/* processor cycles taken by the record of one event, measured on this core */
+extern uint32_t ulPortTraceMeasureCycles(void);
+#endif
+
 /* svc C handler */
 extern void vPortServiceHandler(uint32_t *svc_args);
 
@@ -0,0 +1,155 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Based on original M0+rp2040 port from http://www.FreeRTOS.org             |
+ |___________________________________________________________________________*/
+
+#include <string.h>
+#include "picortos.h"
+#include "cmsis_rp2040.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+#include "portmacro.h"
+
+#if ( configUSE_CRITICAL_SECTION_STATS == 1 )
+
+/* low word of the RP2040 1 MHz timer */
+#define portTIMER_TIMERAWL              ( *( ( volatile uint32_t * ) ( 0x40054000UL + 0x028UL ) ) )
+
+/* one entry per call site, open addressing on the return address */
+static PortCriticalSectionStats_t xSiteStats[configCRITICAL_SECTION_SITES];
+
+/* critical sections not recorded because all the entries were taken */
+static uint32_t ulDroppedSections = 0;
+
+/* the outermost critical section in progress */
+static uint32_t ulEnteredFrom = 0;
+static uint32_t ulEnteredAt = 0;
+
+/**
+ * @brief Start timing the outermost critical section.
+ *
+ * Called by vPortEnterCritical() once the interrupts are masked.
+ *
+ * @param ulSite      return address of the vPortEnterCritical() call
+ */
+void vPortCriticalSectionEntered(uint32_t ulSite)
+{
+    ulEnteredFrom = ulSite;
+    ulEnteredAt = portTIMER_TIMERAWL;
+}
+
+/**
+ * @brief Charge the outermost critical section to its call site.
+ *
+ * Called by vPortExitCritical() before the interrupts are unmasked. The time
+ * is taken first, the bookkeeping that follows is not part of it.
+ */
+void vPortCriticalSectionExited(void)
+{
+    const uint32_t ulTime = portTIMER_TIMERAWL - ulEnteredAt;
+    uint32_t ulIndex = (ulEnteredFrom >> 1) % configCRITICAL_SECTION_SITES;
+    uint32_t ulProbes, ulBucket, ulLength;
+    PortCriticalSectionStats_t *pxStats;
+
+    for (ulProbes = 0; ulProbes < configCRITICAL_SECTION_SITES; ulProbes++) {
+        pxStats = &xSiteStats[ulIndex];
+        if ((pxStats->ulSite == ulEnteredFrom) || (pxStats->ulSite == 0)) {
+            break;
+        }
+        ulIndex = (ulIndex + 1 < configCRITICAL_SECTION_SITES) ? ulIndex + 1 : 0;
+    }
+
+    if (ulProbes == configCRITICAL_SECTION_SITES) {
+        ulDroppedSections++;
+        return;
+    }
+
+    /* 0 us, 1 us, 2-3 us, 4-7 us ... the last bucket takes the rest */
+    ulBucket = 0;
+    for (ulLength = ulTime; (ulLength != 0) && (ulBucket < portCRITICAL_SECTION_BUCKETS - 1); ulLength >>= 1) {
+        ulBucket++;
+    }
+
+    pxStats->ulSite = ulEnteredFrom;
+    pxStats->ulCount++;
+    pxStats->ulTotalTime += ulTime;
+    pxStats->ulHistogram[ulBucket]++;
+    if (ulTime > pxStats->ulMaxTime) {
+        pxStats->ulMaxTime = ulTime;
+    }
+}
+
+/**
+ * @brief Get a copy of the statistics of the call sites.
+ *
+ * The copy is taken inside a critical section so the figures are consistent
+ * with each other. The critical section of this call is itself recorded once
+ * the copy is done. The sites are in no particular order.
+ *
+ * @param pxStats     the statistics are copied here
+ * @param ulMaxSites  number of entries of pxStats
+ * @param pulDropped  receives the number of critical sections that found no
+ *                    free entry, may be NULL
+ * @return the number of entries copied
+ */
+uint32_t ulPortGetCriticalSectionStats(PortCriticalSectionStats_t *pxStats, uint32_t ulMaxSites, uint32_t *pulDropped)
+{
+    uint32_t ulIndex, ulCopied = 0;
+
+    configASSERT(pxStats != NULL);
+
+    taskENTER_CRITICAL();
+    {
+        for (ulIndex = 0; (ulIndex < configCRITICAL_SECTION_SITES) && (ulCopied < ulMaxSites); ulIndex++) {
+            if (xSiteStats[ulIndex].ulSite != 0) {
+                pxStats[ulCopied++] = xSiteStats[ulIndex];
+            }
+        }
+
+        if (pulDropped != NULL) {
+            *pulDropped = ulDroppedSections;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return ulCopied;
+}
+
+/**
+ * @brief Clear the statistics of all call sites.
+ *
+ */
+void vPortResetCriticalSectionStats(void)
+{
+    taskENTER_CRITICAL();
+    {
+        memset(xSiteStats, 0, sizeof(xSiteStats));
+        ulDroppedSections = 0;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* configUSE_CRITICAL_SECTION_STATS */
@@ -0,0 +1,214 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 08.Jan.2023  |
+ |  Based on original M0+rp2040 port from http://www.FreeRTOS.org             |
+ |___________________________________________________________________________*/
+
+#include <string.h>
+#include "picortos.h"
+#include "cmsis_rp2040.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+#include "portmacro.h"
+
+#if ( configUSE_DMA_COPY == 1 )
+
+/* RP2040 DMA, the registers of the reserved channel and the shared interrupt registers */
+#define portDMA_BASE                    ( 0x50000000UL )
+#define portDMA_CH_BASE                 ( portDMA_BASE + ( configDMA_COPY_CHANNEL * 0x40UL ) )
+#define portDMA_READ_ADDR               ( *( ( volatile uint32_t * ) ( portDMA_CH_BASE + 0x000UL ) ) )
+#define portDMA_WRITE_ADDR              ( *( ( volatile uint32_t * ) ( portDMA_CH_BASE + 0x004UL ) ) )
+#define portDMA_TRANS_COUNT             ( *( ( volatile uint32_t * ) ( portDMA_CH_BASE + 0x008UL ) ) )
+#define portDMA_CTRL_TRIG               ( *( ( volatile uint32_t * ) ( portDMA_CH_BASE + 0x00cUL ) ) )
+#define portDMA_INTR                    ( *( ( volatile uint32_t * ) ( portDMA_BASE + 0x400UL ) ) )
+#define portDMA_INTE_SET                ( *( ( volatile uint32_t * ) ( portDMA_BASE + 0x2000UL + 0x404UL + ( configDMA_COPY_IRQ * 0x10UL ) ) ) )
+#define portDMA_INTE_CLR                ( *( ( volatile uint32_t * ) ( portDMA_BASE + 0x3000UL + 0x404UL + ( configDMA_COPY_IRQ * 0x10UL ) ) ) )
+#define portDMA_INTS                    ( *( ( volatile uint32_t * ) ( portDMA_BASE + 0x40cUL + ( configDMA_COPY_IRQ * 0x10UL ) ) ) )
+
+#define portDMA_CTRL_EN                 ( 1UL << 0 )
+#define portDMA_CTRL_DATA_SIZE_WORD     ( 2UL << 2 )
+#define portDMA_CTRL_INCR_READ          ( 1UL << 4 )
+#define portDMA_CTRL_INCR_WRITE         ( 1UL << 5 )
+#define portDMA_CTRL_CHAIN_TO_SELF      ( ( uint32_t ) configDMA_COPY_CHANNEL << 11 )
+#define portDMA_CTRL_TREQ_UNPACED       ( 0x3fUL << 15 )
+#define portDMA_CTRL_BUSY               ( 1UL << 24 )
+
+#define portDMA_CHANNEL_BIT             ( 1UL << configDMA_COPY_CHANNEL )
+#define portDMA_IRQn                    ( ( IRQn_Type ) ( DMA_IRQ_0_IRQn + configDMA_COPY_IRQ ) )
+
+/* a task may sleep during the copy only outside of the critical sections */
+#if ( configNUMBER_OF_CORES > 1 )
+#define portDMA_CRITICAL_NESTING()      portGET_CRITICAL_NESTING_COUNT()
+#else
+#define portDMA_CRITICAL_NESTING()      uxCriticalNesting
+#endif
+
+/* memory to memory copy of 32-bit words, as fast as the bus allows */
+#define portDMA_COPY_CTRL               ( portDMA_CTRL_EN | portDMA_CTRL_DATA_SIZE_WORD | portDMA_CTRL_INCR_READ | \
+                                          portDMA_CTRL_INCR_WRITE | portDMA_CTRL_CHAIN_TO_SELF | portDMA_CTRL_TREQ_UNPACED )
+
+/* set while a copy owns the channel */
+static volatile BaseType_t xChannelBusy = pdFALSE;
+
+/* task blocked until the running copy completes */
+static TaskHandle_t volatile xWaitingTask = NULL;
+
+/**
+ * @brief Handler of the DMA interrupt used for the copies of blocked tasks.
+ *
+ */
+static void prvDmaCopyHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    portDMA_INTS = portDMA_CHANNEL_BIT;
+    if (xWaitingTask != NULL) {
+        vTaskNotifyGiveIndexedFromISR(xWaitingTask, configDMA_COPY_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+        xWaitingTask = NULL;
+    }
+    if (xHigherPriorityTaskWoken != pdFALSE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * @brief Take the channel if no other copy is using it.
+ *
+ * @return pdTRUE if the channel was free
+ */
+static BaseType_t prvClaimChannel(void)
+{
+    BaseType_t xClaimed = pdFALSE;
+    UBaseType_t uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+    if (xChannelBusy == pdFALSE) {
+        xChannelBusy = pdTRUE;
+        xClaimed = pdTRUE;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+    return xClaimed;
+}
+
+/**
+ * @brief Check if the caller is a task that may block for the copy.
+ *
+ * @return pdTRUE for a task running with the scheduler active and outside of
+ * any critical section
+ */
+static BaseType_t prvCallerCanBlock(void)
+{
+    return ((__get_IPSR() == 0) && (__get_PRIMASK() == 0) &&
+            (portDMA_CRITICAL_NESTING() == 0) &&
+            (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)) ? pdTRUE : pdFALSE;
+}
+
+/**
+ * @brief Prepare the reserved DMA channel and its interrupt.
+ *
+ */
+void vPortDmaCopyInit(void)
+{
+    portDMA_INTE_CLR = portDMA_CHANNEL_BIT;
+    portDMA_INTR = portDMA_CHANNEL_BIT;
+    vPortSetInterruptHandler(portDMA_IRQn, prvDmaCopyHandler);
+    NVIC_SetPriority(portDMA_IRQn, configDMA_COPY_INTERRUPT_PRIORITY);
+    NVIC_ClearPendingIRQ(portDMA_IRQn);
+    NVIC_EnableIRQ(portDMA_IRQn);
+}
+
+/**
+ * @brief Copy memory through the reserved DMA channel.
+ *
+ * Called by portMEMCPY() for the copies of at least configDMA_COPY_THRESHOLD
+ * bytes. The DMA moves 32-bit words, so the source and the destination must
+ * share the same alignment, the unaligned head and tail bytes are copied by
+ * the CPU. A task outside of any critical section copying at least
+ * configDMA_COPY_BLOCK_THRESHOLD bytes blocks until the DMA interrupt, every
+ * other caller waits for the channel to finish. The CPU copies everything when
+ * the channel is in use or the alignment does not match.
+ *
+ * @param pvDest      destination of the copy
+ * @param pvSrc       source of the copy
+ * @param xLength     number of bytes to copy
+ * @return pvDest
+ */
+void *pvPortDmaCopy(void *pvDest, const void *pvSrc, size_t xLength)
+{
+    uint8_t *pucDest = (uint8_t *)pvDest;
+    const uint8_t *pucSrc = (const uint8_t *)pvSrc;
+    size_t xHead, xWords;
+
+    if ((((uint32_t)pucDest ^ (uint32_t)pucSrc) & 3UL) != 0) {
+        return memcpy(pvDest, pvSrc, xLength);
+    }
+
+    xHead = (4UL - ((uint32_t)pucDest & 3UL)) & 3UL;
+    xWords = (xLength - xHead) / 4UL;
+    if ((xLength < xHead) || (xWords == 0) || (prvClaimChannel() == pdFALSE)) {
+        return memcpy(pvDest, pvSrc, xLength);
+    }
+
+    /* bytes up to the first word boundary */
+    memcpy(pucDest, pucSrc, xHead);
+    pucDest += xHead;
+    pucSrc += xHead;
+
+    if ((xLength >= configDMA_COPY_BLOCK_THRESHOLD) && (prvCallerCanBlock() == pdTRUE)) {
+        /* sleep until the interrupt of the channel wakes the task */
+        (void)xTaskNotifyStateClearIndexed(NULL, configDMA_COPY_NOTIFY_INDEX);
+        xWaitingTask = xTaskGetCurrentTaskHandle();
+        portDMA_INTR = portDMA_CHANNEL_BIT;
+        portDMA_INTE_SET = portDMA_CHANNEL_BIT;
+
+        portDMA_READ_ADDR = (uint32_t)pucSrc;
+        portDMA_WRITE_ADDR = (uint32_t)pucDest;
+        portDMA_TRANS_COUNT = xWords;
+        portDMA_CTRL_TRIG = portDMA_COPY_CTRL;
+
+        (void)ulTaskNotifyTakeIndexed(configDMA_COPY_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+        portDMA_INTE_CLR = portDMA_CHANNEL_BIT;
+    } else {
+        /* the DMA still moves the words faster than the CPU */
+        portDMA_READ_ADDR = (uint32_t)pucSrc;
+        portDMA_WRITE_ADDR = (uint32_t)pucDest;
+        portDMA_TRANS_COUNT = xWords;
+        portDMA_CTRL_TRIG = portDMA_COPY_CTRL;
+
+        while (portDMA_CTRL_TRIG & portDMA_CTRL_BUSY) {
+        }
+        portDMA_INTR = portDMA_CHANNEL_BIT;
+    }
+    __DMB();
+
+    xChannelBusy = pdFALSE;
+
+    /* bytes after the last whole word */
+    memcpy(pucDest + (xWords * 4UL), pucSrc + (xWords * 4UL), xLength - xHead - (xWords * 4UL));
+
+    return pvDest;
+}
+
+#endif /* configUSE_DMA_COPY */
@@ -51,3 +51,11 @@ void __attribute__((weak)) vApplicationTickHook() { }
  *
  */
 void __attribute__((weak)) vApplicationIdleHook(void) { }
+
+/**
+ *  vApplicationPassiveIdleHook() will only be called if
+ *  configUSE_PASSIVE_IDLE_HOOK is set to 1 in FreeRTOSConfig.h.  It is called
+ *  on each iteration of the passive idle task of core 1 and must not block
+ *  either.
+ */
+void __attribute__((weak)) vApplicationPassiveIdleHook(void) { }
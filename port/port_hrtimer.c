@@ -0,0 +1,372 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Based on original M0+rp2040 port from http://www.FreeRTOS.org             |
+ |___________________________________________________________________________*/
+
+#include "picortos.h"
+#include "cmsis_rp2040.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+#include "portmacro.h"
+
+#if ( configUSE_HR_TIMERS == 1 )
+
+/* RP2040 timer, a 64-bit counter incremented every microsecond with four 32-bit alarms */
+#define portTIMER_BASE                  ( 0x40054000UL )
+#define portTIMER_ALARM(n)              ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x010UL + ( ( n ) * 4UL ) ) ) )
+#define portTIMER_ARMED                 ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x020UL ) ) )
+#define portTIMER_TIMERAWH              ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x024UL ) ) )
+#define portTIMER_TIMERAWL              ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x028UL ) ) )
+#define portTIMER_INTR                  ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x034UL ) ) )
+#define portTIMER_INTE_SET              ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x2000UL + 0x038UL ) ) )
+#define portTIMER_INTF_SET              ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x2000UL + 0x03cUL ) ) )
+#define portTIMER_INTF_CLR              ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x3000UL + 0x03cUL ) ) )
+
+#define portHR_TIMER_ALARM_BIT          ( 1UL << configHR_TIMER_ALARM )
+#define portHR_TIMER_ALARM_IRQn         ( ( IRQn_Type ) ( TIMER_IRQ_0_IRQn + configHR_TIMER_ALARM ) )
+
+/* the alarm compares only the low 32 bits of the timer, farther deadlines are approached in steps */
+#define portHR_TIMER_MAX_ALARM_DELAY    ( 0x7fffffffULL )
+
+/* active timers, the one that expires first at the head */
+static PortHrTimer_t *pxActiveHrTimers = NULL;
+
+/**
+ * @brief Link a timer in the active list, in deadline order.
+ *
+ * Timers with the same deadline expire in the order they were started. Must
+ * be called with the list locked.
+ *
+ * @param pxTimer     the timer, not linked in the list
+ */
+static void prvInsertHrTimer(PortHrTimer_t *pxTimer)
+{
+    PortHrTimer_t **ppxLink = &pxActiveHrTimers;
+
+    while ((*ppxLink != NULL) && ((*ppxLink)->ullDeadline <= pxTimer->ullDeadline)) {
+        ppxLink = &((*ppxLink)->pxNext);
+    }
+
+    pxTimer->pxNext = *ppxLink;
+    *ppxLink = pxTimer;
+    pxTimer->ulActive = 1;
+}
+
+/**
+ * @brief Unlink a timer from the active list if it is linked.
+ *
+ * Must be called with the list locked.
+ *
+ * @param pxTimer     the timer
+ */
+static void prvRemoveHrTimer(PortHrTimer_t *pxTimer)
+{
+    PortHrTimer_t **ppxLink = &pxActiveHrTimers;
+
+    if (pxTimer->ulActive) {
+        while ((*ppxLink != NULL) && (*ppxLink != pxTimer)) {
+            ppxLink = &((*ppxLink)->pxNext);
+        }
+        if (*ppxLink != NULL) {
+            *ppxLink = pxTimer->pxNext;
+        }
+        pxTimer->pxNext = NULL;
+        pxTimer->ulActive = 0;
+    }
+}
+
+/**
+ * @brief Program the alarm for the timer at the head of the active list.
+ *
+ * The alarm fires only when the low word of the timer matches it exactly, so
+ * a deadline that has already passed, or passes while the alarm is written,
+ * forces the interrupt instead. Must be called with the list locked.
+ */
+static void prvProgramHrTimerAlarm(void)
+{
+    uint64_t ullNow, ullTarget;
+
+    if (pxActiveHrTimers == NULL) {
+        /* writing the bit to ARMED disarms the alarm */
+        portTIMER_ARMED = portHR_TIMER_ALARM_BIT;
+        return;
+    }
+
+    ullNow = ullPortHrTimerNow();
+    ullTarget = pxActiveHrTimers->ullDeadline;
+    if (ullTarget > ullNow + portHR_TIMER_MAX_ALARM_DELAY) {
+        /* the interrupt only reprograms the alarm when it gets there */
+        ullTarget = ullNow + portHR_TIMER_MAX_ALARM_DELAY;
+    }
+
+    /* writing the alarm register arms it */
+    portTIMER_ALARM(configHR_TIMER_ALARM) = (uint32_t)ullTarget;
+
+    if (ullPortHrTimerNow() >= ullTarget) {
+        portTIMER_INTF_SET = portHR_TIMER_ALARM_BIT;
+    }
+}
+
+/**
+ * @brief Handler for the timer alarm that expires the microsecond timers.
+ *
+ * Every timer whose deadline has passed is unlinked, a periodic timer is
+ * linked again for its next period before its callback is called. Expiries
+ * that were missed because the interrupt ran late are skipped and counted so a
+ * periodic timer keeps its phase.
+ */
+static void prvHrTimerAlarmHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    UBaseType_t uxSavedInterruptStatus;
+    PortHrTimer_t *pxTimer;
+    uint64_t ullNow, ullLate;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        portTIMER_INTF_CLR = portHR_TIMER_ALARM_BIT;
+        portTIMER_INTR = portHR_TIMER_ALARM_BIT;
+
+        ullNow = ullPortHrTimerNow();
+        while ((pxActiveHrTimers != NULL) && (pxActiveHrTimers->ullDeadline <= ullNow)) {
+            pxTimer = pxActiveHrTimers;
+            pxActiveHrTimers = pxTimer->pxNext;
+            pxTimer->pxNext = NULL;
+            pxTimer->ulActive = 0;
+
+            if (pxTimer->ulPeriod != 0) {
+                pxTimer->ullDeadline += pxTimer->ulPeriod;
+                if (pxTimer->ullDeadline <= ullNow) {
+                    ullLate = ((ullNow - pxTimer->ullDeadline) / pxTimer->ulPeriod) + 1;
+                    pxTimer->ullDeadline += ullLate * pxTimer->ulPeriod;
+                    pxTimer->ulMissed += (uint32_t)ullLate;
+                }
+                prvInsertHrTimer(pxTimer);
+            }
+
+            /* the callback may start or stop timers, the list is already consistent */
+            if (pxTimer->pxCallback != NULL) {
+                pxTimer->pxCallback(pxTimer);
+            }
+            if (pxTimer->pvTask != NULL) {
+                vTaskNotifyGiveIndexedFromISR((TaskHandle_t)pxTimer->pvTask, configHR_TIMER_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+            }
+        }
+
+        prvProgramHrTimerAlarm();
+    }
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+    if (xHigherPriorityTaskWoken != pdFALSE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * @brief Install the alarm interrupt, called when the scheduler starts.
+ *
+ * The interrupt runs on core 0. Timers started before the scheduler are
+ * expired as soon as the interrupts are enabled.
+ */
+void vPortConfigureHrTimers(void)
+{
+    portTIMER_INTF_CLR = portHR_TIMER_ALARM_BIT;
+    portTIMER_INTR = portHR_TIMER_ALARM_BIT;
+    portTIMER_INTE_SET = portHR_TIMER_ALARM_BIT;
+
+    vPortSetInterruptHandler(portHR_TIMER_ALARM_IRQn, prvHrTimerAlarmHandler);
+    NVIC_SetPriority(portHR_TIMER_ALARM_IRQn, configHR_TIMER_INTERRUPT_PRIORITY);
+    NVIC_ClearPendingIRQ(portHR_TIMER_ALARM_IRQn);
+    NVIC_EnableIRQ(portHR_TIMER_ALARM_IRQn);
+
+    if (pxActiveHrTimers != NULL) {
+        portTIMER_INTF_SET = portHR_TIMER_ALARM_BIT;
+    }
+}
+
+/**
+ * @brief Read the 64-bit microsecond timer.
+ *
+ * The raw registers are read, the low word is read again if the high word
+ * changed in between.
+ *
+ * @return the time in microseconds since the timer was started
+ */
+uint64_t ullPortHrTimerNow(void)
+{
+    uint32_t ulHigh, ulLow, ulNextHigh;
+
+    ulHigh = portTIMER_TIMERAWH;
+    for (;;) {
+        ulLow = portTIMER_TIMERAWL;
+        ulNextHigh = portTIMER_TIMERAWH;
+        if (ulNextHigh == ulHigh) {
+            break;
+        }
+        ulHigh = ulNextHigh;
+    }
+
+    return ((uint64_t)ulHigh << 32) | ulLow;
+}
+
+/**
+ * @brief Prepare a microsecond timer.
+ *
+ * The callback is called from the alarm interrupt with the kernel locked, it
+ * must be short and may only use the FromISR functions. The task, when given,
+ * is notified through configHR_TIMER_NOTIFY_INDEX on every expiry, so a task
+ * can run at the rate of a periodic timer by taking that notification.
+ *
+ * @param pxTimer     the timer, it must stay valid while it is active
+ * @param pxCallback  function called on every expiry, or NULL
+ * @param pvTask      task notified on every expiry, or NULL
+ */
+void vPortHrTimerInit(PortHrTimer_t *pxTimer, void (*pxCallback)(PortHrTimer_t *pxTimer), void *pvTask)
+{
+    configASSERT(pxTimer);
+
+    pxTimer->pxNext = NULL;
+    pxTimer->ullDeadline = 0;
+    pxTimer->ulPeriod = 0;
+    pxTimer->ulMissed = 0;
+    pxTimer->pxCallback = pxCallback;
+    pxTimer->pvTask = pvTask;
+    pxTimer->ulActive = 0;
+}
+
+/**
+ * @brief Start or restart a timer to expire at an absolute time.
+ *
+ * May be called from tasks, interrupts and timer callbacks.
+ *
+ * @param pxTimer      the timer
+ * @param ullDeadline  time of the first expiry, see ullPortHrTimerNow()
+ * @param ulPeriod     period in microseconds, 0 for a one-shot timer
+ */
+void vPortHrTimerStartAt(PortHrTimer_t *pxTimer, uint64_t ullDeadline, uint32_t ulPeriod)
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT(pxTimer);
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        prvRemoveHrTimer(pxTimer);
+        pxTimer->ullDeadline = ullDeadline;
+        pxTimer->ulPeriod = ulPeriod;
+        prvInsertHrTimer(pxTimer);
+
+        /* only a new head changes the alarm */
+        if (pxActiveHrTimers == pxTimer) {
+            prvProgramHrTimerAlarm();
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/**
+ * @brief Start or restart a timer relative to the current time.
+ *
+ * @param pxTimer     the timer
+ * @param ulDelay     microseconds to the first expiry
+ * @param ulPeriod    period in microseconds, 0 for a one-shot timer
+ */
+void vPortHrTimerStart(PortHrTimer_t *pxTimer, uint32_t ulDelay, uint32_t ulPeriod)
+{
+    vPortHrTimerStartAt(pxTimer, ullPortHrTimerNow() + ulDelay, ulPeriod);
+}
+
+/**
+ * @brief Stop a timer, nothing happens if it is not active.
+ *
+ * @param pxTimer     the timer
+ */
+void vPortHrTimerStop(PortHrTimer_t *pxTimer)
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT(pxTimer);
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        prvRemoveHrTimer(pxTimer);
+        prvProgramHrTimerAlarm();
+    }
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/**
+ * @brief Block the calling task until an absolute time.
+ *
+ * @param ullWakeTime   time to wake up, see ullPortHrTimerNow()
+ */
+static void prvHrTimerSleepUntil(uint64_t ullWakeTime)
+{
+    PortHrTimer_t xTimer;
+
+    vPortHrTimerInit(&xTimer, NULL, xTaskGetCurrentTaskHandle());
+    vPortHrTimerStartAt(&xTimer, ullWakeTime, 0);
+
+    /* a notification sent to the index by someone else does not end the wait */
+    while (xTimer.ulActive) {
+        (void)ulTaskNotifyTakeIndexed(configHR_TIMER_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief Block the calling task for a number of microseconds.
+ *
+ * The task sleeps instead of busy waiting, it is woken by the alarm interrupt
+ * through the task notification index configHR_TIMER_NOTIFY_INDEX.
+ *
+ * @param ulDelay     microseconds to wait
+ */
+void vPortHrTimerDelay(uint32_t ulDelay)
+{
+    prvHrTimerSleepUntil(ullPortHrTimerNow() + ulDelay);
+}
+
+/**
+ * @brief Block the calling task until the next period of a cycle.
+ *
+ * The microsecond counterpart of vTaskDelayUntil(), the wake time advances by
+ * exactly one period per call so the cycle does not drift. If the next wake
+ * time has already passed the function returns without blocking.
+ *
+ * @param pullPreviousWakeTime  time the task last woke up, updated on return
+ * @param ulPeriod              period of the cycle in microseconds
+ */
+void vPortHrTimerDelayUntil(uint64_t *pullPreviousWakeTime, uint32_t ulPeriod)
+{
+    configASSERT(pullPreviousWakeTime);
+
+    *pullPreviousWakeTime += ulPeriod;
+    if (*pullPreviousWakeTime > ullPortHrTimerNow()) {
+        prvHrTimerSleepUntil(*pullPreviousWakeTime);
+    }
+}
+
+#endif /* configUSE_HR_TIMERS */
@@ -0,0 +1,102 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Based on original M0+rp2040 port from http://www.FreeRTOS.org             |
+ |___________________________________________________________________________*/
+
+#include "picortos.h"
+#include "cmsis_rp2040.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+#include "portmacro.h"
+
+#if ( configUSE_NVIC_PRIORITY_MASKING == 1 )
+
+/* number of external interrupts of the RP2040 */
+#define portNUM_EXTERNAL_IRQS           ( 26UL )
+
+/* external interrupts allowed to call the kernel, the NVIC is banked per core */
+static uint32_t ulKernelInterrupts[configNUMBER_OF_CORES];
+
+/**
+ * @brief Find the external interrupts of this core that may call the kernel.
+ *
+ * These are the interrupts with a priority value at or above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY. The set is built when the scheduler
+ * starts, so this has to be called again when the priority of an interrupt
+ * is changed afterwards.
+ */
+void vPortUpdateKernelInterruptMask(void)
+{
+    uint32_t ulMask = 0;
+
+    for (uint32_t ulIRQ = 0; ulIRQ < portNUM_EXTERNAL_IRQS; ulIRQ++) {
+        if (NVIC_GetPriority((IRQn_Type)ulIRQ) >= configMAX_SYSCALL_INTERRUPT_PRIORITY) {
+            ulMask |= (1UL << ulIRQ);
+        }
+    }
+
+    ulKernelInterrupts[portGET_CORE_ID()] = ulMask;
+}
+
+/**
+ * @brief Disable the enabled kernel interrupts of this core.
+ *
+ * This is the BASEPRI the Cortex-M0+ is missing: the interrupts above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY stay live, the ones that may call
+ * the kernel are held off in the NVIC. Their pending state is kept so they
+ * are taken as soon as they are enabled again. ISER is read and ICER written
+ * with PRIMASK set: an interrupt that disables one of its peers between the
+ * two would otherwise see it enabled again by vPortUnmaskKernelInterrupts().
+ *
+ * @return the interrupts that were disabled, to be passed to
+ *         vPortUnmaskKernelInterrupts()
+ */
+uint32_t ulPortMaskKernelInterrupts(void)
+{
+    const uint32_t ulPrimask = __get_PRIMASK();
+    uint32_t ulMask;
+
+    __disable_irq();
+    ulMask = NVIC->ISER[0] & ulKernelInterrupts[portGET_CORE_ID()];
+    NVIC->ICER[0] = ulMask;
+    __DSB();
+    __ISB();
+    __set_PRIMASK(ulPrimask);
+
+    return ulMask;
+}
+
+/**
+ * @brief Enable again the interrupts disabled by ulPortMaskKernelInterrupts().
+ *
+ * @param ulMask      value returned by ulPortMaskKernelInterrupts()
+ */
+void vPortUnmaskKernelInterrupts(uint32_t ulMask)
+{
+    NVIC->ISER[0] = ulMask;
+}
+
+#endif /* configUSE_NVIC_PRIORITY_MASKING */
@@ -0,0 +1,295 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 08.Jan.2023  |
+ |  Based on original M0+rp2040 port from http://www.FreeRTOS.org             |
+ |___________________________________________________________________________*/
+
+#include <string.h>
+#include "picortos.h"
+#include "cmsis_rp2040.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+#include "portmacro.h"
+
+#if ( configUSE_CORE_MAILBOX == 1 )
+
+/* SIO registers, CPUID tells the cores apart even when only core 0 runs the scheduler */
+#define portSIO_BASE                    ( 0xd0000000UL )
+#define portSIO_CPUID                   ( *( ( volatile uint32_t * ) ( portSIO_BASE + 0x000UL ) ) )
+#define portSIO_FIFO_ST                 ( *( ( volatile uint32_t * ) ( portSIO_BASE + 0x050UL ) ) )
+#define portSIO_FIFO_WR                 ( *( ( volatile uint32_t * ) ( portSIO_BASE + 0x054UL ) ) )
+#define portSIO_FIFO_RD                 ( *( ( volatile uint32_t * ) ( portSIO_BASE + 0x058UL ) ) )
+
+#define portSIO_FIFO_ST_VLD             ( 1UL << 0 )
+#define portSIO_FIFO_ST_RDY             ( 1UL << 1 )
+#define portSIO_FIFO_ST_WOF             ( 1UL << 2 )
+#define portSIO_FIFO_ST_ROE             ( 1UL << 3 )
+
+/* the doorbell word only wakes the other core, its value is not used */
+#define portMAILBOX_DOORBELL            ( 0x4d424f58UL )
+
+/* mailboxes checked by the doorbell handler */
+static PortMailbox_t * volatile pxMailboxes[configCORE_MAILBOX_COUNT];
+
+/**
+ * @brief Next slot of the ring after the given one.
+ *
+ */
+static inline uint32_t prvNextSlot(const PortMailbox_t *pxMailbox, uint32_t ulSlot)
+{
+    ulSlot++;
+    return (ulSlot == pxMailbox->ulSlots) ? 0 : ulSlot;
+}
+
+/**
+ * @brief Wake the task waiting on a mailbox that holds messages.
+ *
+ * Runs in interrupt context, or in a task on the core the receiver blocked on.
+ *
+ * @param pxMailbox                   the mailbox
+ * @param pxHigherPriorityTaskWoken   set to pdTRUE if the woken task should run now
+ */
+static void prvWakeReceiver(PortMailbox_t *pxMailbox, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    TaskHandle_t xTask = (TaskHandle_t)pxMailbox->pvWaitingTask;
+
+    if ((xTask != NULL) && (pxMailbox->ulHead != pxMailbox->ulTail)) {
+        vTaskNotifyGiveIndexedFromISR(xTask, configCORE_MAILBOX_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+    }
+}
+
+#if ( configNUMBER_OF_CORES == 1 )
+/**
+ * @brief Handler for the SIO FIFO interrupt of core 0 when only core 0 runs
+ * the scheduler.
+ *
+ */
+static void prvMailboxFifoHandler(void)
+{
+    while (portSIO_FIFO_ST & portSIO_FIFO_ST_VLD) {
+        (void)portSIO_FIFO_RD;
+    }
+
+    /* clear the WOF and ROE flags */
+    portSIO_FIFO_ST = portSIO_FIFO_ST_WOF | portSIO_FIFO_ST_ROE;
+
+    vPortMailboxDoorbell();
+}
+
+/**
+ * @brief Take over the FIFO interrupt of core 0 for the mailbox doorbells.
+ *
+ * Core 1 runs outside of the scheduler in this configuration, it has to be
+ * launched before the scheduler starts as the launch sequence uses the FIFO.
+ */
+void vPortMailboxStart(void)
+{
+    vPortSetInterruptHandler(SIO_IRQ_PROC0_IRQn, prvMailboxFifoHandler);
+    NVIC_SetPriority(SIO_IRQ_PROC0_IRQn, configSIO_FIFO_INTERRUPT_PRIORITY);
+    NVIC_ClearPendingIRQ(SIO_IRQ_PROC0_IRQn);
+    NVIC_EnableIRQ(SIO_IRQ_PROC0_IRQn);
+}
+#endif
+
+/**
+ * @brief Wake the receivers of all mailboxes that have messages waiting.
+ *
+ * Called by the FIFO interrupt of the core that got a doorbell. The doorbells
+ * carry no mailbox number, a full FIFO drops them, so every mailbox is checked.
+ */
+void vPortMailboxDoorbell(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    for (uint32_t ulIndex = 0; ulIndex < configCORE_MAILBOX_COUNT; ulIndex++) {
+        PortMailbox_t *pxMailbox = pxMailboxes[ulIndex];
+
+        if (pxMailbox != NULL) {
+            prvWakeReceiver(pxMailbox, &xHigherPriorityTaskWoken);
+        }
+    }
+
+    if (xHigherPriorityTaskWoken != pdFALSE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * @brief Prepare a mailbox and register it with the doorbell handler.
+ *
+ * A mailbox carries messages of a fixed size in one direction, from one
+ * sender to one receiver on any of the two cores.
+ *
+ * @param pxMailbox       the mailbox
+ * @param pucStorage      ring of ( ulLength + 1 ) * ulMessageSize bytes
+ * @param ulLength        maximum number of messages in the mailbox
+ * @param ulMessageSize   size of one message in bytes
+ * @return pdPASS, or pdFAIL if configCORE_MAILBOX_COUNT mailboxes are already registered
+ */
+int32_t xPortMailboxInit(PortMailbox_t *pxMailbox, uint8_t *pucStorage, uint32_t ulLength, uint32_t ulMessageSize)
+{
+    int32_t xReturn = pdFAIL;
+
+    configASSERT(pxMailbox != NULL);
+    configASSERT(pucStorage != NULL);
+    configASSERT((ulLength > 0) && (ulMessageSize > 0));
+
+    memset(pxMailbox, 0, sizeof(PortMailbox_t));
+    pxMailbox->ulSlots = ulLength + 1;
+    pxMailbox->ulMessageSize = ulMessageSize;
+    pxMailbox->pucStorage = pucStorage;
+
+    taskENTER_CRITICAL();
+    for (uint32_t ulIndex = 0; ulIndex < configCORE_MAILBOX_COUNT; ulIndex++) {
+        if (pxMailboxes[ulIndex] == NULL) {
+            pxMailboxes[ulIndex] = pxMailbox;
+            xReturn = pdPASS;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+
+/**
+ * @brief Copy a message into a mailbox, never blocks.
+ *
+ * May be called from a task, an interrupt or from a core running outside of
+ * the scheduler. A receiver blocked on the other core is woken through a FIFO
+ * doorbell, a receiver blocked on the calling core directly. The event is
+ * always signalled so a receiver outside of the scheduler may wait with WFE.
+ *
+ * @param pxMailbox   the mailbox
+ * @param pvMessage   message of ulMessageSize bytes
+ * @return pdPASS, or pdFAIL if the mailbox is full
+ */
+int32_t xPortMailboxSend(PortMailbox_t *pxMailbox, const void *pvMessage)
+{
+    const uint32_t ulHead = pxMailbox->ulHead;
+    const uint32_t ulNextHead = prvNextSlot(pxMailbox, ulHead);
+
+    if (ulNextHead == pxMailbox->ulTail) {
+        return pdFAIL;
+    }
+
+    memcpy(&pxMailbox->pucStorage[ulHead * pxMailbox->ulMessageSize], pvMessage, pxMailbox->ulMessageSize);
+
+    /* the message is complete before the receiver sees the new head, and the
+    head is visible before the waiting receiver is read */
+    __DMB();
+    pxMailbox->ulHead = ulNextHead;
+    __DMB();
+
+    if (pxMailbox->pvWaitingTask != NULL) {
+        if (pxMailbox->ulWaitingCore == portSIO_CPUID) {
+            /* same core, the receiver blocked in a task of this scheduler */
+            BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+            prvWakeReceiver(pxMailbox, &xHigherPriorityTaskWoken);
+            if (xHigherPriorityTaskWoken != pdFALSE) {
+                portYIELD_FROM_ISR();
+            }
+        } else if (portSIO_FIFO_ST & portSIO_FIFO_ST_RDY) {
+            /* a full FIFO means a doorbell is already waiting */
+            portSIO_FIFO_WR = portMAILBOX_DOORBELL;
+        }
+    }
+    __SEV();
+
+    return pdPASS;
+}
+
+/**
+ * @brief Copy the oldest message out of a mailbox.
+ *
+ * A task may block until a message arrives. A core running outside of the
+ * scheduler has to poll with a xTicksToWait of 0, waiting with WFE between
+ * the polls.
+ *
+ * @param pxMailbox      the mailbox
+ * @param pvMessage      buffer of ulMessageSize bytes
+ * @param ulTicksToWait  maximum time to wait for a message
+ * @return pdPASS, or pdFAIL if no message arrived in time
+ */
+int32_t xPortMailboxReceive(PortMailbox_t *pxMailbox, void *pvMessage, uint32_t ulTicksToWait)
+{
+    TickType_t xRemaining = (TickType_t)ulTicksToWait;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+
+    for (;;) {
+        const uint32_t ulTail = pxMailbox->ulTail;
+
+        if (ulTail != pxMailbox->ulHead) {
+            /* read the message only after the head that published it */
+            __DMB();
+            memcpy(pvMessage, &pxMailbox->pucStorage[ulTail * pxMailbox->ulMessageSize], pxMailbox->ulMessageSize);
+            __DMB();
+            pxMailbox->ulTail = prvNextSlot(pxMailbox, ulTail);
+            return pdPASS;
+        }
+
+        if (xRemaining == 0) {
+            return pdFAIL;
+        }
+
+        /* the timeout is set up only once the task has to block */
+        if (xEntryTimeSet == pdFALSE) {
+            vTaskSetTimeOutState(&xTimeOut);
+            xEntryTimeSet = pdTRUE;
+        }
+
+        /* register as waiting, then check again: the sender publishes the head
+        before it reads the waiting task so one of the two sides sees the other */
+        pxMailbox->ulWaitingCore = portSIO_CPUID;
+        pxMailbox->pvWaitingTask = xTaskGetCurrentTaskHandle();
+        __DMB();
+
+        if (pxMailbox->ulTail == pxMailbox->ulHead) {
+            (void)ulTaskNotifyTakeIndexed(configCORE_MAILBOX_NOTIFY_INDEX, pdTRUE, xRemaining);
+        }
+        pxMailbox->pvWaitingTask = NULL;
+
+        if (xTaskCheckForTimeOut(&xTimeOut, &xRemaining) != pdFALSE) {
+            xRemaining = 0;
+        }
+    }
+}
+
+/**
+ * @brief Number of messages in a mailbox, a snapshot while the other side is active.
+ *
+ * @param pxMailbox   the mailbox
+ * @return the number of messages that can be received
+ */
+uint32_t ulPortMailboxMessagesWaiting(const PortMailbox_t *pxMailbox)
+{
+    const uint32_t ulHead = pxMailbox->ulHead;
+    const uint32_t ulTail = pxMailbox->ulTail;
+
+    return (ulHead >= ulTail) ? (ulHead - ulTail) : (pxMailbox->ulSlots - ulTail + ulHead);
+}
+
+#endif /* configUSE_CORE_MAILBOX */
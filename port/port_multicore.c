@@ -0,0 +1,202 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Based on original M0+rp2040 port from http://www.FreeRTOS.org             |
+ |___________________________________________________________________________*/
+
+#include "picortos.h"
+#include "cmsis_rp2040.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+#include "portmacro.h"
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* SIO registers, shared by both cores but banked per core where it matters */
+#define portSIO_BASE                    ( 0xd0000000UL )
+#define portSIO_FIFO_ST                 ( *( ( volatile uint32_t * ) ( portSIO_BASE + 0x050UL ) ) )
+#define portSIO_FIFO_WR                 ( *( ( volatile uint32_t * ) ( portSIO_BASE + 0x054UL ) ) )
+#define portSIO_FIFO_RD                 ( *( ( volatile uint32_t * ) ( portSIO_BASE + 0x058UL ) ) )
+
+#define portSIO_FIFO_ST_VLD             ( 1UL << 0 )
+#define portSIO_FIFO_ST_RDY             ( 1UL << 1 )
+#define portSIO_FIFO_ST_WOF             ( 1UL << 2 )
+#define portSIO_FIFO_ST_ROE             ( 1UL << 3 )
+
+/* power-on state machine, used to reset core 1 before launching it */
+#define portPSM_FRCE_OFF                ( *( ( volatile uint32_t * ) ( 0x40010000UL + 0x004UL ) ) )
+#define portPSM_FRCE_OFF_SET            ( *( ( volatile uint32_t * ) ( 0x40010000UL + 0x2000UL + 0x004UL ) ) )
+#define portPSM_FRCE_OFF_CLR            ( *( ( volatile uint32_t * ) ( 0x40010000UL + 0x3000UL + 0x004UL ) ) )
+#define portPSM_FRCE_OFF_PROC1          ( 1UL << 16 )
+
+/* top of the core 1 stack, provided by the linker script */
+extern uint32_t __stack1_top;
+
+/* critical nesting counters, one per core */
+uint32_t uxCriticalNestings[configNUMBER_OF_CORES] = { 0 };
+
+/**
+ * @brief Request a context switch on the given core.
+ *
+ * The calling core pends its own PendSV. The other core is signalled through
+ * the SIO FIFO, its FIFO interrupt then pends the PendSV on that core. A full
+ * FIFO means a doorbell is already waiting so nothing more has to be sent.
+ *
+ * @param xCoreID     the core that has to yield
+ */
+void vPortYieldCore(int32_t xCoreID)
+{
+    if (xCoreID == (int32_t)portGET_CORE_ID()) {
+        vPortYield();
+    } else {
+        if (portSIO_FIFO_ST & portSIO_FIFO_ST_RDY) {
+            portSIO_FIFO_WR = (uint32_t)xCoreID;
+            __SEV();
+        }
+    }
+}
+
+/**
+ * @brief Handler for the SIO FIFO interrupt of both cores.
+ *
+ * The content of the doorbell does not matter, the FIFO is drained, the
+ * sticky error flags are cleared and a context switch is pended. The mailbox
+ * doorbells share the FIFO, their receivers are woken as well.
+ */
+void vPortFifoHandler()
+{
+    while (portSIO_FIFO_ST & portSIO_FIFO_ST_VLD) {
+        (void)portSIO_FIFO_RD;
+    }
+
+    /* clear the WOF and ROE flags */
+    portSIO_FIFO_ST = portSIO_FIFO_ST_WOF | portSIO_FIFO_ST_ROE;
+
+#if ( configUSE_CORE_MAILBOX == 1 )
+    vPortMailboxDoorbell();
+#endif
+
+    vPortYield();
+}
+
+/**
+ * @brief Blocking push of a word into the FIFO towards the other core.
+ *
+ * @param ulData      word to send
+ */
+static void prvFifoPush(uint32_t ulData)
+{
+    while (!(portSIO_FIFO_ST & portSIO_FIFO_ST_RDY)) {
+    }
+    portSIO_FIFO_WR = ulData;
+    __SEV();
+}
+
+/**
+ * @brief Blocking pop of a word from the FIFO of this core.
+ *
+ * @return the received word
+ */
+static uint32_t prvFifoPop(void)
+{
+    while (!(portSIO_FIFO_ST & portSIO_FIFO_ST_VLD)) {
+        __WFE();
+    }
+    return portSIO_FIFO_RD;
+}
+
+/**
+ * @brief Discard everything waiting in the FIFO of this core.
+ *
+ */
+static void prvFifoDrain(void)
+{
+    while (portSIO_FIFO_ST & portSIO_FIFO_ST_VLD) {
+        (void)portSIO_FIFO_RD;
+    }
+}
+
+/**
+ * @brief First code executed by core 1, it joins the running scheduler.
+ *
+ * The exception priorities and the NVIC are banked per core, so core 1 has
+ * to set them up for itself. The tick is generated only on core 0.
+ */
+static void prvCore1Entry(void)
+{
+    __disable_irq();
+
+    /* set PendSV_IRQn and SVCall_IRQn priority */
+    NVIC_SetPriority(SVCall_IRQn, configSVCall_INTERRUPT_PRIORITY);
+    NVIC_SetPriority(PendSV_IRQn, configPendSV_INTERRUPT_PRIORITY);
+
+    /* doorbell from core 0 */
+    NVIC_SetPriority(SIO_IRQ_PROC1_IRQn, configSIO_FIFO_INTERRUPT_PRIORITY);
+    NVIC_ClearPendingIRQ(SIO_IRQ_PROC1_IRQn);
+    NVIC_EnableIRQ(SIO_IRQ_PROC1_IRQn);
+
+#if ( configUSE_NVIC_PRIORITY_MASKING == 1 )
+    /* the NVIC of core 1 has its own priorities */
+    vPortUpdateKernelInterruptMask();
+#endif
+
+    /* start the task selected for this core */
+    vPortStartFirstTask();
+}
+
+/**
+ * @brief Reset core 1 and hand it over to the scheduler.
+ *
+ * Core 1 is kept in the bootrom wait loop until it receives the launch
+ * sequence over the FIFO: the vector table, the stack pointer and the entry
+ * point. Every word is echoed back and the sequence restarts on a mismatch.
+ */
+void vPortLaunchCore1(void)
+{
+    const uint32_t ulSequence[] = { 0, 0, 1, SCB->VTOR, (uint32_t)&__stack1_top, (uint32_t)prvCore1Entry };
+    uint32_t ulIndex = 0;
+
+    /* reset core 1, the bootrom sends a 0 once it is ready */
+    portPSM_FRCE_OFF_SET = portPSM_FRCE_OFF_PROC1;
+    while (!(portPSM_FRCE_OFF & portPSM_FRCE_OFF_PROC1)) {
+    }
+    portPSM_FRCE_OFF_CLR = portPSM_FRCE_OFF_PROC1;
+    (void)prvFifoPop();
+
+    do {
+        const uint32_t ulCommand = ulSequence[ulIndex];
+
+        /* always drain the FIFO before sending a 0, core 1 may wait in WFE */
+        if (ulCommand == 0) {
+            prvFifoDrain();
+            __SEV();
+        }
+
+        prvFifoPush(ulCommand);
+        ulIndex = (prvFifoPop() == ulCommand) ? ulIndex + 1 : 0;
+    } while (ulIndex < (sizeof(ulSequence) / sizeof(ulSequence[0])));
+}
+
+#endif /* configNUMBER_OF_CORES */
@@ -0,0 +1,186 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 08.Jan.2023  |
+ |  Based on original M0+rp2040 port from http://www.FreeRTOS.org             |
+ |___________________________________________________________________________*/
+
+#include <string.h>
+#include "picortos.h"
+#include "cmsis_rp2040.h"
+#include "task.h"
+#include "port.h"
+#include "portmacro.h"
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+/* RP2040 timer, a 64-bit counter incremented every microsecond */
+#define portTIMER_BASE                  ( 0x40054000UL )
+#define portTIMER_TIMERAWH              ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x024UL ) ) )
+#define portTIMER_TIMERAWL              ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x028UL ) ) )
+
+#if ( configUSE_ISR_RUN_TIME_STATS == 1 )
+/* handlers called by the dispatcher, indexed by exception number */
+static void (*pxIsrHandlers[portNUM_EXCEPTIONS])(void);
+
+/* time of the interrupts, per core and exception number */
+static PortIsrRunTime_t xIsrRunTimes[configNUMBER_OF_CORES][portNUM_EXCEPTIONS];
+
+/* time spent in the interrupts nested in the one executing on each core */
+static uint32_t ulNestedTime[configNUMBER_OF_CORES];
+#endif
+
+/**
+ * @brief Prepare the run time counter, called when the scheduler starts.
+ *
+ * The timer is free running from reset, only the interrupt statistics are
+ * cleared here.
+ */
+void vPortConfigureRunTimeCounter(void)
+{
+#if ( configUSE_ISR_RUN_TIME_STATS == 1 )
+    vPortResetIsrRunTimeStats();
+#endif
+}
+
+/**
+ * @brief Read the 64-bit timer used as run time counter.
+ *
+ * The latched TIMEHR/TIMELR pair is not safe when both cores or an interrupt
+ * read it, so the raw registers are read and the low word is read again if
+ * the high word changed in between.
+ *
+ * @return the time in microseconds since the timer was started
+ */
+uint64_t ulPortGetRunTimeCounterValue(void)
+{
+    uint32_t ulHigh, ulLow, ulNextHigh;
+
+    ulHigh = portTIMER_TIMERAWH;
+    for (;;) {
+        ulLow = portTIMER_TIMERAWL;
+        ulNextHigh = portTIMER_TIMERAWH;
+        if (ulNextHigh == ulHigh) {
+            break;
+        }
+        ulHigh = ulNextHigh;
+    }
+
+    return ((uint64_t)ulHigh << 32) | ulLow;
+}
+
+#if ( configUSE_ISR_RUN_TIME_STATS == 1 )
+
+/**
+ * @brief Common entry of the interrupts installed with vPortSetInterruptHandler().
+ *
+ * The handler of the active exception is called and its execution time is
+ * recorded. The time of the interrupts nested in it is not charged to it, so
+ * the totals of all interrupts add up to the time spent in interrupts.
+ */
+static void prvIsrDispatcher(void)
+{
+    const uint32_t ulException = __get_IPSR();
+    const uint32_t ulCore = portGET_CORE_ID();
+    PortIsrRunTime_t *pxRunTime = &xIsrRunTimes[ulCore][ulException];
+    uint32_t ulPrimask, ulOuterNested, ulStart, ulElapsed, ulOwn;
+
+    /* a nested interrupt must not land between the reads and the writes of
+    the nesting accumulator */
+    ulPrimask = __get_PRIMASK();
+    __disable_irq();
+    ulOuterNested = ulNestedTime[ulCore];
+    ulNestedTime[ulCore] = 0;
+    ulStart = portTIMER_TIMERAWL;
+    __set_PRIMASK(ulPrimask);
+
+    pxIsrHandlers[ulException]();
+
+    __disable_irq();
+    ulElapsed = portTIMER_TIMERAWL - ulStart;
+    ulOwn = ulElapsed - ulNestedTime[ulCore];
+    ulNestedTime[ulCore] = ulOuterNested + ulElapsed;
+
+    pxRunTime->ulCount++;
+    pxRunTime->ulTotalTime += ulOwn;
+    if (ulOwn > pxRunTime->ulMaxTime) {
+        pxRunTime->ulMaxTime = ulOwn;
+    }
+    __set_PRIMASK(ulPrimask);
+}
+
+/**
+ * @brief Copy the interrupt statistics of one core.
+ *
+ * The copy is taken with the interrupts of the calling core disabled. The
+ * entries of the other core may be updated while they are copied.
+ *
+ * @param ulCoreID    core whose interrupts are reported
+ * @param pxRunTimes  array of portNUM_EXCEPTIONS entries, indexed by exception number
+ */
+void vPortGetIsrRunTimeStats(uint32_t ulCoreID, PortIsrRunTime_t *pxRunTimes)
+{
+    const uint32_t ulPrimask = __get_PRIMASK();
+
+    __disable_irq();
+    memcpy(pxRunTimes, xIsrRunTimes[ulCoreID], sizeof(xIsrRunTimes[ulCoreID]));
+    __set_PRIMASK(ulPrimask);
+}
+
+/**
+ * @brief Clear the interrupt statistics of both cores.
+ *
+ */
+void vPortResetIsrRunTimeStats(void)
+{
+    const uint32_t ulPrimask = __get_PRIMASK();
+
+    __disable_irq();
+    memset(xIsrRunTimes, 0, sizeof(xIsrRunTimes));
+    __set_PRIMASK(ulPrimask);
+}
+
+#endif /* configUSE_ISR_RUN_TIME_STATS */
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+/**
+ * @brief Install the handler of an interrupt or system exception.
+ *
+ * With configUSE_ISR_RUN_TIME_STATS the vector points to a dispatcher that
+ * measures the time spent in the handler, otherwise the handler is placed in
+ * the vector table directly.
+ *
+ * @param xIRQn       CMSIS interrupt number, negative for system exceptions
+ * @param pxHandler   the interrupt handler
+ */
+void vPortSetInterruptHandler(int32_t xIRQn, void (*pxHandler)(void))
+{
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_ISR_RUN_TIME_STATS == 1 )
+    pxIsrHandlers[xIRQn + 16] = pxHandler;
+    __DMB();
+    NVIC_SetVector((IRQn_Type)xIRQn, (uint32_t)prvIsrDispatcher);
+#else
+    NVIC_SetVector((IRQn_Type)xIRQn, (uint32_t)pxHandler);
+#endif
+}
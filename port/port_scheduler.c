@@ -40,20 +40,66 @@ BaseType_t xPortStartScheduler(void)
     /* add PendSV_IRQn, SVCall_IRQn and SysTick_IRQn handlers */
     NVIC_SetVector(SVCall_IRQn, (uint32_t)vPortSVCHandler);
     NVIC_SetVector(PendSV_IRQn, (uint32_t)vPortPendSVHandler);
-    NVIC_SetVector(SysTick_IRQn, (uint32_t)vPortSysTickHandler);
+    vPortSetInterruptHandler(SysTick_IRQn, vPortSysTickHandler);
 
     /* set PendSV_IRQn, SVCall_IRQn and SysTick_IRQn priority */
     NVIC_SetPriority(SVCall_IRQn, configSVCall_INTERRUPT_PRIORITY);
     NVIC_SetPriority(PendSV_IRQn, configPendSV_INTERRUPT_PRIORITY);
     NVIC_SetPriority(SysTick_IRQn, configSysTick_INTERRUPT_PRIORITY);
 
+#if ( configNUMBER_OF_CORES > 1 )
+    /* add the inter-core doorbell handlers */
+    vPortSetInterruptHandler(SIO_IRQ_PROC0_IRQn, vPortFifoHandler);
+    vPortSetInterruptHandler(SIO_IRQ_PROC1_IRQn, vPortFifoHandler);
+
+    /* Initialise the critical nesting counts ready for the first tasks. */
+    for (uint32_t ulCore = 0; ulCore < configNUMBER_OF_CORES; ulCore++) {
+        uxCriticalNestings[ulCore] = 0;
+    }
+#else
     /* Initialise the critical nesting count ready for the first task. */
     uxCriticalNesting = 0;
+#endif
+
+#if ( configUSE_DMA_COPY == 1 )
+    /* channel used by the large queue and stream buffer copies */
+    vPortDmaCopyInit();
+#endif
+
+#if ( configUSE_CORE_MAILBOX == 1 ) && ( configNUMBER_OF_CORES == 1 )
+    /* the FIFO of core 0 takes the doorbells of the mailboxes */
+    vPortMailboxStart();
+#endif
+
+#if ( configUSE_HR_TIMERS == 1 )
+    /* alarm interrupt of the microsecond timers, the timers started before
+    the scheduler expire from here on */
+    vPortConfigureHrTimers();
+#endif
+
+#if ( configUSE_TASK_LATENCY_STATS == 1 )
+    /* the first task of each core starts below without a switch in */
+    vTaskStartLatencyStats();
+#endif
 
     /* Start the timer that generates the tick ISR.  Interrupts are disabled
     here already. */
     vPortConfigureSysTick();
 
+#if ( configNUMBER_OF_CORES > 1 )
+    /* core 1 starts the task selected for it, the launch uses the FIFO so the
+    doorbell interrupt of core 0 is enabled only after it */
+    vPortLaunchCore1();
+    NVIC_SetPriority(SIO_IRQ_PROC0_IRQn, configSIO_FIFO_INTERRUPT_PRIORITY);
+    NVIC_ClearPendingIRQ(SIO_IRQ_PROC0_IRQn);
+    NVIC_EnableIRQ(SIO_IRQ_PROC0_IRQn);
+#endif
+
+#if ( configUSE_NVIC_PRIORITY_MASKING == 1 )
+    /* all kernel interrupts have their priority by now */
+    vPortUpdateKernelInterruptMask();
+#endif
+
     /* start the first task */
     vPortStartFirstTask();
 
@@ -62,7 +108,11 @@ BaseType_t xPortStartScheduler(void)
     not being called in the case that the application writer overrides this
     functionality. Call vTaskSwitchContext() so link time optimisation does not
     remove the symbol. */
+#if ( configNUMBER_OF_CORES > 1 )
+    vTaskSwitchContext(portGET_CORE_ID());
+#else
     vTaskSwitchContext();
+#endif
     vPortTaskExitError();
 
     /* Should not get here! */
@@ -0,0 +1,175 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Based on original M0+rp2040 port from http://www.FreeRTOS.org             |
+ |___________________________________________________________________________*/
+
+#include "picortos.h"
+#include "cmsis_rp2040.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+#include "portmacro.h"
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* SIO hardware spinlocks, a read claims the lock and any write releases it */
+#define portSIO_SPINLOCK(n)             ( *( ( volatile uint32_t * ) ( 0xd0000000UL + 0x100UL + ( ( n ) * 4UL ) ) ) )
+
+/* hardware spinlocks 26 and 27 are the ones the pico-sdk leaves to the OS */
+#define portRTOS_SPINLOCK_FIRST         ( 26UL )
+#define portRTOS_SPINLOCK_COUNT         ( 2UL )
+
+/* ownership and recursion bookkeeping of the kernel locks */
+static volatile uint8_t ucOwnedByCore[configNUMBER_OF_CORES];
+static volatile uint8_t ucRecursionCountByLock[portRTOS_SPINLOCK_COUNT];
+
+#if ( configUSE_SPINLOCK_STATS == 1 )
+
+/* the microsecond timer is shared by both cores, so a lock taken on one core
+and measured on the other still gives a valid hold time */
+#define portTIMER_TIMERAWL              ( *( ( volatile uint32_t * ) ( 0x40054000UL + 0x028UL ) ) )
+
+/* statistics of the kernel locks, updated only while the lock is held */
+static PortSpinlockStats_t xLockStats[portRTOS_SPINLOCK_COUNT];
+static uint32_t ulLockTakenAt[portRTOS_SPINLOCK_COUNT];
+
+#endif /* configUSE_SPINLOCK_STATS */
+
+/**
+ * @brief Take or give one of the kernel locks.
+ *
+ * The locks are recursive so the same core may take a lock it already holds,
+ * which happens when a critical section is entered while the scheduler is
+ * suspended. Must be called with the interrupts disabled on the calling core.
+ *
+ * @param ulLockNum   lock number, portTASK_LOCK or portISR_LOCK
+ * @param xAcquire    pdTRUE to take the lock, pdFALSE to give it
+ */
+void vPortRecursiveLock(uint32_t ulLockNum, int32_t xAcquire)
+{
+    const uint32_t ulCoreNum = portGET_CORE_ID();
+    const uint8_t ucLockBit = (uint8_t)(1U << ulLockNum);
+#if ( configUSE_SPINLOCK_STATS == 1 )
+    uint32_t ulContended = 0;
+#endif
+
+    configASSERT(ulLockNum < portRTOS_SPINLOCK_COUNT);
+
+    if (xAcquire) {
+        /* a read returns non zero when the lock was claimed */
+        if (portSIO_SPINLOCK(portRTOS_SPINLOCK_FIRST + ulLockNum) == 0) {
+            if (ucOwnedByCore[ulCoreNum] & ucLockBit) {
+                /* already held by this core, just nest */
+                configASSERT(ucRecursionCountByLock[ulLockNum] != 255U);
+                ucRecursionCountByLock[ulLockNum]++;
+                return;
+            }
+
+            while (portSIO_SPINLOCK(portRTOS_SPINLOCK_FIRST + ulLockNum) == 0) {
+            }
+#if ( configUSE_SPINLOCK_STATS == 1 )
+            ulContended = 1;
+#endif
+        }
+
+        __DMB();
+        configASSERT(ucRecursionCountByLock[ulLockNum] == 0);
+        ucRecursionCountByLock[ulLockNum] = 1;
+        ucOwnedByCore[ulCoreNum] |= ucLockBit;
+
+#if ( configUSE_SPINLOCK_STATS == 1 )
+        xLockStats[ulLockNum].ulAcquireCount++;
+        xLockStats[ulLockNum].ulContendedCount += ulContended;
+        ulLockTakenAt[ulLockNum] = portTIMER_TIMERAWL;
+#endif
+    } else {
+        configASSERT((ucOwnedByCore[ulCoreNum] & ucLockBit) != 0);
+        configASSERT(ucRecursionCountByLock[ulLockNum] != 0);
+
+        if (--ucRecursionCountByLock[ulLockNum] == 0) {
+#if ( configUSE_SPINLOCK_STATS == 1 )
+            const uint32_t ulHeld = portTIMER_TIMERAWL - ulLockTakenAt[ulLockNum];
+
+            xLockStats[ulLockNum].ulTotalHoldTime += ulHeld;
+            if (ulHeld > xLockStats[ulLockNum].ulMaxHoldTime) {
+                xLockStats[ulLockNum].ulMaxHoldTime = ulHeld;
+            }
+#endif
+            ucOwnedByCore[ulCoreNum] &= (uint8_t)~ucLockBit;
+            __DMB();
+
+            /* any write releases the lock */
+            portSIO_SPINLOCK(portRTOS_SPINLOCK_FIRST + ulLockNum) = 1;
+        }
+    }
+}
+
+#if ( configUSE_SPINLOCK_STATS == 1 )
+
+/**
+ * @brief Get a copy of the statistics of one kernel lock.
+ *
+ * The copy is taken inside a critical section, which holds both kernel
+ * locks, so the figures of a lock are consistent with each other. The
+ * critical section of this call is itself counted on the next call.
+ *
+ * @param ulLockNum   lock number, portTASK_LOCK or portISR_LOCK
+ * @param pxStats     the statistics are copied here
+ */
+void vPortGetSpinlockStats(uint32_t ulLockNum, PortSpinlockStats_t *pxStats)
+{
+    configASSERT(ulLockNum < portRTOS_SPINLOCK_COUNT);
+    configASSERT(pxStats != NULL);
+
+    taskENTER_CRITICAL();
+    {
+        *pxStats = xLockStats[ulLockNum];
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Clear the statistics of all kernel locks.
+ *
+ */
+void vPortResetSpinlockStats(void)
+{
+    uint32_t ulLockNum;
+
+    taskENTER_CRITICAL();
+    {
+        for (ulLockNum = 0; ulLockNum < portRTOS_SPINLOCK_COUNT; ulLockNum++) {
+            xLockStats[ulLockNum].ulAcquireCount = 0;
+            xLockStats[ulLockNum].ulContendedCount = 0;
+            xLockStats[ulLockNum].ulMaxHoldTime = 0;
+            xLockStats[ulLockNum].ulTotalHoldTime = 0;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* configUSE_SPINLOCK_STATS */
+
+#endif /* configNUMBER_OF_CORES */
@@ -30,6 +30,30 @@
 #include "task.h"
 #include "port.h"
 #include "portmacro.h"
+#include "port_tickless.h"
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+/* RP2040 timer, it counts microseconds once the watchdog tick is running */
+#define portTIMER_BASE                  ( 0x40054000UL )
+#define portTIMER_ALARM(n)              ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x010UL + ( ( n ) * 4UL ) ) ) )
+#define portTIMER_ARMED                 ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x020UL ) ) )
+#define portTIMER_TIMERAWL              ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x028UL ) ) )
+#define portTIMER_INTR                  ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x034UL ) ) )
+#define portTIMER_INTE_SET              ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x2000UL + 0x038UL ) ) )
+#define portTIMER_INTE_CLR              ( *( ( volatile uint32_t * ) ( portTIMER_BASE + 0x3000UL + 0x038UL ) ) )
+
+#define portTICKLESS_ALARM_BIT          ( 1UL << configTICKLESS_TIMER_ALARM )
+#define portTICKLESS_ALARM_IRQn         ( ( IRQn_Type ) ( TIMER_IRQ_0_IRQn + configTICKLESS_TIMER_ALARM ) )
+
+/* length of one tick in microseconds and SysTick cycles in one microsecond */
+#define portUS_PER_TICK                 ( 1000000UL / configTICK_RATE_HZ )
+#define portCYCLES_PER_US               ( configCPU_CLOCK_HZ / 1000000UL )
+
+/* the alarm compares only the low 32 bits of the timer, keep the sleep below half of that range */
+#define portMAX_SUPPRESSED_TICKS        ( 0x7fffffffUL / portUS_PER_TICK )
+
+#endif /* configUSE_TICKLESS_IDLE */
 
 /**
  * @brief Setup the systick timer to generate the tick interrupts at the required frequency.
@@ -41,22 +65,145 @@ void vPortConfigureSysTick(void)
     SysTick->CTRL = 0UL;
     SysTick->VAL  = 0UL;
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    /* the alarm only wakes the core up, it runs with the tick priority */
+    portTIMER_INTE_CLR = portTICKLESS_ALARM_BIT;
+    portTIMER_INTR = portTICKLESS_ALARM_BIT;
+    NVIC_SetVector(portTICKLESS_ALARM_IRQn, (uint32_t)vPortTicklessAlarmHandler);
+    NVIC_SetPriority(portTICKLESS_ALARM_IRQn, configSysTick_INTERRUPT_PRIORITY);
+    NVIC_ClearPendingIRQ(portTICKLESS_ALARM_IRQn);
+    NVIC_EnableIRQ(portTICKLESS_ALARM_IRQn);
+#endif
+
     /* configure SysTick to interrupt at the requested rate. */
     SysTick->LOAD = ( configCPU_CLOCK_HZ / configTICK_RATE_HZ ) - 1UL;
     SysTick->CTRL = ( SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk );
 }
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+/**
+ * @brief Handler for the timer alarm used by the tickless idle.
+ *
+ * The alarm only has to bring the core out of sleep, the tick count is
+ * corrected by vPortSuppressTicksAndSleep() once the core is awake.
+ */
+void vPortTicklessAlarmHandler(void)
+{
+    portTIMER_INTR = portTICKLESS_ALARM_BIT;
+}
+
+/**
+ * @brief Stop the tick and sleep until the next task has to be unblocked.
+ *
+ * The SysTick is stopped and a timer alarm is programmed for the end of the
+ * expected idle period. After wake up the time spent asleep is read from the
+ * timer, the tick count is stepped by the number of complete ticks and the
+ * SysTick is restarted with the remainder of the current tick so no time is
+ * lost between the sleep periods, see vPortTicklessCorrection().
+ *
+ * @param xExpectedIdleTime   number of ticks until the next task unblocks
+ */
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+    uint32_t ulTickElapsedUs, ulSleepUs, ulElapsedUs, ulStart;
+    PortTicklessCorrection_t xCorrection;
+    TickType_t xModifiableIdleTime;
+
+    if (xExpectedIdleTime > portMAX_SUPPRESSED_TICKS) {
+        xExpectedIdleTime = portMAX_SUPPRESSED_TICKS;
+    }
+
+    /* do not use a critical section, the interrupt that ends the sleep must
+    still be able to wake the core */
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    /* stop the SysTick but keep its count, the current tick may be resumed */
+    SysTick->CTRL = ( SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk );
+
+    /* a tick that is already pending or a task that became ready abort the sleep */
+    if ((eTaskConfirmSleepModeStatus() == eAbortSleep) || (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)) {
+        SysTick->CTRL = ( SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk );
+        __enable_irq();
+        return;
+    }
+
+    /* the sleep ends on a tick boundary, part of the current tick is already gone */
+    ulTickElapsedUs = (SysTick->LOAD - SysTick->VAL) / portCYCLES_PER_US;
+    ulSleepUs = (xExpectedIdleTime * portUS_PER_TICK) - ulTickElapsedUs;
+
+    /* writing the alarm register arms it */
+    portTIMER_INTR = portTICKLESS_ALARM_BIT;
+    portTIMER_INTE_SET = portTICKLESS_ALARM_BIT;
+    ulStart = portTIMER_TIMERAWL;
+    portTIMER_ALARM(configTICKLESS_TIMER_ALARM) = ulStart + ulSleepUs;
+
+    /* the application may prepare the sleep or decide to skip it */
+    xModifiableIdleTime = xExpectedIdleTime;
+    configPRE_SLEEP_PROCESSING(xModifiableIdleTime);
+    if (xModifiableIdleTime > 0) {
+        __DSB();
+        __WFI();
+        __ISB();
+    }
+    configPOST_SLEEP_PROCESSING(xExpectedIdleTime);
+
+    /* let the interrupt that woke the core execute before the tick is corrected */
+    __enable_irq();
+    __DSB();
+    __ISB();
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    /* disarm the alarm, it may not be the reason for the wake up */
+    portTIMER_ARMED = portTICKLESS_ALARM_BIT;
+    portTIMER_INTE_CLR = portTICKLESS_ALARM_BIT;
+    portTIMER_INTR = portTICKLESS_ALARM_BIT;
+    NVIC_ClearPendingIRQ(portTICKLESS_ALARM_IRQn);
+
+    ulElapsedUs = portTIMER_TIMERAWL - ulStart;
+    vPortTicklessCorrection(xExpectedIdleTime, portUS_PER_TICK, ulTickElapsedUs, ulSleepUs, ulElapsedUs, &xCorrection);
+
+    /* restart the SysTick with what is left of the current tick, the normal
+    reload value is used from the next tick on */
+    SysTick->LOAD = (xCorrection.ulRemainingUs * portCYCLES_PER_US) - 1UL;
+    SysTick->VAL  = 0UL;
+    SysTick->CTRL = ( SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk );
+    SysTick->LOAD = ( configCPU_CLOCK_HZ / configTICK_RATE_HZ ) - 1UL;
+
+    if (xCorrection.ulPendTick) {
+        SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;
+    }
+
+    vTaskStepTick(xCorrection.ulStepTicks);
+    __enable_irq();
+}
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 /**
  * @brief Handler for the SysTick interupt.
  *
  * The SysTick runs at the lowest interrupt priority, so when this interrupt
  * executes all interrupts must be unmasked.  There is therefore no need to
  * save and then restore the interrupt mask value as its value is already
- * known.
+ * known. With configUSE_NVIC_PRIORITY_MASKING only the interrupts that may
+ * call the kernel are held off while the delayed list is walked.
  */
 void vPortSysTickHandler(void)
 {
+#if ( configNUMBER_OF_CORES > 1 )
+    /* the tick runs on core 0 only, the kernel lock keeps core 1 out of the
+    lists while the tick is processed */
+    UBaseType_t uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+#elif ( configUSE_NVIC_PRIORITY_MASKING == 1 )
+    uint32_t ulKernelInterrupts = ulPortMaskKernelInterrupts();
+#else
     portDISABLE_INTERRUPTS();
+#endif
     {
         /* increment the RTOS tick. If necessary trigger a context switch using
         the PendSV interrupt */
@@ -65,5 +212,11 @@ void vPortSysTickHandler(void)
             vPortYield();
         }
     }
+#if ( configNUMBER_OF_CORES > 1 )
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+#elif ( configUSE_NVIC_PRIORITY_MASKING == 1 )
+    vPortUnmaskKernelInterrupts(ulKernelInterrupts);
+#else
     portENABLE_INTERRUPTS();
+#endif
 }
@@ -0,0 +1,78 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Based on original M0+rp2040 port from http://www.FreeRTOS.org             |
+ |___________________________________________________________________________*/
+
+#pragma once
+
+#include <stdint.h>
+
+/* correction of the tick after a tickless sleep */
+typedef struct {
+    uint32_t ulStepTicks;       /* complete ticks to step the tick count by */
+    uint32_t ulRemainingUs;     /* time left of the current tick, the SysTick restarts with it */
+    uint32_t ulPendTick;        /* the tick that ended the sleep is left to the tick handler */
+} PortTicklessCorrection_t;
+
+/**
+ * @brief Compute the tick correction after the core woke up from a tickless sleep.
+ *
+ * The computation has no side effects so it is shared by vPortSuppressTicksAndSleep()
+ * and the host tests. When the alarm fired the last tick of the sleep and the
+ * whole ticks that passed after the alarm are accounted as well, but the step
+ * never goes past ulExpectedIdleTime: the kernel asserts that the tick count is
+ * not stepped past the next unblock time. Only a wake up that is delayed by
+ * more than one tick loses time.
+ *
+ * @param ulExpectedIdleTime  ticks the core was meant to sleep
+ * @param ulUsPerTick         length of one tick in microseconds
+ * @param ulTickElapsedUs     part of the current tick that passed before the sleep
+ * @param ulSleepUs           time programmed in the alarm, until the end of the idle period
+ * @param ulElapsedUs         time the core actually spent asleep
+ * @param pxCorrection        the correction to apply
+ */
+static inline void vPortTicklessCorrection(uint32_t ulExpectedIdleTime, uint32_t ulUsPerTick, uint32_t ulTickElapsedUs,
+                                           uint32_t ulSleepUs, uint32_t ulElapsedUs, PortTicklessCorrection_t *pxCorrection)
+{
+    uint32_t ulOvershootUs;
+
+    if (ulElapsedUs >= ulSleepUs) {
+        /* the whole period passed, the tick that ends it is processed by the
+        tick handler so the tasks unblocked by it are handled the normal way */
+        ulOvershootUs = ulElapsedUs - ulSleepUs;
+        pxCorrection->ulStepTicks = (ulExpectedIdleTime - 1UL) + (ulOvershootUs / ulUsPerTick);
+        if (pxCorrection->ulStepTicks > ulExpectedIdleTime) {
+            pxCorrection->ulStepTicks = ulExpectedIdleTime;
+        }
+        pxCorrection->ulRemainingUs = ulUsPerTick - (ulOvershootUs % ulUsPerTick);
+        pxCorrection->ulPendTick = 1UL;
+    } else {
+        /* another interrupt woke the core, count from the last tick boundary */
+        ulElapsedUs += ulTickElapsedUs;
+        pxCorrection->ulStepTicks = ulElapsedUs / ulUsPerTick;
+        pxCorrection->ulRemainingUs = ulUsPerTick - (ulElapsedUs % ulUsPerTick);
+        pxCorrection->ulPendTick = 0UL;
+    }
+}
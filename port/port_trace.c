@@ -0,0 +1,161 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 08.Jan.2023  |
+ |  Based on original M0+rp2040 port from http://www.FreeRTOS.org             |
+ |___________________________________________________________________________*/
+
+#include "picortos.h"
+#include "cmsis_rp2040.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+#include "portmacro.h"
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+/* events recorded by ulPortTraceMeasureCycles() */
+#define portTRACE_MEASURE_EVENTS        32UL
+
+#define portTRACE_RING_INIT(core)       { .ulMagic = portTRACE_MAGIC, .usVersion = portTRACE_VERSION, .usCoreID = (core), .ulEventCount = configTRACE_BUFFER_EVENTS }
+
+/* the rings are initialised statically so the tasks created before the
+scheduler starts are recorded as well */
+PortTraceRing_t xPortTraceRings[configNUMBER_OF_CORES] = {
+    portTRACE_RING_INIT(0),
+#if ( configNUMBER_OF_CORES > 1 )
+    portTRACE_RING_INIT(1),
+#endif
+};
+
+/**
+ * @brief Resume the recording of events on both cores.
+ *
+ */
+void vPortTraceStart(void)
+{
+    for (uint32_t ulCore = 0; ulCore < configNUMBER_OF_CORES; ulCore++) {
+        xPortTraceRings[ulCore].ulStopped = 0;
+    }
+}
+
+/**
+ * @brief Freeze the rings, for example from a fault handler before the dump.
+ *
+ * An event that is being recorded on the other core may still complete.
+ */
+void vPortTraceStop(void)
+{
+    for (uint32_t ulCore = 0; ulCore < configNUMBER_OF_CORES; ulCore++) {
+        xPortTraceRings[ulCore].ulStopped = 1;
+    }
+    __DMB();
+}
+
+/**
+ * @brief Discard the events recorded so far.
+ *
+ * The recording should be stopped while the rings are cleared.
+ */
+void vPortTraceClear(void)
+{
+    for (uint32_t ulCore = 0; ulCore < configNUMBER_OF_CORES; ulCore++) {
+        xPortTraceRings[ulCore].ulHead = 0;
+    }
+}
+
+/**
+ * @brief Record the creation of a task followed by its name.
+ *
+ * The name is split in groups of three characters that fit the event
+ * parameter, so the decoder can label the task without a symbol table.
+ *
+ * @param pxTCB       the new task
+ * @param pcName      the name of the task
+ */
+void vPortTraceTaskCreate(const void *pxTCB, const char *pcName)
+{
+    uint32_t ulIndex, ulChars;
+
+    vPortTraceRecord(portTRACE_TASK_CREATE, portTRACE_OBJECT(pxTCB));
+
+    for (ulIndex = 0; ulIndex < configMAX_TASK_NAME_LEN; ulIndex += 3) {
+        ulChars = 0;
+        for (uint32_t ulByte = 0; ulByte < 3; ulByte++) {
+            if (((ulIndex + ulByte) < configMAX_TASK_NAME_LEN) && (pcName[ulIndex + ulByte] != '\0')) {
+                ulChars |= (uint32_t)(uint8_t)pcName[ulIndex + ulByte] << (ulByte * 8);
+            } else {
+                break;
+            }
+        }
+
+        vPortTraceRecord(portTRACE_TASK_NAME, ulChars);
+
+        /* the last group has less than three characters, possibly none */
+        if ((ulChars & 0x00ff0000UL) == 0) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Measure the cost of recording one event, in processor cycles.
+ *
+ * A burst of user events is recorded with the interrupts disabled and timed
+ * with the SysTick, which counts the processor cycles. The same loop without
+ * the records is timed as well and subtracted. The events are taken out of
+ * the ring of this core again, they overwrite as many of its oldest events.
+ * The recording must not be stopped while the cost is measured.
+ *
+ * @return average cycles of one vPortTraceRecord()
+ */
+uint32_t ulPortTraceMeasureCycles(void)
+{
+    PortTraceRing_t * const pxRing = &xPortTraceRings[portGET_CORE_ID()];
+    const uint32_t ulReload = SysTick->LOAD + 1UL;
+    uint32_t ulPrimask, ulHead, ulStart, ulRecordCycles, ulLoopCycles;
+
+    ulPrimask = __get_PRIMASK();
+    __disable_irq();
+    ulHead = pxRing->ulHead;
+
+    /* the SysTick counts down and the burst is much shorter than one reload */
+    ulStart = SysTick->VAL;
+    for (uint32_t ulEvent = 0; ulEvent < portTRACE_MEASURE_EVENTS; ulEvent++) {
+        portTRACE_USER_EVENT(ulEvent);
+    }
+    ulRecordCycles = (ulStart + ulReload - SysTick->VAL) % ulReload;
+
+    ulStart = SysTick->VAL;
+    for (uint32_t ulEvent = 0; ulEvent < portTRACE_MEASURE_EVENTS; ulEvent++) {
+        __asm volatile ("" ::: "memory");
+    }
+    ulLoopCycles = (ulStart + ulReload - SysTick->VAL) % ulReload;
+
+    pxRing->ulHead = ulHead;
+    __set_PRIMASK(ulPrimask);
+
+    return (ulRecordCycles > ulLoopCycles) ? (ulRecordCycles - ulLoopCycles) / portTRACE_MEASURE_EVENTS : 0UL;
+}
+
+#endif /* configUSE_TRACE_RECORDER */
@@ -90,8 +90,54 @@ typedef unsigned long UBaseType_t;
 #define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vClearInterruptMaskFromISR( x )
 #define portDISABLE_INTERRUPTS()				vPortDisableInterrupts()
 #define portENABLE_INTERRUPTS()					vPortEnableInterrupts()
-#define portENTER_CRITICAL()					vPortEnterCritical()
-#define portEXIT_CRITICAL()						vPortExitCritical()
+#if ( configNUMBER_OF_CORES == 1 )
+	#define portENTER_CRITICAL()					vPortEnterCritical()
+	#define portEXIT_CRITICAL()						vPortExitCritical()
+#else
+	/* the kernel takes the inter-core locks around the interrupt masking */
+	#define portENTER_CRITICAL()					vTaskEnterCritical()
+	#define portEXIT_CRITICAL()						vTaskExitCritical()
+	#define portENTER_CRITICAL_FROM_ISR()			vTaskEnterCriticalFromISR()
+	#define portEXIT_CRITICAL_FROM_ISR(x)			vTaskExitCriticalFromISR( x )
+#endif
+/*-----------------------------------------------------------*/
+
+/* Kernel interrupt masking through the NVIC. */
+#if ( configUSE_NVIC_PRIORITY_MASKING == 1 )
+	#if ( configMAX_SYSCALL_INTERRUPT_PRIORITY == 0 ) || ( configMAX_SYSCALL_INTERRUPT_PRIORITY > configPendSV_INTERRUPT_PRIORITY )
+		#error configMAX_SYSCALL_INTERRUPT_PRIORITY must be between 1 and the PendSV priority.
+	#endif
+#endif
+/*-----------------------------------------------------------*/
+
+/* Multicore support. */
+#if ( configNUMBER_OF_CORES > 1 )
+	#if ( configNUMBER_OF_CORES > 2 )
+		#error The RP2040 has only two cores.
+	#endif
+
+	/* SIO CPUID register reads 0 on core 0 and 1 on core 1 */
+	#define portGET_CORE_ID()						( *( ( volatile uint32_t * ) 0xd0000000UL ) )
+	#define portYIELD_CORE( xCoreID )				vPortYieldCore( xCoreID )
+	#define portCHECK_IF_IN_ISR()					( ( __get_IPSR() != 0UL ) ? pdTRUE : pdFALSE )
+
+	/* kernel locks backed by the SIO hardware spinlocks, both recursive */
+	#define portTASK_LOCK							0UL
+	#define portISR_LOCK							1UL
+	#define portGET_TASK_LOCK()						vPortRecursiveLock( portTASK_LOCK, pdTRUE )
+	#define portRELEASE_TASK_LOCK()					vPortRecursiveLock( portTASK_LOCK, pdFALSE )
+	#define portGET_ISR_LOCK()						vPortRecursiveLock( portISR_LOCK, pdTRUE )
+	#define portRELEASE_ISR_LOCK()					vPortRecursiveLock( portISR_LOCK, pdFALSE )
+
+	/* critical nesting is counted per core */
+	#define portGET_CRITICAL_NESTING_COUNT()		( uxCriticalNestings[ portGET_CORE_ID() ] )
+	#define portSET_CRITICAL_NESTING_COUNT( x )		( uxCriticalNestings[ portGET_CORE_ID() ] = ( x ) )
+	#define portINCREMENT_CRITICAL_NESTING_COUNT()	( uxCriticalNestings[ portGET_CORE_ID() ]++ )
+	#define portDECREMENT_CRITICAL_NESTING_COUNT()	( uxCriticalNestings[ portGET_CORE_ID() ]-- )
+#else
+	/* the scheduler runs on core 0 only */
+	#define portGET_CORE_ID()						( 0UL )
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
  /* macros used to allow port/compiler specific language extensions.*/
@@ -99,6 +145,327 @@ typedef unsigned long UBaseType_t;
 #define portTASK_FUNCTION( vFunction, pvParameters )        void vFunction( void *pvParameters )
 /*-----------------------------------------------------------*/
 
+/* Trace recorder. */
+#if ( configUSE_TRACE_RECORDER == 1 )
+	#ifndef configTRACE_BUFFER_EVENTS
+		#define configTRACE_BUFFER_EVENTS		1024
+	#endif
+
+	#if ( ( configTRACE_BUFFER_EVENTS & ( configTRACE_BUFFER_EVENTS - 1 ) ) != 0 )
+		#error configTRACE_BUFFER_EVENTS must be a power of two.
+	#endif
+
+	/* low word of the RP2040 1 MHz timer */
+	#define portTRACE_TIMESTAMP()				( *( ( volatile uint32_t * ) 0x40054028UL ) )
+
+	/* kernel objects live in SRAM, the offset in the 0x20000000 region fits in 24 bits */
+	#define portTRACE_OBJECT( pxObject )		( ( uint32_t ) ( pxObject ) & 0x00ffffffUL )
+
+	/* the slot and the timestamp are taken with the interrupts of this core
+	disabled, so each ring is written in time order without locks */
+	static portFORCE_INLINE void vPortTraceRecord( uint32_t ulEvent, uint32_t ulParameter )
+	{
+		PortTraceRing_t * const pxRing = &xPortTraceRings[ portGET_CORE_ID() ];
+		PortTraceEvent_t *pxEvent;
+		uint32_t ulPrimask, ulTimestamp;
+
+		if( pxRing->ulStopped == 0UL )
+		{
+			ulPrimask = __get_PRIMASK();
+			__disable_irq();
+			ulTimestamp = portTRACE_TIMESTAMP();
+			pxEvent = &pxRing->xEvents[ pxRing->ulHead & ( configTRACE_BUFFER_EVENTS - 1 ) ];
+			pxRing->ulHead++;
+			pxEvent->ulTimestamp = ulTimestamp;
+			pxEvent->ulEvent = ( ulEvent << 24 ) | ( ulParameter & 0x00ffffffUL );
+			__set_PRIMASK( ulPrimask );
+		}
+	}
+
+	#define traceTASK_SWITCHED_IN()							vPortTraceRecord( portTRACE_TASK_SWITCHED_IN, portTRACE_OBJECT( pxCurrentTCB ) )
+	#define traceTASK_INCREMENT_TICK( xTickCount )			vPortTraceRecord( portTRACE_TICK, ( uint32_t ) ( xTickCount ) )
+	#define traceTASK_CREATE( pxNewTCB )					vPortTraceTaskCreate( ( pxNewTCB ), ( pxNewTCB )->pcTaskName )
+	#define traceTASK_DELETE( pxTaskToDelete )				vPortTraceRecord( portTRACE_TASK_DELETE, portTRACE_OBJECT( pxTaskToDelete ) )
+	#define traceMOVED_TASK_TO_READY_STATE( pxTCB )			vPortTraceRecord( portTRACE_TASK_READY, portTRACE_OBJECT( pxTCB ) )
+	#define traceTASK_NOTIFY( uxIndexToNotify )				vPortTraceRecord( portTRACE_TASK_NOTIFY, portTRACE_OBJECT( pxTCB ) )
+	#define traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify )	vPortTraceRecord( portTRACE_TASK_NOTIFY, portTRACE_OBJECT( pxTCB ) )
+	#define traceQUEUE_CREATE( pxNewQueue )					vPortTraceRecord( portTRACE_QUEUE_CREATE, portTRACE_OBJECT( pxNewQueue ) )
+	#define traceQUEUE_SEND( pxQueue )						vPortTraceRecord( portTRACE_QUEUE_SEND, portTRACE_OBJECT( pxQueue ) )
+	#define traceQUEUE_RECEIVE( pxQueue )					vPortTraceRecord( portTRACE_QUEUE_RECEIVE, portTRACE_OBJECT( pxQueue ) )
+	#define traceQUEUE_SEND_FROM_ISR( pxQueue )				vPortTraceRecord( portTRACE_QUEUE_SEND_FROM_ISR, portTRACE_OBJECT( pxQueue ) )
+	#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )			vPortTraceRecord( portTRACE_QUEUE_RECEIVE_FROM_ISR, portTRACE_OBJECT( pxQueue ) )
+	#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )			vPortTraceRecord( portTRACE_QUEUE_BLOCK_SEND, portTRACE_OBJECT( pxQueue ) )
+	#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )		vPortTraceRecord( portTRACE_QUEUE_BLOCK_RECEIVE, portTRACE_OBJECT( pxQueue ) )
+	#define traceTIMER_EXPIRED( pxTimer )					vPortTraceRecord( portTRACE_TIMER_EXPIRED, portTRACE_OBJECT( pxTimer ) )
+
+	/* application marker, the value is truncated to 24 bits */
+	#define portTRACE_USER_EVENT( ulValue )					vPortTraceRecord( portTRACE_USER, ( ulValue ) )
+#endif
+/*-----------------------------------------------------------*/
+
+/* Bulk copies through DMA. */
+#if ( configUSE_DMA_COPY == 1 )
+	#ifndef configDMA_COPY_CHANNEL
+		#define configDMA_COPY_CHANNEL				11
+	#endif
+
+	#ifndef configDMA_COPY_IRQ
+		#define configDMA_COPY_IRQ					1
+	#endif
+
+	#ifndef configDMA_COPY_THRESHOLD
+		#define configDMA_COPY_THRESHOLD			64
+	#endif
+
+	#ifndef configDMA_COPY_BLOCK_THRESHOLD
+		#define configDMA_COPY_BLOCK_THRESHOLD		1024
+	#endif
+
+	#ifndef configDMA_COPY_NOTIFY_INDEX
+		#define configDMA_COPY_NOTIFY_INDEX			1
+	#endif
+
+	#ifndef configDMA_COPY_INTERRUPT_PRIORITY
+		#define configDMA_COPY_INTERRUPT_PRIORITY	configSysTick_INTERRUPT_PRIORITY
+	#endif
+
+	#if ( configDMA_COPY_CHANNEL > 11 ) || ( configDMA_COPY_IRQ > 1 )
+		#error The RP2040 has DMA channels 0 to 11 and DMA interrupts 0 and 1.
+	#endif
+
+	#if ( configDMA_COPY_NOTIFY_INDEX == 0 )
+		#error configDMA_COPY_NOTIFY_INDEX must be a task notification index other than 0.
+	#endif
+
+	/* the small copies stay on the CPU, the call to the DMA path is not worth it */
+	#define portMEMCPY( pvDest, pvSrc, xLength )	( ( ( size_t ) ( xLength ) >= ( size_t ) configDMA_COPY_THRESHOLD ) ? pvPortDmaCopy( ( pvDest ), ( pvSrc ), ( xLength ) ) : memcpy( ( pvDest ), ( pvSrc ), ( xLength ) ) )
+#endif
+/*-----------------------------------------------------------*/
+
+/* Critical section profiling. */
+#if ( configUSE_CRITICAL_SECTION_STATS == 1 )
+	#ifndef configCRITICAL_SECTION_SITES
+		#define configCRITICAL_SECTION_SITES		32
+	#endif
+	#if ( configNUMBER_OF_CORES > 1 )
+		#error configUSE_CRITICAL_SECTION_STATS is supported only when configNUMBER_OF_CORES is 1, the SMP critical sections are entered through the kernel.
+	#endif
+	#if ( configCRITICAL_SECTION_SITES < 1 )
+		#error configCRITICAL_SECTION_SITES must be at least 1.
+	#endif
+#endif
+/*-----------------------------------------------------------*/
+
+/* Inter-core mailboxes. */
+#if ( configUSE_CORE_MAILBOX == 1 )
+	#ifndef configCORE_MAILBOX_COUNT
+		#define configCORE_MAILBOX_COUNT			4
+	#endif
+
+	#ifndef configCORE_MAILBOX_NOTIFY_INDEX
+		#define configCORE_MAILBOX_NOTIFY_INDEX		2
+	#endif
+
+	#if ( configCORE_MAILBOX_NOTIFY_INDEX == 0 )
+		#error configCORE_MAILBOX_NOTIFY_INDEX must be a task notification index other than 0.
+	#endif
+
+	#if ( configUSE_DMA_COPY == 1 ) && ( configCORE_MAILBOX_NOTIFY_INDEX == configDMA_COPY_NOTIFY_INDEX )
+		#error configCORE_MAILBOX_NOTIFY_INDEX and configDMA_COPY_NOTIFY_INDEX must be different task notification indexes.
+	#endif
+#endif
+/*-----------------------------------------------------------*/
+
+/* High resolution timers. */
+#if ( configUSE_HR_TIMERS == 1 )
+	/* timer alarm (0..3) that expires the microsecond timers */
+	#ifndef configHR_TIMER_ALARM
+		#define configHR_TIMER_ALARM				1
+	#endif
+
+	#ifndef configHR_TIMER_INTERRUPT_PRIORITY
+		#define configHR_TIMER_INTERRUPT_PRIORITY	configMAX_SYSCALL_INTERRUPT_PRIORITY
+	#endif
+
+	#ifndef configHR_TIMER_NOTIFY_INDEX
+		#define configHR_TIMER_NOTIFY_INDEX			3
+	#endif
+
+	#if ( configHR_TIMER_NOTIFY_INDEX == 0 )
+		#error configHR_TIMER_NOTIFY_INDEX must be a task notification index other than 0.
+	#endif
+
+	#if ( ( configUSE_DMA_COPY == 1 ) && ( configHR_TIMER_NOTIFY_INDEX == configDMA_COPY_NOTIFY_INDEX ) ) || ( ( configUSE_CORE_MAILBOX == 1 ) && ( configHR_TIMER_NOTIFY_INDEX == configCORE_MAILBOX_NOTIFY_INDEX ) )
+		#error configHR_TIMER_NOTIFY_INDEX must be a task notification index of its own.
+	#endif
+
+	#if ( configUSE_TICKLESS_IDLE == 1 ) && ( configHR_TIMER_ALARM == configTICKLESS_TIMER_ALARM )
+		#error configHR_TIMER_ALARM and configTICKLESS_TIMER_ALARM must be different timer alarms.
+	#endif
+#endif
+/*-----------------------------------------------------------*/
+
+/* Single producer, single consumer channels. */
+#if ( configUSE_SPSC_CHANNELS == 1 )
+	#ifndef configSPSC_CHANNEL_NOTIFY_INDEX
+		#define configSPSC_CHANNEL_NOTIFY_INDEX		4
+	#endif
+
+	#if ( configSPSC_CHANNEL_NOTIFY_INDEX == 0 )
+		#error configSPSC_CHANNEL_NOTIFY_INDEX must be a task notification index other than 0.
+	#endif
+
+	#if ( ( configUSE_DMA_COPY == 1 ) && ( configSPSC_CHANNEL_NOTIFY_INDEX == configDMA_COPY_NOTIFY_INDEX ) ) || ( ( configUSE_CORE_MAILBOX == 1 ) && ( configSPSC_CHANNEL_NOTIFY_INDEX == configCORE_MAILBOX_NOTIFY_INDEX ) ) || ( ( configUSE_HR_TIMERS == 1 ) && ( configSPSC_CHANNEL_NOTIFY_INDEX == configHR_TIMER_NOTIFY_INDEX ) )
+		#error configSPSC_CHANNEL_NOTIFY_INDEX must be a task notification index of its own.
+	#endif
+#endif
+/*-----------------------------------------------------------*/
+
+/* Task notification array. Index 0 is left to the application, each facility
+enabled above wakes its tasks through an index of its own. Unless
+FreeRTOSConfig.h sets configTASK_NOTIFICATION_ARRAY_ENTRIES the array ends at
+the highest of those indexes, a build without them keeps a single entry. */
+#if ( configUSE_DMA_COPY == 1 )
+	#define portDMA_COPY_NOTIFY_ENTRIES			( configDMA_COPY_NOTIFY_INDEX + 1 )
+#else
+	#define portDMA_COPY_NOTIFY_ENTRIES			1
+#endif
+
+#if ( configUSE_CORE_MAILBOX == 1 )
+	#define portCORE_MAILBOX_NOTIFY_ENTRIES		( configCORE_MAILBOX_NOTIFY_INDEX + 1 )
+#else
+	#define portCORE_MAILBOX_NOTIFY_ENTRIES		1
+#endif
+
+#if ( configUSE_HR_TIMERS == 1 )
+	#define portHR_TIMER_NOTIFY_ENTRIES			( configHR_TIMER_NOTIFY_INDEX + 1 )
+#else
+	#define portHR_TIMER_NOTIFY_ENTRIES			1
+#endif
+
+#if ( configUSE_SPSC_CHANNELS == 1 )
+	#define portSPSC_CHANNEL_NOTIFY_ENTRIES		( configSPSC_CHANNEL_NOTIFY_INDEX + 1 )
+#else
+	#define portSPSC_CHANNEL_NOTIFY_ENTRIES		1
+#endif
+
+#define portMAX_NOTIFY_ENTRIES( a, b )			( ( ( a ) > ( b ) ) ? ( a ) : ( b ) )
+#define portTASK_NOTIFICATION_ENTRIES_NEEDED	portMAX_NOTIFY_ENTRIES( portMAX_NOTIFY_ENTRIES( portDMA_COPY_NOTIFY_ENTRIES, portCORE_MAILBOX_NOTIFY_ENTRIES ), portMAX_NOTIFY_ENTRIES( portHR_TIMER_NOTIFY_ENTRIES, portSPSC_CHANNEL_NOTIFY_ENTRIES ) )
+
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES	portTASK_NOTIFICATION_ENTRIES_NEEDED
+#endif
+
+#if ( configTASK_NOTIFICATION_ARRAY_ENTRIES < portTASK_NOTIFICATION_ENTRIES_NEEDED )
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES leaves out the notification index of an enabled facility, increase it or remove it from FreeRTOSConfig.h.
+#endif
+/*-----------------------------------------------------------*/
+
+/* Run time statistics. */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vPortConfigureRunTimeCounter()
+	#define portGET_RUN_TIME_COUNTER_VALUE()			ulPortGetRunTimeCounterValue()
+#endif
+/*-----------------------------------------------------------*/
+
+/* SRAM classes of the heap_5.c regions. Each striped word of SRAM0-3 hits a
+different bank, so both cores and the DMA share all four. A single bank (SRAM0-3
+through the non-striped aliases at 0x21000000) keeps a buffer away from the
+others, and the 4 KB SCRATCH_X/SCRATCH_Y banks (SRAM4/5) are best left to one
+core each.
+
+The striped and the bank aliases are the same memory: word n of the striped
+range 0x20000000-0x2003ffff is word n / 4 of bank n % 4, and bank b is also at
+0x21000000 + b * 0x10000. A striped region [S, S + L) therefore uses the bank
+offsets [S / 4, (S + L) / 4) of all four banks, 0x20020000-0x2002ffff takes
+0x8000-0xbfff of every bank. A BANK region must stay clear of those offsets,
+and of the striped memory the linker script uses. heap_5.c asserts that no two
+regions share memory through either alias. */
+#define portHEAP_CLASS_STRIPED					0
+#define portHEAP_CLASS_BANK						1
+#define portHEAP_CLASS_SCRATCH					2
+
+#define portSRAM_STRIPED_BASE					( 0x20000000UL )
+#define portSRAM_STRIPED_END					( 0x20040000UL )
+#define portSRAM_BANK_BASE						( 0x21000000UL )
+#define portSRAM_BANK_END						( 0x21040000UL )
+#define portSRAM_BANK_SIZE						( 0x10000UL )
+
+/* banks and bank offsets [ulStart, ulEnd) an address range uses, the range is
+returned unchanged outside of SRAM0-3 */
+static portFORCE_INLINE uint32_t ulPortSramBanks( uint32_t *pulStart, uint32_t *pulEnd )
+{
+	uint32_t ulBanks = 0UL;
+
+	if( ( *pulStart >= portSRAM_STRIPED_BASE ) && ( *pulEnd <= portSRAM_STRIPED_END ) )
+	{
+		/* every 16 striped bytes take 4 bytes of each bank */
+		*pulStart = ( ( *pulStart - portSRAM_STRIPED_BASE ) >> 4 ) << 2;
+		*pulEnd = ( ( *pulEnd - portSRAM_STRIPED_BASE + 15UL ) >> 4 ) << 2;
+		ulBanks = 0xfUL;
+	}
+	else if( ( *pulStart >= portSRAM_BANK_BASE ) && ( *pulEnd <= portSRAM_BANK_END ) )
+	{
+		const uint32_t ulFirst = ( *pulStart - portSRAM_BANK_BASE ) / portSRAM_BANK_SIZE;
+		const uint32_t ulLast = ( *pulEnd - 1UL - portSRAM_BANK_BASE ) / portSRAM_BANK_SIZE;
+
+		ulBanks = ( ( 2UL << ulLast ) - 1UL ) & ~( ( 1UL << ulFirst ) - 1UL );
+		if( ulFirst == ulLast )
+		{
+			*pulStart -= portSRAM_BANK_BASE + ( ulFirst * portSRAM_BANK_SIZE );
+			*pulEnd -= portSRAM_BANK_BASE + ( ulFirst * portSRAM_BANK_SIZE );
+		}
+		else
+		{
+			/* a region across banks is checked against the whole banks */
+			*pulStart = 0UL;
+			*pulEnd = portSRAM_BANK_SIZE;
+		}
+	}
+
+	return ulBanks;
+}
+
+/* two heap_5.c regions share memory, directly or through the striped and bank aliases */
+static portFORCE_INLINE BaseType_t xPortHeapRegionsOverlap( const uint8_t *pucStartA, size_t xSizeA, const uint8_t *pucStartB, size_t xSizeB )
+{
+	uint32_t ulStartA = ( uint32_t ) pucStartA, ulEndA = ( uint32_t ) pucStartA + xSizeA;
+	uint32_t ulStartB = ( uint32_t ) pucStartB, ulEndB = ( uint32_t ) pucStartB + xSizeB;
+	const uint32_t ulBanksA = ulPortSramBanks( &ulStartA, &ulEndA );
+	const uint32_t ulBanksB = ulPortSramBanks( &ulStartB, &ulEndB );
+
+	/* a range of SRAM0-3 and one outside of it never share memory */
+	if( ( ulBanksA == 0UL ) != ( ulBanksB == 0UL ) )
+	{
+		return pdFALSE;
+	}
+
+	if( ( ulBanksA != 0UL ) && ( ( ulBanksA & ulBanksB ) == 0UL ) )
+	{
+		return pdFALSE;
+	}
+
+	return ( ( ulStartA < ulEndB ) && ( ulStartB < ulEndA ) ) ? pdTRUE : pdFALSE;
+}
+#define portHEAP_REGIONS_OVERLAP( pucStartA, xSizeA, pucStartB, xSizeB )	xPortHeapRegionsOverlap( ( pucStartA ), ( xSizeA ), ( pucStartB ), ( xSizeB ) )
+/*-----------------------------------------------------------*/
+
+/* Tickless idle/low power functionality. */
+#if ( configUSE_TICKLESS_IDLE == 1 )
+	#if ( configNUMBER_OF_CORES > 1 )
+		#error Tickless idle stops the tick of both cores and is supported only when configNUMBER_OF_CORES is 1.
+	#endif
+
+	/* timer alarm (0..3) that wakes the core at the end of the idle period */
+	#ifndef configTICKLESS_TIMER_ALARM
+		#define configTICKLESS_TIMER_ALARM			0
+	#endif
+
+	extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+/*-----------------------------------------------------------*/
+
 /* optimized task selection - max 32 priorities */
 #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
 	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
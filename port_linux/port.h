@@ -0,0 +1,79 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Linux host simulator, runs the kernel as a single process                 |
+ |___________________________________________________________________________*/
+
+#pragma once
+
+#if ( configNUMBER_OF_CORES > 1 )
+/* critical nesting counters maintained by the kernel, one per core */
+extern uint32_t uxCriticalNestings[];
+
+/* number of the core of the caller, the host thread that runs it */
+extern uint32_t ulPortGetCoreID(void);
+
+/* non zero while the core runs the tick or a handler of vPortRunAsInterrupt() */
+extern uint32_t ulPortInsideInterrupt(void);
+
+/* yield the current task of the given core */
+extern void vPortYieldCore(int32_t xCoreID);
+
+/* recursive inter-core lock used by the kernel */
+extern void vPortRecursiveLock(uint32_t ulLockNum, int32_t xAcquire);
+#else
+/* critical nesting counter maintained by port */
+extern uint32_t uxCriticalNesting;
+#endif
+
+extern uint32_t ulSetInterruptMaskFromISR();
+extern void vClearInterruptMaskFromISR(uint32_t mask);
+
+extern void vPortDisableInterrupts();
+extern void vPortEnableInterrupts();
+
+/* critical section handling */
+extern void vPortEnterCritical();
+extern void vPortExitCritical();
+
+/* used to catch tasks that attempt to return from their implementing function. */
+extern void vPortTaskExitError(void);
+
+/* yield the next highest prio task */
+extern void vPortYield(void);
+
+/* free the host stack and the context of a deleted task */
+extern void vPortCleanUpThread(void *pvTopOfStack);
+
+/* execute a handler as an interrupt, the simulated interrupts of the application */
+extern void vPortRunAsInterrupt(void (*pxHandler)(void));
+
+/* raise an interrupt on core 0 from the host thread of a simulated peripheral */
+extern void vPortRaiseInterrupt(void (*pxHandler)(void));
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+/* CLOCK_MONOTONIC is the run time counter, one count per microsecond */
+extern void vPortConfigureRunTimeCounter(void);
+extern uint64_t ulPortGetRunTimeCounterValue(void);
+#endif
@@ -0,0 +1,86 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Linux host simulator, runs the kernel as a single process                 |
+ |___________________________________________________________________________*/
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "portmacro.h"
+#include "port.h"
+
+/**
+ * This function will be called by each tick interrupt if configUSE_TICK_HOOK
+ * is set to 1 in FreeRTOSConfig.h.  On the simulator the tick interrupt is the
+ * SIGALRM handler, so only the interrupt safe FreeRTOS API functions can be
+ * used (those that end in FromISR()).
+ */
+void __attribute__((weak)) vApplicationTickHook() { }
+
+/**
+ *  vApplicationIdleHook() will only be called if configUSE_IDLE_HOOK is set
+ *  to 1 in FreeRTOSConfig.h.  It will be called on each iteration of the idle
+ * task.  It must never attempt to block and must return to its calling
+ * function, the idle task frees the memory of the deleted tasks. The default
+ * one gives the host processor to the threads of the other cores.
+ */
+void __attribute__((weak)) vApplicationIdleHook(void) { sched_yield(); }
+
+/**
+ *  vApplicationPassiveIdleHook() will only be called if
+ *  configUSE_PASSIVE_IDLE_HOOK is set to 1 in FreeRTOSConfig.h.  It is called
+ *  on each iteration of the passive idle tasks of the other cores, the default
+ *  one gives the host processor to the threads of the other cores.
+ */
+void __attribute__((weak)) vApplicationPassiveIdleHook(void) { sched_yield(); }
+
+/**
+ * @brief Malloc failed hook function.
+ *
+ * Called if a call to pvPortMalloc() fails because there is insufficient free
+ * memory available in the FreeRTOS heap.
+ */
+void __attribute__((weak)) vApplicationMallocFailedHook()
+{
+    fprintf(stderr, "vApplicationMallocFailedHook: malloc failed\n");
+    abort();
+}
+
+/**
+ * @brief Run time stack overflow checking hook function.
+ *
+ * The tasks run on their host stacks, only a corruption of the kernel stack
+ * that holds the context can be detected.
+ * \param[in] pxTask Task handle
+ * \param[in] pcTaskName Task name
+ */
+void __attribute__((weak)) vApplicationStackOverflowHook(TaskHandle_t pxTask, char *pcTaskName)
+{
+    (void)pxTask;
+    fprintf(stderr, "vApplicationStackOverflowHook: stack overflow is detected in %s\n", pcTaskName);
+    abort();
+}
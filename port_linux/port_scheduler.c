@@ -0,0 +1,759 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Linux host simulator, runs the kernel as a single process                 |
+ |___________________________________________________________________________*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <ucontext.h>
+#include <sys/time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+#include "portmacro.h"
+
+/* context of a task, the kernel stack of the task holds a pointer to it */
+typedef struct {
+    ucontext_t xContext;            /* registers and signal mask of the task */
+    TaskFunction_t pxCode;          /* task function */
+    void *pvParameters;             /* parameter of the task function */
+    void *pvStack;                  /* host stack of the task */
+    volatile uint32_t ulInUse;      /* set while a core runs the task or saves its context */
+} PortThread_t;
+
+#if ( configNUMBER_OF_CORES > 1 )
+/* critical nesting counters, one per core */
+uint32_t uxCriticalNestings[configNUMBER_OF_CORES] = { 0 };
+#else
+/* critical nesting counter, 0 whenever a task is switched out */
+uint32_t uxCriticalNesting = 0;
+#endif
+
+/* The interrupt mask of the simulated core. The signals are not blocked while
+the tasks run, a tick or a doorbell that arrives while the mask is set is only
+recorded and processed once the mask is cleared, the same way a pending SysTick
+and PendSV are taken on the target. Masking is therefore a plain store, without
+a system call. The mask is thread local: every core is a host thread and the
+store stays a single instruction even if the task moves to another core right
+before it. Only core 0 takes the tick. */
+static __thread volatile uint32_t ulInterruptsMasked = 1;
+static volatile uint32_t ulPendingYield[configNUMBER_OF_CORES];
+static volatile uint32_t ulInsideInterrupt[configNUMBER_OF_CORES];
+static volatile uint32_t ulPendingTicks = 0;
+
+/* Interrupt raised by a simulated peripheral, a host thread outside of the
+kernel. It is delivered to core 0 with SIGUSR2 and taken like the tick. */
+static void (*volatile pxPendingHandler)(void) = NULL;
+static pthread_t xInterruptThread;
+static struct sigaction xPreviousPeripheralAction;
+
+/* task switched out by each core, released once its context is saved */
+static PortThread_t *volatile pxSwitchedOut[configNUMBER_OF_CORES];
+
+/* context of each core before the scheduler started, resumed by vTaskEndScheduler() */
+static ucontext_t xSchedulerContexts[configNUMBER_OF_CORES];
+static struct sigaction xPreviousTickAction;
+
+#if ( configNUMBER_OF_CORES > 1 )
+/* Every core is a host thread, core 0 is the thread that started the
+scheduler. The tasks move between the threads, the core number stays with the
+thread. The doorbell between the cores is SIGUSR1, sent with pthread_kill(). */
+static pthread_t xCoreThreads[configNUMBER_OF_CORES];
+static __thread volatile uint32_t ulThisCore = 0;
+static volatile uint32_t ulSchedulerEnding = 0;
+static struct sigaction xPreviousDoorbellAction;
+#endif
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+static uint64_t ulRunTimeStart = 0;
+#endif
+
+/**
+ * @brief Context of the task selected by the kernel.
+ *
+ * @return the context stored in the kernel stack of pxCurrentTCB
+ */
+static PortThread_t *prvCurrentThread(void)
+{
+#if ( configNUMBER_OF_CORES > 1 )
+    TaskHandle_t xTask = xTaskGetCurrentTaskHandleForCore((BaseType_t)portGET_CORE_ID());
+#else
+    TaskHandle_t xTask = xTaskGetCurrentTaskHandle();
+#endif
+
+    /* pxTopOfStack is the first member of the TCB */
+    StackType_t *pxTopOfStack = *(StackType_t **)xTask;
+    return (PortThread_t *)(uintptr_t)(*pxTopOfStack);
+}
+
+/**
+ * @brief Release the task switched out by this core before the running task
+ * was switched in, its context is saved by now and another core may run it.
+ *
+ */
+static void prvReleaseSwitchedOut(void)
+{
+    const uint32_t ulCore = portGET_CORE_ID();
+    PortThread_t *pxThread = pxSwitchedOut[ulCore];
+
+    if (pxThread != NULL) {
+        pxSwitchedOut[ulCore] = NULL;
+        __atomic_store_n(&pxThread->ulInUse, 0, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief Switch to the task selected by the kernel.
+ *
+ * Called with the interrupts masked and outside of any critical section. The
+ * context of the current task is saved where it is, in the task or in the tick
+ * signal handler, and execution continues from there once the task is
+ * selected again.
+ */
+static void prvSwitchContext(void)
+{
+    PortThread_t *pxPrevious = prvCurrentThread();
+    PortThread_t *pxNext;
+
+#if ( configNUMBER_OF_CORES > 1 )
+    vTaskSwitchContext((BaseType_t)portGET_CORE_ID());
+#else
+    vTaskSwitchContext();
+#endif
+
+    pxNext = prvCurrentThread();
+    if (pxNext != pxPrevious) {
+        /* a task switched out by the other core may still be saving its context */
+        while (__atomic_exchange_n(&pxNext->ulInUse, 1, __ATOMIC_ACQUIRE) != 0) {
+            sched_yield();
+        }
+
+        pxSwitchedOut[portGET_CORE_ID()] = pxPrevious;
+        swapcontext(&pxPrevious->xContext, &pxNext->xContext);
+
+        /* running again, possibly on another core */
+        prvReleaseSwitchedOut();
+    }
+}
+
+/**
+ * @brief Process the ticks and the context switch pended while the interrupts
+ * were masked.
+ *
+ */
+static void prvServicePendingInterrupts(void)
+{
+    const uint32_t ulCore = portGET_CORE_ID();
+    uint32_t ulTicks;
+
+    while ((ulCore == 0) && ((ulTicks = __atomic_exchange_n(&ulPendingTicks, 0, __ATOMIC_SEQ_CST)) != 0)) {
+        ulInsideInterrupt[ulCore] = 1;
+        while (ulTicks-- > 0) {
+#if ( configNUMBER_OF_CORES > 1 )
+            /* the kernel lock keeps the other core out of the lists while the
+            tick is processed */
+            UBaseType_t uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+#endif
+            if (xTaskIncrementTick() != pdFALSE) {
+                ulPendingYield[ulCore] = 1;
+            }
+#if ( configNUMBER_OF_CORES > 1 )
+            taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+#endif
+        }
+        ulInsideInterrupt[ulCore] = 0;
+    }
+
+    if (ulCore == 0) {
+        void (*pxHandler)(void) = __atomic_exchange_n(&pxPendingHandler, NULL, __ATOMIC_SEQ_CST);
+
+        if (pxHandler != NULL) {
+            ulInsideInterrupt[ulCore] = 1;
+            pxHandler();
+            ulInsideInterrupt[ulCore] = 0;
+        }
+    }
+
+    if (__atomic_exchange_n(&ulPendingYield[ulCore], 0, __ATOMIC_SEQ_CST) != 0) {
+        prvSwitchContext();
+    }
+}
+
+/**
+ * @brief Handler for the SIGALRM of the tick timer.
+ *
+ * The tick is counted as pending and processed right away unless the
+ * interrupts are masked. A context switch from here suspends the current task
+ * inside the handler, it returns from the signal when it runs again.
+ *
+ * @param iSignal     signal number, always SIGALRM
+ */
+static void prvTickSignalHandler(int iSignal)
+{
+#if ( configNUMBER_OF_CORES > 1 )
+    if (ulSchedulerEnding != 0) {
+        setcontext(&xSchedulerContexts[portGET_CORE_ID()]);
+    }
+
+    /* the signal goes to any thread of the process, the tick belongs to core 0 */
+    if (portGET_CORE_ID() != 0) {
+        pthread_kill(xCoreThreads[0], iSignal);
+        return;
+    }
+#else
+    (void)iSignal;
+#endif
+
+    __atomic_add_fetch(&ulPendingTicks, 1, __ATOMIC_SEQ_CST);
+    if (ulInterruptsMasked == 0) {
+        vPortDisableInterrupts();
+        vPortEnableInterrupts();
+    }
+}
+
+/**
+ * @brief Handler for the SIGUSR2 of the simulated peripherals.
+ *
+ * The handler of the peripheral is pending already, it is taken right away
+ * unless the interrupts of core 0 are masked.
+ *
+ * @param iSignal     signal number, always SIGUSR2
+ */
+static void prvPeripheralSignalHandler(int iSignal)
+{
+    (void)iSignal;
+
+#if ( configNUMBER_OF_CORES > 1 )
+    if (ulSchedulerEnding != 0) {
+        setcontext(&xSchedulerContexts[portGET_CORE_ID()]);
+    }
+#endif
+
+    if (ulInterruptsMasked == 0) {
+        vPortDisableInterrupts();
+        vPortEnableInterrupts();
+    }
+}
+
+/**
+ * @brief First code executed by every task.
+ *
+ * The task is entered from a context switch, with the interrupts masked.
+ */
+static void prvTaskEntry(void)
+{
+    PortThread_t *pxThread = prvCurrentThread();
+
+    prvReleaseSwitchedOut();
+    vPortEnableInterrupts();
+    pxThread->pxCode(pxThread->pvParameters);
+
+    /* tasks must not return from their function */
+    vPortTaskExitError();
+}
+
+/**
+ * @brief Setup the context of a new task.
+ *
+ * The task gets a host stack of configSIMULATOR_STACK_SIZE bytes, the kernel
+ * stack only stores the pointer to the context. The tick signal is unblocked
+ * in the context regardless of the signal mask of the creator.
+ *
+ * @param pxTopOfStack    top of the kernel stack
+ * @param pxCode          task function
+ * @param pvParameters    parameter of the task function
+ * @return the new top of the kernel stack
+ */
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters)
+{
+    PortThread_t *pxThread;
+    uint32_t ulMask;
+
+    /* a task switch inside malloc() would deadlock on the allocator lock */
+    ulMask = ulSetInterruptMaskFromISR();
+    pxThread = malloc(sizeof(PortThread_t));
+    configASSERT(pxThread != NULL);
+    pxThread->pvStack = malloc(configSIMULATOR_STACK_SIZE);
+    configASSERT(pxThread->pvStack != NULL);
+    vClearInterruptMaskFromISR(ulMask);
+
+    pxThread->pxCode = pxCode;
+    pxThread->pvParameters = pvParameters;
+    pxThread->ulInUse = 0;
+
+    getcontext(&pxThread->xContext);
+    pxThread->xContext.uc_stack.ss_sp = pxThread->pvStack;
+    pxThread->xContext.uc_stack.ss_size = configSIMULATOR_STACK_SIZE;
+    pxThread->xContext.uc_link = NULL;
+    sigdelset(&pxThread->xContext.uc_sigmask, SIGALRM);
+    sigdelset(&pxThread->xContext.uc_sigmask, SIGUSR2);
+#if ( configNUMBER_OF_CORES > 1 )
+    sigdelset(&pxThread->xContext.uc_sigmask, SIGUSR1);
+#endif
+    makecontext(&pxThread->xContext, prvTaskEntry, 0);
+
+    *pxTopOfStack = (StackType_t)(uintptr_t)pxThread;
+    return pxTopOfStack;
+}
+
+/**
+ * @brief Free the host stack and the context of a deleted task.
+ *
+ * Called by the kernel once the task can no longer run, a task that deleted
+ * itself is cleaned up by the idle task. The core that switched the task out
+ * may still be saving its context.
+ *
+ * @param pvTopOfStack    top of the kernel stack, where the context is stored
+ */
+void vPortCleanUpThread(void *pvTopOfStack)
+{
+    PortThread_t *pxThread = *(PortThread_t **)pvTopOfStack;
+    uint32_t ulMask;
+
+    while (__atomic_load_n(&pxThread->ulInUse, __ATOMIC_ACQUIRE) != 0) {
+        sched_yield();
+    }
+
+    ulMask = ulSetInterruptMaskFromISR();
+    free(pxThread->pvStack);
+    free(pxThread);
+    vClearInterruptMaskFromISR(ulMask);
+}
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/**
+ * @brief Number of the core that executes the caller.
+ *
+ * Kept out of line so the thread local variable is read again on every call, a
+ * task may continue on another thread after any context switch.
+ *
+ * @return the core number
+ */
+uint32_t __attribute__((noinline)) ulPortGetCoreID(void)
+{
+    return ulThisCore;
+}
+
+/**
+ * @brief Tell whether the caller runs as a simulated interrupt, the tick or a
+ * handler of vPortRunAsInterrupt().
+ *
+ * @return non zero inside an interrupt
+ */
+uint32_t ulPortInsideInterrupt(void)
+{
+    return ulInsideInterrupt[portGET_CORE_ID()];
+}
+
+/**
+ * @brief Request a context switch on the given core.
+ *
+ * The switch is pended on the core first, so the core takes it the next time
+ * it unmasks its interrupts, then the thread of the core is signalled in case
+ * its interrupts are unmasked already.
+ *
+ * @param xCoreID     the core that has to yield
+ */
+void vPortYieldCore(int32_t xCoreID)
+{
+    if (xCoreID == (int32_t)portGET_CORE_ID()) {
+        vPortYield();
+    } else {
+        __atomic_store_n(&ulPendingYield[xCoreID], 1, __ATOMIC_SEQ_CST);
+        pthread_kill(xCoreThreads[xCoreID], SIGUSR1);
+    }
+}
+
+/**
+ * @brief Handler for the SIGUSR1 doorbell between the cores.
+ *
+ * The context switch was pended by the sender, it is taken right away unless
+ * the interrupts of the core are masked. Once the scheduler ends the doorbell
+ * takes the core out of whatever it executes.
+ *
+ * @param iSignal     signal number, always SIGUSR1
+ */
+static void prvDoorbellSignalHandler(int iSignal)
+{
+    (void)iSignal;
+
+    if (ulSchedulerEnding != 0) {
+        setcontext(&xSchedulerContexts[portGET_CORE_ID()]);
+    }
+
+    if (ulInterruptsMasked == 0) {
+        vPortDisableInterrupts();
+        vPortEnableInterrupts();
+    }
+}
+
+/**
+ * @brief Host thread of a core other than core 0.
+ *
+ * Starts the task the kernel selected for the core and returns once the
+ * scheduler ends.
+ *
+ * @param pvCore      number of the core
+ * @return NULL
+ */
+static void *prvCoreThread(void *pvCore)
+{
+    PortThread_t *pxThread;
+
+    ulThisCore = (uint32_t)(uintptr_t)pvCore;
+
+    pxThread = prvCurrentThread();
+    pxThread->ulInUse = 1;
+    swapcontext(&xSchedulerContexts[portGET_CORE_ID()], &pxThread->xContext);
+
+    return NULL;
+}
+
+#endif /* configNUMBER_OF_CORES */
+
+/**
+ * @brief This is the startup of the scheduler. The tick timer is started and
+ * the first task is executed.
+ *
+ * The threads that run the tasks start with the signals of the port blocked,
+ * the context of every task unblocks them. The signals are blocked again once
+ * the scheduler ends, the ones still pending are discarded before the
+ * previous handlers are restored.
+ *
+ * @return pdFALSE once vTaskEndScheduler() has been called
+ */
+BaseType_t xPortStartScheduler(void)
+{
+    const struct timespec xNoWait = { 0 };
+    struct sigaction xTickAction = { 0 };
+    struct itimerval xTickTimer = { 0 };
+    sigset_t xSignals, xPreviousSignals;
+    PortThread_t *pxThread;
+
+    sigemptyset(&xSignals);
+    sigaddset(&xSignals, SIGALRM);
+    sigaddset(&xSignals, SIGUSR2);
+#if ( configNUMBER_OF_CORES > 1 )
+    sigaddset(&xSignals, SIGUSR1);
+#endif
+    pthread_sigmask(SIG_BLOCK, &xSignals, &xPreviousSignals);
+
+    /* Initialise the critical nesting counts ready for the first tasks. */
+    for (uint32_t ulCore = 0; ulCore < configNUMBER_OF_CORES; ulCore++) {
+#if ( configNUMBER_OF_CORES > 1 )
+        uxCriticalNestings[ulCore] = 0;
+#endif
+        ulPendingYield[ulCore] = 0;
+        ulInsideInterrupt[ulCore] = 0;
+        pxSwitchedOut[ulCore] = NULL;
+    }
+#if ( configNUMBER_OF_CORES == 1 )
+    uxCriticalNesting = 0;
+#endif
+    ulInterruptsMasked = 1;
+    ulPendingTicks = 0;
+    pxPendingHandler = NULL;
+    xInterruptThread = pthread_self();
+
+#if ( configUSE_TASK_LATENCY_STATS == 1 )
+    /* the first task of each core starts below without a switch in */
+    vTaskStartLatencyStats();
+#endif
+
+    /* SA_RESTART keeps the system calls of the tasks going through the ticks */
+    xTickAction.sa_handler = prvTickSignalHandler;
+    xTickAction.sa_flags = SA_RESTART;
+    sigemptyset(&xTickAction.sa_mask);
+    sigaction(SIGALRM, &xTickAction, &xPreviousTickAction);
+
+    xTickAction.sa_handler = prvPeripheralSignalHandler;
+    sigaction(SIGUSR2, &xTickAction, &xPreviousPeripheralAction);
+
+#if ( configNUMBER_OF_CORES > 1 )
+    {
+        struct sigaction xDoorbellAction = { 0 };
+
+        xDoorbellAction.sa_handler = prvDoorbellSignalHandler;
+        xDoorbellAction.sa_flags = SA_RESTART;
+        sigemptyset(&xDoorbellAction.sa_mask);
+        sigaction(SIGUSR1, &xDoorbellAction, &xPreviousDoorbellAction);
+
+        /* the other cores start the tasks the kernel selected for them */
+        ulSchedulerEnding = 0;
+        xCoreThreads[0] = pthread_self();
+        for (uint32_t ulCore = 1; ulCore < configNUMBER_OF_CORES; ulCore++) {
+            int iResult = pthread_create(&xCoreThreads[ulCore], NULL, prvCoreThread, (void *)(uintptr_t)ulCore);
+            configASSERT(iResult == 0);
+            (void)iResult;
+        }
+    }
+#endif
+
+    xTickTimer.it_interval.tv_usec = 1000000L / configTICK_RATE_HZ;
+    xTickTimer.it_value = xTickTimer.it_interval;
+    setitimer(ITIMER_REAL, &xTickTimer, NULL);
+
+    /* start the first task, vPortEndScheduler() returns here */
+    pxThread = prvCurrentThread();
+    pxThread->ulInUse = 1;
+    swapcontext(&xSchedulerContexts[0], &pxThread->xContext);
+
+#if ( configNUMBER_OF_CORES > 1 )
+    for (uint32_t ulCore = 1; ulCore < configNUMBER_OF_CORES; ulCore++) {
+        pthread_join(xCoreThreads[ulCore], NULL);
+    }
+#endif
+
+    while (sigtimedwait(&xSignals, NULL, &xNoWait) > 0) {
+    }
+    sigaction(SIGALRM, &xPreviousTickAction, NULL);
+    sigaction(SIGUSR2, &xPreviousPeripheralAction, NULL);
+#if ( configNUMBER_OF_CORES > 1 )
+    sigaction(SIGUSR1, &xPreviousDoorbellAction, NULL);
+#endif
+    pthread_sigmask(SIG_SETMASK, &xPreviousSignals, NULL);
+
+    return pdFALSE;
+}
+
+/**
+ * @brief Stop the tick and return to the caller of vTaskStartScheduler().
+ *
+ * The other cores are signalled to leave their tasks as well. The tasks are
+ * not deleted, the memory they hold is released with the process.
+ */
+void vPortEndScheduler(void)
+{
+    struct itimerval xTickTimer = { 0 };
+
+    setitimer(ITIMER_REAL, &xTickTimer, NULL);
+
+#if ( configNUMBER_OF_CORES > 1 )
+    ulSchedulerEnding = 1;
+    for (uint32_t ulCore = 0; ulCore < configNUMBER_OF_CORES; ulCore++) {
+        if (ulCore != portGET_CORE_ID()) {
+            pthread_kill(xCoreThreads[ulCore], SIGUSR1);
+        }
+    }
+#endif
+
+    setcontext(&xSchedulerContexts[portGET_CORE_ID()]);
+}
+
+/**
+ * @brief Request a context switch.
+ *
+ * Inside a critical section or a simulated interrupt the switch stays pending
+ * until the interrupts are unmasked, like the PendSV on the target.
+ */
+void vPortYield(void)
+{
+    uint32_t ulMask = ulSetInterruptMaskFromISR();
+
+    ulPendingYield[portGET_CORE_ID()] = 1;
+    vClearInterruptMaskFromISR(ulMask);
+}
+
+/**
+ * @brief Execute a handler as an interrupt of the simulated core.
+ *
+ * Has to be called from a task, outside of a critical section. The handler
+ * runs with the interrupts masked and may use the FromISR API, a context
+ * switch it requests is taken when it returns.
+ *
+ * @param pxHandler   the interrupt handler
+ */
+void vPortRunAsInterrupt(void (*pxHandler)(void))
+{
+    uint32_t ulMask = ulSetInterruptMaskFromISR();
+
+    ulInsideInterrupt[portGET_CORE_ID()] = 1;
+    pxHandler();
+    ulInsideInterrupt[portGET_CORE_ID()] = 0;
+    vClearInterruptMaskFromISR(ulMask);
+}
+
+/**
+ * @brief Raise an interrupt from a simulated peripheral.
+ *
+ * Has to be called from a host thread that is not a core, the thread of a
+ * simulated peripheral. The handler runs on core 0 like the tick, right away
+ * or once core 0 unmasks its interrupts, and may use the FromISR API. A single
+ * interrupt is pending at a time, the caller waits until the previous one is
+ * taken.
+ *
+ * @param pxHandler   the interrupt handler
+ */
+void vPortRaiseInterrupt(void (*pxHandler)(void))
+{
+    void (*pxNone)(void) = NULL;
+
+    while (!__atomic_compare_exchange_n(&pxPendingHandler, &pxNone, pxHandler, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+        pxNone = NULL;
+        sched_yield();
+    }
+    pthread_kill(xInterruptThread, SIGUSR2);
+}
+
+/**
+ * @brief Mask the interrupts.
+ *
+ */
+void vPortDisableInterrupts()
+{
+    ulInterruptsMasked = 1;
+    portMEMORY_BARRIER();
+}
+
+/**
+ * @brief Unmask the interrupts, the pending ticks and the pending context
+ * switch are taken first.
+ *
+ */
+void vPortEnableInterrupts()
+{
+    for (;;) {
+        /* the task cannot move to another core while the interrupts are masked */
+        const uint32_t ulCore = portGET_CORE_ID();
+
+        portMEMORY_BARRIER();
+        ulInterruptsMasked = 0;
+        portMEMORY_BARRIER();
+
+        /* a tick, a doorbell or a peripheral that signals from here on is
+        processed by its own handler */
+        if (((ulCore != 0) || ((ulPendingTicks == 0) && (pxPendingHandler == NULL))) && (ulPendingYield[ulCore] == 0)) {
+            break;
+        }
+
+        ulInterruptsMasked = 1;
+        portMEMORY_BARRIER();
+        prvServicePendingInterrupts();
+    }
+}
+
+/**
+ * @brief Mask the interrupts and return the previous mask.
+ *
+ * @return the previous mask, for vClearInterruptMaskFromISR()
+ */
+uint32_t ulSetInterruptMaskFromISR()
+{
+    uint32_t ulMask = ulInterruptsMasked;
+
+    vPortDisableInterrupts();
+    return ulMask;
+}
+
+/**
+ * @brief Restore the mask returned by ulSetInterruptMaskFromISR().
+ *
+ * @param mask    the previous mask
+ */
+void vClearInterruptMaskFromISR(uint32_t mask)
+{
+    if (mask == 0) {
+        vPortEnableInterrupts();
+    }
+}
+
+#if ( configNUMBER_OF_CORES == 1 )
+
+/**
+ * @brief Enter a critical section.
+ *
+ */
+void vPortEnterCritical()
+{
+    vPortDisableInterrupts();
+    uxCriticalNesting++;
+}
+
+/**
+ * @brief Exit a critical section, the interrupts are unmasked when the
+ * outermost one is left.
+ *
+ */
+void vPortExitCritical()
+{
+    configASSERT(uxCriticalNesting);
+    uxCriticalNesting--;
+    if (uxCriticalNesting == 0) {
+        vPortEnableInterrupts();
+    }
+}
+
+#endif /* configNUMBER_OF_CORES */
+
+/**
+ * @brief Called when a task returns from its function.
+ *
+ */
+void vPortTaskExitError(void)
+{
+    fprintf(stderr, "vPortTaskExitError: task returned from its function\n");
+    abort();
+}
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+/**
+ * @brief Read CLOCK_MONOTONIC in microseconds.
+ *
+ * @return microseconds since an arbitrary point in the past
+ */
+static uint64_t prvMonotonicTimeUs(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return ((uint64_t)xNow.tv_sec * 1000000ULL) + ((uint64_t)xNow.tv_nsec / 1000ULL);
+}
+
+/**
+ * @brief Start the run time counter at 0.
+ *
+ */
+void vPortConfigureRunTimeCounter(void)
+{
+    ulRunTimeStart = prvMonotonicTimeUs();
+}
+
+/**
+ * @brief Read the run time counter.
+ *
+ * @return microseconds since vPortConfigureRunTimeCounter()
+ */
+uint64_t ulPortGetRunTimeCounterValue(void)
+{
+    return prvMonotonicTimeUs() - ulRunTimeStart;
+}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
@@ -0,0 +1,86 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Linux host simulator, runs the kernel as a single process                 |
+ |___________________________________________________________________________*/
+
+#include <sched.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "port.h"
+#include "portmacro.h"
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+#define portRTOS_SPINLOCK_COUNT         ( 2UL )
+
+/* owner of each kernel lock, the core number plus one, 0 when the lock is free */
+static volatile uint32_t ulLockOwner[portRTOS_SPINLOCK_COUNT];
+static volatile uint32_t ulRecursionCountByLock[portRTOS_SPINLOCK_COUNT];
+
+/**
+ * @brief Take or give one of the kernel locks.
+ *
+ * The locks are recursive so the same core may take a lock it already holds,
+ * which happens when a critical section is entered while the scheduler is
+ * suspended. Must be called with the interrupts masked on the calling core.
+ * A core that waits for the lock gives the host processor to the thread of
+ * the core that holds it.
+ *
+ * @param ulLockNum   lock number, portTASK_LOCK or portISR_LOCK
+ * @param xAcquire    pdTRUE to take the lock, pdFALSE to give it
+ */
+void vPortRecursiveLock(uint32_t ulLockNum, int32_t xAcquire)
+{
+    const uint32_t ulOwner = portGET_CORE_ID() + 1UL;
+
+    configASSERT(ulLockNum < portRTOS_SPINLOCK_COUNT);
+
+    if (xAcquire) {
+        uint32_t ulFree = 0;
+
+        if (__atomic_load_n(&ulLockOwner[ulLockNum], __ATOMIC_RELAXED) == ulOwner) {
+            /* already held by this core, just nest */
+            ulRecursionCountByLock[ulLockNum]++;
+            return;
+        }
+
+        while (!__atomic_compare_exchange_n(&ulLockOwner[ulLockNum], &ulFree, ulOwner, pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            ulFree = 0;
+            sched_yield();
+        }
+
+        configASSERT(ulRecursionCountByLock[ulLockNum] == 0);
+        ulRecursionCountByLock[ulLockNum] = 1;
+    } else {
+        configASSERT(ulLockOwner[ulLockNum] == ulOwner);
+        configASSERT(ulRecursionCountByLock[ulLockNum] != 0);
+
+        if (--ulRecursionCountByLock[ulLockNum] == 0) {
+            __atomic_store_n(&ulLockOwner[ulLockNum], 0, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+#endif /* configNUMBER_OF_CORES */
@@ -0,0 +1,210 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Linux host simulator, runs the kernel as a single process                 |
+ |___________________________________________________________________________*/
+
+#pragma once
+
+/* Programs that need other kernel options than the FreeRTOSConfig.h of the
+target name a header in configSIMULATOR_OPTIONS_HEADER, it is included before
+any option is used and changes them with #undef and #define. */
+#ifdef configSIMULATOR_OPTIONS_HEADER
+	#include configSIMULATOR_OPTIONS_HEADER
+#endif
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "port.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for a Linux
+ * process. The tasks run as ucontext contexts, every core is a thread of the
+ * process and the tick is the SIGALRM of an interval timer.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+typedef unsigned long StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+	/* 32-bit tick type on a 64-bit host, so reads of the tick count do not need
+	to be guarded with a critical section. */
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH						( -1 )
+#define portTICK_PERIOD_MS						( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT						16
+#define portPOINTER_SIZE_TYPE					uintptr_t
+#define portFORCE_INLINE 						inline __attribute__(( always_inline))
+
+#if ( configNUMBER_OF_CORES > 1 )
+	/* the cores are threads that run in parallel on the host */
+	#define portMEMORY_BARRIER()				__atomic_thread_fence( __ATOMIC_SEQ_CST )
+#else
+	/* all the tasks and the tick share one thread, only the compiler has to be stopped */
+	#define portMEMORY_BARRIER()				__atomic_signal_fence( __ATOMIC_SEQ_CST )
+#endif
+/*-----------------------------------------------------------*/
+
+/* Host stacks. The kernel stack of a task only holds its context, the task
+itself runs on a stack of this size allocated by the port. The C library and
+the signal frames need much more than the stack sizes used on the target. */
+#ifndef configSIMULATOR_STACK_SIZE
+	#define configSIMULATOR_STACK_SIZE			( 64 * 1024 )
+#endif
+
+/* the host stack and the context are freed with the task */
+#define portCLEAN_UP_TCB( pxTCB )				vPortCleanUpThread( ( void * ) ( pxTCB )->pxTopOfStack )
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities. */
+#define portYIELD() 							vPortYield()
+#define portYIELD_FROM_ISR() 					vPortYield()
+/*-----------------------------------------------------------*/
+
+/* Critical section management. */
+#define portSET_INTERRUPT_MASK_FROM_ISR()		ulSetInterruptMaskFromISR()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vClearInterruptMaskFromISR( x )
+#define portDISABLE_INTERRUPTS()				vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()					vPortEnableInterrupts()
+#if ( configNUMBER_OF_CORES == 1 )
+	#define portENTER_CRITICAL()					vPortEnterCritical()
+	#define portEXIT_CRITICAL()						vPortExitCritical()
+#else
+	/* the kernel takes the inter-core locks around the interrupt masking */
+	#define portENTER_CRITICAL()					vTaskEnterCritical()
+	#define portEXIT_CRITICAL()						vTaskExitCritical()
+	#define portENTER_CRITICAL_FROM_ISR()			vTaskEnterCriticalFromISR()
+	#define portEXIT_CRITICAL_FROM_ISR(x)			vTaskExitCriticalFromISR( x )
+#endif
+/*-----------------------------------------------------------*/
+
+/* Multicore support. Every core is a host thread, a task continues on the
+thread of the core that selects it. The tasks must not keep per-thread state of
+the C library, such as a stdio lock, across a point where they can be switched
+out, unless they suspend the scheduler around it. */
+#if ( configNUMBER_OF_CORES > 1 )
+	#define portGET_CORE_ID()						ulPortGetCoreID()
+	#define portYIELD_CORE( xCoreID )				vPortYieldCore( xCoreID )
+	#define portCHECK_IF_IN_ISR()					( ( ulPortInsideInterrupt() != 0UL ) ? pdTRUE : pdFALSE )
+	#define portASSERT_IF_IN_ISR()					configASSERT( portCHECK_IF_IN_ISR() == pdFALSE )
+
+	/* kernel locks, both recursive */
+	#define portTASK_LOCK							0UL
+	#define portISR_LOCK							1UL
+	#define portGET_TASK_LOCK()						vPortRecursiveLock( portTASK_LOCK, pdTRUE )
+	#define portRELEASE_TASK_LOCK()					vPortRecursiveLock( portTASK_LOCK, pdFALSE )
+	#define portGET_ISR_LOCK()						vPortRecursiveLock( portISR_LOCK, pdTRUE )
+	#define portRELEASE_ISR_LOCK()					vPortRecursiveLock( portISR_LOCK, pdFALSE )
+
+	/* critical nesting is counted per core */
+	#define portGET_CRITICAL_NESTING_COUNT()		( uxCriticalNestings[ portGET_CORE_ID() ] )
+	#define portSET_CRITICAL_NESTING_COUNT( x )		( uxCriticalNestings[ portGET_CORE_ID() ] = ( x ) )
+	#define portINCREMENT_CRITICAL_NESTING_COUNT()	( uxCriticalNestings[ portGET_CORE_ID() ]++ )
+	#define portDECREMENT_CRITICAL_NESTING_COUNT()	( uxCriticalNestings[ portGET_CORE_ID() ]-- )
+#else
+	/* the scheduler runs on the thread that started it */
+	#define portGET_CORE_ID()						( 0UL )
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+/* Options of the RP2040 port. The peripherals behind them are not simulated,
+they are turned off so the FreeRTOSConfig.h of the target builds unchanged. */
+
+#undef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE					0
+#undef configUSE_NVIC_PRIORITY_MASKING
+#define configUSE_NVIC_PRIORITY_MASKING			0
+#undef configUSE_SPINLOCK_STATS
+#define configUSE_SPINLOCK_STATS				0
+#undef configUSE_CRITICAL_SECTION_STATS
+#define configUSE_CRITICAL_SECTION_STATS		0
+#undef configUSE_ISR_RUN_TIME_STATS
+#define configUSE_ISR_RUN_TIME_STATS			0
+#undef configUSE_DMA_COPY
+#define configUSE_DMA_COPY						0
+#undef configUSE_CORE_MAILBOX
+#define configUSE_CORE_MAILBOX					0
+#undef configUSE_HR_TIMERS
+#define configUSE_HR_TIMERS						0
+#undef configUSE_TRACE_RECORDER
+#define configUSE_TRACE_RECORDER				0
+/*-----------------------------------------------------------*/
+
+ /* macros used to allow port/compiler specific language extensions.*/
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters )  void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters )        void vFunction( void *pvParameters )
+/*-----------------------------------------------------------*/
+
+/* Run time statistics. */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vPortConfigureRunTimeCounter()
+	#define portGET_RUN_TIME_COUNTER_VALUE()			ulPortGetRunTimeCounterValue()
+#endif
+/*-----------------------------------------------------------*/
+
+/* optimized task selection - max 32 priorities */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+#endif
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+	/* check the configuration. */
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#endif
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )    ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )     ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )  uxTopPriority = ( 31UL - ( uint32_t ) __builtin_clz( ( uint32_t ) ( uxReadyPriorities ) ) )
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+/* assertions enabled */
+#define configASSERT( x ) assert( x )
+
+#ifdef __cplusplus
+}
+#endif
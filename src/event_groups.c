@@ -40,6 +40,10 @@
 #include "timers.h"
 #include "event_groups.h"
 
+#if ( configUSE_OBJECT_POOLS == 1 )
+    #include "object_pool.h"
+#endif
+
 /* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -75,6 +79,16 @@ typedef struct EventGroupDef_t
     #endif
 } EventGroup_t;
 
+/* The event groups created dynamically are taken from a fixed size pool when
+ * configUSE_OBJECT_POOLS is 1. */
+#if ( configUSE_OBJECT_POOLS == 1 )
+    #define eventALLOCATE_EVENT_GROUP()               ( ( EventGroup_t * ) pvObjectPoolAllocate( eObjectPoolEventGroup, sizeof( EventGroup_t ) ) )
+    #define eventFREE_EVENT_GROUP( pxEventBits )      vObjectPoolFree( eObjectPoolEventGroup, ( pxEventBits ) )
+#else
+    #define eventALLOCATE_EVENT_GROUP()               ( ( EventGroup_t * ) pvPortMalloc( sizeof( EventGroup_t ) ) )
+    #define eventFREE_EVENT_GROUP( pxEventBits )      vPortFree( pxEventBits )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -162,7 +176,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
          * sizeof( TickType_t ), the TickType_t variables will be accessed in two
          * or more reads operations, and the alignment requirements is only that
          * of each individual read. */
-        pxEventBits = ( EventGroup_t * ) pvPortMalloc( sizeof( EventGroup_t ) ); /*lint !e9087 !e9079 see comment above. */
+        pxEventBits = eventALLOCATE_EVENT_GROUP(); /*lint !e9087 !e9079 see comment above. */
 
         if( pxEventBits != NULL )
         {
@@ -520,11 +534,11 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
     EventGroup_t const * const pxEventBits = xEventGroup;
     EventBits_t uxReturn;
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         uxReturn = pxEventBits->uxEventBits;
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return uxReturn;
 } /*lint !e818 EventGroupHandle_t is a typedef used in other functions to so can't be pointer to const. */
@@ -653,7 +667,7 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
     {
         /* The event group can only have been allocated dynamically - free
          * it again. */
-        vPortFree( pxEventBits );
+        eventFREE_EVENT_GROUP( pxEventBits );
     }
     #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
     {
@@ -661,7 +675,7 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
          * dynamically, so check before attempting to free the memory. */
         if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
         {
-            vPortFree( pxEventBits );
+            eventFREE_EVENT_GROUP( pxEventBits );
         }
         else
         {
@@ -0,0 +1,747 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * A sample implementation of pvPortMalloc() that allows the heap to be defined
+ * across multiple non-contigous blocks and combines (coalescences) adjacent
+ * memory blocks as they are freed.
+ *
+ * Every region belongs to a class of memory, given by the uxRegionClass member
+ * of its HeapRegion_t entry, and every class has its own free list.  This lets
+ * the application keep memory with different bus properties apart, for
+ * example task stacks in small per core banks and buffers shared with DMA in
+ * banks no core executes from.  pvPortMallocFromClass() allocates from one
+ * class only, pvPortMalloc() prefers configHEAP_DEFAULT_CLASS and falls back to
+ * the other classes when it is exhausted.
+ *
+ * See heap_3.c and heap_6.c for alternative implementations, and the memory
+ * management pages of https://www.FreeRTOS.org for more information.
+ *
+ * Usage notes:
+ *
+ * vPortDefineHeapRegions() ***must*** be called before pvPortMalloc().
+ * pvPortMalloc() will be called if any task objects (tasks, queues, event
+ * groups, etc.) are created, therefore vPortDefineHeapRegions() ***must*** be
+ * called before any other objects are defined.
+ *
+ * vPortDefineHeapRegions() takes a single parameter.  The parameter is an array
+ * of HeapRegion_t structures.  HeapRegion_t is defined in portable.h as
+ *
+ * typedef struct HeapRegion
+ * {
+ *  uint8_t *pucStartAddress; << Start address of a block of memory that will be part of the heap.
+ *  size_t xSizeInBytes;      << Size of the block of memory.
+ *  UBaseType_t uxRegionClass; << Class of memory the block belongs to.
+ * } HeapRegion_t;
+ *
+ * The array is terminated using a NULL zero sized region definition, and the
+ * regions of a class must appear in address order in the array, from lowest
+ * address to highest address.  The following example uses the RP2040 classes
+ * of portmacro.h:
+ *
+ * HeapRegion_t xHeapRegions[] =
+ * {
+ *  { ( uint8_t * ) 0x20020000UL, 0x10000, portHEAP_CLASS_STRIPED }, << 64K of the striped SRAM0-3, 0x8000-0xbfff of every bank.
+ *  { ( uint8_t * ) 0x2103c000UL, 0x4000, portHEAP_CLASS_BANK },     << the top 16K of SRAM3 through its non-striped alias.
+ *  { ( uint8_t * ) 0x20040000UL, 0x800, portHEAP_CLASS_SCRATCH },   << the part of SCRATCH_X not used by a stack.
+ *  { NULL, 0, 0 }                                                   << Terminates the array.
+ * };
+ *
+ * vPortDefineHeapRegions( xHeapRegions ); << Pass the array into vPortDefineHeapRegions().
+ *
+ * Note 0x20020000 is the lowest address so appears in the array first.  A
+ * region table that omits uxRegionClass puts every region in class 0.
+ *
+ * The striped and the non-striped addresses are aliases of the same SRAM (see
+ * portHEAP_CLASS_STRIPED), so the SRAM3 region above is also part of the
+ * striped range 0x20030000-0x2003ffff, which the linker script must leave
+ * unused.  vPortDefineHeapRegions() asserts that no two regions share memory.
+ *
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configHEAP_IMPLEMENTATION == 5 )
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#if ( configHEAP_REGION_CLASSES < 1 ) || ( configHEAP_REGION_CLASSES > 4 )
+    #error configHEAP_REGION_CLASSES must be between 1 and 4
+#endif
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Check if two regions share memory.  A port whose memory is visible at more
+ * than one address defines its own test that sees through the aliases. */
+#ifndef portHEAP_REGIONS_OVERLAP
+    #define portHEAP_REGIONS_OVERLAP( pucStartA, xSizeA, pucStartB, xSizeB ) \
+    ( ( ( pucStartA ) < ( ( pucStartB ) + ( xSizeB ) ) ) && ( ( pucStartB ) < ( ( pucStartA ) + ( xSizeA ) ) ) )
+#endif
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* The top bit of the block size is set while the block is allocated, the two
+ * bits below it then record the class the block has to be returned to. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_CLASS_SHIFT          ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 3 )
+#define heapBLOCK_CLASS_BITMASK        ( ( ( size_t ) 3 ) << heapBLOCK_CLASS_SHIFT )
+#define heapBLOCK_SIZE_IS_VALID( xBlockSize )    ( ( ( xBlockSize ) & ( heapBLOCK_ALLOCATED_BITMASK | heapBLOCK_CLASS_BITMASK ) ) == 0 )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock, uxClass )   ( ( pxBlock->xBlockSize ) |= ( heapBLOCK_ALLOCATED_BITMASK | ( ( ( size_t ) ( uxClass ) ) << heapBLOCK_CLASS_SHIFT ) ) )
+#define heapBLOCK_CLASS( pxBlock )               ( ( UBaseType_t ) ( ( ( pxBlock->xBlockSize ) & heapBLOCK_CLASS_BITMASK ) >> heapBLOCK_CLASS_SHIFT ) )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~( heapBLOCK_ALLOCATED_BITMASK | heapBLOCK_CLASS_BITMASK ) )
+
+/*-----------------------------------------------------------*/
+
+/* Define the linked list structure.  This is used to link free blocks in order
+ * of their memory address. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxNextFreeBlock; /*<< The next free block in the list. */
+    size_t xBlockSize;                     /*<< The size of the free block. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts a block of memory that is being freed into the correct position in
+ * the list of free memory blocks of its class.  The block being freed will be
+ * merged with the block in front it and/or the block behind it if the memory
+ * blocks are adjacent to each other.
+ */
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert,
+                                        UBaseType_t uxClass ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes the first block of the class that is large enough, xWantedSize already
+ * includes the block header and the alignment.  Must be called with the
+ * scheduler suspended.
+ */
+static void * prvAllocateFromClass( size_t xWantedSize,
+                                    UBaseType_t uxClass ) PRIVILEGED_FUNCTION;
+
+/*
+ * Common part of pvPortMalloc(), pvPortMallocStack() and
+ * pvPortMallocFromClass().  When xAnyClass is pdTRUE the other classes are
+ * tried in turn once uxClass is exhausted.
+ */
+static void * prvMalloc( size_t xWantedSize,
+                         UBaseType_t uxClass,
+                         BaseType_t xAnyClass ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+ * block must by correctly byte aligned. */
+static const size_t xHeapStructSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Create a couple of list links to mark the start and end of the list of each
+ * class. */
+PRIVILEGED_DATA static BlockLink_t xStart[ configHEAP_REGION_CLASSES ];
+PRIVILEGED_DATA static BlockLink_t * pxEnd[ configHEAP_REGION_CLASSES ];
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xFreeBytesRemainingInClass[ configHEAP_REGION_CLASSES ];
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0;
+PRIVILEGED_DATA static BaseType_t xHeapDefined = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    return prvMalloc( xWantedSize, configHEAP_DEFAULT_CLASS, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortMallocFromClass( size_t xWantedSize,
+                              UBaseType_t uxRegionClass )
+{
+    configASSERT( uxRegionClass < configHEAP_REGION_CLASSES );
+
+    return prvMalloc( xWantedSize, uxRegionClass, pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
+
+    void * pvPortMallocStack( size_t xWantedSize )
+    {
+        return prvMalloc( xWantedSize, configHEAP_STACK_CLASS, pdTRUE );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortFreeStack( void * pv )
+    {
+        vPortFree( pv );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configSTACK_ALLOCATION_FROM_SEPARATE_HEAP */
+
+static void * prvMalloc( size_t xWantedSize,
+                         UBaseType_t uxClass,
+                         BaseType_t xAnyClass )
+{
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+    UBaseType_t uxTry;
+
+    /* The heap must be initialised before the first call to
+     * pvPortMalloc(). */
+    configASSERT( xHeapDefined != pdFALSE );
+
+    if( xWantedSize > 0 )
+    {
+        /* The wanted size must be increased so it can contain a BlockLink_t
+         * structure in addition to the requested amount of bytes. */
+        if( ( xWantedSize + xHeapStructSize ) > xWantedSize ) /* Overflow check */
+        {
+            xWantedSize += xHeapStructSize;
+
+            /* Ensure that blocks are always aligned */
+            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                /* Byte alignment required. */
+                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+                if( ( xWantedSize + xAdditionalRequiredSize ) > xWantedSize )
+                {
+                    xWantedSize += xAdditionalRequiredSize;
+                }
+                else
+                {
+                    xWantedSize = 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xWantedSize = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    vTaskSuspendAll();
+    {
+        /* The size bits used for the allocated flag and the class must be
+         * clear in the wanted size. */
+        if( ( xWantedSize > 0 ) && heapBLOCK_SIZE_IS_VALID( xWantedSize ) )
+        {
+            pvReturn = prvAllocateFromClass( xWantedSize, uxClass );
+
+            if( xAnyClass != pdFALSE )
+            {
+                for( uxTry = 0; ( pvReturn == NULL ) && ( uxTry < configHEAP_REGION_CLASSES ); uxTry++ )
+                {
+                    if( uxTry != uxClass )
+                    {
+                        pvReturn = prvAllocateFromClass( xWantedSize, uxTry );
+                    }
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvAllocateFromClass( size_t xWantedSize,
+                                    UBaseType_t uxClass )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxPreviousBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+
+    if( ( pxEnd[ uxClass ] == NULL ) || ( xWantedSize > xFreeBytesRemainingInClass[ uxClass ] ) )
+    {
+        /* The class has no region or not enough memory left. */
+        return NULL;
+    }
+
+    /* Traverse the list of the class from the start (lowest address) block
+     * until one of adequate size is found. */
+    pxPreviousBlock = &xStart[ uxClass ];
+    pxBlock = xStart[ uxClass ].pxNextFreeBlock;
+
+    while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+    {
+        pxPreviousBlock = pxBlock;
+        pxBlock = pxBlock->pxNextFreeBlock;
+    }
+
+    /* If the end marker was reached then a block of adequate size was not
+     * found. */
+    if( pxBlock != pxEnd[ uxClass ] )
+    {
+        /* Return the memory space pointed to - jumping over the BlockLink_t
+         * structure at its start. */
+        pvReturn = ( void * ) ( ( ( uint8_t * ) pxPreviousBlock->pxNextFreeBlock ) + xHeapStructSize );
+
+        /* This block is being returned for use so must be taken out of the
+         * list of free blocks. */
+        pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+        /* If the block is larger than required it can be split into two. */
+        if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+        {
+            /* This block is to be split into two.  Create a new block
+             * following the number of bytes requested. */
+            pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+
+            /* Calculate the sizes of two blocks split from the single
+             * block. */
+            pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+            pxBlock->xBlockSize = xWantedSize;
+
+            /* Insert the new block into the list of free blocks. */
+            prvInsertBlockIntoFreeList( pxNewBlockLink, uxClass );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xFreeBytesRemaining -= pxBlock->xBlockSize;
+        xFreeBytesRemainingInClass[ uxClass ] -= pxBlock->xBlockSize;
+
+        if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+        {
+            xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The block is being returned - it is allocated and owned by the
+         * application and has no "next" block. */
+        heapALLOCATE_BLOCK( pxBlock, uxClass );
+        pxBlock->pxNextFreeBlock = NULL;
+        xNumberOfSuccessfulAllocations++;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    UBaseType_t uxClass;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have an BlockLink_t structure immediately
+         * before it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+        configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        {
+            if( pxLink->pxNextFreeBlock == NULL )
+            {
+                /* The block is being returned to the heap of its class - it is
+                 * no longer allocated. */
+                uxClass = heapBLOCK_CLASS( pxLink );
+                heapFREE_BLOCK( pxLink );
+
+                vTaskSuspendAll();
+                {
+                    /* Add this block to the list of free blocks. */
+                    xFreeBytesRemaining += pxLink->xBlockSize;
+                    xFreeBytesRemainingInClass[ uxClass ] += pxLink->xBlockSize;
+                    traceFREE( pv, pxLink->xBlockSize );
+                    prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ), uxClass );
+                    xNumberOfSuccessfulFrees++;
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSizeOfClass( UBaseType_t uxRegionClass )
+{
+    configASSERT( uxRegionClass < configHEAP_REGION_CLASSES );
+
+    return xFreeBytesRemainingInClass[ uxRegionClass ];
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert,
+                                        UBaseType_t uxClass ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxIterator;
+    uint8_t * puc;
+
+    /* Iterate through the list until a block is found that has a higher address
+     * than the block being inserted. */
+    for( pxIterator = &xStart[ uxClass ]; pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+    {
+        /* Nothing to do here, just iterate to the right position. */
+    }
+
+    /* Do the block being inserted, and the block it is being inserted after
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxIterator;
+
+    if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+    {
+        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+        pxBlockToInsert = pxIterator;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Do the block being inserted, and the block it is being inserted before
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxBlockToInsert;
+
+    if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+    {
+        if( pxIterator->pxNextFreeBlock != pxEnd[ uxClass ] )
+        {
+            /* Form one big block from the two blocks. */
+            pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+            pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+        }
+        else
+        {
+            pxBlockToInsert->pxNextFreeBlock = pxEnd[ uxClass ];
+        }
+    }
+    else
+    {
+        pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+    }
+
+    /* If the block being inserted plugged a gap, so was merged with the block
+     * before and the block after, then it's pxNextFreeBlock pointer will have
+     * already been set, and should not be set here as that would make it point
+     * to itself. */
+    if( pxIterator != pxBlockToInsert )
+    {
+        pxIterator->pxNextFreeBlock = pxBlockToInsert;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxFirstFreeBlockInRegion = NULL;
+    BlockLink_t * pxPreviousFreeBlock;
+    portPOINTER_SIZE_TYPE xAlignedHeap;
+    size_t xTotalRegionSize, xTotalHeapSize = 0;
+    BaseType_t xDefinedRegions = 0;
+    portPOINTER_SIZE_TYPE xAddress;
+    const HeapRegion_t * pxHeapRegion;
+    UBaseType_t uxClass;
+
+    /* Can only call once! */
+    configASSERT( xHeapDefined == pdFALSE );
+
+    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+    while( pxHeapRegion->xSizeInBytes > 0 )
+    {
+        uxClass = pxHeapRegion->uxRegionClass;
+        configASSERT( uxClass < configHEAP_REGION_CLASSES );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            BaseType_t xRegion;
+
+            /* A region must not share memory with one defined before it. */
+            for( xRegion = 0; xRegion < xDefinedRegions; xRegion++ )
+            {
+                configASSERT( portHEAP_REGIONS_OVERLAP( pxHeapRegion->pucStartAddress, pxHeapRegion->xSizeInBytes,
+                                                        pxHeapRegions[ xRegion ].pucStartAddress, pxHeapRegions[ xRegion ].xSizeInBytes ) == pdFALSE );
+            }
+        }
+        #endif
+
+        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+        /* Ensure the heap region starts on a correctly aligned boundary. */
+        xAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+
+        if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+        {
+            xAddress += ( portBYTE_ALIGNMENT - 1 );
+            xAddress &= ~( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK;
+
+            /* Adjust the size for the bytes lost to alignment. */
+            xTotalRegionSize -= ( size_t ) ( xAddress - ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress );
+        }
+
+        xAlignedHeap = xAddress;
+
+        /* Set xStart if it has not already been set for this class. */
+        if( pxEnd[ uxClass ] == NULL )
+        {
+            /* xStart is used to hold a pointer to the first item in the list
+             *  of free blocks.  The void cast is used to prevent compiler
+             * warnings. */
+            xStart[ uxClass ].pxNextFreeBlock = ( BlockLink_t * ) xAlignedHeap;
+            xStart[ uxClass ].xBlockSize = ( size_t ) 0;
+            pxPreviousFreeBlock = NULL;
+        }
+        else
+        {
+            /* Should only get here if one region of this class has already
+             * been added to the heap, and it must be at a lower address. */
+            configASSERT( ( size_t ) xAddress > ( size_t ) pxEnd[ uxClass ] );
+            pxPreviousFreeBlock = pxEnd[ uxClass ];
+        }
+
+        /* pxEnd is used to mark the end of the list of free blocks of the
+         * class and is inserted at the end of the region space. */
+        xAddress = xAlignedHeap + ( portPOINTER_SIZE_TYPE ) xTotalRegionSize;
+        xAddress -= ( portPOINTER_SIZE_TYPE ) xHeapStructSize;
+        xAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        pxEnd[ uxClass ] = ( BlockLink_t * ) xAddress;
+        pxEnd[ uxClass ]->xBlockSize = 0;
+        pxEnd[ uxClass ]->pxNextFreeBlock = NULL;
+
+        /* To start with there is a single free block in this region that is
+         * sized to take up the entire heap region minus the space taken by the
+         * free block structure. */
+        pxFirstFreeBlockInRegion = ( BlockLink_t * ) xAlignedHeap;
+        pxFirstFreeBlockInRegion->xBlockSize = ( size_t ) ( xAddress - ( portPOINTER_SIZE_TYPE ) pxFirstFreeBlockInRegion );
+        pxFirstFreeBlockInRegion->pxNextFreeBlock = pxEnd[ uxClass ];
+
+        /* If this is not the first region of the class that makes up the
+         * heap space then link the previous region of the class to this
+         * region. */
+        if( pxPreviousFreeBlock != NULL )
+        {
+            pxPreviousFreeBlock->pxNextFreeBlock = pxFirstFreeBlockInRegion;
+        }
+
+        xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
+        xFreeBytesRemainingInClass[ uxClass ] += pxFirstFreeBlockInRegion->xBlockSize;
+
+        /* Move onto the next HeapRegion_t structure. */
+        xDefinedRegions++;
+        pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+    }
+
+    xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+    xFreeBytesRemaining = xTotalHeapSize;
+
+    /* Check something was actually defined before it is accessed. */
+    configASSERT( xTotalHeapSize );
+
+    /* The classes without a region keep a NULL end marker. */
+    xHeapDefined = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+    UBaseType_t uxClass;
+
+    vTaskSuspendAll();
+    {
+        for( uxClass = 0; uxClass < configHEAP_REGION_CLASSES; uxClass++ )
+        {
+            if( pxEnd[ uxClass ] == NULL )
+            {
+                continue;
+            }
+
+            pxBlock = xStart[ uxClass ].pxNextFreeBlock;
+
+            /* pxBlock will be NULL if the heap has not been initialised.  The
+             * heap is initialised automatically when the first allocation is
+             * made. */
+            while( ( pxBlock != NULL ) && ( pxBlock != pxEnd[ uxClass ] ) )
+            {
+                /* Increment the number of blocks and record the largest block seen
+                 * so far. */
+                xBlocks++;
+
+                if( pxBlock->xBlockSize > xMaxSize )
+                {
+                    xMaxSize = pxBlock->xBlockSize;
+                }
+
+                /* Heap five will have a zero sized block at the end of each
+                 * each region - the block is only used to link to the next
+                 * heap region so it not a real block. */
+                if( pxBlock->xBlockSize != 0 )
+                {
+                    if( pxBlock->xBlockSize < xMinSize )
+                    {
+                        xMinSize = pxBlock->xBlockSize;
+                    }
+                }
+
+                /* Move to the next block in the chain until the last block is
+                 * reached. */
+                pxBlock = pxBlock->pxNextFreeBlock;
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = ( xBlocks > 0U ) ? xMinSize : 0U;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configHEAP_IMPLEMENTATION */
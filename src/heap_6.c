@@ -0,0 +1,615 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * A two level segregated fit (TLSF) implementation of pvPortMalloc() and
+ * vPortFree().  Both run in constant time, independent of the number of free
+ * blocks, and adjacent free blocks are combined when a block is freed to limit
+ * fragmentation.
+ *
+ * The free blocks are kept in an array of lists.  The first level index is the
+ * power of two of the block size, the second level splits each power of two
+ * range into heapSL_INDEX_COUNT linear sub-ranges.  Two bitmaps record which
+ * lists hold blocks, so the smallest list able to satisfy a request is found
+ * with a couple of bit scans instead of a walk of the free blocks.
+ *
+ * The heap is a statically allocated array of configTOTAL_HEAP_SIZE bytes, or
+ * is provided by the application when configAPPLICATION_ALLOCATED_HEAP is 1.
+ *
+ * Selected by setting configHEAP_IMPLEMENTATION to 6.  See heap_3.c for the
+ * implementation that relies on the C library malloc() and free().
+ */
+#include <stddef.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configHEAP_IMPLEMENTATION == 6 )
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configTOTAL_HEAP_SIZE
+    #error configTOTAL_HEAP_SIZE must be defined to use heap_6.c
+#endif
+
+#if ( portBYTE_ALIGNMENT == 16 )
+    #define heapALIGNMENT_LOG2    ( 4U )
+#elif ( portBYTE_ALIGNMENT == 8 )
+    #define heapALIGNMENT_LOG2    ( 3U )
+#elif ( portBYTE_ALIGNMENT == 4 )
+    #define heapALIGNMENT_LOG2    ( 2U )
+#else
+    #error heap_6.c supports a portBYTE_ALIGNMENT of 4, 8 or 16
+#endif
+
+/* Each power of two range is split into 16 second level lists. */
+#define heapSL_INDEX_COUNT_LOG2    ( 4U )
+#define heapSL_INDEX_COUNT         ( 1U << heapSL_INDEX_COUNT_LOG2 )
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE all share the first level list 0,
+ * split linearly in steps of the byte alignment. */
+#define heapFL_INDEX_SHIFT         ( heapSL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapSMALL_BLOCK_SIZE       ( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* The largest first level covers blocks up to 512 KB, more than the RAM of the
+ * part, which keeps the list array small. */
+#define heapFL_INDEX_MAX           ( 18U )
+#define heapFL_INDEX_COUNT         ( heapFL_INDEX_MAX - heapFL_INDEX_SHIFT + 2U )
+#define heapMAXIMUM_REQUEST_SIZE   ( ( size_t ) 1 << heapFL_INDEX_MAX )
+
+/* Bit scans used to index the bitmaps. */
+#define heapFLS( x )               ( 31U - ( uint32_t ) __builtin_clz( ( unsigned int ) ( x ) ) )
+#define heapFFS( x )               ( ( uint32_t ) __builtin_ctz( ( unsigned int ) ( x ) ) )
+
+/*-----------------------------------------------------------*/
+
+/* Header placed in front of every block.  The free list links overlay the
+ * start of the payload, so they only exist while the block is free and a block
+ * in use only costs heapBLOCK_OVERHEAD bytes. */
+typedef struct A_BLOCK_HEADER
+{
+    struct A_BLOCK_HEADER * pxPrevPhysBlock; /*<< The block just before this one in memory, NULL for the first block. */
+    size_t xBlockSize;                       /*<< The size of the payload, the lowest bit is set while the block is free. */
+    struct A_BLOCK_HEADER * pxNextFreeBlock; /*<< The next block in the same free list. */
+    struct A_BLOCK_HEADER * pxPrevFreeBlock; /*<< The previous block in the same free list. */
+} BlockHeader_t;
+
+#define heapBLOCK_OVERHEAD                 ( offsetof( BlockHeader_t, pxNextFreeBlock ) )
+#define heapMINIMUM_BLOCK_SIZE             ( sizeof( BlockHeader_t ) - heapBLOCK_OVERHEAD )
+#define heapBLOCK_FREE_BIT                 ( ( size_t ) 1 )
+
+#define heapBLOCK_SIZE( pxBlock )          ( ( pxBlock )->xBlockSize & ~heapBLOCK_FREE_BIT )
+#define heapBLOCK_IS_FREE( pxBlock )       ( ( ( pxBlock )->xBlockSize & heapBLOCK_FREE_BIT ) != 0U )
+#define heapNEXT_PHYS_BLOCK( pxBlock )     ( ( BlockHeader_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_OVERHEAD + heapBLOCK_SIZE( pxBlock ) ) )
+#define heapBLOCK_TO_POINTER( pxBlock )    ( ( void * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_OVERHEAD ) )
+#define heapPOINTER_TO_BLOCK( pv )         ( ( BlockHeader_t * ) ( ( ( uint8_t * ) ( pv ) ) - heapBLOCK_OVERHEAD ) )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Computes the first and second level list a block of xSize bytes belongs to.
+ */
+static void prvMappingInsert( size_t xSize,
+                              uint32_t * pulFL,
+                              uint32_t * pulSL );
+
+/*
+ * Computes the first list whose blocks are all at least xSize bytes, so the
+ * head of any list from there on can be used without a search.
+ */
+static void prvMappingSearch( size_t xSize,
+                              uint32_t * pulFL,
+                              uint32_t * pulSL );
+
+/*
+ * Returns the head of the first non empty list at or after the given one, or
+ * NULL if no free block is large enough.
+ */
+static BlockHeader_t * prvSearchSuitableBlock( uint32_t ulFL,
+                                               uint32_t ulSL );
+
+/*
+ * Adds a block to, or removes a block from, the free list matching its size.
+ */
+static void prvInsertFreeBlock( BlockHeader_t * pxBlock );
+static void prvRemoveFreeBlock( BlockHeader_t * pxBlock );
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*-----------------------------------------------------------*/
+
+/* Allocate the memory for the heap. */
+#if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+    extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+    PRIVILEGED_DATA static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* Bitmaps of the non empty lists, one bit per first level and one bit per
+ * second level list of each first level. */
+PRIVILEGED_DATA static uint32_t ulFLBitmap = 0U;
+PRIVILEGED_DATA static uint32_t ulSLBitmap[ heapFL_INDEX_COUNT ];
+
+/* Heads of the free lists. */
+PRIVILEGED_DATA static BlockHeader_t * pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0;
+PRIVILEGED_DATA static BaseType_t xHeapInitialised = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockHeader_t * pxBlock;
+    BlockHeader_t * pxNewBlock;
+    uint32_t ulFL, ulSL;
+    void * pvReturn = NULL;
+
+    /* The payload is rounded up to the byte alignment and must be able to hold
+     * the free list links once the block is freed again. */
+    if( ( xWantedSize > 0U ) && ( xWantedSize <= heapMAXIMUM_REQUEST_SIZE ) )
+    {
+        xWantedSize = ( xWantedSize + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+        if( xWantedSize < heapMINIMUM_BLOCK_SIZE )
+        {
+            xWantedSize = heapMINIMUM_BLOCK_SIZE;
+        }
+    }
+    else
+    {
+        xWantedSize = 0U;
+    }
+
+    vTaskSuspendAll();
+    {
+        if( xHeapInitialised == pdFALSE )
+        {
+            prvHeapInit();
+        }
+
+        if( xWantedSize > 0U )
+        {
+            prvMappingSearch( xWantedSize, &ulFL, &ulSL );
+            pxBlock = prvSearchSuitableBlock( ulFL, ulSL );
+
+            if( pxBlock == NULL )
+            {
+                /* The rounding up of the search skips the list the request
+                 * itself maps to, its head may still be large enough.  Only
+                 * the head is looked at to keep the allocation time bound. */
+                prvMappingInsert( xWantedSize, &ulFL, &ulSL );
+                pxBlock = pxFreeLists[ ulFL ][ ulSL ];
+
+                if( ( pxBlock != NULL ) && ( heapBLOCK_SIZE( pxBlock ) < xWantedSize ) )
+                {
+                    pxBlock = NULL;
+                }
+            }
+
+            if( pxBlock != NULL )
+            {
+                prvRemoveFreeBlock( pxBlock );
+
+                /* Return the end of the block to the heap if it is large
+                 * enough to hold a block of its own. */
+                if( heapBLOCK_SIZE( pxBlock ) >= ( xWantedSize + sizeof( BlockHeader_t ) ) )
+                {
+                    pxNewBlock = ( BlockHeader_t * ) ( ( ( uint8_t * ) heapBLOCK_TO_POINTER( pxBlock ) ) + xWantedSize );
+                    pxNewBlock->xBlockSize = heapBLOCK_SIZE( pxBlock ) - xWantedSize - heapBLOCK_OVERHEAD;
+                    pxNewBlock->pxPrevPhysBlock = pxBlock;
+                    heapNEXT_PHYS_BLOCK( pxNewBlock )->pxPrevPhysBlock = pxNewBlock;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    prvInsertFreeBlock( pxNewBlock );
+                }
+                else
+                {
+                    pxBlock->xBlockSize = heapBLOCK_SIZE( pxBlock );
+                }
+
+                xFreeBytesRemaining -= heapBLOCK_SIZE( pxBlock ) + heapBLOCK_OVERHEAD;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xNumberOfSuccessfulAllocations++;
+                pvReturn = heapBLOCK_TO_POINTER( pxBlock );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    BlockHeader_t * pxBlock;
+    BlockHeader_t * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        pxBlock = heapPOINTER_TO_BLOCK( pv );
+
+        /* Check the block is actually allocated. */
+        configASSERT( heapBLOCK_IS_FREE( pxBlock ) == pdFALSE );
+
+        vTaskSuspendAll();
+        {
+            xFreeBytesRemaining += heapBLOCK_SIZE( pxBlock ) + heapBLOCK_OVERHEAD;
+            traceFREE( pv, heapBLOCK_SIZE( pxBlock ) );
+            xNumberOfSuccessfulFrees++;
+
+            /* Absorb the next block if it is free.  The end of the heap is
+             * marked with a block that is never free. */
+            pxNeighbour = heapNEXT_PHYS_BLOCK( pxBlock );
+
+            if( heapBLOCK_IS_FREE( pxNeighbour ) )
+            {
+                prvRemoveFreeBlock( pxNeighbour );
+                pxBlock->xBlockSize += heapBLOCK_SIZE( pxNeighbour ) + heapBLOCK_OVERHEAD;
+                heapNEXT_PHYS_BLOCK( pxBlock )->pxPrevPhysBlock = pxBlock;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Let the previous block absorb this one if it is free. */
+            pxNeighbour = pxBlock->pxPrevPhysBlock;
+
+            if( ( pxNeighbour != NULL ) && heapBLOCK_IS_FREE( pxNeighbour ) )
+            {
+                prvRemoveFreeBlock( pxNeighbour );
+                pxNeighbour->xBlockSize = heapBLOCK_SIZE( pxNeighbour ) + heapBLOCK_SIZE( pxBlock ) + heapBLOCK_OVERHEAD;
+                pxBlock = pxNeighbour;
+                heapNEXT_PHYS_BLOCK( pxBlock )->pxPrevPhysBlock = pxBlock;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvInsertFreeBlock( pxBlock );
+        }
+        ( void ) xTaskResumeAll();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( ( xSize == 0U ) || ( xNum <= ( ( ( size_t ) -1 ) / xSize ) ) )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockHeader_t * pxBlock;
+    uint32_t ulFLMap, ulSLMap, ulFL, ulSL;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        /* Walk every non empty list, this is the only part of the heap that
+         * does not run in constant time. */
+        ulFLMap = ulFLBitmap;
+
+        while( ulFLMap != 0U )
+        {
+            ulFL = heapFFS( ulFLMap );
+            ulFLMap &= ~( 1UL << ulFL );
+            ulSLMap = ulSLBitmap[ ulFL ];
+
+            while( ulSLMap != 0U )
+            {
+                ulSL = heapFFS( ulSLMap );
+                ulSLMap &= ~( 1UL << ulSL );
+
+                for( pxBlock = pxFreeLists[ ulFL ][ ulSL ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    xBlocks++;
+
+                    if( heapBLOCK_SIZE( pxBlock ) > xMaxSize )
+                    {
+                        xMaxSize = heapBLOCK_SIZE( pxBlock );
+                    }
+
+                    if( heapBLOCK_SIZE( pxBlock ) < xMinSize )
+                    {
+                        xMinSize = heapBLOCK_SIZE( pxBlock );
+                    }
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = ( xBlocks > 0U ) ? xMinSize : 0U;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xSize,
+                              uint32_t * pulFL,
+                              uint32_t * pulSL )
+{
+    uint32_t ulFL;
+
+    if( xSize < heapSMALL_BLOCK_SIZE )
+    {
+        *pulFL = 0U;
+        *pulSL = ( uint32_t ) ( xSize / ( heapSMALL_BLOCK_SIZE / heapSL_INDEX_COUNT ) );
+    }
+    else
+    {
+        ulFL = heapFLS( xSize );
+        *pulSL = ( uint32_t ) ( xSize >> ( ulFL - heapSL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT;
+        *pulFL = ulFL - ( heapFL_INDEX_SHIFT - 1U );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingSearch( size_t xSize,
+                              uint32_t * pulFL,
+                              uint32_t * pulSL )
+{
+    /* Round the size up to the start of the next second level range so any
+     * block found in the resulting list is large enough. */
+    if( xSize >= heapSMALL_BLOCK_SIZE )
+    {
+        xSize += ( ( size_t ) 1 << ( heapFLS( xSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - 1U;
+    }
+
+    prvMappingInsert( xSize, pulFL, pulSL );
+}
+/*-----------------------------------------------------------*/
+
+static BlockHeader_t * prvSearchSuitableBlock( uint32_t ulFL,
+                                               uint32_t ulSL )
+{
+    uint32_t ulFLMap;
+    uint32_t ulSLMap = ulSLBitmap[ ulFL ] & ( ~0UL << ulSL );
+
+    if( ulSLMap == 0U )
+    {
+        /* Nothing left in this first level, take the smallest list of the
+         * next non empty one. */
+        ulFLMap = ulFLBitmap & ( ~0UL << ( ulFL + 1U ) );
+
+        if( ulFLMap == 0U )
+        {
+            return NULL;
+        }
+
+        ulFL = heapFFS( ulFLMap );
+        ulSLMap = ulSLBitmap[ ulFL ];
+    }
+
+    return pxFreeLists[ ulFL ][ heapFFS( ulSLMap ) ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockHeader_t * pxBlock )
+{
+    uint32_t ulFL, ulSL;
+
+    prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &ulFL, &ulSL );
+
+    pxBlock->xBlockSize |= heapBLOCK_FREE_BIT;
+    pxBlock->pxPrevFreeBlock = NULL;
+    pxBlock->pxNextFreeBlock = pxFreeLists[ ulFL ][ ulSL ];
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock;
+    }
+
+    pxFreeLists[ ulFL ][ ulSL ] = pxBlock;
+    ulFLBitmap |= ( 1UL << ulFL );
+    ulSLBitmap[ ulFL ] |= ( 1UL << ulSL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockHeader_t * pxBlock )
+{
+    uint32_t ulFL, ulSL;
+
+    prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &ulFL, &ulSL );
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+    }
+
+    if( pxBlock->pxPrevFreeBlock != NULL )
+    {
+        pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block was the head of its list, clear the bitmaps when the list
+         * becomes empty. */
+        pxFreeLists[ ulFL ][ ulSL ] = pxBlock->pxNextFreeBlock;
+
+        if( pxFreeLists[ ulFL ][ ulSL ] == NULL )
+        {
+            ulSLBitmap[ ulFL ] &= ~( 1UL << ulSL );
+
+            if( ulSLBitmap[ ulFL ] == 0U )
+            {
+                ulFLBitmap &= ~( 1UL << ulFL );
+            }
+        }
+    }
+
+    pxBlock->xBlockSize &= ~heapBLOCK_FREE_BIT;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    BlockHeader_t * pxFirstBlock;
+    BlockHeader_t * pxEndBlock;
+    portPOINTER_SIZE_TYPE uxAddress;
+    size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+    /* Ensure the heap starts on a correctly aligned boundary. */
+    uxAddress = ( portPOINTER_SIZE_TYPE ) ucHeap;
+
+    if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+    {
+        uxAddress += ( portBYTE_ALIGNMENT - 1 );
+        uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        xTotalHeapSize -= uxAddress - ( portPOINTER_SIZE_TYPE ) ucHeap;
+    }
+
+    xTotalHeapSize &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+    /* The payload follows the header, it is only aligned if the header is. */
+    configASSERT( ( heapBLOCK_OVERHEAD & portBYTE_ALIGNMENT_MASK ) == 0U );
+
+    /* The whole heap must fit in the largest first level. */
+    configASSERT( xTotalHeapSize < ( ( size_t ) 2 * heapMAXIMUM_REQUEST_SIZE ) );
+
+    /* One free block covers the heap, followed by a zero sized block that is
+     * never free so the last block has a next block to look at.  The whole
+     * header of that block is kept inside the heap array. */
+    pxFirstBlock = ( BlockHeader_t * ) uxAddress;
+    pxFirstBlock->pxPrevPhysBlock = NULL;
+    pxFirstBlock->xBlockSize = xTotalHeapSize - heapBLOCK_OVERHEAD - sizeof( BlockHeader_t );
+
+    pxEndBlock = heapNEXT_PHYS_BLOCK( pxFirstBlock );
+    pxEndBlock->pxPrevPhysBlock = pxFirstBlock;
+    pxEndBlock->xBlockSize = 0U;
+
+    prvInsertFreeBlock( pxFirstBlock );
+
+    xFreeBytesRemaining = heapBLOCK_SIZE( pxFirstBlock ) + heapBLOCK_OVERHEAD;
+    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+    xHeapInitialised = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configHEAP_IMPLEMENTATION */
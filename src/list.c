@@ -224,3 +224,60 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
     return pxList->uxNumberOfItems;
 }
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+    void vListInitialisePriorityEventList( PriorityEventList_t * const pxEventList )
+    {
+        UBaseType_t uxPriority;
+
+        for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+        {
+            vListInitialise( &( pxEventList->xWaiters[ uxPriority ] ) );
+        }
+
+        pxEventList->uxWaitingPriorities = ( UBaseType_t ) 0U;
+    }
+/*-----------------------------------------------------------*/
+
+    List_t * pxListGetHighestPriorityWaiters( PriorityEventList_t * const pxEventList )
+    {
+        UBaseType_t uxPriority;
+        List_t * pxWaiters = NULL;
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION, or with the
+         * scheduler suspended and the object owning the event list locked, as
+         * it may clear bits of uxWaitingPriorities. */
+        while( pxEventList->uxWaitingPriorities != ( UBaseType_t ) 0U )
+        {
+            #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+            {
+                portGET_HIGHEST_PRIORITY( uxPriority, pxEventList->uxWaitingPriorities );
+            }
+            #else
+            {
+                uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+
+                while( ( pxEventList->uxWaitingPriorities & ( ( UBaseType_t ) 1U << uxPriority ) ) == ( UBaseType_t ) 0U )
+                {
+                    uxPriority--;
+                }
+            }
+            #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+            if( listLIST_IS_EMPTY( &( pxEventList->xWaiters[ uxPriority ] ) ) == pdFALSE )
+            {
+                pxWaiters = &( pxEventList->xWaiters[ uxPriority ] );
+                break;
+            }
+
+            /* The last waiter of this priority timed out or was removed, its
+             * bit can only be cleared now. */
+            pxEventList->uxWaitingPriorities &= ~( ( UBaseType_t ) 1U << uxPriority );
+        }
+
+        return pxWaiters;
+    }
+
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+/*-----------------------------------------------------------*/
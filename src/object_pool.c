@@ -0,0 +1,214 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "object_pool.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+#if ( configUSE_OBJECT_POOLS == 1 )
+
+/* The slots are sized with the public Static*_t types, which have the same
+ * size as the private kernel structures they stand in for.  The storage of a
+ * pool with no entries is left out. */
+#if ( configTASK_POOL_SIZE > 0 )
+    PRIVILEGED_DATA static StaticTask_t xTaskPoolStorage[ configTASK_POOL_SIZE ];
+    #define poolTASK_STORAGE    ( ( uint8_t * ) xTaskPoolStorage )
+#else
+    #define poolTASK_STORAGE    NULL
+#endif
+
+#if ( configQUEUE_POOL_SIZE > 0 )
+    PRIVILEGED_DATA static StaticQueue_t xQueuePoolStorage[ configQUEUE_POOL_SIZE ];
+    #define poolQUEUE_STORAGE    ( ( uint8_t * ) xQueuePoolStorage )
+#else
+    #define poolQUEUE_STORAGE    NULL
+#endif
+
+#if ( configTIMER_POOL_SIZE > 0 )
+    PRIVILEGED_DATA static StaticTimer_t xTimerPoolStorage[ configTIMER_POOL_SIZE ];
+    #define poolTIMER_STORAGE    ( ( uint8_t * ) xTimerPoolStorage )
+#else
+    #define poolTIMER_STORAGE    NULL
+#endif
+
+#if ( configEVENT_GROUP_POOL_SIZE > 0 )
+    PRIVILEGED_DATA static StaticEventGroup_t xEventGroupPoolStorage[ configEVENT_GROUP_POOL_SIZE ];
+    #define poolEVENT_GROUP_STORAGE    ( ( uint8_t * ) xEventGroupPoolStorage )
+#else
+    #define poolEVENT_GROUP_STORAGE    NULL
+#endif
+
+/* A pool hands out its slots in address order the first time round, so no
+ * initialisation pass is needed.  Returned slots are linked through their
+ * first word and are reused before any untouched slot. */
+typedef struct xOBJECT_POOL
+{
+    uint8_t * const pucStorage;    /*< Start of the slots. */
+    const size_t xObjectSize;      /*< Size of one slot. */
+    const UBaseType_t uxCapacity;  /*< Number of slots. */
+    UBaseType_t uxNextUnused;      /*< Slots from this index on were never handed out. */
+    void * pvFreeList;             /*< Slots that were handed out and returned. */
+    UBaseType_t uxInUse;           /*< Slots currently handed out. */
+    UBaseType_t uxMaximumInUse;    /*< Highest value of uxInUse. */
+    UBaseType_t uxHeapAllocations; /*< Requests passed on to the heap. */
+} ObjectPool_t;
+
+PRIVILEGED_DATA static ObjectPool_t xPools[ eObjectPoolCount ] =
+{
+    { poolTASK_STORAGE,        sizeof( StaticTask_t ),       configTASK_POOL_SIZE,        0, NULL, 0, 0, 0 },
+    { poolQUEUE_STORAGE,       sizeof( StaticQueue_t ),      configQUEUE_POOL_SIZE,       0, NULL, 0, 0, 0 },
+    { poolTIMER_STORAGE,       sizeof( StaticTimer_t ),      configTIMER_POOL_SIZE,       0, NULL, 0, 0, 0 },
+    { poolEVENT_GROUP_STORAGE, sizeof( StaticEventGroup_t ), configEVENT_GROUP_POOL_SIZE, 0, NULL, 0, 0, 0 }
+};
+
+/*-----------------------------------------------------------*/
+
+void * pvObjectPoolAllocate( eObjectPool ePool,
+                             size_t xSize )
+{
+    ObjectPool_t * pxPool;
+    void * pvReturn = NULL;
+
+    configASSERT( ePool < eObjectPoolCount );
+    pxPool = &( xPools[ ePool ] );
+
+    /* The Static*_t types would be out of step with the kernel structures
+     * if this failed. */
+    configASSERT( xSize <= pxPool->xObjectSize );
+
+    taskENTER_CRITICAL();
+    {
+        if( pxPool->pvFreeList != NULL )
+        {
+            pvReturn = pxPool->pvFreeList;
+            pxPool->pvFreeList = *( ( void ** ) pvReturn );
+        }
+        else if( pxPool->uxNextUnused < pxPool->uxCapacity )
+        {
+            pvReturn = pxPool->pucStorage + ( pxPool->uxNextUnused * pxPool->xObjectSize );
+            pxPool->uxNextUnused++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pvReturn != NULL )
+        {
+            pxPool->uxInUse++;
+
+            if( pxPool->uxInUse > pxPool->uxMaximumInUse )
+            {
+                pxPool->uxMaximumInUse = pxPool->uxInUse;
+            }
+        }
+        else
+        {
+            pxPool->uxHeapAllocations++;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if( pvReturn == NULL )
+    {
+        /* The pool is exhausted, the heap keeps the create functions working
+         * as they did without the pools. */
+        pvReturn = pvPortMalloc( xSize );
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vObjectPoolFree( eObjectPool ePool,
+                      void * pv )
+{
+    ObjectPool_t * pxPool;
+    uint8_t * pucObject = ( uint8_t * ) pv;
+
+    configASSERT( ePool < eObjectPoolCount );
+    pxPool = &( xPools[ ePool ] );
+
+    if( ( pxPool->uxCapacity > 0U ) &&
+        ( pucObject >= pxPool->pucStorage ) &&
+        ( pucObject < ( pxPool->pucStorage + ( pxPool->uxCapacity * pxPool->xObjectSize ) ) ) )
+    {
+        taskENTER_CRITICAL();
+        {
+            configASSERT( pxPool->uxInUse > 0U );
+
+            *( ( void ** ) pv ) = pxPool->pvFreeList;
+            pxPool->pvFreeList = pv;
+            pxPool->uxInUse--;
+        }
+        taskEXIT_CRITICAL();
+    }
+    else
+    {
+        vPortFree( pv );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vObjectPoolGetStats( eObjectPool ePool,
+                          ObjectPoolStats_t * pxStats )
+{
+    ObjectPool_t * pxPool;
+
+    configASSERT( ePool < eObjectPoolCount );
+    configASSERT( pxStats );
+    pxPool = &( xPools[ ePool ] );
+
+    taskENTER_CRITICAL();
+    {
+        pxStats->uxCapacity = pxPool->uxCapacity;
+        pxStats->uxInUse = pxPool->uxInUse;
+        pxStats->uxMaximumInUse = pxPool->uxMaximumInUse;
+        pxStats->uxHeapAllocations = pxPool->uxHeapAllocations;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_OBJECT_POOLS */
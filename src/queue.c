@@ -38,10 +38,18 @@
 #include "task.h"
 #include "queue.h"
 
+#if ( configUSE_OBJECT_POOLS == 1 )
+    #include "object_pool.h"
+#endif
+
 #if ( configUSE_CO_ROUTINES == 1 )
     #include "croutine.h"
 #endif
 
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATS == 1 ) )
+    #include "stream_buffer.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -92,6 +100,26 @@ typedef struct SemaphoreData
     #define queueYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
 #endif
 
+/* The tasks blocked on a queue wait either in a single list sorted by priority
+ * or, when configUSE_PRIORITY_EVENT_LISTS is 1, in one list per priority. */
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    typedef PriorityEventList_t QueueWaitingList_t;
+
+    #define queueINITIALISE_WAITING_LIST( pxList )                                      vListInitialisePriorityEventList( pxList )
+    #define queueWAITING_LIST_IS_EMPTY( pxList )                                        listPRIORITY_EVENT_LIST_IS_EMPTY( pxList )
+    #define queuePLACE_ON_WAITING_LIST( pxList, xTicksToWait )                          vTaskPlaceOnPriorityEventList( ( pxList ), ( xTicksToWait ) )
+    #define queuePLACE_ON_WAITING_LIST_RESTRICTED( pxList, xTicksToWait, xIndefinitely )    vTaskPlaceOnPriorityEventListRestricted( ( pxList ), ( xTicksToWait ), ( xIndefinitely ) )
+    #define queueREMOVE_FROM_WAITING_LIST( pxList )                                     xTaskRemoveFromPriorityEventList( pxList )
+#else
+    typedef List_t QueueWaitingList_t;
+
+    #define queueINITIALISE_WAITING_LIST( pxList )                                      vListInitialise( pxList )
+    #define queueWAITING_LIST_IS_EMPTY( pxList )                                        listLIST_IS_EMPTY( pxList )
+    #define queuePLACE_ON_WAITING_LIST( pxList, xTicksToWait )                          vTaskPlaceOnEventList( ( pxList ), ( xTicksToWait ) )
+    #define queuePLACE_ON_WAITING_LIST_RESTRICTED( pxList, xTicksToWait, xIndefinitely )    vTaskPlaceOnEventListRestricted( ( pxList ), ( xTicksToWait ), ( xIndefinitely ) )
+    #define queueREMOVE_FROM_WAITING_LIST( pxList )                                     xTaskRemoveFromEventList( pxList )
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -108,8 +136,8 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         SemaphoreData_t xSemaphore; /*< Data required exclusively when this structure is used as a semaphore. */
     } u;
 
-    List_t xTasksWaitingToSend;             /*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
-    List_t xTasksWaitingToReceive;          /*< List of tasks that are blocked waiting to read from this queue.  Stored in priority order. */
+    QueueWaitingList_t xTasksWaitingToSend;    /*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
+    QueueWaitingList_t xTasksWaitingToReceive; /*< List of tasks that are blocked waiting to read from this queue.  Stored in priority order. */
 
     volatile UBaseType_t uxMessagesWaiting; /*< The number of items currently in the queue. */
     UBaseType_t uxLength;                   /*< The length of the queue defined as the number of items it will hold, not the number of bytes. */
@@ -130,12 +158,92 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        QueueStats_t xStats; /*< Traffic through the queue, see vQueueGetStats(). */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
  * name below to enable the use of older kernel aware debuggers. */
 typedef xQUEUE Queue_t;
 
+/* The queues created dynamically take their structure from a fixed size pool
+ * when configUSE_OBJECT_POOLS is 1, the storage area is then allocated on its
+ * own and pointed to by pcHead.  Semaphores and mutexes have no storage area. */
+#if ( configUSE_OBJECT_POOLS == 1 )
+    #define queueFREE_QUEUE( pxQueue )                        \
+    do {                                                      \
+        if( ( pxQueue )->uxItemSize > ( UBaseType_t ) 0 )     \
+        {                                                     \
+            vPortFree( ( pxQueue )->pcHead );                 \
+        }                                                     \
+        vObjectPoolFree( eObjectPoolQueue, ( pxQueue ) );     \
+    } while( 0 )
+#else
+    #define queueFREE_QUEUE( pxQueue )    vPortFree( pxQueue )
+#endif
+
+/* With configUSE_QUEUE_STATS the items are counted where the number of items
+ * waiting changes, always from a critical section.  A task that blocks notes
+ * the tick count while the scheduler is suspended and adds the time it spent
+ * blocked once it runs again. */
+#if ( configUSE_QUEUE_STATS == 1 )
+    #define queueSTATS_ITEMS_SENT( pxQueue, uxCount )                                                  \
+    do {                                                                                               \
+        ( pxQueue )->xStats.ulItemsSent += ( uint32_t ) ( uxCount );                                   \
+        ( pxQueue )->xStats.ulBytesSent += ( uint32_t ) ( ( uxCount ) * ( pxQueue )->uxItemSize );     \
+        if( ( uint32_t ) ( pxQueue )->uxMessagesWaiting > ( pxQueue )->xStats.ulHighWaterMark )       \
+        {                                                                                              \
+            ( pxQueue )->xStats.ulHighWaterMark = ( uint32_t ) ( pxQueue )->uxMessagesWaiting;         \
+        }                                                                                              \
+    } while( 0 )
+
+    #define queueSTATS_ITEMS_RECEIVED( pxQueue, uxCount )                                              \
+    do {                                                                                               \
+        ( pxQueue )->xStats.ulItemsReceived += ( uint32_t ) ( uxCount );                               \
+        ( pxQueue )->xStats.ulBytesReceived += ( uint32_t ) ( ( uxCount ) * ( pxQueue )->uxItemSize ); \
+    } while( 0 )
+
+    #define queueSTATS_SEND_FAILED( pxQueue )    ( ( pxQueue )->xStats.ulFailedSends++ )
+
+    #define queueSTATS_SEND_BLOCKING( pxQueue, xBlockedSince ) \
+    do {                                                     \
+        ( pxQueue )->xStats.ulSendBlocks++;                  \
+        ( xBlockedSince ) = xTaskGetTickCount();             \
+    } while( 0 )
+
+    #define queueSTATS_RECEIVE_BLOCKING( pxQueue, xBlockedSince ) \
+    do {                                                        \
+        ( pxQueue )->xStats.ulReceiveBlocks++;                  \
+        ( xBlockedSince ) = xTaskGetTickCount();                \
+    } while( 0 )
+
+    #define queueSTATS_SEND_UNBLOCKED( pxQueue, xBlockedSince )                   \
+    do {                                                                          \
+        const TickType_t xBlockedTicks = xTaskGetTickCount() - ( xBlockedSince ); \
+        taskENTER_CRITICAL();                                                     \
+        ( pxQueue )->xStats.ulSendBlockedTicks += ( uint32_t ) xBlockedTicks;     \
+        taskEXIT_CRITICAL();                                                      \
+    } while( 0 )
+
+    #define queueSTATS_RECEIVE_UNBLOCKED( pxQueue, xBlockedSince )                \
+    do {                                                                          \
+        const TickType_t xBlockedTicks = xTaskGetTickCount() - ( xBlockedSince ); \
+        taskENTER_CRITICAL();                                                     \
+        ( pxQueue )->xStats.ulReceiveBlockedTicks += ( uint32_t ) xBlockedTicks;  \
+        taskEXIT_CRITICAL();                                                      \
+    } while( 0 )
+#else
+    #define queueSTATS_ITEMS_SENT( pxQueue, uxCount )
+    #define queueSTATS_ITEMS_RECEIVED( pxQueue, uxCount )
+    #define queueSTATS_SEND_FAILED( pxQueue )
+    #define queueSTATS_SEND_BLOCKING( pxQueue, xBlockedSince )
+    #define queueSTATS_RECEIVE_BLOCKING( pxQueue, xBlockedSince )
+    #define queueSTATS_SEND_UNBLOCKED( pxQueue, xBlockedSince )
+    #define queueSTATS_RECEIVE_UNBLOCKED( pxQueue, xBlockedSince )
+#endif /* configUSE_QUEUE_STATS */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -163,8 +271,29 @@ typedef xQUEUE Queue_t;
  * array position being vacant. */
     PRIVILEGED_DATA QueueRegistryItem_t xQueueRegistry[ configQUEUE_REGISTRY_SIZE ];
 
+/* The kind of object held in each slot of the registry.  It is kept out of
+ * QueueRegistryItem_t so kernel aware debuggers still find the layout they
+ * expect. */
+    #define queueREGISTRY_QUEUE            ( ( uint8_t ) 0U )
+    #define queueREGISTRY_STREAM_BUFFER    ( ( uint8_t ) 1U )
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        PRIVILEGED_DATA static uint8_t ucQueueRegistryTypes[ configQUEUE_REGISTRY_SIZE ];
+    #endif
+
 #endif /* configQUEUE_REGISTRY_SIZE */
 
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+/*
+ * Stores the name of a queue, or of a stream buffer, in the registry.
+ */
+    static void prvAddToRegistry( QueueHandle_t xQueue,
+                                  const char * pcQueueName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                  uint8_t ucObjectType ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Unlocks a queue locked by a call to prvLockQueue.  Locking a queue does not
  * prevent an ISR from adding or removing items to the queue, but does prevent
@@ -203,6 +332,32 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies uxCount items to the back of a queue, or out of the front of a queue,
+ * with at most two memory copies.  The caller has already checked that there
+ * is room for, or that the queue holds, uxCount items.
+ */
+static void prvCopyBatchToQueue( Queue_t * const pxQueue,
+                                 const void * pvItemsToQueue,
+                                 const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+static void prvCopyBatchFromQueue( Queue_t * const pxQueue,
+                                   void * const pvBuffer,
+                                   const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes up to uxMaxTasks tasks from an event list.  Returns pdTRUE if any of
+ * the unblocked tasks has a priority above that of the calling task.
+ */
+static BaseType_t prvUnblockWaitingTasks( QueueWaitingList_t * const pxEventList,
+                                          UBaseType_t uxMaxTasks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Wakes the receivers of a queue after uxCount items were added to it, either
+ * through the queue set the queue belongs to or directly.
+ */
+static BaseType_t prvNotifyBatchReceivers( Queue_t * const pxQueue,
+                                           const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -322,9 +477,9 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
                  * will still be empty.  If there are tasks blocked waiting to write to
                  * the queue, then one should be unblocked as after this function exits
                  * it will be possible to write to it. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
                         queueYIELD_IF_USING_PREEMPTION();
                     }
@@ -341,8 +496,8 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             else
             {
                 /* Ensure the event queues start in the correct state. */
-                vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
-                vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+                queueINITIALISE_WAITING_LIST( &( pxQueue->xTasksWaitingToSend ) );
+                queueINITIALISE_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ) );
             }
         }
         taskEXIT_CRITICAL();
@@ -444,24 +599,50 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
              * zero in the case the queue is used as a semaphore. */
             xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
-            /* Allocate the queue and storage area.  Justification for MISRA
-             * deviation as follows:  pvPortMalloc() always ensures returned memory
-             * blocks are aligned per the requirements of the MCU stack.  In this case
-             * pvPortMalloc() must return a pointer that is guaranteed to meet the
-             * alignment requirements of the Queue_t structure - which in this case
-             * is an int8_t *.  Therefore, whenever the stack alignment requirements
-             * are greater than or equal to the pointer to char requirements the cast
-             * is safe.  In other cases alignment requirements are not strict (one or
-             * two bytes). */
-            pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
+            #if ( configUSE_OBJECT_POOLS == 1 )
+            {
+                /* Take the queue structure from the pool, the storage area is
+                 * allocated on its own. */
+                pxNewQueue = ( Queue_t * ) pvObjectPoolAllocate( eObjectPoolQueue, sizeof( Queue_t ) );
+                pucQueueStorage = NULL;
+
+                if( ( pxNewQueue != NULL ) && ( xQueueSizeInBytes > ( size_t ) 0 ) )
+                {
+                    pucQueueStorage = ( uint8_t * ) pvPortMalloc( xQueueSizeInBytes );
 
-            if( pxNewQueue != NULL )
+                    if( pucQueueStorage == NULL )
+                    {
+                        vObjectPoolFree( eObjectPoolQueue, pxNewQueue );
+                        pxNewQueue = NULL;
+                    }
+                }
+            }
+            #else /* if ( configUSE_OBJECT_POOLS == 1 ) */
             {
+                /* Allocate the queue and storage area.  Justification for MISRA
+                 * deviation as follows:  pvPortMalloc() always ensures returned memory
+                 * blocks are aligned per the requirements of the MCU stack.  In this case
+                 * pvPortMalloc() must return a pointer that is guaranteed to meet the
+                 * alignment requirements of the Queue_t structure - which in this case
+                 * is an int8_t *.  Therefore, whenever the stack alignment requirements
+                 * are greater than or equal to the pointer to char requirements the cast
+                 * is safe.  In other cases alignment requirements are not strict (one or
+                 * two bytes). */
+                pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
+
                 /* Jump past the queue structure to find the location of the queue
                  * storage area. */
                 pucQueueStorage = ( uint8_t * ) pxNewQueue;
-                pucQueueStorage += sizeof( Queue_t ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
 
+                if( pxNewQueue != NULL )
+                {
+                    pucQueueStorage += sizeof( Queue_t ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+                }
+            }
+            #endif /* if ( configUSE_OBJECT_POOLS == 1 ) */
+
+            if( pxNewQueue != NULL )
+            {
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
                     /* Queues can be created either statically or dynamically, so
@@ -533,6 +714,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     }
     #endif /* configUSE_QUEUE_SETS */
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+    {
+        ( void ) memset( &( pxNewQueue->xStats ), 0x00, sizeof( QueueStats_t ) );
+    }
+    #endif /* configUSE_QUEUE_STATS */
+
     traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -841,6 +1028,10 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
     TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+    #endif
+
     configASSERT( pxQueue );
     configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
     configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
@@ -896,9 +1087,9 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                     {
                         /* If there was a task waiting for data to arrive on the
                          * queue then unblock it now. */
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                             {
                                 /* The unblocked task has a priority higher than
                                  * our own so yield immediately.  Yes it is ok to
@@ -931,9 +1122,9 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
 
                     /* If there was a task waiting for data to arrive on the
                      * queue then unblock it now. */
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
                             /* The unblocked task has a priority higher than
                              * our own so yield immediately.  Yes it is ok to do
@@ -970,6 +1161,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                 {
                     /* The queue was full and no block time is specified (or
                      * the block time has expired) so leave now. */
+                    queueSTATS_SEND_FAILED( pxQueue );
                     taskEXIT_CRITICAL();
 
                     /* Return to the original privilege level before exiting
@@ -1005,7 +1197,8 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
             if( prvIsQueueFull( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_SEND( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                queuePLACE_ON_WAITING_LIST( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                queueSTATS_SEND_BLOCKING( pxQueue, xBlockedSince );
 
                 /* Unlocking the queue means queue events can effect the
                  * event list. It is possible that interrupts occurring now
@@ -1023,6 +1216,8 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                 {
                     portYIELD_WITHIN_API();
                 }
+
+                queueSTATS_SEND_UNBLOCKED( pxQueue, xBlockedSince );
             }
             else
             {
@@ -1078,7 +1273,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
      * read, instead return a flag to say whether a context switch is required or
      * not (i.e. has a task with a higher priority than us been woken by this
      * post). */
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
         {
@@ -1130,9 +1325,9 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                     }
                     else
                     {
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                             {
                                 /* The task waiting has a higher priority so
                                  *  record that a context switch is required. */
@@ -1158,9 +1353,9 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                 }
                 #else /* configUSE_QUEUE_SETS */
                 {
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -1200,10 +1395,11 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
         else
         {
             traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            queueSTATS_SEND_FAILED( pxQueue );
             xReturn = errQUEUE_FULL;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1249,7 +1445,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1269,6 +1465,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
              * priority disinheritance is needed.  Simply increase the count of
              * messages (semaphores) available. */
             pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+            queueSTATS_ITEMS_SENT( pxQueue, 1 );
 
             /* The event list is not altered if the queue is locked.  This will
              * be done when the queue is unlocked later. */
@@ -1299,9 +1496,9 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                     }
                     else
                     {
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                             {
                                 /* The task waiting has a higher priority so
                                  *  record that a context switch is required. */
@@ -1327,9 +1524,9 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                 }
                 #else /* configUSE_QUEUE_SETS */
                 {
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -1366,10 +1563,11 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
         else
         {
             traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            queueSTATS_SEND_FAILED( pxQueue );
             xReturn = errQUEUE_FULL;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1383,6 +1581,10 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
     TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+    #endif
+
     /* Check the pointer is not NULL. */
     configASSERT( ( pxQueue ) );
 
@@ -1414,13 +1616,14 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 prvCopyDataFromQueue( pxQueue, pvBuffer );
                 traceQUEUE_RECEIVE( pxQueue );
                 pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+                queueSTATS_ITEMS_RECEIVED( pxQueue, 1 );
 
                 /* There is now space in the queue, were any tasks waiting to
                  * post to the queue?  If so, unblock the highest priority waiting
                  * task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
                         queueYIELD_IF_USING_PREEMPTION();
                     }
@@ -1477,7 +1680,8 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                queuePLACE_ON_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                queueSTATS_RECEIVE_BLOCKING( pxQueue, xBlockedSince );
                 prvUnlockQueue( pxQueue );
 
                 if( xTaskResumeAll() == pdFALSE )
@@ -1488,6 +1692,8 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                queueSTATS_RECEIVE_UNBLOCKED( pxQueue, xBlockedSince );
             }
             else
             {
@@ -1529,6 +1735,10 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
         BaseType_t xInheritanceOccurred = pdFALSE;
     #endif
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+    #endif
+
     /* Check the queue pointer is not NULL. */
     configASSERT( ( pxQueue ) );
 
@@ -1563,6 +1773,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 /* Semaphores are queues with a data size of zero and where the
                  * messages waiting is the semaphore's count.  Reduce the count. */
                 pxQueue->uxMessagesWaiting = uxSemaphoreCount - ( UBaseType_t ) 1;
+                queueSTATS_ITEMS_RECEIVED( pxQueue, 1 );
 
                 #if ( configUSE_MUTEXES == 1 )
                 {
@@ -1581,9 +1792,9 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 
                 /* Check to see if other tasks are blocked waiting to give the
                  * semaphore, and if so, unblock the highest priority such task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
                         queueYIELD_IF_USING_PREEMPTION();
                     }
@@ -1660,7 +1871,8 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 }
                 #endif /* if ( configUSE_MUTEXES == 1 ) */
 
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                queuePLACE_ON_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                queueSTATS_RECEIVE_BLOCKING( pxQueue, xBlockedSince );
                 prvUnlockQueue( pxQueue );
 
                 if( xTaskResumeAll() == pdFALSE )
@@ -1671,6 +1883,8 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                queueSTATS_RECEIVE_UNBLOCKED( pxQueue, xBlockedSince );
             }
             else
             {
@@ -1737,6 +1951,10 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
     int8_t * pcOriginalReadPosition;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+    #endif
+
     /* Check the pointer is not NULL. */
     configASSERT( ( pxQueue ) );
 
@@ -1777,9 +1995,9 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
 
                 /* The data is being left in the queue, so see if there are
                  * any other tasks waiting for the data. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority than this task. */
                         queueYIELD_IF_USING_PREEMPTION();
@@ -1838,7 +2056,8 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                queuePLACE_ON_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                queueSTATS_RECEIVE_BLOCKING( pxQueue, xBlockedSince );
                 prvUnlockQueue( pxQueue );
 
                 if( xTaskResumeAll() == pdFALSE )
@@ -1849,6 +2068,8 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                queueSTATS_RECEIVE_UNBLOCKED( pxQueue, xBlockedSince );
             }
             else
             {
@@ -1906,7 +2127,7 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1919,6 +2140,7 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
 
             prvCopyDataFromQueue( pxQueue, pvBuffer );
             pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+            queueSTATS_ITEMS_RECEIVED( pxQueue, 1 );
 
             /* If the queue is locked the event list will not be modified.
              * Instead update the lock count so the task that unlocks the queue
@@ -1926,9 +2148,9 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
              * locked. */
             if( cRxLock == queueUNLOCKED )
             {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority than us so
                          * force a context switch. */
@@ -1966,107 +2188,534 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
             traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
-                              void * const pvBuffer )
+UBaseType_t xQueueSendBatch( QueueHandle_t xQueue,
+                             const void * const pvItemsToQueue,
+                             const UBaseType_t uxItemCount,
+                             TickType_t xTicksToWait )
 {
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    int8_t * pcOriginalReadPosition;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+    #endif
+
     configASSERT( pxQueue );
-    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+    configASSERT( !( ( pvItemsToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+    /* Mutexes have to be given back one by one by their holder. */
+    configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
     {
-        /* Cannot block in an ISR, so check there is data available. */
-        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        taskENTER_CRITICAL();
         {
-            traceQUEUE_PEEK_FROM_ISR( pxQueue );
+            const UBaseType_t uxSpacesAvailable = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
 
-            /* Remember the read position so it can be reset as nothing is
-             * actually being removed from the queue. */
-            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+            /* Is there room for at least one item?  As many items as fit are
+             * copied, the receivers are woken and the calling task yields at
+             * most once for the whole batch. */
+            if( uxSpacesAvailable > ( UBaseType_t ) 0 )
+            {
+                const UBaseType_t uxItemsToSend = ( uxItemCount < uxSpacesAvailable ) ? uxItemCount : uxSpacesAvailable;
 
-            xReturn = pdPASS;
+                traceQUEUE_SEND( pxQueue );
+                prvCopyBatchToQueue( pxQueue, pvItemsToQueue, uxItemsToSend );
+
+                if( prvNotifyBatchReceivers( pxQueue, uxItemsToSend ) != pdFALSE )
+                {
+                    /* A task with a priority higher than our own was
+                     * unblocked, yield from within the critical section - the
+                     * kernel takes care of that. */
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return uxItemsToSend;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was full and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueSTATS_SEND_FAILED( pxQueue );
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    return ( UBaseType_t ) 0;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was full and a block time was specified so
+                     * configure the timeout structure. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
         }
-        else
+        taskEXIT_CRITICAL();
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            xReturn = pdFAIL;
-            traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                queuePLACE_ON_WAITING_LIST( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                queueSTATS_SEND_BLOCKING( pxQueue, xBlockedSince );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueSTATS_SEND_UNBLOCKED( pxQueue, xBlockedSince );
+            }
+            else
+            {
+                /* Try again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
         }
-    }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        else
+        {
+            /* The timeout has expired. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
 
-    return xReturn;
+            traceQUEUE_SEND_FAILED( pxQueue );
+            return ( UBaseType_t ) 0;
+        }
+    } /*lint -restore */
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+UBaseType_t xQueueSendBatchFromISR( QueueHandle_t xQueue,
+                                    const void * const pvItemsToQueue,
+                                    const UBaseType_t uxItemCount,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
 {
     UBaseType_t uxReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
 
-    configASSERT( xQueue );
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemsToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
 
-    taskENTER_CRITICAL();
+    /* See the comment in xQueueGenericSendFromISR() about the maximum system
+     * call interrupt priority. */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
+        const UBaseType_t uxSpacesAvailable = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+        if( uxSpacesAvailable > ( UBaseType_t ) 0 )
+        {
+            int8_t cTxLock = pxQueue->cTxLock;
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+            uxReturn = ( uxItemCount < uxSpacesAvailable ) ? uxItemCount : uxSpacesAvailable;
 
-    configASSERT( pxQueue );
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+            prvCopyBatchToQueue( pxQueue, pvItemsToQueue, uxReturn );
 
-    taskENTER_CRITICAL();
-    {
-        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                if( prvNotifyBatchReceivers( pxQueue, uxReturn ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                UBaseType_t uxItem;
+
+                /* Count every item so the task that unlocks the queue can
+                 * wake one receiver for each of them. */
+                for( uxItem = ( UBaseType_t ) 0; uxItem < uxReturn; uxItem++ )
+                {
+                    prvIncrementQueueTxLock( pxQueue, cTxLock );
+                    cTxLock = pxQueue->cTxLock;
+                }
+            }
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            queueSTATS_SEND_FAILED( pxQueue );
+            uxReturn = ( UBaseType_t ) 0;
+        }
     }
-    taskEXIT_CRITICAL();
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+}
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+UBaseType_t xQueueReceiveBatch( QueueHandle_t xQueue,
+                                void * const pvBuffer,
+                                const UBaseType_t uxMaxItems,
+                                TickType_t xTicksToWait )
 {
-    UBaseType_t uxReturn;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+    #endif
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* Mutexes are taken with xSemaphoreTake() so the priority inheritance
+     * is applied. */
+    configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /*lint -save -e904  This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            /* Is there data in the queue now?  Everything up to uxMaxItems is
+             * removed and the senders are woken with a single yield. */
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                const UBaseType_t uxItemsToReceive = ( uxMaxItems < uxMessagesWaiting ) ? uxMaxItems : uxMessagesWaiting;
+
+                prvCopyBatchFromQueue( pxQueue, pvBuffer, uxItemsToReceive );
+                traceQUEUE_RECEIVE( pxQueue );
+                pxQueue->uxMessagesWaiting = uxMessagesWaiting - uxItemsToReceive;
+                queueSTATS_ITEMS_RECEIVED( pxQueue, uxItemsToReceive );
+
+                if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToSend ), uxItemsToReceive ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return uxItemsToReceive;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return ( UBaseType_t ) 0;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was empty and a block time was specified so
+                     * configure the timeout structure. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            /* The timeout has not expired.  If the queue is still empty place
+             * the task on the list of tasks waiting to receive from the queue. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                queuePLACE_ON_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                queueSTATS_RECEIVE_BLOCKING( pxQueue, xBlockedSince );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueSTATS_RECEIVE_UNBLOCKED( pxQueue, xBlockedSince );
+            }
+            else
+            {
+                /* The queue contains data again.  Loop back to try and read the
+                 * data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out.  If there is no data in the queue exit, otherwise loop
+             * back and attempt to read the data. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                return ( UBaseType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueReceiveBatchFromISR( QueueHandle_t xQueue,
+                                       void * const pvBuffer,
+                                       const UBaseType_t uxMaxItems,
+                                       BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+    /* See the comment in xQueueGenericSendFromISR() about the maximum system
+     * call interrupt priority. */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+        /* Cannot block in an ISR, so check there is data available. */
+        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        {
+            int8_t cRxLock = pxQueue->cRxLock;
+
+            uxReturn = ( uxMaxItems < uxMessagesWaiting ) ? uxMaxItems : uxMessagesWaiting;
+
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+            prvCopyBatchFromQueue( pxQueue, pvBuffer, uxReturn );
+            pxQueue->uxMessagesWaiting = uxMessagesWaiting - uxReturn;
+            queueSTATS_ITEMS_RECEIVED( pxQueue, uxReturn );
+
+            /* If the queue is locked the event list will not be modified.
+             * Instead update the lock count so the task that unlocks the queue
+             * will know that an ISR has removed data while the queue was
+             * locked. */
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToSend ), uxReturn ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                UBaseType_t uxItem;
+
+                for( uxItem = ( UBaseType_t ) 0; uxItem < uxReturn; uxItem++ )
+                {
+                    prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    cRxLock = pxQueue->cRxLock;
+                }
+            }
+        }
+        else
+        {
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            uxReturn = ( UBaseType_t ) 0;
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
+                              void * const pvBuffer )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    int8_t * pcOriginalReadPosition;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        /* Cannot block in an ISR, so check there is data available. */
+        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        {
+            traceQUEUE_PEEK_FROM_ISR( pxQueue );
+
+            /* Remember the read position so it can be reset as nothing is
+             * actually being removed from the queue. */
+            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+            prvCopyDataFromQueue( pxQueue, pvBuffer );
+            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+            traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+
+    configASSERT( xQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    uxReturn = pxQueue->uxMessagesWaiting;
 
     return uxReturn;
 } /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
@@ -2089,7 +2738,7 @@ void vQueueDelete( QueueHandle_t xQueue )
     {
         /* The queue can only have been allocated dynamically - free it
          * again. */
-        vPortFree( pxQueue );
+        queueFREE_QUEUE( pxQueue );
     }
     #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
     {
@@ -2097,7 +2746,7 @@ void vQueueDelete( QueueHandle_t xQueue )
          * check before attempting to free the memory. */
         if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
         {
-            vPortFree( pxQueue );
+            queueFREE_QUEUE( pxQueue );
         }
         else
         {
@@ -2157,14 +2806,33 @@ void vQueueDelete( QueueHandle_t xQueue )
          * other tasks that are waiting for the same mutex.  For this purpose,
          * return the priority of the highest priority task that is waiting for the
          * mutex. */
-        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+        #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
         {
-            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+            /* The first task of the highest priority list has the highest
+             * priority of all the waiting tasks. */
+            const List_t * const pxWaiters = pxListGetHighestPriorityWaiters( ( PriorityEventList_t * ) &( pxQueue->xTasksWaitingToReceive ) );
+
+            if( pxWaiters != NULL )
+            {
+                uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxWaiters );
+            }
+            else
+            {
+                uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            }
         }
-        else
+        #else /* configUSE_PRIORITY_EVENT_LISTS */
         {
-            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+            {
+                uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+            }
+            else
+            {
+                uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            }
         }
+        #endif /* configUSE_PRIORITY_EVENT_LISTS */
 
         return uxHighestPriorityOfWaitingTasks;
     }
@@ -2202,7 +2870,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
     else if( xPosition == queueSEND_TO_BACK )
     {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        ( void ) portMEMCPY( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
         pxQueue->pcWriteTo += pxQueue->uxItemSize;                                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 
         if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                                             /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
@@ -2216,7 +2884,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
     else
     {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
+        ( void ) portMEMCPY( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
         pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 
         if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
@@ -2250,6 +2918,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
 
     pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+    queueSTATS_ITEMS_SENT( pxQueue, 1 );
 
     return xReturn;
 }
@@ -2271,11 +2940,182 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
             mtCOVERAGE_TEST_MARKER();
         }
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        ( void ) portMEMCPY( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
     }
 }
 /*-----------------------------------------------------------*/
 
+static void prvCopyBatchToQueue( Queue_t * const pxQueue,
+                                 const void * pvItemsToQueue,
+                                 const UBaseType_t uxCount )
+{
+    /* This function is called from a critical section. */
+
+    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+    {
+        const size_t xTotalBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+        size_t xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ); /*lint !e946 !e9033 The write pointer never passes the tail. */
+
+        if( xFirstBytes > xTotalBytes )
+        {
+            xFirstBytes = xTotalBytes;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Copy up to the end of the storage area, then wrap to its start. */
+        ( void ) portMEMCPY( ( void * ) pxQueue->pcWriteTo, pvItemsToQueue, xFirstBytes ); /*lint !e961 !e418 !e9087 Previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+        pxQueue->pcWriteTo += xFirstBytes;                                                  /*lint !e9016 Pointer arithmetic on char types ok. */
+
+        if( xFirstBytes < xTotalBytes )
+        {
+            ( void ) portMEMCPY( ( void * ) pxQueue->pcHead, ( const void * ) ( ( const int8_t * ) pvItemsToQueue + xFirstBytes ), xTotalBytes - xFirstBytes ); /*lint !e961 !e418 !e9087 !e9016 Pointer arithmetic on char types ok. */
+            pxQueue->pcWriteTo = pxQueue->pcHead + ( xTotalBytes - xFirstBytes );                                                                                 /*lint !e9016 Pointer arithmetic on char types ok. */
+        }
+        else if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting + uxCount;
+    queueSTATS_ITEMS_SENT( pxQueue, uxCount );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyBatchFromQueue( Queue_t * const pxQueue,
+                                   void * const pvBuffer,
+                                   const UBaseType_t uxCount )
+{
+    /* This function is called from a critical section.  As with
+     * prvCopyDataFromQueue() the number of items waiting is updated by the
+     * caller. */
+
+    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+    {
+        const size_t xTotalBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+        int8_t * pcReadStart = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+        size_t xFirstBytes;
+
+        /* pcReadFrom points to the item that was read last, the next item
+         * follows it. */
+        if( pcReadStart >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+        {
+            pcReadStart = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadStart ); /*lint !e946 !e9033 The read pointer never passes the tail. */
+
+        if( xFirstBytes > xTotalBytes )
+        {
+            xFirstBytes = xTotalBytes;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) portMEMCPY( pvBuffer, ( void * ) pcReadStart, xFirstBytes ); /*lint !e961 !e418 !e9087 Previous logic ensures a null pointer can only be passed to memcpy() when the count is 0. */
+
+        if( xFirstBytes < xTotalBytes )
+        {
+            ( void ) portMEMCPY( ( void * ) ( ( int8_t * ) pvBuffer + xFirstBytes ), ( void * ) pxQueue->pcHead, xTotalBytes - xFirstBytes ); /*lint !e961 !e418 !e9087 !e9016 Pointer arithmetic on char types ok. */
+            pcReadStart = pxQueue->pcHead + ( xTotalBytes - xFirstBytes );                                                                     /*lint !e9016 Pointer arithmetic on char types ok. */
+        }
+        else
+        {
+            pcReadStart += xFirstBytes; /*lint !e9016 Pointer arithmetic on char types ok. */
+        }
+
+        /* Leave the read pointer on the last item copied out. */
+        pxQueue->u.xQueue.pcReadFrom = pcReadStart - pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockWaitingTasks( QueueWaitingList_t * const pxEventList,
+                                          UBaseType_t uxMaxTasks )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    /* This function is called from a critical section.  Every item added or
+     * removed can satisfy one waiting task, usually only one task waits so a
+     * single task is woken no matter how many items were moved. */
+    while( ( uxMaxTasks > ( UBaseType_t ) 0 ) && ( queueWAITING_LIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+    {
+        if( queueREMOVE_FROM_WAITING_LIST( pxEventList ) != pdFALSE )
+        {
+            xHigherPriorityTaskWoken = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxMaxTasks--;
+    }
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvNotifyBatchReceivers( Queue_t * const pxQueue,
+                                           const UBaseType_t uxCount )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+    {
+        if( pxQueue->pxQueueSetContainer != NULL )
+        {
+            UBaseType_t uxItem;
+
+            /* The queue set holds one handle for every item in the queue. */
+            for( uxItem = ( UBaseType_t ) 0; uxItem < uxCount; uxItem++ )
+            {
+                if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            xHigherPriorityTaskWoken = prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxCount );
+        }
+    }
+    #else /* configUSE_QUEUE_SETS */
+    {
+        xHigherPriorityTaskWoken = prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxCount );
+    }
+    #endif /* configUSE_QUEUE_SETS */
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2314,9 +3154,9 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
                     /* Tasks that are removed from the event list will get
                      * added to the pending ready list as the scheduler is still
                      * suspended. */
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -2337,9 +3177,9 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
             {
                 /* Tasks that are removed from the event list will get added to
                  * the pending ready list as the scheduler is still suspended. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority so record that
                          * a context switch is required. */
@@ -2371,9 +3211,9 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 
         while( cRxLock > queueLOCKED_UNMODIFIED )
         {
-            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            if( queueWAITING_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
             {
-                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                if( queueREMOVE_FROM_WAITING_LIST( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                 {
                     vTaskMissedYield();
                 }
@@ -2613,6 +3453,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 }
 
                 --( pxQueue->uxMessagesWaiting );
+                queueSTATS_ITEMS_RECEIVED( pxQueue, 1 );
                 ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
 
                 xReturn = pdPASS;
@@ -2727,6 +3568,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             }
 
             --( pxQueue->uxMessagesWaiting );
+            queueSTATS_ITEMS_RECEIVED( pxQueue, 1 );
             ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
 
             if( ( *pxCoRoutineWoken ) == pdFALSE )
@@ -2769,6 +3611,31 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
     void vQueueAddToRegistry( QueueHandle_t xQueue,
                               const char * pcQueueName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        prvAddToRegistry( xQueue, pcQueueName, queueREGISTRY_QUEUE );
+    }
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATS == 1 ) )
+
+    void vQueueAddStreamBufferToRegistry( void * pvStreamBuffer,
+                                          const char * pcStreamBufferName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        /* The registry only keeps the handle, the type tells
+         * uxQueueGetRegistryStats() how to read the statistics. */
+        prvAddToRegistry( ( QueueHandle_t ) pvStreamBuffer, pcStreamBufferName, queueREGISTRY_STREAM_BUFFER );
+    }
+
+#endif /* ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+    static void prvAddToRegistry( QueueHandle_t xQueue,
+                                  const char * pcQueueName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                  uint8_t ucObjectType )
     {
         UBaseType_t ux;
         QueueRegistryItem_t * pxEntryToWrite = NULL;
@@ -2805,6 +3672,16 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             pxEntryToWrite->pcQueueName = pcQueueName;
             pxEntryToWrite->xHandle = xQueue;
 
+            #if ( configUSE_QUEUE_STATS == 1 )
+            {
+                ucQueueRegistryTypes[ pxEntryToWrite - xQueueRegistry ] = ucObjectType;
+            }
+            #else
+            {
+                ( void ) ucObjectType;
+            }
+            #endif
+
             traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
         }
     }
@@ -2876,6 +3753,97 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 #endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_STATS == 1 )
+
+    void vQueueGetStats( QueueHandle_t xQueue,
+                         QueueStats_t * pxStats )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pxStats );
+
+        taskENTER_CRITICAL();
+        {
+            *pxStats = pxQueue->xStats;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+    void vQueueResetStats( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            ( void ) memset( &( pxQueue->xStats ), 0x00, sizeof( QueueStats_t ) );
+
+            /* The high water mark starts again from the current fill level. */
+            pxQueue->xStats.ulHighWaterMark = ( uint32_t ) pxQueue->uxMessagesWaiting;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATS == 1 ) )
+
+    UBaseType_t uxQueueGetRegistryStats( QueueRegistryStats_t * const pxRegistryStats,
+                                         const UBaseType_t uxArraySize )
+    {
+        UBaseType_t ux, uxCount = ( UBaseType_t ) 0U;
+        QueueRegistryStats_t * pxEntry;
+
+        configASSERT( ( pxRegistryStats != NULL ) || ( uxArraySize == ( UBaseType_t ) 0U ) );
+
+        /* As with pcQueueGetName() nothing protects the registry while it is
+         * read, an object must not be deleted while its statistics are
+         * collected. */
+        for( ux = ( UBaseType_t ) 0U; ( ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE ) && ( uxCount < uxArraySize ); ux++ )
+        {
+            if( xQueueRegistry[ ux ].pcQueueName != NULL )
+            {
+                pxEntry = &( pxRegistryStats[ uxCount ] );
+                pxEntry->pcName = xQueueRegistry[ ux ].pcQueueName;
+                pxEntry->pvHandle = ( void * ) xQueueRegistry[ ux ].xHandle;
+
+                if( ucQueueRegistryTypes[ ux ] == queueREGISTRY_STREAM_BUFFER )
+                {
+                    StreamBufferHandle_t xStreamBuffer = ( StreamBufferHandle_t ) pxEntry->pvHandle;
+
+                    pxEntry->xIsStreamBuffer = pdTRUE;
+                    pxEntry->xCapacity = xStreamBufferSpacesAvailable( xStreamBuffer ) + xStreamBufferBytesAvailable( xStreamBuffer );
+                    vStreamBufferGetStats( xStreamBuffer, &( pxEntry->xStats ) );
+                }
+                else
+                {
+                    pxEntry->xIsStreamBuffer = pdFALSE;
+                    pxEntry->xCapacity = ( size_t ) xQueueRegistry[ ux ].xHandle->uxLength;
+                    vQueueGetStats( xQueueRegistry[ ux ].xHandle, &( pxEntry->xStats ) );
+                }
+
+                uxCount++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return uxCount;
+    }
+
+#endif /* ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATS == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TIMERS == 1 )
 
     void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
@@ -2903,7 +3871,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0U )
         {
             /* There is nothing in the queue, block for the specified period. */
-            vTaskPlaceOnEventListRestricted( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait, xWaitIndefinitely );
+            queuePLACE_ON_WAITING_LIST_RESTRICTED( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait, xWaitIndefinitely );
         }
         else
         {
@@ -3054,9 +4022,9 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
             if( cTxLock == queueUNLOCKED )
             {
-                if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( queueWAITING_LIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_WAITING_LIST( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority. */
                         xReturn = pdTRUE;
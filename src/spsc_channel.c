@@ -0,0 +1,678 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc_channel.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if ( configUSE_SPSC_CHANNELS == 1 )
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build spsc_channel.c
+#endif
+
+#if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+    #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build spsc_channel.c
+#endif
+
+#if ( configSPSC_CHANNEL_NOTIFY_INDEX == 0 )
+    #error configSPSC_CHANNEL_NOTIFY_INDEX must be a task notification index other than 0, index 0 is left to the application
+#endif
+
+#if ( configSPSC_CHANNEL_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+    #error configSPSC_CHANNEL_NOTIFY_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
+/* Bits stored in the ucFlags field of the channel. */
+#define spscFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 ) /* Set if the channel was created using statically allocated memory. */
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on the channel.  uxHead is only
+ * written by the writer and uxTail only by the reader, each side publishes its
+ * own index and reads the index of the other side.  The wait counters follow
+ * the same rule: a side counts the times it registers as waiting, the other
+ * side records the count it last notified so a blocked task is notified once
+ * and not for every item moved while it waits to run. */
+typedef struct SpscChannelDef_t                     /*lint !e9058 Style convention uses tag. */
+{
+    volatile UBaseType_t uxHead;                    /* Index of the slot the next item is written to. */
+    volatile UBaseType_t uxTail;                    /* Index of the slot the next item is read from. */
+    UBaseType_t uxSlots;                            /* Number of slots in the storage area, one more than the length of the channel. */
+    UBaseType_t uxItemSize;                         /* Size of a single item in bytes. */
+    uint8_t * pucStorage;                           /* Holds the items. */
+    volatile TaskHandle_t xTaskWaitingToReceive;    /* The reader task while it is about to block on an empty channel. */
+    volatile TaskHandle_t xTaskWaitingToSend;       /* The writer task while it is about to block on a full channel. */
+    volatile UBaseType_t uxReceiveWaits;            /* Times the reader registered as waiting, written by the reader. */
+    volatile UBaseType_t uxSendWaits;               /* Times the writer registered as waiting, written by the writer. */
+    UBaseType_t uxReceiveWaitsNotified;             /* uxReceiveWaits when the writer last notified the reader, written by the writer. */
+    UBaseType_t uxSendWaitsNotified;                /* uxSendWaits when the reader last notified the writer, written by the reader. */
+    uint8_t ucFlags;
+} SpscChannel_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Copies an item into the slot at the head of the channel and publishes it.
+ * Returns pdFALSE without copying anything if the channel is full.
+ */
+static BaseType_t prvWriteItem( SpscChannel_t * const pxChannel,
+                                const void * pvItemToSend ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the item at the tail of the channel out and frees its slot.  Returns
+ * pdFALSE if the channel is empty.
+ */
+static BaseType_t prvReadItem( SpscChannel_t * const pxChannel,
+                               void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task until the other side notifies it, unless the
+ * channel changed state while the task was registering itself as waiting.
+ */
+static void prvWaitForOtherSide( SpscChannel_t * const pxChannel,
+                                 volatile TaskHandle_t * const pxWaitingTask,
+                                 volatile UBaseType_t * const puxWaits,
+                                 const BaseType_t xIsSender,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the task of the other side if it registered as waiting since it was
+ * last notified, NULL otherwise.  Called after the index of the caller was
+ * published.
+ */
+static TaskHandle_t prvTaskToNotify( volatile TaskHandle_t * const pxWaitingTask,
+                                     volatile UBaseType_t * const puxWaits,
+                                     UBaseType_t * const puxWaitsNotified ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when a channel has been created to fill in its structure.
+ */
+static void prvInitialiseNewChannel( SpscChannel_t * const pxChannel,
+                                     uint8_t * const pucStorage,
+                                     UBaseType_t uxSlots,
+                                     UBaseType_t uxItemSize,
+                                     uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    SpscChannelHandle_t xSpscChannelCreate( UBaseType_t uxChannelLength,
+                                            UBaseType_t uxItemSize )
+    {
+        uint8_t * pucAllocatedMemory = NULL;
+        size_t xStorageSize;
+
+        configASSERT( uxChannelLength > ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        /* One slot more than requested is allocated, a channel with the head
+         * one slot behind the tail is full, one with the head on the tail is
+         * empty.  The structure and the storage area are allocated in a single
+         * call to pvPortMalloc(), the storage area follows the structure. */
+        xStorageSize = ( size_t ) ( uxChannelLength + ( UBaseType_t ) 1 ) * ( size_t ) uxItemSize;
+
+        /* Check for multiplication overflow. */
+        if( ( xStorageSize / ( size_t ) uxItemSize ) == ( size_t ) ( uxChannelLength + ( UBaseType_t ) 1 ) )
+        {
+            pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( SpscChannel_t ) + xStorageSize ); /*lint !e9079 malloc() only returns void*. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pucAllocatedMemory != NULL )
+        {
+            prvInitialiseNewChannel( ( SpscChannel_t * ) pucAllocatedMemory,        /* Structure at the start of the allocated memory. */ /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+                                     pucAllocatedMemory + sizeof( SpscChannel_t ), /* Storage area follows. */ /*lint !e9016 Indexing past structure valid for uint8_t pointer. */
+                                     uxChannelLength + ( UBaseType_t ) 1,
+                                     uxItemSize,
+                                     0 );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return ( SpscChannelHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    SpscChannelHandle_t xSpscChannelCreateStatic( UBaseType_t uxChannelLength,
+                                                  UBaseType_t uxItemSize,
+                                                  uint8_t * const pucChannelStorage,
+                                                  StaticSpscChannel_t * const pxStaticChannel )
+    {
+        SpscChannel_t * const pxChannel = ( SpscChannel_t * ) pxStaticChannel; /*lint !e740 !e9087 Safe cast as StaticSpscChannel_t is opaque SpscChannel_t. */
+        SpscChannelHandle_t xReturn;
+
+        configASSERT( pucChannelStorage );
+        configASSERT( pxStaticChannel );
+        configASSERT( uxChannelLength > ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticSpscChannel_t equals the size of the real
+             * channel structure. */
+            volatile size_t xSize = sizeof( StaticSpscChannel_t );
+            configASSERT( xSize == sizeof( SpscChannel_t ) );
+        } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucChannelStorage != NULL ) && ( pxStaticChannel != NULL ) )
+        {
+            prvInitialiseNewChannel( pxChannel,
+                                     pucChannelStorage,
+                                     uxChannelLength + ( UBaseType_t ) 1,
+                                     uxItemSize,
+                                     spscFLAGS_IS_STATICALLY_ALLOCATED );
+
+            xReturn = ( SpscChannelHandle_t ) pxStaticChannel; /*lint !e9087 Data hiding requires cast to opaque type. */
+        }
+        else
+        {
+            xReturn = NULL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vSpscChannelDelete( SpscChannelHandle_t xChannel )
+{
+    SpscChannel_t * pxChannel = xChannel;
+
+    configASSERT( pxChannel );
+
+    if( ( pxChannel->ucFlags & spscFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            /* Both the structure and the storage area were allocated in a
+             * single block of memory, which can be freed at once. */
+            vPortFree( ( void * ) pxChannel ); /*lint !e9087 Standard free() semantics require void *, plus pxChannel was allocated by pvPortMalloc(). */
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xChannel == ( SpscChannelHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* The structure and storage area were statically allocated, so
+         * just scrub the structure. */
+        ( void ) memset( pxChannel, 0x00, sizeof( SpscChannel_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscChannelSend( SpscChannelHandle_t xChannel,
+                             const void * pvItemToSend,
+                             TickType_t xTicksToWait )
+{
+    SpscChannel_t * const pxChannel = xChannel;
+    BaseType_t xReturn = pdFAIL, xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    TaskHandle_t xReceiver;
+
+    configASSERT( pxChannel );
+    configASSERT( pvItemToSend );
+
+    for( ; ; )
+    {
+        if( prvWriteItem( pxChannel, pvItemToSend ) != pdFALSE )
+        {
+            xReturn = pdPASS;
+            break;
+        }
+        else if( xTicksToWait == ( TickType_t ) 0 )
+        {
+            break;
+        }
+        else
+        {
+            /* The timeout is only set up once the task has to block, so the
+             * fast path does not enter a critical section. */
+            if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvWaitForOtherSide( pxChannel, &( pxChannel->xTaskWaitingToSend ), &( pxChannel->uxSendWaits ), pdTRUE, xTicksToWait );
+
+            /* Try once more without blocking once the time is up. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xTicksToWait = ( TickType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+    if( xReturn == pdPASS )
+    {
+        /* The head was published before the waiting reader is read, the
+         * reader registers itself before it checks the head again, so at
+         * least one of the two sides sees the other. */
+        portMEMORY_BARRIER();
+        xReceiver = prvTaskToNotify( &( pxChannel->xTaskWaitingToReceive ), &( pxChannel->uxReceiveWaits ), &( pxChannel->uxReceiveWaitsNotified ) );
+
+        if( xReceiver != NULL )
+        {
+            ( void ) xTaskNotifyGiveIndexed( xReceiver, configSPSC_CHANNEL_NOTIFY_INDEX );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscChannelSendFromISR( SpscChannelHandle_t xChannel,
+                                    const void * pvItemToSend,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    SpscChannel_t * const pxChannel = xChannel;
+    BaseType_t xReturn = pdFAIL;
+    TaskHandle_t xReceiver;
+
+    configASSERT( pxChannel );
+    configASSERT( pvItemToSend );
+
+    if( prvWriteItem( pxChannel, pvItemToSend ) != pdFALSE )
+    {
+        portMEMORY_BARRIER();
+        xReceiver = prvTaskToNotify( &( pxChannel->xTaskWaitingToReceive ), &( pxChannel->uxReceiveWaits ), &( pxChannel->uxReceiveWaitsNotified ) );
+
+        if( xReceiver != NULL )
+        {
+            vTaskNotifyGiveIndexedFromISR( xReceiver, configSPSC_CHANNEL_NOTIFY_INDEX, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscChannelReceive( SpscChannelHandle_t xChannel,
+                                void * pvBuffer,
+                                TickType_t xTicksToWait )
+{
+    SpscChannel_t * const pxChannel = xChannel;
+    BaseType_t xReturn = pdFAIL, xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    TaskHandle_t xSender;
+
+    configASSERT( pxChannel );
+    configASSERT( pvBuffer );
+
+    for( ; ; )
+    {
+        if( prvReadItem( pxChannel, pvBuffer ) != pdFALSE )
+        {
+            xReturn = pdPASS;
+            break;
+        }
+        else if( xTicksToWait == ( TickType_t ) 0 )
+        {
+            break;
+        }
+        else
+        {
+            if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvWaitForOtherSide( pxChannel, &( pxChannel->xTaskWaitingToReceive ), &( pxChannel->uxReceiveWaits ), pdFALSE, xTicksToWait );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xTicksToWait = ( TickType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+    if( xReturn == pdPASS )
+    {
+        portMEMORY_BARRIER();
+        xSender = prvTaskToNotify( &( pxChannel->xTaskWaitingToSend ), &( pxChannel->uxSendWaits ), &( pxChannel->uxSendWaitsNotified ) );
+
+        if( xSender != NULL )
+        {
+            ( void ) xTaskNotifyGiveIndexed( xSender, configSPSC_CHANNEL_NOTIFY_INDEX );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscChannelReceiveFromISR( SpscChannelHandle_t xChannel,
+                                       void * pvBuffer,
+                                       BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    SpscChannel_t * const pxChannel = xChannel;
+    BaseType_t xReturn = pdFAIL;
+    TaskHandle_t xSender;
+
+    configASSERT( pxChannel );
+    configASSERT( pvBuffer );
+
+    if( prvReadItem( pxChannel, pvBuffer ) != pdFALSE )
+    {
+        portMEMORY_BARRIER();
+        xSender = prvTaskToNotify( &( pxChannel->xTaskWaitingToSend ), &( pxChannel->uxSendWaits ), &( pxChannel->uxSendWaitsNotified ) );
+
+        if( xSender != NULL )
+        {
+            vTaskNotifyGiveIndexedFromISR( xSender, configSPSC_CHANNEL_NOTIFY_INDEX, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxSpscChannelMessagesWaiting( SpscChannelHandle_t xChannel )
+{
+    const SpscChannel_t * const pxChannel = xChannel;
+    UBaseType_t uxHead, uxTail, uxReturn;
+
+    configASSERT( pxChannel );
+
+    uxHead = pxChannel->uxHead;
+    uxTail = pxChannel->uxTail;
+
+    if( uxHead >= uxTail )
+    {
+        uxReturn = uxHead - uxTail;
+    }
+    else
+    {
+        uxReturn = ( pxChannel->uxSlots - uxTail ) + uxHead;
+    }
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWriteItem( SpscChannel_t * const pxChannel,
+                                const void * pvItemToSend )
+{
+    const UBaseType_t uxHead = pxChannel->uxHead;
+    UBaseType_t uxNextHead = uxHead + ( UBaseType_t ) 1;
+    BaseType_t xReturn;
+
+    if( uxNextHead == pxChannel->uxSlots )
+    {
+        uxNextHead = ( UBaseType_t ) 0;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( uxNextHead != pxChannel->uxTail )
+    {
+        ( void ) portMEMCPY( ( void * ) &( pxChannel->pucStorage[ uxHead * pxChannel->uxItemSize ] ), pvItemToSend, ( size_t ) pxChannel->uxItemSize ); /*lint !e9087 !e418 Cast to void required by function signature. */
+
+        /* The item must be complete before the reader can see the new head. */
+        portMEMORY_BARRIER();
+        pxChannel->uxHead = uxNextHead;
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReadItem( SpscChannel_t * const pxChannel,
+                               void * pvBuffer )
+{
+    const UBaseType_t uxTail = pxChannel->uxTail;
+    UBaseType_t uxNextTail;
+    BaseType_t xReturn;
+
+    if( uxTail != pxChannel->uxHead )
+    {
+        /* Do not read the item before the head that published it. */
+        portMEMORY_BARRIER();
+        ( void ) portMEMCPY( pvBuffer, ( const void * ) &( pxChannel->pucStorage[ uxTail * pxChannel->uxItemSize ] ), ( size_t ) pxChannel->uxItemSize ); /*lint !e9087 !e418 Cast to void required by function signature. */
+
+        uxNextTail = uxTail + ( UBaseType_t ) 1;
+
+        if( uxNextTail == pxChannel->uxSlots )
+        {
+            uxNextTail = ( UBaseType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The item must be copied out before the writer may reuse its slot. */
+        portMEMORY_BARRIER();
+        pxChannel->uxTail = uxNextTail;
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForOtherSide( SpscChannel_t * const pxChannel,
+                                 volatile TaskHandle_t * const pxWaitingTask,
+                                 volatile UBaseType_t * const puxWaits,
+                                 const BaseType_t xIsSender,
+                                 TickType_t xTicksToWait )
+{
+    BaseType_t xMustWait;
+    UBaseType_t uxNextHead;
+
+    /* Register as waiting first, then check the channel again.  The other side
+     * updates its index before it looks for a waiting task, so either the
+     * check below sees the update or the other side sees this task.  The count
+     * is updated first, a side that sees the task also sees a count it did
+     * not notify yet. */
+    ( *puxWaits )++;
+    portMEMORY_BARRIER();
+    *pxWaitingTask = xTaskGetCurrentTaskHandle();
+    portMEMORY_BARRIER();
+
+    if( xIsSender != pdFALSE )
+    {
+        uxNextHead = pxChannel->uxHead + ( UBaseType_t ) 1;
+
+        if( uxNextHead == pxChannel->uxSlots )
+        {
+            uxNextHead = ( UBaseType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xMustWait = ( uxNextHead == pxChannel->uxTail ) ? pdTRUE : pdFALSE;
+    }
+    else
+    {
+        xMustWait = ( pxChannel->uxHead == pxChannel->uxTail ) ? pdTRUE : pdFALSE;
+    }
+
+    if( xMustWait != pdFALSE )
+    {
+        /* A notification left over from an earlier wake up only results in
+         * one more pass through the loop of the caller. */
+        ( void ) ulTaskNotifyTakeIndexed( configSPSC_CHANNEL_NOTIFY_INDEX, pdTRUE, xTicksToWait );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    *pxWaitingTask = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvTaskToNotify( volatile TaskHandle_t * const pxWaitingTask,
+                                     volatile UBaseType_t * const puxWaits,
+                                     UBaseType_t * const puxWaitsNotified )
+{
+    TaskHandle_t xTask = *pxWaitingTask;
+    UBaseType_t uxWaits;
+
+    if( xTask != NULL )
+    {
+        /* The task stays registered until it runs again.  Once notified it is
+         * only notified again after it registers once more. */
+        portMEMORY_BARRIER();
+        uxWaits = *puxWaits;
+
+        if( uxWaits != *puxWaitsNotified )
+        {
+            *puxWaitsNotified = uxWaits;
+        }
+        else
+        {
+            xTask = NULL;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xTask;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewChannel( SpscChannel_t * const pxChannel,
+                                     uint8_t * const pucStorage,
+                                     UBaseType_t uxSlots,
+                                     UBaseType_t uxItemSize,
+                                     uint8_t ucFlags )
+{
+    ( void ) memset( ( void * ) pxChannel, 0x00, sizeof( SpscChannel_t ) ); /*lint !e9087 memset() requires void *. */
+    pxChannel->pucStorage = pucStorage;
+    pxChannel->uxSlots = uxSlots;
+    pxChannel->uxItemSize = uxItemSize;
+    pxChannel->ucFlags = ucFlags;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_SPSC_CHANNELS */
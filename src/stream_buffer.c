@@ -98,7 +98,7 @@
     {                                                                                \
         UBaseType_t uxSavedInterruptStatus;                                          \
                                                                                      \
-        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();  \
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();      \
         {                                                                            \
             if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )                     \
             {                                                                        \
@@ -109,7 +109,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToSend = NULL;                       \
             }                                                                        \
         }                                                                            \
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );                 \
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                        \
     }
 #endif /* sbRECEIVE_COMPLETED_FROM_ISR */
 
@@ -175,7 +175,7 @@
     {                                                                                   \
         UBaseType_t uxSavedInterruptStatus;                                             \
                                                                                         \
-        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();     \
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();         \
         {                                                                               \
             if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )                     \
             {                                                                           \
@@ -186,7 +186,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;                       \
             }                                                                           \
         }                                                                               \
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );                    \
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                           \
     }
 #endif /* sbSEND_COMPLETE_FROM_ISR */
 
@@ -239,8 +239,62 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
         StreamBufferCallbackFunction_t pxSendCompletedCallback;    /* Optional callback called on send complete. sbSEND_COMPLETED is called if this is NULL. */
         StreamBufferCallbackFunction_t pxReceiveCompletedCallback; /* Optional callback called on receive complete.  sbRECEIVE_COMPLETED is called if this is NULL. */
     #endif
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        QueueStats_t xStats; /* Traffic through the buffer, see vStreamBufferGetStats(). */
+    #endif
 } StreamBuffer_t;
 
+/* With configUSE_QUEUE_STATS the writer updates the send side of the
+ * statistics and the reader the receive side, the same way they own the head
+ * and the tail of the buffer. */
+#if ( configUSE_QUEUE_STATS == 1 )
+    #define sbSTATS_SENT( pxStreamBuffer, xBytes )                                          \
+    do {                                                                                    \
+        const size_t xBytesInBuffer = prvBytesInBuffer( pxStreamBuffer );                   \
+        ( pxStreamBuffer )->xStats.ulItemsSent++;                                           \
+        ( pxStreamBuffer )->xStats.ulBytesSent += ( uint32_t ) ( xBytes );                  \
+        if( ( uint32_t ) xBytesInBuffer > ( pxStreamBuffer )->xStats.ulHighWaterMark )     \
+        {                                                                                   \
+            ( pxStreamBuffer )->xStats.ulHighWaterMark = ( uint32_t ) xBytesInBuffer;       \
+        }                                                                                   \
+    } while( 0 )
+
+    #define sbSTATS_RECEIVED( pxStreamBuffer, xBytes )                             \
+    do {                                                                           \
+        ( pxStreamBuffer )->xStats.ulItemsReceived++;                              \
+        ( pxStreamBuffer )->xStats.ulBytesReceived += ( uint32_t ) ( xBytes );     \
+    } while( 0 )
+
+    #define sbSTATS_SEND_FAILED( pxStreamBuffer )    ( ( pxStreamBuffer )->xStats.ulFailedSends++ )
+
+    #define sbSTATS_SEND_BLOCKING( pxStreamBuffer, xBlockedSince ) \
+    do {                                                           \
+        ( pxStreamBuffer )->xStats.ulSendBlocks++;                 \
+        ( xBlockedSince ) = xTaskGetTickCount();                   \
+    } while( 0 )
+
+    #define sbSTATS_RECEIVE_BLOCKING( pxStreamBuffer, xBlockedSince ) \
+    do {                                                              \
+        ( pxStreamBuffer )->xStats.ulReceiveBlocks++;                 \
+        ( xBlockedSince ) = xTaskGetTickCount();                      \
+    } while( 0 )
+
+    #define sbSTATS_SEND_UNBLOCKED( pxStreamBuffer, xBlockedSince ) \
+    ( ( pxStreamBuffer )->xStats.ulSendBlockedTicks += ( uint32_t ) ( xTaskGetTickCount() - ( xBlockedSince ) ) )
+
+    #define sbSTATS_RECEIVE_UNBLOCKED( pxStreamBuffer, xBlockedSince ) \
+    ( ( pxStreamBuffer )->xStats.ulReceiveBlockedTicks += ( uint32_t ) ( xTaskGetTickCount() - ( xBlockedSince ) ) )
+#else
+    #define sbSTATS_SENT( pxStreamBuffer, xBytes )
+    #define sbSTATS_RECEIVED( pxStreamBuffer, xBytes )
+    #define sbSTATS_SEND_FAILED( pxStreamBuffer )
+    #define sbSTATS_SEND_BLOCKING( pxStreamBuffer, xBlockedSince )
+    #define sbSTATS_RECEIVE_BLOCKING( pxStreamBuffer, xBlockedSince )
+    #define sbSTATS_SEND_UNBLOCKED( pxStreamBuffer, xBlockedSince )
+    #define sbSTATS_RECEIVE_UNBLOCKED( pxStreamBuffer, xBlockedSince )
+#endif /* configUSE_QUEUE_STATS */
+
 /*
  * The number of bytes available to be read from the buffer.
  */
@@ -304,6 +358,31 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                       size_t xCount,
                                       size_t xTail ) PRIVILEGED_FUNCTION;
 
+/*
+ * Describes the xCount bytes of the storage area that start at xIndex, split
+ * in two parts if they wrap past the end of the storage area.  Used by the
+ * zero copy functions to hand out pointers into pucBuffer.
+ */
+static void prvGetRegion( const StreamBuffer_t * const pxStreamBuffer,
+                          size_t xIndex,
+                          size_t xCount,
+                          StreamBufferRegion_t * const pxRegion ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves xHead past the xDataLengthBytes written in place after a call to
+ * xStreamBufferSendReserve(), writing the message length first if this is a
+ * message buffer.
+ */
+static size_t prvCommitReservedBytes( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves xTail past the xDataLengthBytes returned by xStreamBufferReceivePeek(),
+ * or past the whole next message if this is a message buffer.
+ */
+static size_t prvReleasePeekedBytes( StreamBuffer_t * const pxStreamBuffer,
+                                     size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -482,6 +561,13 @@ void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer )
 
     traceSTREAM_BUFFER_DELETE( xStreamBuffer );
 
+    #if ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATS == 1 ) )
+    {
+        /* The registry must not point to a deleted stream buffer. */
+        vStreamBufferUnregister( xStreamBuffer );
+    }
+    #endif
+
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
     {
         #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
@@ -517,6 +603,10 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        QueueStats_t xStats;
+    #endif
+
     configASSERT( pxStreamBuffer );
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -539,6 +629,13 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_QUEUE_STATS == 1 )
+            {
+                /* The statistics cover the whole life of the buffer. */
+                xStats = pxStreamBuffer->xStats;
+            }
+            #endif
+
             prvInitialiseNewStreamBuffer( pxStreamBuffer,
                                           pxStreamBuffer->pucBuffer,
                                           pxStreamBuffer->xLength,
@@ -553,6 +650,12 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_QUEUE_STATS == 1 )
+            {
+                pxStreamBuffer->xStats = xStats;
+            }
+            #endif
+
             traceSTREAM_BUFFER_RESET( xStreamBuffer );
 
             xReturn = pdPASS;
@@ -650,6 +753,11 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
     TimeOut_t xTimeOut;
     size_t xMaxReportedSpace = 0;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+        BaseType_t xCanBlock;
+    #endif
+
     configASSERT( pvTxData );
     configASSERT( pxStreamBuffer );
 
@@ -696,6 +804,13 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         }
     }
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+    {
+        /* A message that can never fit is a failed non-blocking send too. */
+        xCanBlock = ( xTicksToWait != ( TickType_t ) 0 ) ? pdTRUE : pdFALSE;
+    }
+    #endif
+
     if( xTicksToWait != ( TickType_t ) 0 )
     {
         vTaskSetTimeOutState( &xTimeOut );
@@ -726,8 +841,10 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
             taskEXIT_CRITICAL();
 
             traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+            sbSTATS_SEND_BLOCKING( pxStreamBuffer, xBlockedSince );
             ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
             pxStreamBuffer->xTaskWaitingToSend = NULL;
+            sbSTATS_SEND_UNBLOCKED( pxStreamBuffer, xBlockedSince );
         } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
     }
     else
@@ -746,6 +863,19 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
 
     xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+    {
+        if( ( xCanBlock == pdFALSE ) && ( xReturn < xDataLengthBytes ) )
+        {
+            sbSTATS_SEND_FAILED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif
+
     if( xReturn > ( size_t ) 0 )
     {
         traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
@@ -798,6 +928,15 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
     xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
     xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
+    if( xReturn < xDataLengthBytes )
+    {
+        sbSTATS_SEND_FAILED( pxStreamBuffer );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
     if( xReturn > ( size_t ) 0 )
     {
         /* Was a task waiting for the data? */
@@ -865,6 +1004,7 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
     {
         /* Write the data to the buffer. */
         pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+        sbSTATS_SENT( pxStreamBuffer, xDataLengthBytes );
     }
 
     return xDataLengthBytes;
@@ -879,6 +1019,10 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+    #endif
+
     configASSERT( pvRxData );
     configASSERT( pxStreamBuffer );
 
@@ -929,8 +1073,10 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
         {
             /* Wait for data to be available. */
             traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+            sbSTATS_RECEIVE_BLOCKING( pxStreamBuffer, xBlockedSince );
             ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
             pxStreamBuffer->xTaskWaitingToReceive = NULL;
+            sbSTATS_RECEIVE_UNBLOCKED( pxStreamBuffer, xBlockedSince );
 
             /* Recheck the data available after blocking. */
             xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
@@ -1072,6 +1218,461 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
+size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xDataLengthBytes,
+                                 StreamBufferRegion_t * const pxRegion,
+                                 TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn, xSpace, xNextHead;
+    size_t xRequiredSpace = xDataLengthBytes;
+    size_t xMaxReportedSpace;
+    TimeOut_t xTimeOut;
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+    #endif
+
+    configASSERT( pxRegion );
+    configASSERT( pxStreamBuffer );
+
+    /* The space is checked the same way as in xStreamBufferSend(), the only
+     * difference is that nothing is copied. */
+    xMaxReportedSpace = pxStreamBuffer->xLength - ( size_t ) 1;
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+        /* Overflow? */
+        configASSERT( xRequiredSpace > xDataLengthBytes );
+
+        if( xRequiredSpace > xMaxReportedSpace )
+        {
+            /* The message would not fit even if the entire buffer was empty,
+             * so don't wait for space. */
+            xTicksToWait = ( TickType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        if( xRequiredSpace > xMaxReportedSpace )
+        {
+            xRequiredSpace = xMaxReportedSpace;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            taskENTER_CRITICAL();
+            {
+                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+                if( xSpace < xRequiredSpace )
+                {
+                    /* Clear notification state as going to wait for space. */
+                    ( void ) xTaskNotifyStateClear( NULL );
+
+                    /* Should only be one writer. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                    pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    taskEXIT_CRITICAL();
+                    break;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+            sbSTATS_SEND_BLOCKING( pxStreamBuffer, xBlockedSince );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToSend = NULL;
+            sbSTATS_SEND_UNBLOCKED( pxStreamBuffer, xBlockedSince );
+        } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+    xNextHead = pxStreamBuffer->xHead;
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        if( xSpace >= xRequiredSpace )
+        {
+            /* The message length is written by the commit, the region starts
+             * after it. */
+            xNextHead += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+            if( xNextHead >= pxStreamBuffer->xLength )
+            {
+                xNextHead -= pxStreamBuffer->xLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = xDataLengthBytes;
+        }
+        else
+        {
+            xReturn = 0;
+        }
+    }
+    else
+    {
+        xReturn = configMIN( xDataLengthBytes, xSpace );
+    }
+
+    prvGetRegion( pxStreamBuffer, xNextHead, xReturn, pxRegion );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+                                size_t xDataLengthBytes )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvCommitReservedBytes( pxStreamBuffer, xDataLengthBytes );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                       size_t xDataLengthBytes,
+                                       BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvCommitReservedBytes( pxStreamBuffer, xDataLengthBytes );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCommitReservedBytes( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xDataLengthBytes )
+{
+    size_t xNextHead = pxStreamBuffer->xHead;
+    configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
+
+    if( xDataLengthBytes != ( size_t ) 0 )
+    {
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* The space was checked by xStreamBufferSendReserve(), only the
+             * length of the message is missing in front of the data. */
+            configASSERT( ( xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH ) <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+            xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+            configASSERT( ( size_t ) xMessageLength == xDataLengthBytes );
+
+            xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+        }
+        else
+        {
+            configASSERT( xDataLengthBytes <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+        }
+
+        /* The data is already in place, publish it. */
+        xNextHead += xDataLengthBytes;
+
+        if( xNextHead >= pxStreamBuffer->xLength )
+        {
+            xNextHead -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStreamBuffer->xHead = xNextHead;
+        sbSTATS_SENT( pxStreamBuffer, xDataLengthBytes );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceivePeek( StreamBufferHandle_t xStreamBuffer,
+                                 StreamBufferRegion_t * const pxRegion,
+                                 TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn = 0, xBytesAvailable, xBytesToStoreMessageLength, xNextTail;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempMessageLength;
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+    #endif
+
+    configASSERT( pxRegion );
+    configASSERT( pxStreamBuffer );
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+    }
+    else
+    {
+        xBytesToStoreMessageLength = 0;
+    }
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        /* Checking if there is data and clearing the notification state must be
+         * performed atomically. */
+        taskENTER_CRITICAL();
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+            if( xBytesAvailable <= xBytesToStoreMessageLength )
+            {
+                /* Clear notification state as going to wait for data. */
+                ( void ) xTaskNotifyStateClear( NULL );
+
+                /* Should only be one reader. */
+                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xBytesAvailable <= xBytesToStoreMessageLength )
+        {
+            /* Wait for data to be available. */
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+            sbSTATS_RECEIVE_BLOCKING( pxStreamBuffer, xBlockedSince );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+            sbSTATS_RECEIVE_UNBLOCKED( pxStreamBuffer, xBlockedSince );
+
+            /* Recheck the data available after blocking. */
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+    }
+
+    xNextTail = pxStreamBuffer->xTail;
+
+    if( xBytesAvailable > xBytesToStoreMessageLength )
+    {
+        if( xBytesToStoreMessageLength != ( size_t ) 0 )
+        {
+            /* The region is the next message, it starts after its length. */
+            xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempMessageLength, xBytesToStoreMessageLength, xNextTail );
+            xReturn = ( size_t ) xTempMessageLength;
+        }
+        else
+        {
+            xReturn = xBytesAvailable;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    prvGetRegion( pxStreamBuffer, xNextTail, xReturn, pxRegion );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xDataLengthBytes )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvReleasePeekedBytes( pxStreamBuffer, xDataLengthBytes );
+
+    /* Was a task waiting for space in the buffer? */
+    if( xReturn != ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReturn );
+        prvRECEIVE_COMPLETED( pxStreamBuffer );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           size_t xDataLengthBytes,
+                                           BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvReleasePeekedBytes( pxStreamBuffer, xDataLengthBytes );
+
+    /* Was a task waiting for space in the buffer? */
+    if( xReturn != ( size_t ) 0 )
+    {
+        prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReleasePeekedBytes( StreamBuffer_t * const pxStreamBuffer,
+                                     size_t xDataLengthBytes )
+{
+    size_t xNextTail = pxStreamBuffer->xTail;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempMessageLength;
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        /* A message is always released as a whole. */
+        if( prvBytesInBuffer( pxStreamBuffer ) > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+        {
+            xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+            xDataLengthBytes = ( size_t ) xTempMessageLength;
+        }
+        else
+        {
+            xDataLengthBytes = 0;
+        }
+    }
+    else
+    {
+        configASSERT( xDataLengthBytes <= prvBytesInBuffer( pxStreamBuffer ) );
+    }
+
+    if( xDataLengthBytes != ( size_t ) 0 )
+    {
+        xNextTail += xDataLengthBytes;
+
+        if( xNextTail >= pxStreamBuffer->xLength )
+        {
+            xNextTail -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStreamBuffer->xTail = xNextTail;
+        sbSTATS_RECEIVED( pxStreamBuffer, xDataLengthBytes );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGetRegion( const StreamBuffer_t * const pxStreamBuffer,
+                          size_t xIndex,
+                          size_t xCount,
+                          StreamBufferRegion_t * const pxRegion )
+{
+    configASSERT( xIndex < pxStreamBuffer->xLength );
+
+    pxRegion->pucFirst = &( pxStreamBuffer->pucBuffer[ xIndex ] );
+    pxRegion->xFirstLength = configMIN( pxStreamBuffer->xLength - xIndex, xCount );
+    pxRegion->pucSecond = pxStreamBuffer->pucBuffer;
+    pxRegion->xSecondLength = xCount - pxRegion->xFirstLength;
+}
+/*-----------------------------------------------------------*/
+
 static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                         void * pvRxData,
                                         size_t xBufferLengthBytes,
@@ -1118,6 +1719,7 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
     {
         /* Read the actual data and update the tail to mark the data as officially consumed. */
         pxStreamBuffer->xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, xNextTail ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+        sbSTATS_RECEIVED( pxStreamBuffer, xCount );
     }
 
     return xCount;
@@ -1192,7 +1794,7 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 
     configASSERT( pxStreamBuffer );
 
-    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
         if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
         {
@@ -1208,7 +1810,7 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
             xReturn = pdFALSE;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1223,7 +1825,7 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 
     configASSERT( pxStreamBuffer );
 
-    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
         if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
         {
@@ -1239,7 +1841,7 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
             xReturn = pdFALSE;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1261,7 +1863,7 @@ static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
 
     /* Write as many bytes as can be written in the first write. */
     configASSERT( ( xHead + xFirstLength ) <= pxStreamBuffer->xLength );
-    ( void ) memcpy( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    ( void ) portMEMCPY( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
 
     /* If the number of bytes written was less than the number that could be
      * written in the first write... */
@@ -1269,7 +1871,7 @@ static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
     {
         /* ...then write the remaining bytes to the start of the buffer. */
         configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
-        ( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+        ( void ) portMEMCPY( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
     }
     else
     {
@@ -1309,14 +1911,14 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
      * read.  Asserts check bounds of read and write. */
     configASSERT( xFirstLength <= xCount );
     configASSERT( ( xTail + xFirstLength ) <= pxStreamBuffer->xLength );
-    ( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    ( void ) portMEMCPY( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
 
     /* If the total number of wanted bytes is greater than the number
      * that could be read in the first read... */
     if( xCount > xFirstLength )
     {
         /* ...then read the remaining bytes from the start of the buffer. */
-        ( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+        ( void ) portMEMCPY( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
     }
     else
     {
@@ -1395,6 +1997,47 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
     #endif
 }
 
+#if ( configUSE_QUEUE_STATS == 1 )
+
+    void vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer,
+                                QueueStats_t * pxStats )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( pxStats );
+
+        taskENTER_CRITICAL();
+        {
+            *pxStats = pxStreamBuffer->xStats;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+    void vStreamBufferResetStats( StreamBufferHandle_t xStreamBuffer )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        taskENTER_CRITICAL();
+        {
+            ( void ) memset( &( pxStreamBuffer->xStats ), 0x00, sizeof( QueueStats_t ) );
+
+            /* The high water mark starts again from the current fill level. */
+            pxStreamBuffer->xStats.ulHighWaterMark = ( uint32_t ) prvBytesInBuffer( pxStreamBuffer );
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TRACE_FACILITY == 1 )
 
     UBaseType_t uxStreamBufferGetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer )
@@ -41,6 +41,10 @@
 #include "timers.h"
 #include "stack_macros.h"
 
+#if ( configUSE_OBJECT_POOLS == 1 )
+    #include "object_pool.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -67,6 +71,46 @@
     #define taskYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
 #endif
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* In the SMP kernel a task that becomes ready, or whose priority changes, may
+ * need to preempt a core other than the one executing the API call.  These
+ * macros must be called from within a critical section. */
+    #if ( configUSE_PREEMPTION == 0 )
+        #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB )
+        #define taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB )
+    #else
+        #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB )    prvYieldForTask( pxTCB )
+        #define taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB )                 \
+    {                                                                            \
+        if( ( pxTCB )->xTaskRunState == ( BaseType_t ) portGET_CORE_ID() )      \
+        {                                                                        \
+            portYIELD_WITHIN_API();                                              \
+        }                                                                        \
+        else                                                                     \
+        {                                                                        \
+            prvYieldCore( ( pxTCB )->xTaskRunState );                            \
+        }                                                                        \
+    }
+    #endif
+
+/* Values that can be assigned to the xTaskRunState member of the TCB.  A
+ * value between 0 and ( configNUMBER_OF_CORES - 1 ) is the index of the core
+ * the task is running on. */
+    #define taskTASK_NOT_RUNNING                      ( ( BaseType_t ) ( -1 ) )
+    #define taskTASK_SCHEDULED_TO_YIELD               ( ( BaseType_t ) ( -2 ) )
+
+    #define taskVALID_CORE_ID( xCoreID )                          ( ( ( ( BaseType_t ) ( xCoreID ) >= 0 ) && ( ( BaseType_t ) ( xCoreID ) < ( BaseType_t ) configNUMBER_OF_CORES ) ) ? pdTRUE : pdFALSE )
+    #define taskTASK_IS_RUNNING( pxTCB )                          ( taskVALID_CORE_ID( ( pxTCB )->xTaskRunState ) )
+    #define taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB )    ( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING )
+
+/* Bits used in the uxTaskAttributes member of the TCB. */
+    #define taskATTRIBUTE_IS_IDLE                     ( ( UBaseType_t ) ( 1U << 0U ) )
+
+/* Mask with one bit set for every core in the system. */
+    #define taskVALID_CORE_MASK                       ( ( UBaseType_t ) ( ( 1U << configNUMBER_OF_CORES ) - 1U ) )
+#endif /* configNUMBER_OF_CORES > 1 */
+
 /* Values that can be assigned to the ucNotifyState member of the TCB. */
 #define taskNOT_WAITING_NOTIFICATION              ( ( uint8_t ) 0 ) /* Must be zero as it is the initialised value. */
 #define taskWAITING_NOTIFICATION                  ( ( uint8_t ) 1 )
@@ -196,30 +240,94 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+/* With the delayed task heap every delayed task is held in pxDelayedTaskList,
+ * whatever its wake time, so only the overflow count and the next unblock time
+ * change when the tick count overflows. */
+    #define taskSWITCH_DELAYED_LISTS() \
+    {                                  \
+        xNumOfOverflows++;             \
+        prvResetNextTaskUnblockTime(); \
+    }
+
+/* The delayed list only records the state of the task, the heap orders the
+ * tasks by wake time. */
+    #define taskINSERT_DELAYED_TASK( pxList, pxTCB )                                                               \
+    {                                                                                                              \
+        listINSERT_END( pxDelayedTaskList, &( ( pxTCB )->xStateListItem ) );                                       \
+        prvDelayedTaskHeapInsert( ( pxTCB ), listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) ) ); \
+    }
+
+/* Every task reserves its heap entry when it is created. */
+    #define taskDELAYED_TASK_HEAP_RESERVE()    prvDelayedTaskHeapReserve()
+    #define taskDELAYED_TASK_HEAP_RELEASE()    prvDelayedTaskHeapRelease()
+
+#else /* configUSE_DELAYED_TASK_HEAP */
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
-#define taskSWITCH_DELAYED_LISTS()                                                \
-    {                                                                             \
-        List_t * pxTemp;                                                          \
-                                                                                  \
-        /* The delayed tasks list should be empty when the lists are switched. */ \
-        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );               \
-                                                                                  \
-        pxTemp = pxDelayedTaskList;                                               \
-        pxDelayedTaskList = pxOverflowDelayedTaskList;                            \
-        pxOverflowDelayedTaskList = pxTemp;                                       \
-        xNumOfOverflows++;                                                        \
-        prvResetNextTaskUnblockTime();                                            \
+    #define taskSWITCH_DELAYED_LISTS()                                                \
+    {                                                                                 \
+        List_t * pxTemp;                                                              \
+                                                                                      \
+        /* The delayed tasks list should be empty when the lists are switched. */     \
+        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );                   \
+                                                                                      \
+        pxTemp = pxDelayedTaskList;                                                   \
+        pxDelayedTaskList = pxOverflowDelayedTaskList;                                \
+        pxOverflowDelayedTaskList = pxTemp;                                           \
+        xNumOfOverflows++;                                                            \
+        prvResetNextTaskUnblockTime();                                                \
     }
 
+/* The delayed lists are kept in wake time order. */
+    #define taskINSERT_DELAYED_TASK( pxList, pxTCB )    vListInsert( ( pxList ), &( ( pxTCB )->xStateListItem ) )
+
+/* The delayed lists have room for every task. */
+    #define taskDELAYED_TASK_HEAP_RESERVE()    pdTRUE
+    #define taskDELAYED_TASK_HEAP_RELEASE()
+
+#endif /* configUSE_DELAYED_TASK_HEAP */
+
 /*-----------------------------------------------------------*/
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
+#if ( configUSE_TASK_LATENCY_STATS == 1 )
+
+/* Start timing the wait of a task that is added to a ready list.  A task that
+ * is moved between the ready lists, on a priority change, keeps the time it was
+ * first made ready, and the running task is not timed at all. */
+    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+        #define taskREAD_RUN_TIME_COUNTER( ulTime )    portALT_GET_RUN_TIME_COUNTER_VALUE( ( ulTime ) )
+    #else
+        #define taskREAD_RUN_TIME_COUNTER( ulTime )    ( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+    #endif
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define taskLATENCY_IS_RUNNING( pxTCB )    ( ( pxTCB ) == pxCurrentTCB )
+    #else
+        #define taskLATENCY_IS_RUNNING( pxTCB )    ( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+    #endif
+
+    #define taskRECORD_READY_TIME( pxTCB )                                                                  \
+    do {                                                                                                    \
+        if( ( ( pxTCB )->xLatencyPending == pdFALSE ) && !taskLATENCY_IS_RUNNING( pxTCB ) )                 \
+        {                                                                                                   \
+            taskREAD_RUN_TIME_COUNTER( ( pxTCB )->ulReadyTime );                                            \
+            ( pxTCB )->xLatencyPending = pdTRUE;                                                            \
+        }                                                                                                   \
+    } while( 0 )
+#else
+    #define taskRECORD_READY_TIME( pxTCB )
+#endif /* configUSE_TASK_LATENCY_STATS */
+
 #define prvAddTaskToReadyList( pxTCB )                                                                 \
     traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
+    taskRECORD_READY_TIME( pxTCB );                                                                    \
     taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
     listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
@@ -266,6 +374,12 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     StackType_t * pxStack;                      /*< Points to the start of the stack. */
     char pcTaskName[ configMAX_TASK_NAME_LEN ]; /*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
+    #if ( configNUMBER_OF_CORES > 1 )
+        volatile BaseType_t xTaskRunState; /*< Index of the core the task is running on, taskTASK_NOT_RUNNING or taskTASK_SCHEDULED_TO_YIELD. */
+        UBaseType_t uxTaskAttributes;      /*< Task attributes, e.g. taskATTRIBUTE_IS_IDLE. */
+        UBaseType_t uxCoreAffinityMask;    /*< Bit mask of the cores the task is allowed to run on. */
+    #endif
+
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
         StackType_t * pxEndOfStack; /*< Points to the highest valid address for the stack. */
     #endif
@@ -318,15 +432,45 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+        UBaseType_t uxDelayedTaskHeapIndex; /*< One more than the position of the task in xDelayedTaskHeap, 0 if the task has no entry in the heap. */
+    #endif
+
+    #if ( configUSE_TASK_LATENCY_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulReadyTime;                     /*< Run time counter value when the task was last added to a ready list. */
+        configRUN_TIME_COUNTER_TYPE ulTotalLatency;                  /*< Accumulated time from ready to running. */
+        configRUN_TIME_COUNTER_TYPE ulMaxLatency;                    /*< Longest time from ready to running. */
+        uint32_t ulLatencyCount;                                     /*< Number of latencies recorded. */
+        uint32_t ulLatencyHistogram[ configTASK_LATENCY_BUCKETS ];   /*< Latencies by length, see TaskLatencyStats_t. */
+        BaseType_t xLatencyPending;                                  /*< Set to pdTRUE while ulReadyTime waits to be matched by a switch in. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
  * below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+/* The TCBs of dynamically created tasks are taken from a fixed size pool when
+ * configUSE_OBJECT_POOLS is 1. */
+#if ( configUSE_OBJECT_POOLS == 1 )
+    #define taskALLOCATE_TCB()       ( ( TCB_t * ) pvObjectPoolAllocate( eObjectPoolTask, sizeof( TCB_t ) ) )
+    #define taskFREE_TCB( pxTCB )    vObjectPoolFree( eObjectPoolTask, ( pxTCB ) )
+#else
+    #define taskALLOCATE_TCB()       ( ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ) )
+    #define taskFREE_TCB( pxTCB )    vPortFree( pxTCB )
+#endif
+
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
-portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if ( configNUMBER_OF_CORES == 1 )
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#else
+    /* Each core runs its own task.  pxCurrentTCB resolves to the task running on
+     * the core executing the code. */
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ] = { NULL };
+    #define pxCurrentTCB    xTaskGetCurrentTaskHandle()
+#endif
 
 /* Lists for ready and blocked tasks. --------------------
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
@@ -339,6 +483,37 @@ PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Poi
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+/* The wake times of the delayed tasks, kept as a binary min heap so the task to
+ * unblock next is always at index 0.  A task has at most one entry.  When a task
+ * leaves the Blocked state before its wake time the entry is left in place and
+ * dropped once it reaches the top of the heap, or reused if the task blocks
+ * again first. */
+    typedef struct xDELAYED_TASK_HEAP_ENTRY
+    {
+        TickType_t xWakeTime;
+        TCB_t * pxTCB;
+    } DelayedTaskHeapEntry_t;
+
+    PRIVILEGED_DATA static DelayedTaskHeapEntry_t xDelayedTaskHeap[ configDELAYED_TASK_HEAP_LENGTH ];
+    PRIVILEGED_DATA static UBaseType_t uxDelayedTaskHeapLength = ( UBaseType_t ) 0U;
+
+/* The number of tasks that exist, each holds a reservation for its entry.  A
+ * task is only created while a reservation is left, so the heap cannot
+ * overflow whether or not configASSERT() is defined. */
+    PRIVILEGED_DATA static UBaseType_t uxDelayedTaskHeapReserved = ( UBaseType_t ) 0U;
+
+/* Wake times are compared relative to xDelayedTaskHeapBase, the tick count at
+ * which the heap was last processed.  No wake time in the heap is earlier, so
+ * the order holds across tick count overflows. */
+    PRIVILEGED_DATA static TickType_t xDelayedTaskHeapBase = ( TickType_t ) configINITIAL_TICK_COUNT;
+
+    #define taskWAKES_BEFORE( xWakeTimeA, xWakeTimeB ) \
+    ( ( TickType_t ) ( ( xWakeTimeA ) - xDelayedTaskHeapBase ) < ( TickType_t ) ( ( xWakeTimeB ) - xDelayedTaskHeapBase ) )
+
+#endif /* configUSE_DELAYED_TASK_HEAP */
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
     PRIVILEGED_DATA static List_t xTasksWaitingTermination; /*< Tasks that have been deleted - but their memory not yet freed. */
@@ -364,11 +539,20 @@ PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINI
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#if ( configNUMBER_OF_CORES == 1 )
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#else
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ] = { pdFALSE };
+    #define xYieldPending    xYieldPendings[ portGET_CORE_ID() ]
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows = ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                          /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#if ( configNUMBER_OF_CORES == 1 )
+    PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                      /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#else
+    PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ] = { NULL }; /*< Holds the handles of the idle tasks, one per core. */
+#endif
 
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
@@ -389,8 +573,13 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 /* Do not move these variables to function scope as doing so prevents the
  * code working with debuggers that need to remove the static qualifier. */
-    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;    /*< Holds the value of a timer/counter the last time a task was switched in. */
-    PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL; /*< Holds the total amount of execution time as defined by the run time counter clock. */
+    #if ( configNUMBER_OF_CORES == 1 )
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;    /*< Holds the value of a timer/counter the last time a task was switched in. */
+        PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL; /*< Holds the total amount of execution time as defined by the run time counter clock. */
+    #else
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime[ configNUMBER_OF_CORES ] = { 0UL };    /*< Holds the value of a timer/counter the last time a task was switched in on each core. */
+        PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime[ configNUMBER_OF_CORES ] = { 0UL }; /*< Holds the total amount of execution time as defined by the run time counter clock, per core. */
+    #endif
 
 #endif
 
@@ -430,6 +619,44 @@ static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
  */
 static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * The passive idle task runs on every core other than the one running
+ * prvIdleTask().  It does not perform any of the house keeping done by the
+ * idle task and only exists so each core always has a task to run.
+ */
+    static portTASK_FUNCTION_PROTO( prvPassiveIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Request the core xCoreID to perform a context switch.  If xCoreID is the
+ * calling core the yield is held pending until the critical section is left.
+ * Must be called from within a critical section.
+ */
+    static void prvYieldCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Find the core running the lowest priority task that pxTCB is allowed to
+ * preempt, and request that core to yield.  Must be called from within a
+ * critical section.
+ */
+    static void prvYieldForTask( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Select the highest priority ready task that is allowed to run on xCoreID
+ * and that is not already running on another core.
+ */
+    static void prvSelectHighestPriorityTask( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when the calling task enters a critical section or suspends the
+ * scheduler.  If another core requested this task to yield in the meantime the
+ * locks are temporarily released so the pending yield can be serviced.
+ */
+    static void prvCheckForRunStateChange( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES > 1 */
+
 /*
  * Utility to free all memory allocated by the scheduler to hold a TCB,
  * including the stack pointed to by the TCB.
@@ -473,6 +700,17 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+/*
+ * Fills a TaskRunTime_t structure with the run time counter of each task that
+ * is referenced from the pxList list.
+ */
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configGENERATE_RUN_TIME_STATS == 1 ) )
+
+    static UBaseType_t prvListTaskRunTimesWithinSingleList( TaskRunTime_t * pxTaskRunTimeArray,
+                                                            List_t * pxList ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Searches pxList for a task with name pcNameToQuery - returning a handle to
  * the task if it is found, or NULL if the task is not found.
@@ -516,6 +754,59 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+/*
+ * Store a wake time at uxIndex of the delayed task heap, then move it up or
+ * down until the heap is ordered again.
+ */
+    static void prvDelayedTaskHeapPlace( UBaseType_t uxIndex,
+                                         TickType_t xWakeTime,
+                                         TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add the wake time of a task to the delayed task heap, or update the entry the
+ * task already has.
+ */
+    static void prvDelayedTaskHeapInsert( TCB_t * pxTCB,
+                                          TickType_t xWakeTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the entry of a task from the delayed task heap.
+ */
+    static void prvDelayedTaskHeapRemove( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Take the next task whose wake time has been reached out of the delayed task
+ * heap.  Returns NULL, with xNextTaskUnblockTime updated, once there is none.
+ */
+    static TCB_t * prvDelayedTaskHeapTakeExpired( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Reserve the heap entry of a task that is being created.  Returns pdFALSE when
+ * configDELAYED_TASK_HEAP_LENGTH tasks exist already.
+ */
+    static BaseType_t prvDelayedTaskHeapReserve( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Give back the reservation of a task that was deleted.
+ */
+    static void prvDelayedTaskHeapRelease( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_DELAYED_TASK_HEAP */
+
+#if ( configUSE_TASK_LATENCY_STATS == 1 )
+
+/*
+ * Add the time since a task was made ready to its latency statistics, called
+ * when the task is switched in.  ulNow is the run time counter value of the
+ * switch.
+ */
+    static void prvRecordTaskLatency( TCB_t * pxTCB,
+                                      configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TASK_LATENCY_STATS */
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -559,169 +850,490 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
 /*-----------------------------------------------------------*/
 
-#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    TaskHandle_t xTaskCreateStatic( TaskFunction_t pxTaskCode,
-                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                                    const uint32_t ulStackDepth,
-                                    void * const pvParameters,
-                                    UBaseType_t uxPriority,
-                                    StackType_t * const puxStackBuffer,
-                                    StaticTask_t * const pxTaskBuffer )
+    static void prvCheckForRunStateChange( void )
     {
-        TCB_t * pxNewTCB;
-        TaskHandle_t xReturn;
+        UBaseType_t uxPrevCriticalNesting;
+        const TCB_t * pxThisTCB;
 
-        configASSERT( puxStackBuffer != NULL );
-        configASSERT( pxTaskBuffer != NULL );
+        /* This must only be called from within a task. */
+        portASSERT_IF_IN_ISR();
 
-        #if ( configASSERT_DEFINED == 1 )
-        {
-            /* Sanity check that the size of the structure used to declare a
-             * variable of type StaticTask_t equals the size of the real task
-             * structure. */
-            volatile size_t xSize = sizeof( StaticTask_t );
-            configASSERT( xSize == sizeof( TCB_t ) );
-            ( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
-        }
-        #endif /* configASSERT_DEFINED */
+        /* This function is always called with interrupts disabled
+         * so this is safe. */
+        pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
 
-        if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
+        while( pxThisTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD )
         {
-            /* The memory used for the task's TCB and stack are passed into this
-             * function - use them. */
-            pxNewTCB = ( TCB_t * ) pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
-            memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
-            pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
+            /* We are only here if we just entered a critical section
+             * or if we just suspended the scheduler, and another task
+             * has requested that we yield.
+             *
+             * This is slightly complicated since we need to save and restore
+             * the critical nesting count, as well as release and reacquire the
+             * correct locks.  And then do it all over again if our state
+             * changed again during the reacquisition. */
+            uxPrevCriticalNesting = portGET_CRITICAL_NESTING_COUNT();
 
-            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+            if( uxPrevCriticalNesting > 0U )
             {
-                /* Tasks can be created statically or dynamically, so note this
-                 * task was created statically in case the task is later deleted. */
-                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+                portSET_CRITICAL_NESTING_COUNT( 0U );
+                portRELEASE_ISR_LOCK();
+            }
+            else
+            {
+                /* The scheduler is suspended.  uxSchedulerSuspended is updated
+                 * only when the task is not requested to yield. */
+                mtCOVERAGE_TEST_MARKER();
             }
-            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
-            prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL );
-            prvAddNewTaskToReadyList( pxNewTCB );
-        }
-        else
-        {
-            xReturn = NULL;
-        }
+            portRELEASE_TASK_LOCK();
+            portMEMORY_BARRIER();
 
-        return xReturn;
+            /* Enabling interrupts lets this core service the inter-core
+             * doorbell and switch out.  By the time the task runs again the
+             * yield has been serviced. */
+            portENABLE_INTERRUPTS();
+            portDISABLE_INTERRUPTS();
+
+            portGET_TASK_LOCK();
+            portGET_ISR_LOCK();
+
+            portSET_CRITICAL_NESTING_COUNT( uxPrevCriticalNesting );
+
+            if( uxPrevCriticalNesting == 0U )
+            {
+                portRELEASE_ISR_LOCK();
+            }
+        }
     }
 
-#endif /* SUPPORT_STATIC_ALLOCATION */
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    BaseType_t xTaskCreateRestrictedStatic( const TaskParameters_t * const pxTaskDefinition,
-                                            TaskHandle_t * pxCreatedTask )
+    static void prvYieldCore( BaseType_t xCoreID )
     {
-        TCB_t * pxNewTCB;
-        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
-
-        configASSERT( pxTaskDefinition->puxStackBuffer != NULL );
-        configASSERT( pxTaskDefinition->pxTaskBuffer != NULL );
-
-        if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( pxTaskDefinition->pxTaskBuffer != NULL ) )
+        /* This must be called from a critical section and xCoreID must be valid. */
+        if( ( portCHECK_IF_IN_ISR() == pdTRUE ) && ( xCoreID == ( BaseType_t ) portGET_CORE_ID() ) )
         {
-            /* Allocate space for the TCB.  Where the memory comes from depends
-             * on the implementation of the port malloc function and whether or
-             * not static allocation is being used. */
-            pxNewTCB = ( TCB_t * ) pxTaskDefinition->pxTaskBuffer;
-            memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
-
-            /* Store the stack location in the TCB. */
-            pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
-
-            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+            xYieldPendings[ xCoreID ] = pdTRUE;
+        }
+        else
+        {
+            if( pxCurrentTCBs[ xCoreID ]->xTaskRunState != taskTASK_SCHEDULED_TO_YIELD )
             {
-                /* Tasks can be created statically or dynamically, so note this
-                 * task was created statically in case the task is later deleted. */
-                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+                if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+                {
+                    xYieldPendings[ xCoreID ] = pdTRUE;
+                }
+                else
+                {
+                    portYIELD_CORE( xCoreID );
+                    pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_SCHEDULED_TO_YIELD;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
-            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
-
-            prvInitialiseNewTask( pxTaskDefinition->pvTaskCode,
-                                  pxTaskDefinition->pcName,
-                                  ( uint32_t ) pxTaskDefinition->usStackDepth,
-                                  pxTaskDefinition->pvParameters,
-                                  pxTaskDefinition->uxPriority,
-                                  pxCreatedTask, pxNewTCB,
-                                  pxTaskDefinition->xRegions );
-
-            prvAddNewTaskToReadyList( pxNewTCB );
-            xReturn = pdPASS;
         }
-
-        return xReturn;
     }
 
-#endif /* ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    BaseType_t xTaskCreateRestricted( const TaskParameters_t * const pxTaskDefinition,
-                                      TaskHandle_t * pxCreatedTask )
+    static void prvYieldForTask( const TCB_t * pxTCB )
     {
-        TCB_t * pxNewTCB;
-        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+        BaseType_t xLowestPriorityToPreempt;
+        BaseType_t xCurrentCoreTaskPriority;
+        BaseType_t xLowestPriorityCore = ( BaseType_t ) -1;
+        BaseType_t xCoreID;
 
-        configASSERT( pxTaskDefinition->puxStackBuffer );
+        /* This must be called from a critical section. */
+        configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+        /* xLowestPriorityToPreempt will be decremented to -1 if the priority of
+         * pxTCB is 0.  This is ok as the idle tasks are given a priority of -1
+         * below. */
+        xLowestPriorityToPreempt = ( BaseType_t ) pxTCB->uxPriority;
+        --xLowestPriorityToPreempt;
 
-        if( pxTaskDefinition->puxStackBuffer != NULL )
+        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
         {
-            /* Allocate space for the TCB.  Where the memory comes from depends
-             * on the implementation of the port malloc function and whether or
-             * not static allocation is being used. */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            xCurrentCoreTaskPriority = ( BaseType_t ) pxCurrentTCBs[ xCoreID ]->uxPriority;
 
-            if( pxNewTCB != NULL )
+            /* The idle tasks are treated as having a priority of
+             * tskIDLE_PRIORITY - 1 so an idle core is preferred over a core
+             * running a real task of the idle priority. */
+            if( ( pxCurrentTCBs[ xCoreID ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
             {
-                memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
-
-                /* Store the stack location in the TCB. */
-                pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
+                xCurrentCoreTaskPriority = xCurrentCoreTaskPriority - 1;
+            }
 
-                #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+            if( ( taskTASK_IS_RUNNING( pxCurrentTCBs[ xCoreID ] ) != pdFALSE ) && ( xYieldPendings[ xCoreID ] == pdFALSE ) )
+            {
+                if( ( xCurrentCoreTaskPriority <= xLowestPriorityToPreempt ) &&
+                    ( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U ) )
                 {
-                    /* Tasks can be created statically or dynamically, so note
-                     * this task had a statically allocated stack in case it is
-                     * later deleted.  The TCB was allocated dynamically. */
-                    pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_ONLY;
+                    xLowestPriorityToPreempt = xCurrentCoreTaskPriority;
+                    xLowestPriorityCore = xCoreID;
                 }
-                #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
-
-                prvInitialiseNewTask( pxTaskDefinition->pvTaskCode,
-                                      pxTaskDefinition->pcName,
-                                      ( uint32_t ) pxTaskDefinition->usStackDepth,
-                                      pxTaskDefinition->pvParameters,
-                                      pxTaskDefinition->uxPriority,
-                                      pxCreatedTask, pxNewTCB,
-                                      pxTaskDefinition->xRegions );
-
-                prvAddNewTaskToReadyList( pxNewTCB );
-                xReturn = pdPASS;
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
         }
 
-        return xReturn;
+        if( xLowestPriorityCore >= 0 )
+        {
+            prvYieldCore( xLowestPriorityCore );
+        }
     }
 
-#endif /* portUSING_MPU_WRAPPERS */
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    BaseType_t xTaskCreate( TaskFunction_t pxTaskCode,
-                            const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                            const configSTACK_DEPTH_TYPE usStackDepth,
-                            void * const pvParameters,
+    static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
+    {
+        UBaseType_t uxCurrentPriority;
+        BaseType_t xTaskScheduled = pdFALSE;
+        TCB_t * pxPreviousTCB = NULL;
+
+        /* The task switching out may still be ready.  Put it at the end of its
+         * ready list so that tasks of equal priority that have been waiting
+         * longer are selected before it. */
+        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ),
+                                     &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) ) != pdFALSE )
+        {
+            ( void ) uxListRemove( &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) );
+            prvAddTaskToReadyList( pxCurrentTCBs[ xCoreID ] );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        portGET_HIGHEST_PRIORITY( uxCurrentPriority, uxTopReadyPriority );
+
+        for( ; ; )
+        {
+            List_t * const pxReadyList = &( pxReadyTasksLists[ uxCurrentPriority ] );
+
+            if( listLIST_IS_EMPTY( pxReadyList ) == pdFALSE )
+            {
+                const ListItem_t * pxEndMarker = listGET_END_MARKER( pxReadyList );
+                ListItem_t * pxIterator;
+                TCB_t * pxTCB;
+
+                /* Ready tasks are kept in the lists while they run, so skip
+                 * the ones that are running on the other core or that are
+                 * not allowed to run on this one. */
+                for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+                {
+                    pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                    if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+                    {
+                        if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+                        {
+                            /* The task is not being executed by any core so
+                             * swap it in. */
+                            pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+                            pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+                            pxTCB->xTaskRunState = xCoreID;
+                            pxCurrentTCBs[ xCoreID ] = pxTCB;
+                            xTaskScheduled = pdTRUE;
+                        }
+                        else if( pxTCB == pxCurrentTCBs[ xCoreID ] )
+                        {
+                            configASSERT( ( pxTCB->xTaskRunState == xCoreID ) || ( pxTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD ) );
+
+                            /* The task is already running on this core, mark
+                             * it as scheduled. */
+                            pxTCB->xTaskRunState = xCoreID;
+                            xTaskScheduled = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xTaskScheduled != pdFALSE )
+                    {
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xTaskScheduled != pdFALSE )
+            {
+                break;
+            }
+
+            /* There is always an idle task that can run, so this cannot go
+             * below the idle priority. */
+            configASSERT( uxCurrentPriority > tskIDLE_PRIORITY );
+            uxCurrentPriority--;
+        }
+
+        /* If a task that is still ready was just evicted from this core, see if
+         * it can preempt a lower priority task on another core. */
+        if( ( pxPreviousTCB != NULL ) &&
+            ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+        {
+            UBaseType_t uxCoreMap = pxPreviousTCB->uxCoreAffinityMask;
+            BaseType_t xLowestPriority = ( BaseType_t ) pxPreviousTCB->uxPriority;
+            BaseType_t xLowestPriorityCore = ( BaseType_t ) -1;
+            BaseType_t xTaskPriority;
+            BaseType_t x;
+
+            if( ( pxPreviousTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+            {
+                xLowestPriority = xLowestPriority - 1;
+            }
+
+            if( ( uxCoreMap & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+            {
+                /* pxPreviousTCB was preempted by the new task on this core.  Every
+                 * other core the new task could have run on is already running
+                 * a task of no lower priority than pxPreviousTCB, otherwise that
+                 * core would have been chosen instead - so only the cores the
+                 * new task is excluded from need to be searched. */
+                uxCoreMap &= ~( pxCurrentTCBs[ xCoreID ]->uxCoreAffinityMask );
+            }
+            else
+            {
+                /* pxPreviousTCB's affinity mask changed and it is no longer
+                 * allowed to run on this core - search every core it is
+                 * allowed to run on. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxCoreMap &= taskVALID_CORE_MASK;
+
+            for( x = ( ( BaseType_t ) configNUMBER_OF_CORES - 1 ); x >= ( BaseType_t ) 0; x-- )
+            {
+                if( ( uxCoreMap & ( ( UBaseType_t ) 1U << ( UBaseType_t ) x ) ) != 0U )
+                {
+                    xTaskPriority = ( BaseType_t ) pxCurrentTCBs[ x ]->uxPriority;
+
+                    if( ( pxCurrentTCBs[ x ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+                    {
+                        xTaskPriority = xTaskPriority - 1;
+                    }
+
+                    if( ( xTaskPriority < xLowestPriority ) &&
+                        ( taskTASK_IS_RUNNING( pxCurrentTCBs[ x ] ) != pdFALSE ) &&
+                        ( xYieldPendings[ x ] == pdFALSE ) )
+                    {
+                        xLowestPriority = xTaskPriority;
+                        xLowestPriorityCore = x;
+                    }
+                }
+            }
+
+            if( xLowestPriorityCore >= 0 )
+            {
+                prvYieldCore( xLowestPriorityCore );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    TaskHandle_t xTaskCreateStatic( TaskFunction_t pxTaskCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const uint32_t ulStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    StackType_t * const puxStackBuffer,
+                                    StaticTask_t * const pxTaskBuffer )
+    {
+        TCB_t * pxNewTCB;
+        TaskHandle_t xReturn;
+
+        configASSERT( puxStackBuffer != NULL );
+        configASSERT( pxTaskBuffer != NULL );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticTask_t equals the size of the real task
+             * structure. */
+            volatile size_t xSize = sizeof( StaticTask_t );
+            configASSERT( xSize == sizeof( TCB_t ) );
+            ( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
+        }
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) && ( taskDELAYED_TASK_HEAP_RESERVE() != pdFALSE ) )
+        {
+            /* The memory used for the task's TCB and stack are passed into this
+             * function - use them. */
+            pxNewTCB = ( TCB_t * ) pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+            memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+            pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
+
+            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+            {
+                /* Tasks can be created statically or dynamically, so note this
+                 * task was created statically in case the task is later deleted. */
+                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+            }
+            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+            prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL );
+            prvAddNewTaskToReadyList( pxNewTCB );
+        }
+        else
+        {
+            xReturn = NULL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* SUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    BaseType_t xTaskCreateRestrictedStatic( const TaskParameters_t * const pxTaskDefinition,
+                                            TaskHandle_t * pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+
+        configASSERT( pxTaskDefinition->puxStackBuffer != NULL );
+        configASSERT( pxTaskDefinition->pxTaskBuffer != NULL );
+
+        if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( pxTaskDefinition->pxTaskBuffer != NULL ) && ( taskDELAYED_TASK_HEAP_RESERVE() != pdFALSE ) )
+        {
+            /* Allocate space for the TCB.  Where the memory comes from depends
+             * on the implementation of the port malloc function and whether or
+             * not static allocation is being used. */
+            pxNewTCB = ( TCB_t * ) pxTaskDefinition->pxTaskBuffer;
+            memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+
+            /* Store the stack location in the TCB. */
+            pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
+
+            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+            {
+                /* Tasks can be created statically or dynamically, so note this
+                 * task was created statically in case the task is later deleted. */
+                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+            }
+            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+            prvInitialiseNewTask( pxTaskDefinition->pvTaskCode,
+                                  pxTaskDefinition->pcName,
+                                  ( uint32_t ) pxTaskDefinition->usStackDepth,
+                                  pxTaskDefinition->pvParameters,
+                                  pxTaskDefinition->uxPriority,
+                                  pxCreatedTask, pxNewTCB,
+                                  pxTaskDefinition->xRegions );
+
+            prvAddNewTaskToReadyList( pxNewTCB );
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    BaseType_t xTaskCreateRestricted( const TaskParameters_t * const pxTaskDefinition,
+                                      TaskHandle_t * pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+
+        configASSERT( pxTaskDefinition->puxStackBuffer );
+
+        if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( taskDELAYED_TASK_HEAP_RESERVE() != pdFALSE ) )
+        {
+            /* Allocate space for the TCB.  Where the memory comes from depends
+             * on the implementation of the port malloc function and whether or
+             * not static allocation is being used. */
+            pxNewTCB = taskALLOCATE_TCB();
+
+            if( pxNewTCB != NULL )
+            {
+                memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+
+                /* Store the stack location in the TCB. */
+                pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
+
+                #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+                {
+                    /* Tasks can be created statically or dynamically, so note
+                     * this task had a statically allocated stack in case it is
+                     * later deleted.  The TCB was allocated dynamically. */
+                    pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_ONLY;
+                }
+                #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+                prvInitialiseNewTask( pxTaskDefinition->pvTaskCode,
+                                      pxTaskDefinition->pcName,
+                                      ( uint32_t ) pxTaskDefinition->usStackDepth,
+                                      pxTaskDefinition->pvParameters,
+                                      pxTaskDefinition->uxPriority,
+                                      pxCreatedTask, pxNewTCB,
+                                      pxTaskDefinition->xRegions );
+
+                prvAddNewTaskToReadyList( pxNewTCB );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                taskDELAYED_TASK_HEAP_RELEASE();
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* portUSING_MPU_WRAPPERS */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    BaseType_t xTaskCreate( TaskFunction_t pxTaskCode,
+                            const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                            const configSTACK_DEPTH_TYPE usStackDepth,
+                            void * const pvParameters,
                             UBaseType_t uxPriority,
                             TaskHandle_t * const pxCreatedTask )
     {
@@ -736,7 +1348,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* Allocate space for the TCB.  Where the memory comes from depends on
              * the implementation of the port malloc function and whether or not static
              * allocation is being used. */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = taskALLOCATE_TCB();
 
             if( pxNewTCB != NULL )
             {
@@ -750,7 +1362,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 if( pxNewTCB->pxStack == NULL )
                 {
                     /* Could not allocate the stack.  Delete the allocated TCB. */
-                    vPortFree( pxNewTCB );
+                    taskFREE_TCB( pxNewTCB );
                     pxNewTCB = NULL;
                 }
             }
@@ -765,7 +1377,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             if( pxStack != NULL )
             {
                 /* Allocate space for the TCB. */
-                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+                pxNewTCB = taskALLOCATE_TCB(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
                 if( pxNewTCB != NULL )
                 {
@@ -788,6 +1400,23 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
         }
         #endif /* portSTACK_GROWTH */
 
+        #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+        {
+            /* The task needs room in the delayed task heap as well, without it
+             * the task is not created. */
+            if( ( pxNewTCB != NULL ) && ( prvDelayedTaskHeapReserve() == pdFALSE ) )
+            {
+                vPortFreeStack( pxNewTCB->pxStack );
+                taskFREE_TCB( pxNewTCB );
+                pxNewTCB = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_DELAYED_TASK_HEAP */
+
         if( pxNewTCB != NULL )
         {
             #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
@@ -929,6 +1558,24 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     }
     #endif /* configUSE_MUTEXES */
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+        pxNewTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+
+        /* Idle tasks are given a lower effective priority than other tasks of
+         * the same priority when deciding which core to preempt. */
+        if( ( pxTaskCode == prvIdleTask ) || ( pxTaskCode == prvPassiveIdleTask ) )
+        {
+            pxNewTCB->uxTaskAttributes = taskATTRIBUTE_IS_IDLE;
+        }
+        else
+        {
+            pxNewTCB->uxTaskAttributes = 0U;
+        }
+    }
+    #endif /* configNUMBER_OF_CORES > 1 */
+
     vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
     vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -1023,26 +1670,79 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 }
 /*-----------------------------------------------------------*/
 
-static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
-{
-    /* Ensure interrupts don't access the task lists while the lists are being
-     * updated. */
-    taskENTER_CRITICAL();
-    {
-        uxCurrentNumberOfTasks++;
+#if ( configNUMBER_OF_CORES == 1 )
 
-        if( pxCurrentTCB == NULL )
+    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    {
+        /* Ensure interrupts don't access the task lists while the lists are being
+         * updated. */
+        taskENTER_CRITICAL();
         {
-            /* There are no other tasks, or all the other tasks are in
-             * the suspended state - make this the current task. */
-            pxCurrentTCB = pxNewTCB;
+            uxCurrentNumberOfTasks++;
+
+            if( pxCurrentTCB == NULL )
+            {
+                /* There are no other tasks, or all the other tasks are in
+                 * the suspended state - make this the current task. */
+                pxCurrentTCB = pxNewTCB;
+
+                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+                {
+                    /* This is the first task to be created so do the preliminary
+                     * initialisation required.  We will not recover if this call
+                     * fails, but we will report the failure. */
+                    prvInitialiseTaskLists();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* If the scheduler is not already running, make this task the
+                 * current task if it is the highest priority task to be created
+                 * so far. */
+                if( xSchedulerRunning == pdFALSE )
+                {
+                    if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                    {
+                        pxCurrentTCB = pxNewTCB;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
 
-            if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+            uxTaskNumber++;
+
+            #if ( configUSE_TRACE_FACILITY == 1 )
             {
-                /* This is the first task to be created so do the preliminary
-                 * initialisation required.  We will not recover if this call
-                 * fails, but we will report the failure. */
-                prvInitialiseTaskLists();
+                /* Add a counter into the TCB for tracing only. */
+                pxNewTCB->uxTCBNumber = uxTaskNumber;
+            }
+            #endif /* configUSE_TRACE_FACILITY */
+            traceTASK_CREATE( pxNewTCB );
+
+            prvAddTaskToReadyList( pxNewTCB );
+
+            portSETUP_TCB( pxNewTCB );
+        }
+        taskEXIT_CRITICAL();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* If the created task is of a higher priority than the current task
+             * then it should run now. */
+            if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+            {
+                taskYIELD_IF_USING_PREEMPTION();
             }
             else
             {
@@ -1051,14 +1751,54 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         }
         else
         {
-            /* If the scheduler is not already running, make this task the
-             * current task if it is the highest priority task to be created
-             * so far. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#else /* configNUMBER_OF_CORES == 1 */
+
+    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    {
+        /* Ensure interrupts don't access the task lists while the lists are being
+         * updated. */
+        taskENTER_CRITICAL();
+        {
+            uxCurrentNumberOfTasks++;
+
             if( xSchedulerRunning == pdFALSE )
             {
-                if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
                 {
-                    pxCurrentTCB = pxNewTCB;
+                    /* This is the first task to be created so do the preliminary
+                     * initialisation required.  We will not recover if this call
+                     * fails, but we will report the failure. */
+                    prvInitialiseTaskLists();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Every core starts the scheduler running its own idle task.
+                 * The idle tasks are created last, from vTaskStartScheduler(), and
+                 * each one is bound to the first core without a current task. */
+                if( ( pxNewTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+                {
+                    BaseType_t xCoreID;
+
+                    for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                    {
+                        if( pxCurrentTCBs[ xCoreID ] == NULL )
+                        {
+                            pxNewTCB->xTaskRunState = xCoreID;
+                            pxCurrentTCBs[ xCoreID ] = pxNewTCB;
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
                 }
                 else
                 {
@@ -1069,42 +1809,36 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-        }
 
-        uxTaskNumber++;
+            uxTaskNumber++;
 
-        #if ( configUSE_TRACE_FACILITY == 1 )
-        {
-            /* Add a counter into the TCB for tracing only. */
-            pxNewTCB->uxTCBNumber = uxTaskNumber;
-        }
-        #endif /* configUSE_TRACE_FACILITY */
-        traceTASK_CREATE( pxNewTCB );
+            #if ( configUSE_TRACE_FACILITY == 1 )
+            {
+                /* Add a counter into the TCB for tracing only. */
+                pxNewTCB->uxTCBNumber = uxTaskNumber;
+            }
+            #endif /* configUSE_TRACE_FACILITY */
+            traceTASK_CREATE( pxNewTCB );
 
-        prvAddTaskToReadyList( pxNewTCB );
+            prvAddTaskToReadyList( pxNewTCB );
 
-        portSETUP_TCB( pxNewTCB );
-    }
-    taskEXIT_CRITICAL();
+            portSETUP_TCB( pxNewTCB );
 
-    if( xSchedulerRunning != pdFALSE )
-    {
-        /* If the created task is of a higher priority than the current task
-         * then it should run now. */
-        if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
-        {
-            taskYIELD_IF_USING_PREEMPTION();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
+            if( xSchedulerRunning != pdFALSE )
+            {
+                /* If the created task is of a higher priority than a task
+                 * running on any core it should run now. */
+                taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxNewTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
+        taskEXIT_CRITICAL();
     }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-}
+
+#endif /* configNUMBER_OF_CORES == 1 */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -1112,6 +1846,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     void vTaskDelete( TaskHandle_t xTaskToDelete )
     {
         TCB_t * pxTCB;
+        BaseType_t xDeleteTCBInIdleTask;
 
         taskENTER_CRITICAL();
         {
@@ -1129,6 +1864,20 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+            {
+                /* The TCB may be freed before the tick gets to the entry. */
+                if( pxTCB->uxDelayedTaskHeapIndex != ( UBaseType_t ) 0U )
+                {
+                    prvDelayedTaskHeapRemove( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
             /* Is the task waiting on an event also? */
             if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
@@ -1145,7 +1894,20 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
              * not return. */
             uxTaskNumber++;
 
-            if( pxTCB == pxCurrentTCB )
+            /* A task that is still running, on this or on another core, cannot
+             * be freed here - its memory is released by the idle task once it
+             * has been switched out. */
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                xDeleteTCBInIdleTask = ( pxTCB == pxCurrentTCB ) ? pdTRUE : pdFALSE;
+            }
+            #else
+            {
+                xDeleteTCBInIdleTask = ( ( xSchedulerRunning != pdFALSE ) && taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB ) ) ? pdTRUE : pdFALSE;
+            }
+            #endif
+
+            if( xDeleteTCBInIdleTask != pdFALSE )
             {
                 /* A task is deleting itself.  This cannot complete within the
                  * task itself, as a context switch to another task is required.
@@ -1179,31 +1941,57 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * the task that has just been deleted. */
                 prvResetNextTaskUnblockTime();
             }
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* Force the core running the deleted task to reschedule. */
+                if( ( xSchedulerRunning != pdFALSE ) && taskTASK_IS_RUNNING( pxTCB ) )
+                {
+                    if( pxTCB->xTaskRunState == ( BaseType_t ) portGET_CORE_ID() )
+                    {
+                        configASSERT( uxSchedulerSuspended == 0 );
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        prvYieldCore( pxTCB->xTaskRunState );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configNUMBER_OF_CORES > 1 */
         }
         taskEXIT_CRITICAL();
 
         /* If the task is not deleting itself, call prvDeleteTCB from outside of
          * critical section. If a task deletes itself, prvDeleteTCB is called
          * from prvCheckTasksWaitingTermination which is called from Idle task. */
-        if( pxTCB != pxCurrentTCB )
+        if( xDeleteTCBInIdleTask == pdFALSE )
         {
             prvDeleteTCB( pxTCB );
         }
 
-        /* Force a reschedule if it is the currently running task that has just
-         * been deleted. */
-        if( xSchedulerRunning != pdFALSE )
+        #if ( configNUMBER_OF_CORES == 1 )
         {
-            if( pxTCB == pxCurrentTCB )
-            {
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
-            }
-            else
+            /* Force a reschedule if it is the currently running task that has just
+             * been deleted. */
+            if( xSchedulerRunning != pdFALSE )
             {
-                mtCOVERAGE_TEST_MARKER();
+                if( pxTCB == pxCurrentTCB )
+                {
+                    configASSERT( uxSchedulerSuspended == 0 );
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
+        #endif /* configNUMBER_OF_CORES == 1 */
     }
 
 #endif /* INCLUDE_vTaskDelete */
@@ -1353,9 +2141,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
         configASSERT( pxTCB );
 
-        if( pxTCB == pxCurrentTCB )
+        #if ( configNUMBER_OF_CORES == 1 )
+            if( pxTCB == pxCurrentTCB )
+        #else
+            if( taskTASK_IS_RUNNING( pxTCB ) )
+        #endif
         {
-            /* The task calling this function is querying its own state. */
+            /* The task calling this function is querying its own state, or the
+             * state of a task running on another core. */
             eReturn = eRunning;
         }
         else
@@ -1487,14 +2280,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
          * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
         portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
         {
             /* If null is passed in here then it is the priority of the calling
              * task that is being queried. */
             pxTCB = prvGetTCBFromHandle( xTask );
             uxReturn = pxTCB->uxPriority;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptState );
 
         return uxReturn;
     }
@@ -1511,6 +2304,10 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         UBaseType_t uxCurrentBasePriority, uxPriorityUsedOnEntry;
         BaseType_t xYieldRequired = pdFALSE;
 
+        #if ( configNUMBER_OF_CORES > 1 )
+            BaseType_t xYieldForTask = pdFALSE;
+        #endif
+
         configASSERT( uxNewPriority < configMAX_PRIORITIES );
 
         /* Ensure the new priority is valid. */
@@ -1545,6 +2342,25 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             {
                 /* The priority change may have readied a task of higher
                  * priority than the calling task. */
+                #if ( configNUMBER_OF_CORES > 1 )
+                    if( uxNewPriority > uxCurrentBasePriority )
+                    {
+                        /* The task may now be able to preempt a core, which is
+                         * decided once its ready list has been updated below. */
+                        xYieldForTask = pdTRUE;
+                    }
+                    else if( taskTASK_IS_RUNNING( pxTCB ) )
+                    {
+                        /* Setting the priority of a running task down means
+                         * there may now be another task of higher priority that
+                         * is ready to execute on its core. */
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                #else /* if ( configNUMBER_OF_CORES > 1 ) */
                 if( uxNewPriority > uxCurrentBasePriority )
                 {
                     if( pxTCB != pxCurrentTCB )
@@ -1581,6 +2397,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                      * require a yield as the running task must be above the
                      * new priority of the task being modified. */
                 }
+                #endif /* if ( configNUMBER_OF_CORES > 1 ) */
 
                 /* Remember the ready list the task might be referenced from
                  * before its uxPriority member is changed so the
@@ -1640,32 +2457,147 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-
-                    prvAddTaskToReadyList( pxTCB );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
+
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    if( xYieldRequired != pdFALSE )
+                    {
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* if ( configNUMBER_OF_CORES == 1 ) */
+                {
+                    if( xYieldRequired != pdFALSE )
+                    {
+                        /* The running task priority was set down, request the
+                         * core running it to reschedule. */
+                        taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB );
+                    }
+                    else if( xYieldForTask != pdFALSE )
+                    {
+                        /* The priority was raised, preempt the core running the
+                         * lowest priority task if required. */
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
+                #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+
+                /* Remove compiler warning about unused variables when the port
+                 * optimised task selection is not being used. */
+                ( void ) uxPriorityUsedOnEntry;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* INCLUDE_vTaskPrioritySet */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                               UBaseType_t uxCoreAffinityMask )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xCoreID;
+        UBaseType_t uxPrevCoreAffinityMask;
 
-                if( xYieldRequired != pdFALSE )
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            uxPrevCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+            pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+            if( xSchedulerRunning != pdFALSE )
+            {
+                if( taskTASK_IS_RUNNING( pxTCB ) )
                 {
-                    taskYIELD_IF_USING_PREEMPTION();
+                    xCoreID = ( BaseType_t ) pxTCB->xTaskRunState;
+
+                    /* If the task can no longer run on the core it was running,
+                     * request the core to yield. */
+                    if( ( uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) == 0U )
+                    {
+                        prvYieldCore( xCoreID );
+                    }
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        /* The SMP scheduler requests a core to yield when a ready
+                         * task is able to run.  It is possible that the core affinity
+                         * of the ready task is changed before the requested core
+                         * can select it to run.  In that case, the task may not be
+                         * selected by the previously requested core due to core
+                         * affinity constraint and the SMP scheduler must select
+                         * another core to yield for the task. */
+                        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                        {
+                            if( ( uxCoreAffinityMask & ~uxPrevCoreAffinityMask ) != 0U )
+                            {
+                                prvYieldForTask( pxTCB );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #else /* #if ( configUSE_PREEMPTION == 1 ) */
+                    {
+                        /* The task is picked up on the next yield of a
+                         * core it is allowed to run on. */
+                        ( void ) uxPrevCoreAffinityMask;
+                    }
+                    #endif /* #if ( configUSE_PREEMPTION == 1 ) */
                 }
-
-                /* Remove compiler warning about unused variables when the port
-                 * optimised task selection is not being used. */
-                ( void ) uxPriorityUsedOnEntry;
             }
         }
         taskEXIT_CRITICAL();
     }
 
-#endif /* INCLUDE_vTaskPrioritySet */
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    UBaseType_t vTaskCoreAffinityGet( const TaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        UBaseType_t uxCoreAffinityMask;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxCoreAffinityMask;
+    }
+
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_vTaskSuspend == 1 )
@@ -1693,6 +2625,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            #if ( configUSE_TASK_LATENCY_STATS == 1 )
+            {
+                /* A ready task suspended before it ran is timed again from
+                 * the next time it is made ready. */
+                pxTCB->xLatencyPending = pdFALSE;
+            }
+            #endif
+
             /* Is the task waiting on an event also? */
             if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
@@ -1720,55 +2660,95 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 }
             }
             #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-        }
-        taskEXIT_CRITICAL();
 
-        if( xSchedulerRunning != pdFALSE )
-        {
-            /* Reset the next expected unblock time in case it referred to the
-             * task that is now in the Suspended state. */
-            taskENTER_CRITICAL();
+            #if ( configNUMBER_OF_CORES > 1 )
             {
-                prvResetNextTaskUnblockTime();
+                if( xSchedulerRunning != pdFALSE )
+                {
+                    /* Reset the next expected unblock time in case it referred
+                     * to the task that is now in the Suspended state. */
+                    prvResetNextTaskUnblockTime();
+
+                    /* The suspended task may be running on this or on another
+                     * core.  Only idle tasks run before the scheduler is started
+                     * and they cannot be suspended. */
+                    if( taskTASK_IS_RUNNING( pxTCB ) )
+                    {
+                        if( pxTCB->xTaskRunState == ( BaseType_t ) portGET_CORE_ID() )
+                        {
+                            /* The current task has just been suspended. */
+                            configASSERT( uxSchedulerSuspended == 0 );
+                            portYIELD_WITHIN_API();
+                        }
+                        else
+                        {
+                            prvYieldCore( pxTCB->xTaskRunState );
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            taskEXIT_CRITICAL();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
+            #endif /* configNUMBER_OF_CORES > 1 */
         }
+        taskEXIT_CRITICAL();
 
-        if( pxTCB == pxCurrentTCB )
+        #if ( configNUMBER_OF_CORES == 1 )
         {
             if( xSchedulerRunning != pdFALSE )
             {
-                /* The current task has just been suspended. */
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
+                /* Reset the next expected unblock time in case it referred to the
+                 * task that is now in the Suspended state. */
+                taskENTER_CRITICAL();
+                {
+                    prvResetNextTaskUnblockTime();
+                }
+                taskEXIT_CRITICAL();
             }
             else
             {
-                /* The scheduler is not running, but the task that was pointed
-                 * to by pxCurrentTCB has just been suspended and pxCurrentTCB
-                 * must be adjusted to point to a different task. */
-                if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxTCB == pxCurrentTCB )
+            {
+                if( xSchedulerRunning != pdFALSE )
                 {
-                    /* No other tasks are ready, so set pxCurrentTCB back to
-                     * NULL so when the next task is created pxCurrentTCB will
-                     * be set to point to it no matter what its relative priority
-                     * is. */
-                    pxCurrentTCB = NULL;
+                    /* The current task has just been suspended. */
+                    configASSERT( uxSchedulerSuspended == 0 );
+                    portYIELD_WITHIN_API();
                 }
                 else
                 {
-                    vTaskSwitchContext();
+                    /* The scheduler is not running, but the task that was pointed
+                     * to by pxCurrentTCB has just been suspended and pxCurrentTCB
+                     * must be adjusted to point to a different task. */
+                    if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                    {
+                        /* No other tasks are ready, so set pxCurrentTCB back to
+                         * NULL so when the next task is created pxCurrentTCB will
+                         * be set to point to it no matter what its relative priority
+                         * is. */
+                        pxCurrentTCB = NULL;
+                    }
+                    else
+                    {
+                        vTaskSwitchContext();
+                    }
                 }
             }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        #endif /* configNUMBER_OF_CORES == 1 */
     }
 
 #endif /* INCLUDE_vTaskSuspend */
@@ -1844,18 +2824,28 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
                     prvAddTaskToReadyList( pxTCB );
 
-                    /* A higher priority task may have just been resumed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        /* This yield may not cause the task just resumed to run,
-                         * but will leave the lists in the correct state for the
-                         * next yield. */
-                        taskYIELD_IF_USING_PREEMPTION();
+                        /* A higher priority task may have just been resumed. */
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            /* This yield may not cause the task just resumed to run,
+                             * but will leave the lists in the correct state for the
+                             * next yield. */
+                            taskYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
-                    else
+                    #else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* The resumed task may be able to preempt one of the
+                         * cores. */
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
                     }
+                    #endif /* configNUMBER_OF_CORES == 1 */
                 }
                 else
                 {
@@ -1902,7 +2892,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
          * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
         portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
             {
@@ -1911,21 +2901,25 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 /* Check the ready lists can be accessed. */
                 if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
-                    /* Ready lists can be accessed so move the task from the
-                     * suspended list to the ready list directly. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        xYieldRequired = pdTRUE;
+                        /* Ready lists can be accessed so move the task from the
+                         * suspended list to the ready list directly. */
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            xYieldRequired = pdTRUE;
 
-                        /* Mark that a yield is pending in case the user is not
-                         * using the return value to initiate a context switch
-                         * from the ISR using portYIELD_FROM_ISR. */
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
+                            /* Mark that a yield is pending in case the user is not
+                             * using the return value to initiate a context switch
+                             * from the ISR using portYIELD_FROM_ISR. */
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
+                    #endif /* configNUMBER_OF_CORES == 1 */
 
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
                     prvAddTaskToReadyList( pxTCB );
@@ -1937,13 +2931,30 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                      * unsuspended. */
                     vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
+
+                #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+                {
+                    /* The resumed task may preempt another core, or this one in
+                     * which case the yield is held pending for this core. */
+                    prvYieldForTask( pxTCB );
+
+                    if( xYieldPending != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) */
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xYieldRequired;
     }
@@ -1951,48 +2962,163 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 #endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-void vTaskStartScheduler( void )
-{
-    BaseType_t xReturn;
+#if ( configNUMBER_OF_CORES > 1 )
 
-    /* Add the idle task at the lowest priority. */
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    static BaseType_t prvCreateIdleTasks( void )
     {
-        StaticTask_t * pxIdleTaskTCBBuffer = NULL;
-        StackType_t * pxIdleTaskStackBuffer = NULL;
-        uint32_t ulIdleTaskStackSize;
+        BaseType_t xReturn = pdPASS;
+        BaseType_t xCoreID;
+        char cIdleName[ configMAX_TASK_NAME_LEN ];
+        TaskFunction_t pxIdleTaskFunction;
+        UBaseType_t x;
+
+        /* Copy the idle task name, leaving room for the core number suffix. */
+        for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 2 ); x++ )
+        {
+            cIdleName[ x ] = configIDLE_TASK_NAME[ x ];
 
-        /* The Idle task is created using user provided RAM - obtain the
-         * address of the RAM then create the idle task. */
-        vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
-        xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
-                                             configIDLE_TASK_NAME,
-                                             ulIdleTaskStackSize,
-                                             ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
-                                             portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                                             pxIdleTaskStackBuffer,
-                                             pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+            if( cIdleName[ x ] == ( char ) 0x00 )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
 
-        if( xIdleTaskHandle != NULL )
+        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
         {
-            xReturn = pdPASS;
+            /* The idle task of core 0 performs the house keeping, the idle
+             * tasks of the remaining cores are passive. */
+            if( xCoreID == ( BaseType_t ) 0 )
+            {
+                pxIdleTaskFunction = prvIdleTask;
+            }
+            else
+            {
+                pxIdleTaskFunction = prvPassiveIdleTask;
+            }
+
+            /* Append the core number to the name so each idle task can be told
+             * apart. */
+            cIdleName[ x ] = ( char ) ( '0' + xCoreID );
+            cIdleName[ x + 1U ] = ( char ) 0x00;
+
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+                StackType_t * pxIdleTaskStackBuffer = NULL;
+                uint32_t ulIdleTaskStackSize;
+
+                /* The Idle tasks are created using user provided RAM - obtain
+                 * the address of the RAM then create the idle task. */
+                if( xCoreID == ( BaseType_t ) 0 )
+                {
+                    vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+                }
+                else
+                {
+                    vApplicationGetPassiveIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize, xCoreID - 1 );
+                }
+
+                xIdleTaskHandles[ xCoreID ] = xTaskCreateStatic( pxIdleTaskFunction,
+                                                                 cIdleName,
+                                                                 ulIdleTaskStackSize,
+                                                                 ( void * ) NULL,
+                                                                 portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                                                 pxIdleTaskStackBuffer,
+                                                                 pxIdleTaskTCBBuffer );
+
+                if( xIdleTaskHandles[ xCoreID ] != NULL )
+                {
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+            }
+            #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+            {
+                /* The Idle tasks are being created using dynamically allocated
+                 * RAM. */
+                xReturn = xTaskCreate( pxIdleTaskFunction,
+                                       cIdleName,
+                                       configMINIMAL_STACK_SIZE,
+                                       ( void * ) NULL,
+                                       portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                       &xIdleTaskHandles[ xCoreID ] );
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+            if( xReturn != pdPASS )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        else
+
+        return xReturn;
+    }
+
+#endif /* configNUMBER_OF_CORES > 1 */
+/*-----------------------------------------------------------*/
+
+void vTaskStartScheduler( void )
+{
+    BaseType_t xReturn;
+
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* Add the idle task at the lowest priority. */
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        {
+            StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+            StackType_t * pxIdleTaskStackBuffer = NULL;
+            uint32_t ulIdleTaskStackSize;
+
+            /* The Idle task is created using user provided RAM - obtain the
+             * address of the RAM then create the idle task. */
+            vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+            xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
+                                                 configIDLE_TASK_NAME,
+                                                 ulIdleTaskStackSize,
+                                                 ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
+                                                 portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                                 pxIdleTaskStackBuffer,
+                                                 pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+            if( xIdleTaskHandle != NULL )
+            {
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
         {
-            xReturn = pdFAIL;
+            /* The Idle task is being created using dynamically allocated RAM. */
+            xReturn = xTaskCreate( prvIdleTask,
+                                   configIDLE_TASK_NAME,
+                                   configMINIMAL_STACK_SIZE,
+                                   ( void * ) NULL,
+                                   portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                   &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
         }
+        #endif /* configSUPPORT_STATIC_ALLOCATION */
     }
-    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+    #else /* configNUMBER_OF_CORES == 1 */
     {
-        /* The Idle task is being created using dynamically allocated RAM. */
-        xReturn = xTaskCreate( prvIdleTask,
-                               configIDLE_TASK_NAME,
-                               configMINIMAL_STACK_SIZE,
-                               ( void * ) NULL,
-                               portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                               &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+        /* Add one idle task per core at the lowest priority. */
+        xReturn = prvCreateIdleTasks();
     }
-    #endif /* configSUPPORT_STATIC_ALLOCATION */
+    #endif /* configNUMBER_OF_CORES == 1 */
 
     #if ( configUSE_TIMERS == 1 )
     {
@@ -2068,7 +3194,11 @@ void vTaskStartScheduler( void )
 
     /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
      * meaning xIdleTaskHandle is not used anywhere else. */
-    ( void ) xIdleTaskHandle;
+    #if ( configNUMBER_OF_CORES == 1 )
+        ( void ) xIdleTaskHandle;
+    #else
+        ( void ) xIdleTaskHandles;
+    #endif
 
     /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
      * from getting optimized out as it is no longer used by the kernel. */
@@ -2089,22 +3219,74 @@ void vTaskEndScheduler( void )
 
 void vTaskSuspendAll( void )
 {
-    /* A critical section is not required as the variable is of type
-     * BaseType_t.  Please read Richard Barry's reply in the following link to a
-     * post in the FreeRTOS support forum before reporting this as a bug! -
-     * https://goo.gl/wu4acr */
-
-    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
-     * do not otherwise exhibit real time behaviour. */
-    portSOFTWARE_BARRIER();
-
-    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
-     * is used to allow calls to vTaskSuspendAll() to nest. */
-    ++uxSchedulerSuspended;
-
-    /* Enforces ordering for ports and optimised compilers that may otherwise place
-     * the above increment elsewhere. */
-    portMEMORY_BARRIER();
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* A critical section is not required as the variable is of type
+         * BaseType_t.  Please read Richard Barry's reply in the following link to a
+         * post in the FreeRTOS support forum before reporting this as a bug! -
+         * https://goo.gl/wu4acr */
+
+        /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
+         * do not otherwise exhibit real time behaviour. */
+        portSOFTWARE_BARRIER();
+
+        /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
+         * is used to allow calls to vTaskSuspendAll() to nest. */
+        ++uxSchedulerSuspended;
+
+        /* Enforces ordering for ports and optimised compilers that may otherwise place
+         * the above increment elsewhere. */
+        portMEMORY_BARRIER();
+    }
+    #else /* configNUMBER_OF_CORES == 1 */
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* This must only be called from within a task. */
+        portASSERT_IF_IN_ISR();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Writes to uxSchedulerSuspended must be protected by both the task
+             * and the ISR locks.  The task lock is kept until the matching call
+             * to xTaskResumeAll() so tasks running on the other core cannot
+             * enter the kernel while the scheduler is suspended. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+            /* This must never be called from inside a critical section. */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() == 0 );
+
+            portSOFTWARE_BARRIER();
+
+            portGET_TASK_LOCK();
+
+            /* The calling task may have been asked to yield by the other core
+             * before the task lock was obtained.  That yield must be serviced
+             * before the scheduler is suspended. */
+            if( uxSchedulerSuspended == 0U )
+            {
+                prvCheckForRunStateChange();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            portGET_ISR_LOCK();
+
+            /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An
+             * increment is used to allow calls to vTaskSuspendAll() to nest. */
+            ++uxSchedulerSuspended;
+            portRELEASE_ISR_LOCK();
+
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configNUMBER_OF_CORES == 1 */
 }
 /*----------------------------------------------------------*/
 
@@ -2163,6 +3345,23 @@ void vTaskSuspendAll( void )
         else
         {
             xReturn = xNextTaskUnblockTime - xTickCount;
+
+            #if ( configUSE_ISR_TIMERS == 1 )
+            {
+                /* The ISR context timers are called from xTaskIncrementTick(),
+                 * the core has to wake up for the next one as well. */
+                const TickType_t xTicksToISRTimer = xTimerGetTicksToNextISRTimer( xTickCount );
+
+                if( xTicksToISRTimer < xReturn )
+                {
+                    xReturn = xTicksToISRTimer;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_ISR_TIMERS */
         }
 
         return xReturn;
@@ -2176,68 +3375,51 @@ BaseType_t xTaskResumeAll( void )
     TCB_t * pxTCB = NULL;
     BaseType_t xAlreadyYielded = pdFALSE;
 
-    /* If uxSchedulerSuspended is zero then this function does not match a
-     * previous call to vTaskSuspendAll(). */
-    configASSERT( uxSchedulerSuspended );
-
-    /* It is possible that an ISR caused a task to be removed from an event
-     * list while the scheduler was suspended.  If this was the case then the
-     * removed task will have been added to the xPendingReadyList.  Once the
-     * scheduler has been resumed it is safe to move all the pending ready
-     * tasks from this list into their appropriate ready list. */
-    taskENTER_CRITICAL();
+    #if ( configNUMBER_OF_CORES > 1 )
+        /* vTaskSuspendAll() does nothing until the scheduler is started. */
+        if( xSchedulerRunning != pdFALSE )
+    #endif
     {
-        --uxSchedulerSuspended;
-
-        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        /* If uxSchedulerSuspended is zero then this function does not match a
+         * previous call to vTaskSuspendAll(). */
+        configASSERT( uxSchedulerSuspended );
+
+        /* It is possible that an ISR caused a task to be removed from an event
+         * list while the scheduler was suspended.  If this was the case then the
+         * removed task will have been added to the xPendingReadyList.  Once the
+         * scheduler has been resumed it is safe to move all the pending ready
+         * tasks from this list into their appropriate ready list. */
+        taskENTER_CRITICAL();
         {
-            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
-            {
-                /* Move any readied tasks from the pending list into the
-                 * appropriate ready list. */
-                while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
-                {
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    portMEMORY_BARRIER();
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
-
-                    /* If the moved task has a priority higher than or equal to
-                     * the current task then a yield must be performed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-                    {
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
+            --uxSchedulerSuspended;
 
-                if( pxTCB != NULL )
-                {
-                    /* A task was unblocked while the scheduler was suspended,
-                     * which may have prevented the next unblock time from being
-                     * re-calculated, in which case re-calculate it now.  Mainly
-                     * important for low power tickless implementations, where
-                     * this can prevent an unnecessary exit from low power
-                     * state. */
-                    prvResetNextTaskUnblockTime();
-                }
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* Drop the task lock taken by vTaskSuspendAll().  It remains held by
+                 * this critical section until the pending ready list is processed. */
+                portRELEASE_TASK_LOCK();
+            }
+            #endif
 
-                /* If any ticks occurred while the scheduler was suspended then
-                 * they should be processed now.  This ensures the tick count does
-                 * not  slip, and that any delayed tasks are resumed at the correct
-                 * time. */
+            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+            {
+                if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
                 {
-                    TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
-
-                    if( xPendedCounts > ( TickType_t ) 0U )
+                    /* Move any readied tasks from the pending list into the
+                     * appropriate ready list. */
+                    while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
                     {
-                        do
+                        pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                        portMEMORY_BARRIER();
+                        listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                        prvAddTaskToReadyList( pxTCB );
+
+                        #if ( configNUMBER_OF_CORES == 1 )
                         {
-                            if( xTaskIncrementTick() != pdFALSE )
+                            /* If the moved task has a priority higher than or equal to
+                             * the current task then a yield must be performed. */
+                            if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
                             {
                                 xYieldPending = pdTRUE;
                             }
@@ -2245,39 +3427,80 @@ BaseType_t xTaskResumeAll( void )
                             {
                                 mtCOVERAGE_TEST_MARKER();
                             }
+                        }
+                        #else
+                        {
+                            /* The cores that must run the task were already asked
+                             * to yield when it was placed in the pending ready
+                             * list. */
+                        }
+                        #endif /* configNUMBER_OF_CORES == 1 */
+                    }
 
-                            --xPendedCounts;
-                        } while( xPendedCounts > ( TickType_t ) 0U );
-
-                        xPendedTicks = 0;
+                    if( pxTCB != NULL )
+                    {
+                        /* A task was unblocked while the scheduler was suspended,
+                         * which may have prevented the next unblock time from being
+                         * re-calculated, in which case re-calculate it now.  Mainly
+                         * important for low power tickless implementations, where
+                         * this can prevent an unnecessary exit from low power
+                         * state. */
+                        prvResetNextTaskUnblockTime();
                     }
-                    else
+
+                    /* If any ticks occurred while the scheduler was suspended then
+                     * they should be processed now.  This ensures the tick count does
+                     * not  slip, and that any delayed tasks are resumed at the correct
+                     * time. */
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+
+                        if( xPendedCounts > ( TickType_t ) 0U )
+                        {
+                            do
+                            {
+                                if( xTaskIncrementTick() != pdFALSE )
+                                {
+                                    xYieldPending = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+
+                                --xPendedCounts;
+                            } while( xPendedCounts > ( TickType_t ) 0U );
+
+                            xPendedTicks = 0;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
-                }
 
-                if( xYieldPending != pdFALSE )
-                {
-                    #if ( configUSE_PREEMPTION != 0 )
+                    if( xYieldPending != pdFALSE )
+                    {
+                        #if ( configUSE_PREEMPTION != 0 )
+                        {
+                            xAlreadyYielded = pdTRUE;
+                        }
+                        #endif
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
                     {
-                        xAlreadyYielded = pdTRUE;
+                        mtCOVERAGE_TEST_MARKER();
                     }
-                    #endif
-                    taskYIELD_IF_USING_PREEMPTION();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
                 }
             }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        taskEXIT_CRITICAL();
     }
-    taskEXIT_CRITICAL();
 
     return xAlreadyYielded;
 }
@@ -2559,16 +3782,91 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 #endif /* configUSE_TRACE_FACILITY */
 /*----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configGENERATE_RUN_TIME_STATS == 1 ) )
 
-    TaskHandle_t xTaskGetIdleTaskHandle( void )
+    UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTime_t * const pxTaskRunTimeArray,
+                                          const UBaseType_t uxArraySize,
+                                          configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
     {
-        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-         * started, then xIdleTaskHandle will be NULL. */
-        configASSERT( ( xIdleTaskHandle != NULL ) );
-        return xIdleTaskHandle;
+        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+
+        vTaskSuspendAll();
+        {
+            /* Is there a space in the array for each task in the system? */
+            if( uxArraySize >= uxCurrentNumberOfTasks )
+            {
+                do
+                {
+                    uxQueue--;
+                    uxTask += prvListTaskRunTimesWithinSingleList( &( pxTaskRunTimeArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ) );
+                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+                uxTask += prvListTaskRunTimesWithinSingleList( &( pxTaskRunTimeArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList );
+                uxTask += prvListTaskRunTimesWithinSingleList( &( pxTaskRunTimeArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList );
+
+                #if ( INCLUDE_vTaskDelete == 1 )
+                {
+                    uxTask += prvListTaskRunTimesWithinSingleList( &( pxTaskRunTimeArray[ uxTask ] ), &xTasksWaitingTermination );
+                }
+                #endif
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    uxTask += prvListTaskRunTimesWithinSingleList( &( pxTaskRunTimeArray[ uxTask ] ), &xSuspendedTaskList );
+                }
+                #endif
+
+                if( pulTotalRunTime != NULL )
+                {
+                    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                        portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+                    #else
+                        *pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                    #endif
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxTask;
     }
 
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configGENERATE_RUN_TIME_STATS == 1 ) ) */
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        TaskHandle_t xTaskGetIdleTaskHandle( void )
+        {
+            /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+             * started, then xIdleTaskHandle will be NULL. */
+            configASSERT( ( xIdleTaskHandle != NULL ) );
+            return xIdleTaskHandle;
+        }
+    #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+        TaskHandle_t xTaskGetIdleTaskHandle( void )
+        {
+            /* The idle task that frees deleted tasks and calls the idle hook
+             * always runs on core 0. */
+            return xTaskGetIdleTaskHandleForCore( 0 );
+        }
+
+        TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID )
+        {
+            configASSERT( taskVALID_CORE_ID( xCoreID ) == pdTRUE );
+
+            /* If xTaskGetIdleTaskHandleForCore() is called before the scheduler
+             * has been started, then xIdleTaskHandles will be NULL. */
+            configASSERT( ( xIdleTaskHandles[ xCoreID ] != NULL ) );
+            return xIdleTaskHandles[ xCoreID ];
+        }
+    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+
 #endif /* INCLUDE_xTaskGetIdleTaskHandle */
 /*----------------------------------------------------------*/
 
@@ -2580,6 +3878,8 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 
     void vTaskStepTick( TickType_t xTicksToJump )
     {
+        TickType_t xTicksToPend = ( TickType_t ) 0;
+
         /* Correct the tick count value after a period during which the tick
          * was suppressed.  Note this does *not* call the tick hook function for
          * each stepped tick. */
@@ -2590,16 +3890,45 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
             /* Arrange for xTickCount to reach xNextTaskUnblockTime in
              * xTaskIncrementTick() when the scheduler resumes.  This ensures
              * that any delayed tasks are resumed at the correct time. */
-            configASSERT( uxSchedulerSuspended );
             configASSERT( xTicksToJump != ( TickType_t ) 0 );
+            xTicksToPend = ( TickType_t ) 1;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_ISR_TIMERS == 1 )
+        {
+            /* The stepped ticks do not call the ISR context timers either.  The
+             * ticks from the next one on are pended so xTaskIncrementTick()
+             * calls it on its own tick, prvGetExpectedIdleTime() makes this
+             * the last tick of the jump unless an interrupt started a timer
+             * while the core slept. */
+            const TickType_t xTicksToISRTimer = xTimerGetTicksToNextISRTimer( xTickCount );
+
+            if( xTicksToJump >= xTicksToISRTimer )
+            {
+                xTicksToPend = ( xTicksToISRTimer > ( TickType_t ) 0 ) ? ( ( xTicksToJump - xTicksToISRTimer ) + ( TickType_t ) 1 ) : xTicksToJump;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_ISR_TIMERS */
+
+        if( xTicksToPend > ( TickType_t ) 0 )
+        {
+            configASSERT( uxSchedulerSuspended );
 
             /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
             taskENTER_CRITICAL();
             {
-                xPendedTicks++;
+                xPendedTicks += xTicksToPend;
             }
             taskEXIT_CRITICAL();
-            xTicksToJump--;
+            xTicksToJump -= xTicksToPend;
         }
         else
         {
@@ -2688,19 +4017,34 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                  * switch if preemption is turned off. */
                 #if ( configUSE_PREEMPTION == 1 )
                 {
-                    /* Preemption is on, but a context switch should only be
-                     * performed if the unblocked task has a priority that is
-                     * higher than the currently executing task. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        /* Pend the yield to be performed when the scheduler
-                         * is unsuspended. */
-                        xYieldPending = pdTRUE;
+                        /* Preemption is on, but a context switch should only be
+                         * performed if the unblocked task has a priority that is
+                         * higher than the currently executing task. */
+                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        {
+                            /* Pend the yield to be performed when the scheduler
+                             * is unsuspended. */
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
-                    else
+                    #else /* #if ( configNUMBER_OF_CORES == 1 ) */
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* The unblocked task may preempt a task on either
+                         * core - the core chosen is signalled from within a
+                         * critical section. */
+                        taskENTER_CRITICAL();
+                        {
+                            prvYieldForTask( pxTCB );
+                        }
+                        taskEXIT_CRITICAL();
                     }
+                    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
                 }
                 #endif /* configUSE_PREEMPTION */
             }
@@ -2720,9 +4064,15 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 BaseType_t xTaskIncrementTick( void )
 {
     TCB_t * pxTCB;
-    TickType_t xItemValue;
+    #if ( configUSE_DELAYED_TASK_HEAP == 0 )
+        TickType_t xItemValue;
+    #endif
     BaseType_t xSwitchRequired = pdFALSE;
 
+    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+        BaseType_t xYieldRequiredForCore[ configNUMBER_OF_CORES ] = { pdFALSE };
+    #endif
+
     /* Called by the portable layer each time a tick interrupt occurs.
      * Increments the tick then checks to see if the new tick value will cause any
      * tasks to be unblocked. */
@@ -2755,18 +4105,35 @@ BaseType_t xTaskIncrementTick( void )
         {
             for( ; ; )
             {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                #if ( configUSE_DELAYED_TASK_HEAP == 1 )
                 {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    break;
+                    /* The heap gives the task with the earliest wake time
+                     * directly, and sets xNextTaskUnblockTime once no task
+                     * is left to unblock. */
+                    pxTCB = prvDelayedTaskHeapTakeExpired( xConstTickCount );
+
+                    if( pxTCB == NULL )
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
-                else
+                #else /* configUSE_DELAYED_TASK_HEAP */
                 {
+                    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                    {
+                        /* The delayed list is empty.  Set xNextTaskUnblockTime
+                         * to the maximum possible value so it is extremely
+                         * unlikely that the
+                         * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                         * next time through. */
+                        xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                        break;
+                    }
+
                     /* The delayed list is not empty, get the value of the
                      * item at the head of the delayed list.  This is the time
                      * at which the task at the head of the delayed list must
@@ -2788,37 +4155,41 @@ BaseType_t xTaskIncrementTick( void )
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
+                }
+                #endif /* configUSE_DELAYED_TASK_HEAP */
 
-                    /* It is time to remove the item from the Blocked state. */
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                /* It is time to remove the item from the Blocked state. */
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
 
-                    /* Is the task waiting on an event also?  If so remove
-                     * it from the event list. */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                    {
-                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                /* Is the task waiting on an event also?  If so remove
+                 * it from the event list. */
+                if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-                    /* Place the unblocked task into the appropriate ready
-                     * list. */
-                    prvAddTaskToReadyList( pxTCB );
+                /* Place the unblocked task into the appropriate ready
+                 * list. */
+                prvAddTaskToReadyList( pxTCB );
 
-                    /* A task being unblocked cannot cause an immediate
-                     * context switch if preemption is turned off. */
-                    #if ( configUSE_PREEMPTION == 1 )
+                /* A task being unblocked cannot cause an immediate
+                 * context switch if preemption is turned off. */
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    /* Preemption is on, but a context switch should
+                     * only be performed if the unblocked task's
+                     * priority is higher than the currently executing
+                     * task.
+                     * The case of equal priority tasks sharing
+                     * processing time (which happens when both
+                     * preemption and time slicing are on) is
+                     * handled below.*/
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        /* Preemption is on, but a context switch should
-                         * only be performed if the unblocked task's
-                         * priority is higher than the currently executing
-                         * task.
-                         * The case of equal priority tasks sharing
-                         * processing time (which happens when both
-                         * preemption and time slicing are on) is
-                         * handled below.*/
                         if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
                         {
                             xSwitchRequired = pdTRUE;
@@ -2828,27 +4199,67 @@ BaseType_t xTaskIncrementTick( void )
                             mtCOVERAGE_TEST_MARKER();
                         }
                     }
-                    #endif /* configUSE_PREEMPTION */
+                    #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+                    {
+                        prvYieldForTask( pxTCB );
+                    }
+                    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
                 }
+                #endif /* configUSE_PREEMPTION */
             }
         }
 
+        #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+        {
+            /* Every wake time up to this tick has been taken out of the heap. */
+            xDelayedTaskHeapBase = xConstTickCount;
+        }
+        #endif
+
         /* Tasks of equal priority to the currently running task will share
          * processing time (time slice) if preemption is on, and the application
          * writer has not explicitly turned time slicing off. */
         #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
         {
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                xSwitchRequired = pdTRUE;
+                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            else
+            #else /* #if ( configNUMBER_OF_CORES == 1 ) */
             {
-                mtCOVERAGE_TEST_MARKER();
+                BaseType_t xCoreID;
+
+                for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                    {
+                        xYieldRequiredForCore[ xCoreID ] = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
             }
+            #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
         }
         #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
+        #if ( configUSE_ISR_TIMERS == 1 )
+        {
+            /* Call the ISR context timers that expire on this tick.  A task
+             * they unblock marks the yield as pending. */
+            vTimerProcessISRTimers( xConstTickCount );
+        }
+        #endif /* configUSE_ISR_TIMERS */
+
         #if ( configUSE_TICK_HOOK == 1 )
         {
             /* Guard against the tick hook being called when the pended tick
@@ -2866,14 +4277,45 @@ BaseType_t xTaskIncrementTick( void )
 
         #if ( configUSE_PREEMPTION == 1 )
         {
-            if( xYieldPending != pdFALSE )
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                xSwitchRequired = pdTRUE;
+                if( xYieldPending != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            else
+            #else /* #if ( configNUMBER_OF_CORES == 1 ) */
             {
-                mtCOVERAGE_TEST_MARKER();
+                BaseType_t xCoreID, xCurrentCoreID;
+
+                xCurrentCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+                /* The tick is only processed on one core - the yield for the
+                 * other core is requested through the inter-core signal. */
+                for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    if( ( xYieldRequiredForCore[ xCoreID ] != pdFALSE ) || ( xYieldPendings[ xCoreID ] != pdFALSE ) )
+                    {
+                        if( xCoreID == xCurrentCoreID )
+                        {
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            prvYieldCore( xCoreID );
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
             }
+            #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
         }
         #endif /* configUSE_PREEMPTION */
     }
@@ -2961,11 +4403,11 @@ BaseType_t xTaskIncrementTick( void )
 
         /* Save the hook function in the TCB.  A critical section is required as
          * the value can be accessed from an interrupt. */
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             xReturn = pxTCB->pxTaskTag;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xReturn;
     }
@@ -3006,78 +4448,183 @@ BaseType_t xTaskIncrementTick( void )
 #endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
-{
-    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
-    {
-        /* The scheduler is currently suspended - do not allow a context
-         * switch. */
-        xYieldPending = pdTRUE;
-    }
-    else
+#if ( configNUMBER_OF_CORES == 1 )
+    void vTaskSwitchContext( void )
     {
-        xYieldPending = pdFALSE;
-        traceTASK_SWITCHED_OUT();
-
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
         {
-            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-            #else
-                ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+            /* The scheduler is currently suspended - do not allow a context
+             * switch. */
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            xYieldPending = pdFALSE;
+            traceTASK_SWITCHED_OUT();
+
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+                #else
+                    ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+
+                /* Add the amount of time the task has been running to the
+                 * accumulated time so far.  The time the task started running was
+                 * stored in ulTaskSwitchedInTime.  Note that there is no overflow
+                 * protection here so count values are only valid until the timer
+                 * overflows.  The guard against negative values is to protect
+                 * against suspect run time stat counter implementations - which
+                 * are provided by the application, not the kernel. */
+                if( ulTotalRunTime > ulTaskSwitchedInTime )
+                {
+                    pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ulTaskSwitchedInTime = ulTotalRunTime;
+            }
+            #endif /* configGENERATE_RUN_TIME_STATS */
+
+            /* Check for stack overflow, if configured. */
+            taskCHECK_FOR_STACK_OVERFLOW();
+
+            /* Before the currently running task is switched out, save its errno. */
+            #if ( configUSE_POSIX_ERRNO == 1 )
+            {
+                pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+            }
             #endif
 
-            /* Add the amount of time the task has been running to the
-             * accumulated time so far.  The time the task started running was
-             * stored in ulTaskSwitchedInTime.  Note that there is no overflow
-             * protection here so count values are only valid until the timer
-             * overflows.  The guard against negative values is to protect
-             * against suspect run time stat counter implementations - which
-             * are provided by the application, not the kernel. */
-            if( ulTotalRunTime > ulTaskSwitchedInTime )
+            /* Select a new task to run using either the generic C or port
+             * optimised asm code. */
+            taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            traceTASK_SWITCHED_IN();
+
+            #if ( configUSE_TASK_LATENCY_STATS == 1 )
             {
-                pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                prvRecordTaskLatency( pxCurrentTCB, ulTotalRunTime );
             }
-            else
+            #endif
+
+            /* After the new task is switched in, update the global errno. */
+            #if ( configUSE_POSIX_ERRNO == 1 )
             {
-                mtCOVERAGE_TEST_MARKER();
+                FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
             }
+            #endif
 
-            ulTaskSwitchedInTime = ulTotalRunTime;
+            #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+            {
+                /* Switch C-Runtime's TLS Block to point to the TLS
+                 * Block specific to this task. */
+                configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+            }
+            #endif
         }
-        #endif /* configGENERATE_RUN_TIME_STATS */
+    }
+#else /* if ( configNUMBER_OF_CORES == 1 ) */
+    void vTaskSwitchContext( BaseType_t xCoreID )
+    {
+        /* Acquire both locks:
+         * - The ISR lock protects the ready list from simultaneous access by
+         *   both other ISRs and tasks.
+         * - We also take the task lock to pause here in case another core has
+         *   suspended the scheduler.  We don't want to simply set xYieldPending
+         *   and move on if another core suspended the scheduler.  We should only
+         *   do that if the current core has suspended the scheduler. */
+
+        portGET_TASK_LOCK(); /* Must always acquire the task lock first. */
+        portGET_ISR_LOCK();
+        {
+            /* vTaskSwitchContext() must never be called from within a critical
+             * section.  This is not necessarily true for single core FreeRTOS, but
+             * it is for this SMP port. */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() == 0 );
+
+            if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+            {
+                /* The scheduler is currently suspended - do not allow a context
+                 * switch. */
+                xYieldPendings[ xCoreID ] = pdTRUE;
+            }
+            else
+            {
+                xYieldPendings[ xCoreID ] = pdFALSE;
+                traceTASK_SWITCHED_OUT();
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                        portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime[ xCoreID ] );
+                    #else
+                        ulTotalRunTime[ xCoreID ] = portGET_RUN_TIME_COUNTER_VALUE();
+                    #endif
 
-        /* Check for stack overflow, if configured. */
-        taskCHECK_FOR_STACK_OVERFLOW();
+                    /* Add the amount of time the task has been running to the
+                     * accumulated time so far.  The time the task started running was
+                     * stored in ulTaskSwitchedInTime.  Note that there is no overflow
+                     * protection here so count values are only valid until the timer
+                     * overflows.  The guard against negative values is to protect
+                     * against suspect run time stat counter implementations - which
+                     * are provided by the application, not the kernel. */
+                    if( ulTotalRunTime[ xCoreID ] > ulTaskSwitchedInTime[ xCoreID ] )
+                    {
+                        pxCurrentTCBs[ xCoreID ]->ulRunTimeCounter += ( ulTotalRunTime[ xCoreID ] - ulTaskSwitchedInTime[ xCoreID ] );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-        /* Before the currently running task is switched out, save its errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
-        {
-            pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
-        }
-        #endif
+                    ulTaskSwitchedInTime[ xCoreID ] = ulTotalRunTime[ xCoreID ];
+                }
+                #endif /* configGENERATE_RUN_TIME_STATS */
 
-        /* Select a new task to run using either the generic C or port
-         * optimised asm code. */
-        taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-        traceTASK_SWITCHED_IN();
+                /* Check for stack overflow, if configured. */
+                taskCHECK_FOR_STACK_OVERFLOW();
 
-        /* After the new task is switched in, update the global errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
-        {
-            FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
-        }
-        #endif
+                /* Before the currently running task is switched out, save its errno. */
+                #if ( configUSE_POSIX_ERRNO == 1 )
+                {
+                    pxCurrentTCBs[ xCoreID ]->iTaskErrno = FreeRTOS_errno;
+                }
+                #endif
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
-        {
-            /* Switch C-Runtime's TLS Block to point to the TLS
-             * Block specific to this task. */
-            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+                /* Select a new task to run. */
+                prvSelectHighestPriorityTask( xCoreID );
+                traceTASK_SWITCHED_IN();
+
+                #if ( configUSE_TASK_LATENCY_STATS == 1 )
+                {
+                    prvRecordTaskLatency( pxCurrentTCBs[ xCoreID ], ulTotalRunTime[ xCoreID ] );
+                }
+                #endif
+
+                /* After the new task is switched in, update the global errno. */
+                #if ( configUSE_POSIX_ERRNO == 1 )
+                {
+                    FreeRTOS_errno = pxCurrentTCBs[ xCoreID ]->iTaskErrno;
+                }
+                #endif
+
+                #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+                {
+                    /* Switch C-Runtime's TLS Block to point to the TLS
+                     * Block specific to this task. */
+                    configSET_TLS_BLOCK( pxCurrentTCBs[ xCoreID ]->xTLSBlock );
+                }
+                #endif
+            }
         }
-        #endif
+        portRELEASE_ISR_LOCK();
+        portRELEASE_TASK_LOCK();
     }
-}
+#endif /* if ( configNUMBER_OF_CORES == 1 ) */
 /*-----------------------------------------------------------*/
 
 void vTaskPlaceOnEventList( List_t * const pxEventList,
@@ -3166,6 +4713,71 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
 #endif /* configUSE_TIMERS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+    void vTaskPlaceOnPriorityEventList( PriorityEventList_t * const pxEventList,
+                                        const TickType_t xTicksToWait )
+    {
+        const UBaseType_t uxPriority = pxCurrentTCB->uxPriority;
+
+        configASSERT( pxEventList );
+
+        /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+         * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+        /* The task joins the end of the list of its priority, so tasks of equal
+         * priority are woken in the order they started waiting, as with
+         * vListInsert() on a single list.  No other waiting task is visited. */
+        listINSERT_END( &( pxEventList->xWaiters[ uxPriority ] ), &( pxCurrentTCB->xEventListItem ) );
+        pxEventList->uxWaitingPriorities |= ( ( UBaseType_t ) 1U << uxPriority );
+
+        prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+
+        void vTaskPlaceOnPriorityEventListRestricted( PriorityEventList_t * const pxEventList,
+                                                      TickType_t xTicksToWait,
+                                                      const BaseType_t xWaitIndefinitely )
+        {
+            const UBaseType_t uxPriority = pxCurrentTCB->uxPriority;
+
+            configASSERT( pxEventList );
+
+            /* See vTaskPlaceOnEventListRestricted(), it should be called with
+             * the scheduler suspended. */
+            listINSERT_END( &( pxEventList->xWaiters[ uxPriority ] ), &( pxCurrentTCB->xEventListItem ) );
+            pxEventList->uxWaitingPriorities |= ( ( UBaseType_t ) 1U << uxPriority );
+
+            if( xWaitIndefinitely != pdFALSE )
+            {
+                xTicksToWait = portMAX_DELAY;
+            }
+
+            traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
+            prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+        }
+
+    #endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskRemoveFromPriorityEventList( PriorityEventList_t * const pxEventList )
+    {
+        List_t * pxWaiters;
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION, see
+         * xTaskRemoveFromEventList().  The first task in the list of the
+         * highest waiting priority is the one to unblock. */
+        pxWaiters = pxListGetHighestPriorityWaiters( pxEventList );
+        configASSERT( pxWaiters );
+
+        return xTaskRemoveFromEventList( pxWaiters );
+    }
+
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+/*-----------------------------------------------------------*/
+
 BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
 {
     TCB_t * pxUnblockedTCB;
@@ -3214,21 +4826,43 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #if ( configNUMBER_OF_CORES == 1 )
     {
-        /* Return true if the task removed from the event list has a higher
-         * priority than the calling task.  This allows the calling task to know if
-         * it should force a context switch now. */
-        xReturn = pdTRUE;
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        {
+            /* Return true if the task removed from the event list has a higher
+             * priority than the calling task.  This allows the calling task to know if
+             * it should force a context switch now. */
+            xReturn = pdTRUE;
 
-        /* Mark that a yield is pending in case the user is not using the
-         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-        xYieldPending = pdTRUE;
+            /* Mark that a yield is pending in case the user is not using the
+             * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
     }
-    else
+    #else /* #if ( configNUMBER_OF_CORES == 1 ) */
     {
         xReturn = pdFALSE;
+
+        #if ( configUSE_PREEMPTION == 1 )
+        {
+            /* The unblocked task may preempt the task running on either core.
+             * Only report a required switch if it is the calling core that has
+             * to yield - the other core is signalled by prvYieldForTask(). */
+            prvYieldForTask( pxUnblockedTCB );
+
+            if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
+        }
+        #endif /* #if ( configUSE_PREEMPTION == 1 ) */
     }
+    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 
     return xReturn;
 }
@@ -3272,14 +4906,30 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
     listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
     prvAddTaskToReadyList( pxUnblockedTCB );
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        {
+            /* The unblocked task has a priority above that of the calling task, so
+             * a context switch is required.  This function is called with the
+             * scheduler suspended so xYieldPending is set so the context switch
+             * occurs immediately that the scheduler is resumed (unsuspended). */
+            xYieldPending = pdTRUE;
+        }
+    }
+    #else /* #if ( configNUMBER_OF_CORES == 1 ) */
     {
-        /* The unblocked task has a priority above that of the calling task, so
-         * a context switch is required.  This function is called with the
-         * scheduler suspended so xYieldPending is set so the context switch
-         * occurs immediately that the scheduler is resumed (unsuspended). */
-        xYieldPending = pdTRUE;
+        #if ( configUSE_PREEMPTION == 1 )
+        {
+            taskENTER_CRITICAL();
+            {
+                prvYieldForTask( pxUnblockedTCB );
+            }
+            taskEXIT_CRITICAL();
+        }
+        #endif
     }
+    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 }
 /*-----------------------------------------------------------*/
 
@@ -3437,6 +5087,15 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
      * any. */
     portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* The idle task may have been placed on a core before the scheduler
+         * had a chance to pick the highest priority task for it - give it
+         * that chance now. */
+        taskYIELD();
+    }
+    #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+
     for( ; ; )
     {
         /* See if any tasks have deleted themselves - if so then the idle task
@@ -3463,8 +5122,9 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
              * A critical region is not required here as we are just reading from
              * the list, and an occasional incorrect value will not matter.  If
              * the ready list at the idle priority contains more than one task
-             * then a task other than the idle task is ready to execute. */
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+             * per core then a task other than an idle task is ready to
+             * execute. */
+            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
             {
                 taskYIELD();
             }
@@ -3541,6 +5201,59 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+    /*
+     * The passive idle task runs on every core other than the one running the
+     * idle task.  It does not free deleted tasks, call the idle hook or enter
+     * low power mode - it only keeps the core busy until another task is ready.
+     */
+    static portTASK_FUNCTION( prvPassiveIdleTask, pvParameters )
+    {
+        ( void ) pvParameters;
+
+        taskYIELD();
+
+        for( ; ; )
+        {
+            #if ( configUSE_PREEMPTION == 0 )
+            {
+                /* If we are not using preemption we keep forcing a task switch to
+                 * see if any other task has become available. */
+                taskYIELD();
+            }
+            #endif /* configUSE_PREEMPTION */
+
+            #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+            {
+                /* See the comment in prvIdleTask(). */
+                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+                {
+                    taskYIELD();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+            #if ( configUSE_PASSIVE_IDLE_HOOK == 1 )
+            {
+                extern void vApplicationPassiveIdleHook( void );
+
+                /* Call the user defined function from within the passive idle
+                 * task.  Like the idle hook it MUST NOT CALL A FUNCTION THAT
+                 * MIGHT BLOCK. */
+                vApplicationPassiveIdleHook();
+            }
+            #endif /* configUSE_PASSIVE_IDLE_HOOK */
+        }
+    }
+
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TICKLESS_IDLE != 0 )
 
     eSleepModeStatus eTaskConfirmSleepModeStatus( void )
@@ -3698,16 +5411,58 @@ static void prvCheckTasksWaitingTermination( void )
          * being called too often in the idle task. */
         while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
         {
-            taskENTER_CRITICAL();
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                --uxCurrentNumberOfTasks;
-                --uxDeletedTasksWaitingCleanUp;
+                taskENTER_CRITICAL();
+                {
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    --uxCurrentNumberOfTasks;
+                    --uxDeletedTasksWaitingCleanUp;
+                }
+                taskEXIT_CRITICAL();
+
+                prvDeleteTCB( pxTCB );
             }
-            taskEXIT_CRITICAL();
+            #else /* #if( configNUMBER_OF_CORES == 1 ) */
+            {
+                pxTCB = NULL;
 
-            prvDeleteTCB( pxTCB );
+                taskENTER_CRITICAL();
+                {
+                    /* For SMP, multiple idles can be running simultaneously
+                     * and we need to check that other idles did not cleanup while we were
+                     * waiting to enter the critical section. */
+                    if( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+                    {
+                        pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                        /* A task that deleted itself may still be switching
+                         * out on the other core - leave it for the next pass. */
+                        if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+                        {
+                            ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                            --uxCurrentNumberOfTasks;
+                            --uxDeletedTasksWaitingCleanUp;
+                        }
+                        else
+                        {
+                            /* The TCB to be deleted still has not yet been switched out
+                             * by the scheduler, so we will just exit this loop early and
+                             * try again next time. */
+                            taskEXIT_CRITICAL();
+                            break;
+                        }
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( pxTCB != NULL )
+                {
+                    prvDeleteTCB( pxTCB );
+                }
+            }
+            #endif /* #if( configNUMBER_OF_CORES == 1 ) */
         }
     }
     #endif /* INCLUDE_vTaskDelete */
@@ -3761,7 +5516,11 @@ static void prvCheckTasksWaitingTermination( void )
          * state is just set to whatever is passed in. */
         if( eState != eInvalid )
         {
-            if( pxTCB == pxCurrentTCB )
+            #if ( configNUMBER_OF_CORES == 1 )
+                if( pxTCB == pxCurrentTCB )
+            #else
+                if( taskTASK_IS_RUNNING( pxTCB ) )
+            #endif
             {
                 pxTaskStatus->eCurrentState = eRunning;
             }
@@ -3804,24 +5563,59 @@ static void prvCheckTasksWaitingTermination( void )
             }
             #else
             {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
-            }
-            #endif
+                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+            }
+            #endif
+        }
+        else
+        {
+            pxTaskStatus->usStackHighWaterMark = 0;
+        }
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
+                                                     List_t * pxList,
+                                                     eTaskState eState )
+    {
+        configLIST_VOLATILE TCB_t * pxNextTCB;
+        configLIST_VOLATILE TCB_t * pxFirstTCB;
+        UBaseType_t uxTask = 0;
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            /* Populate an TaskStatus_t structure within the
+             * pxTaskStatusArray array for each task that is referenced from
+             * pxList.  See the definition of TaskStatus_t in task.h for the
+             * meaning of each TaskStatus_t structure member. */
+            do
+            {
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+                uxTask++;
+            } while( pxNextTCB != pxFirstTCB );
         }
         else
         {
-            pxTaskStatus->usStackHighWaterMark = 0;
+            mtCOVERAGE_TEST_MARKER();
         }
+
+        return uxTask;
     }
 
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configGENERATE_RUN_TIME_STATS == 1 ) )
 
-    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
-                                                     List_t * pxList,
-                                                     eTaskState eState )
+    static UBaseType_t prvListTaskRunTimesWithinSingleList( TaskRunTime_t * pxTaskRunTimeArray,
+                                                            List_t * pxList )
     {
         configLIST_VOLATILE TCB_t * pxNextTCB;
         configLIST_VOLATILE TCB_t * pxFirstTCB;
@@ -3831,14 +5625,12 @@ static void prvCheckTasksWaitingTermination( void )
         {
             listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-            /* Populate an TaskStatus_t structure within the
-             * pxTaskStatusArray array for each task that is referenced from
-             * pxList.  See the definition of TaskStatus_t in task.h for the
-             * meaning of each TaskStatus_t structure member. */
             do
             {
                 listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+                pxTaskRunTimeArray[ uxTask ].xHandle = ( TaskHandle_t ) pxNextTCB;
+                pxTaskRunTimeArray[ uxTask ].xTaskNumber = pxNextTCB->uxTCBNumber;
+                pxTaskRunTimeArray[ uxTask ].ulRunTimeCounter = pxNextTCB->ulRunTimeCounter;
                 uxTask++;
             } while( pxNextTCB != pxFirstTCB );
         }
@@ -3850,7 +5642,7 @@ static void prvCheckTasksWaitingTermination( void )
         return uxTask;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configGENERATE_RUN_TIME_STATS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
@@ -3950,6 +5742,9 @@ static void prvCheckTasksWaitingTermination( void )
          * want to allocate and clean RAM statically. */
         portCLEAN_UP_TCB( pxTCB );
 
+        /* The task no longer has an entry in the delayed task heap. */
+        taskDELAYED_TASK_HEAP_RELEASE();
+
         #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
         {
             /* Free up the memory allocated for the task's TLS Block. */
@@ -3962,7 +5757,7 @@ static void prvCheckTasksWaitingTermination( void )
             /* The task can only have been allocated dynamically - free both
              * the stack and TCB. */
             vPortFreeStack( pxTCB->pxStack );
-            vPortFree( pxTCB );
+            taskFREE_TCB( pxTCB );
         }
         #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
         {
@@ -3974,13 +5769,13 @@ static void prvCheckTasksWaitingTermination( void )
                 /* Both the stack and TCB were allocated dynamically, so both
                  * must be freed. */
                 vPortFreeStack( pxTCB->pxStack );
-                vPortFree( pxTCB );
+                taskFREE_TCB( pxTCB );
             }
             else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
             {
                 /* Only the stack was statically allocated, so the TCB is the
                  * only memory that must be freed. */
-                vPortFree( pxTCB );
+                taskFREE_TCB( pxTCB );
             }
             else
             {
@@ -3996,42 +5791,275 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+    static void prvResetNextTaskUnblockTime( void )
     {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
+        TickType_t xWakeTime;
+
+        if( uxDelayedTaskHeapLength == ( UBaseType_t ) 0U )
+        {
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            xWakeTime = xDelayedTaskHeap[ 0 ].xWakeTime;
+
+            if( ( xWakeTime < xTickCount ) && taskWAKES_BEFORE( xTickCount, xWakeTime ) )
+            {
+                /* The earliest wake time is after the tick count overflows,
+                 * xNextTaskUnblockTime is set again when it does. */
+                xNextTaskUnblockTime = portMAX_DELAY;
+            }
+            else
+            {
+                xNextTaskUnblockTime = xWakeTime;
+            }
+        }
     }
-    else
+/*-----------------------------------------------------------*/
+
+    static void prvDelayedTaskHeapPlace( UBaseType_t uxIndex,
+                                         TickType_t xWakeTime,
+                                         TCB_t * pxTCB )
+    {
+        UBaseType_t uxParent, uxChild;
+
+        /* Move the entries that wake later down until the parent wakes first. */
+        while( uxIndex > ( UBaseType_t ) 0U )
+        {
+            uxParent = ( uxIndex - ( UBaseType_t ) 1U ) / ( UBaseType_t ) 2U;
+
+            if( taskWAKES_BEFORE( xWakeTime, xDelayedTaskHeap[ uxParent ].xWakeTime ) == pdFALSE )
+            {
+                break;
+            }
+
+            xDelayedTaskHeap[ uxIndex ] = xDelayedTaskHeap[ uxParent ];
+            xDelayedTaskHeap[ uxIndex ].pxTCB->uxDelayedTaskHeapIndex = uxIndex + ( UBaseType_t ) 1U;
+            uxIndex = uxParent;
+        }
+
+        /* Then move the children that wake earlier up. */
+        for( ; ; )
+        {
+            uxChild = ( uxIndex * ( UBaseType_t ) 2U ) + ( UBaseType_t ) 1U;
+
+            if( uxChild >= uxDelayedTaskHeapLength )
+            {
+                break;
+            }
+
+            if( ( ( uxChild + ( UBaseType_t ) 1U ) < uxDelayedTaskHeapLength ) &&
+                ( taskWAKES_BEFORE( xDelayedTaskHeap[ uxChild + ( UBaseType_t ) 1U ].xWakeTime, xDelayedTaskHeap[ uxChild ].xWakeTime ) != pdFALSE ) )
+            {
+                uxChild++;
+            }
+
+            if( taskWAKES_BEFORE( xDelayedTaskHeap[ uxChild ].xWakeTime, xWakeTime ) == pdFALSE )
+            {
+                break;
+            }
+
+            xDelayedTaskHeap[ uxIndex ] = xDelayedTaskHeap[ uxChild ];
+            xDelayedTaskHeap[ uxIndex ].pxTCB->uxDelayedTaskHeapIndex = uxIndex + ( UBaseType_t ) 1U;
+            uxIndex = uxChild;
+        }
+
+        xDelayedTaskHeap[ uxIndex ].xWakeTime = xWakeTime;
+        xDelayedTaskHeap[ uxIndex ].pxTCB = pxTCB;
+        pxTCB->uxDelayedTaskHeapIndex = uxIndex + ( UBaseType_t ) 1U;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDelayedTaskHeapInsert( TCB_t * pxTCB,
+                                          TickType_t xWakeTime )
     {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        UBaseType_t uxIndex;
+
+        if( pxTCB->uxDelayedTaskHeapIndex == ( UBaseType_t ) 0U )
+        {
+            /* A task has at most one entry and no more tasks are created than
+             * the heap has entries, see prvDelayedTaskHeapReserve(). */
+            configASSERT( uxDelayedTaskHeapLength < ( UBaseType_t ) configDELAYED_TASK_HEAP_LENGTH );
+
+            uxIndex = uxDelayedTaskHeapLength;
+            uxDelayedTaskHeapLength++;
+        }
+        else
+        {
+            /* The task left the Blocked state early and its entry is still in
+             * the heap, give it the new wake time. */
+            uxIndex = pxTCB->uxDelayedTaskHeapIndex - ( UBaseType_t ) 1U;
+        }
+
+        prvDelayedTaskHeapPlace( uxIndex, xWakeTime, pxTCB );
     }
-}
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+    static void prvDelayedTaskHeapRemove( TCB_t * pxTCB )
+    {
+        UBaseType_t uxIndex = pxTCB->uxDelayedTaskHeapIndex - ( UBaseType_t ) 1U;
+
+        pxTCB->uxDelayedTaskHeapIndex = ( UBaseType_t ) 0U;
+        uxDelayedTaskHeapLength--;
+
+        /* The last entry fills the hole. */
+        if( uxIndex != uxDelayedTaskHeapLength )
+        {
+            prvDelayedTaskHeapPlace( uxIndex, xDelayedTaskHeap[ uxDelayedTaskHeapLength ].xWakeTime, xDelayedTaskHeap[ uxDelayedTaskHeapLength ].pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvDelayedTaskHeapTakeExpired( const TickType_t xConstTickCount )
+    {
+        TCB_t * pxTCB = NULL;
+
+        while( pxTCB == NULL )
+        {
+            if( uxDelayedTaskHeapLength == ( UBaseType_t ) 0U )
+            {
+                xNextTaskUnblockTime = portMAX_DELAY;
+                break;
+            }
+
+            if( taskWAKES_BEFORE( xConstTickCount, xDelayedTaskHeap[ 0 ].xWakeTime ) != pdFALSE )
+            {
+                /* It is not time to unblock the first task yet. */
+                prvResetNextTaskUnblockTime();
+                break;
+            }
+
+            pxTCB = xDelayedTaskHeap[ 0 ].pxTCB;
+            prvDelayedTaskHeapRemove( pxTCB );
+
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) ) != pxDelayedTaskList )
+            {
+                /* The task has already left the Blocked state, drop the
+                 * entry. */
+                pxTCB = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return pxTCB;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvDelayedTaskHeapReserve( void )
+    {
+        BaseType_t xReturn;
+
+        taskENTER_CRITICAL();
+        {
+            if( uxDelayedTaskHeapReserved < ( UBaseType_t ) configDELAYED_TASK_HEAP_LENGTH )
+            {
+                uxDelayedTaskHeapReserved++;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDelayedTaskHeapRelease( void )
+    {
+        taskENTER_CRITICAL();
+        {
+            configASSERT( uxDelayedTaskHeapReserved > ( UBaseType_t ) 0U );
+            uxDelayedTaskHeapReserved--;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#else /* configUSE_DELAYED_TASK_HEAP */
+
+    static void prvResetNextTaskUnblockTime( void )
+    {
+        if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+        {
+            /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+             * the maximum possible value so it is  extremely unlikely that the
+             * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+             * there is an item in the delayed list. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            /* The new current delayed list is not empty, get the value of
+             * the item at the head of the delayed list.  This is the time at
+             * which the task at the head of the delayed list should be removed
+             * from the Blocked state. */
+            xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        }
+    }
+
+#endif /* configUSE_DELAYED_TASK_HEAP */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES == 1 )
+    #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+
+        TaskHandle_t xTaskGetCurrentTaskHandle( void )
+        {
+            TaskHandle_t xReturn;
+
+            /* A critical section is not required as this is not called from
+             * an interrupt and the current TCB will always be the same for any
+             * individual execution thread. */
+            xReturn = pxCurrentTCB;
+
+            return xReturn;
+        }
 
+    #endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+#else /* #if ( configNUMBER_OF_CORES == 1 ) */
+
+    /* Always available as pxCurrentTCB resolves to this function in the SMP
+     * build. */
     TaskHandle_t xTaskGetCurrentTaskHandle( void )
     {
         TaskHandle_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* The task must not migrate to the other core between reading the
+         * core ID and reading that core's current TCB. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+    {
+        TaskHandle_t xReturn = NULL;
 
-        /* A critical section is not required as this is not called from
-         * an interrupt and the current TCB will always be the same for any
-         * individual execution thread. */
-        xReturn = pxCurrentTCB;
+        if( taskVALID_CORE_ID( xCoreID ) != pdFALSE )
+        {
+            xReturn = pxCurrentTCBs[ xCoreID ];
+        }
 
         return xReturn;
     }
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+#endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
@@ -4046,14 +6074,22 @@ static void prvResetNextTaskUnblockTime( void )
         }
         else
         {
-            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-            {
-                xReturn = taskSCHEDULER_RUNNING;
-            }
-            else
+            #if ( configNUMBER_OF_CORES > 1 )
+                taskENTER_CRITICAL();
+            #endif
             {
-                xReturn = taskSCHEDULER_SUSPENDED;
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    xReturn = taskSCHEDULER_RUNNING;
+                }
+                else
+                {
+                    xReturn = taskSCHEDULER_SUSPENDED;
+                }
             }
+            #if ( configNUMBER_OF_CORES > 1 )
+                taskEXIT_CRITICAL();
+            #endif
         }
 
         return xReturn;
@@ -4292,32 +6328,95 @@ static void prvResetNextTaskUnblockTime( void )
                         mtCOVERAGE_TEST_MARKER();
                     }
 
-                    /* If the running task is not the task that holds the mutex
-                     * then the task that holds the mutex could be in either the
-                     * Ready, Blocked or Suspended states.  Only remove the task
-                     * from its current state list if it is in the Ready state as
-                     * the task's priority is going to change and there is one
-                     * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
-                    {
-                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                        {
-                            /* It is known that the task is in its ready list so
-                             * there is no need to check again and the port level
-                             * reset macro can be called directly. */
-                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                    /* If the running task is not the task that holds the mutex
+                     * then the task that holds the mutex could be in either the
+                     * Ready, Blocked or Suspended states.  Only remove the task
+                     * from its current state list if it is in the Ready state as
+                     * the task's priority is going to change and there is one
+                     * Ready list per priority. */
+                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    {
+                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                        {
+                            /* It is known that the task is in its ready list so
+                             * there is no need to check again and the port level
+                             * reset macro can be called directly. */
+                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        prvAddTaskToReadyList( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+    void vTaskEnterCritical( void )
+    {
+        portDISABLE_INTERRUPTS();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            ( pxCurrentTCB->uxCriticalNesting )++;
+
+            /* This is not the interrupt safe version of the enter critical
+             * function so  assert() if it is being called from an interrupt
+             * context.  Only API functions that end in "FromISR" can be used in an
+             * interrupt.  Only assert if the critical nesting count is 1 to
+             * protect against recursive calls if the assert function also uses a
+             * critical section. */
+            if( pxCurrentTCB->uxCriticalNesting == 1 )
+            {
+                portASSERT_IF_IN_ISR();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
 
-                        prvAddTaskToReadyList( pxTCB );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+    void vTaskExitCritical( void )
+    {
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( pxCurrentTCB->uxCriticalNesting > 0U )
+            {
+                ( pxCurrentTCB->uxCriticalNesting )--;
+
+                if( pxCurrentTCB->uxCriticalNesting == 0U )
+                {
+                    portENABLE_INTERRUPTS();
                 }
                 else
                 {
@@ -4335,10 +6434,10 @@ static void prvResetNextTaskUnblockTime( void )
         }
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* portCRITICAL_NESTING_IN_TCB */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configNUMBER_OF_CORES > 1 )
 
     void vTaskEnterCritical( void )
     {
@@ -4346,7 +6445,13 @@ static void prvResetNextTaskUnblockTime( void )
 
         if( xSchedulerRunning != pdFALSE )
         {
-            ( pxCurrentTCB->uxCriticalNesting )++;
+            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+            {
+                portGET_TASK_LOCK();
+                portGET_ISR_LOCK();
+            }
+
+            portINCREMENT_CRITICAL_NESTING_COUNT();
 
             /* This is not the interrupt safe version of the enter critical
              * function so  assert() if it is being called from an interrupt
@@ -4354,9 +6459,18 @@ static void prvResetNextTaskUnblockTime( void )
              * interrupt.  Only assert if the critical nesting count is 1 to
              * protect against recursive calls if the assert function also uses a
              * critical section. */
-            if( pxCurrentTCB->uxCriticalNesting == 1 )
+            if( portGET_CRITICAL_NESTING_COUNT() == 1U )
             {
                 portASSERT_IF_IN_ISR();
+
+                if( uxSchedulerSuspended == 0U )
+                {
+                    /* The only time there would be a problem is if this is called
+                     * before a context switch and vTaskExitCritical() is called
+                     * after pxCurrentTCB changes.  Therefore this should not be
+                     * used within vTaskSwitchContext(). */
+                    prvCheckForRunStateChange();
+                }
             }
         }
         else
@@ -4365,22 +6479,74 @@ static void prvResetNextTaskUnblockTime( void )
         }
     }
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configNUMBER_OF_CORES > 1 )
+
+    UBaseType_t vTaskEnterCriticalFromISR( void )
+    {
+        UBaseType_t uxSavedInterruptStatus = 0;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+            {
+                portGET_ISR_LOCK();
+            }
+
+            portINCREMENT_CRITICAL_NESTING_COUNT();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxSavedInterruptStatus;
+    }
+
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
 
     void vTaskExitCritical( void )
     {
+        BaseType_t xYieldCurrentTask;
+
         if( xSchedulerRunning != pdFALSE )
         {
-            if( pxCurrentTCB->uxCriticalNesting > 0U )
+            /* If the critical nesting count is zero then this function
+             * does not match a previous call to vTaskEnterCritical(). */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+            /* This function should not be called in ISR.  Use vTaskExitCriticalFromISR
+             * to exit critical section from ISR. */
+            portASSERT_IF_IN_ISR();
+
+            if( portGET_CRITICAL_NESTING_COUNT() > 0U )
             {
-                ( pxCurrentTCB->uxCriticalNesting )--;
+                portDECREMENT_CRITICAL_NESTING_COUNT();
 
-                if( pxCurrentTCB->uxCriticalNesting == 0U )
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
                 {
+                    /* Get the xYieldPending status inside the critical section. */
+                    xYieldCurrentTask = xYieldPendings[ portGET_CORE_ID() ];
+
+                    portRELEASE_ISR_LOCK();
+                    portRELEASE_TASK_LOCK();
                     portENABLE_INTERRUPTS();
+
+                    /* When a task yields in a critical section it just sets
+                     * xYieldPending to true.  So now that we have exited the
+                     * critical section check if xYieldPending is true, and
+                     * if so yield. */
+                    if( xYieldCurrentTask != pdFALSE )
+                    {
+                        portYIELD();
+                    }
                 }
                 else
                 {
@@ -4398,7 +6564,45 @@ static void prvResetNextTaskUnblockTime( void )
         }
     }
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
+    {
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* If critical nesting count is zero then this function
+             * does not match a previous call to vTaskEnterCriticalFromISR(). */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+            if( portGET_CRITICAL_NESTING_COUNT() > 0U )
+            {
+                portDECREMENT_CRITICAL_NESTING_COUNT();
+
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    portRELEASE_ISR_LOCK();
+                    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
@@ -4943,16 +7147,24 @@ TickType_t uxTaskResetEventItemValue( void )
                 }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    taskYIELD_IF_USING_PREEMPTION();
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
-                else
+                #else /* #if ( configNUMBER_OF_CORES == 1 ) */
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
                 }
+                #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
             }
             else
             {
@@ -5004,7 +7216,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
         pxTCB = xTaskToNotify;
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             if( pulPreviousNotificationValue != NULL )
             {
@@ -5078,27 +7290,47 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    if( pxHigherPriorityTaskWoken != NULL )
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
                     {
-                        *pxHigherPriorityTaskWoken = pdTRUE;
-                    }
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
 
-                    /* Mark that a yield is pending in case the user is not
-                     * using the "xHigherPriorityTaskWoken" parameter to an ISR
-                     * safe FreeRTOS function. */
-                    xYieldPending = pdTRUE;
+                        /* Mark that a yield is pending in case the user is not
+                         * using the "xHigherPriorityTaskWoken" parameter to an ISR
+                         * safe FreeRTOS function. */
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
-                else
+                #else /* #if ( configNUMBER_OF_CORES == 1 ) */
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        prvYieldForTask( pxTCB );
+
+                        if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                        {
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                        }
+                    }
+                    #endif /* if ( configUSE_PREEMPTION == 1 ) */
                 }
+                #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xReturn;
     }
@@ -5139,7 +7371,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
         pxTCB = xTaskToNotify;
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
             pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
@@ -5169,27 +7401,47 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    if( pxHigherPriorityTaskWoken != NULL )
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
                     {
-                        *pxHigherPriorityTaskWoken = pdTRUE;
-                    }
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
 
-                    /* Mark that a yield is pending in case the user is not
-                     * using the "xHigherPriorityTaskWoken" parameter in an ISR
-                     * safe FreeRTOS function. */
-                    xYieldPending = pdTRUE;
+                        /* Mark that a yield is pending in case the user is not
+                         * using the "xHigherPriorityTaskWoken" parameter in an ISR
+                         * safe FreeRTOS function. */
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
-                else
+                #else /* #if ( configNUMBER_OF_CORES == 1 ) */
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        prvYieldForTask( pxTCB );
+
+                        if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                        {
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                        }
+                    }
+                    #endif /* if ( configUSE_PREEMPTION == 1 ) */
                 }
+                #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
     }
 
 #endif /* configUSE_TASK_NOTIFICATIONS */
@@ -5261,7 +7513,24 @@ TickType_t uxTaskResetEventItemValue( void )
 
     configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
     {
-        return xIdleTaskHandle->ulRunTimeCounter;
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            return xIdleTaskHandle->ulRunTimeCounter;
+        }
+        #else
+        {
+            configRUN_TIME_COUNTER_TYPE ulReturn = 0;
+            BaseType_t xCoreID;
+
+            /* Sum the time spent in the idle task of every core. */
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                ulReturn += xIdleTaskHandles[ xCoreID ]->ulRunTimeCounter;
+            }
+
+            return ulReturn;
+        }
+        #endif
     }
 
 #endif
@@ -5273,7 +7542,7 @@ TickType_t uxTaskResetEventItemValue( void )
     {
         configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
 
-        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE() * configNUMBER_OF_CORES;
 
         /* For percentage calculations. */
         ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
@@ -5281,7 +7550,7 @@ TickType_t uxTaskResetEventItemValue( void )
         /* Avoid divide by zero errors. */
         if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
         {
-            ulReturn = xIdleTaskHandle->ulRunTimeCounter / ulTotalTime;
+            ulReturn = ulTaskGetIdleRunTimeCounter() / ulTotalTime;
         }
         else
         {
@@ -5294,6 +7563,143 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_LATENCY_STATS == 1 )
+
+    static void prvRecordTaskLatency( TCB_t * pxTCB,
+                                      configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        configRUN_TIME_COUNTER_TYPE ulLatency, ulRemaining;
+        UBaseType_t uxBucket = 0;
+
+        if( pxTCB->xLatencyPending != pdFALSE )
+        {
+            pxTCB->xLatencyPending = pdFALSE;
+
+            /* The same guard as the run time statistics, against counters
+             * that go backwards. */
+            if( ulNow > pxTCB->ulReadyTime )
+            {
+                ulLatency = ulNow - pxTCB->ulReadyTime;
+            }
+            else
+            {
+                ulLatency = 0;
+            }
+
+            /* Bucket 0 holds the zero latencies, bucket n the latencies from
+             * 2^(n-1) to 2^n - 1, and the last bucket everything longer. */
+            for( ulRemaining = ulLatency; ( ulRemaining != 0 ) && ( uxBucket < ( UBaseType_t ) ( configTASK_LATENCY_BUCKETS - 1 ) ); ulRemaining >>= 1 )
+            {
+                uxBucket++;
+            }
+
+            pxTCB->ulLatencyHistogram[ uxBucket ]++;
+            pxTCB->ulLatencyCount++;
+            pxTCB->ulTotalLatency += ulLatency;
+
+            if( ulLatency > pxTCB->ulMaxLatency )
+            {
+                pxTCB->ulMaxLatency = ulLatency;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetLatencyStats( TaskHandle_t xTask,
+                               TaskLatencyStats_t * pxLatencyStats )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxBucket;
+
+        configASSERT( pxLatencyStats );
+
+        /* The statistics are updated by the context switch, so they are copied
+         * with it held off to keep them consistent with each other. */
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxLatencyStats->ulCount = pxTCB->ulLatencyCount;
+            pxLatencyStats->ulTotalLatency = pxTCB->ulTotalLatency;
+            pxLatencyStats->ulMaxLatency = pxTCB->ulMaxLatency;
+
+            for( uxBucket = 0; uxBucket < ( UBaseType_t ) configTASK_LATENCY_BUCKETS; uxBucket++ )
+            {
+                pxLatencyStats->ulHistogram[ uxBucket ] = pxTCB->ulLatencyHistogram[ uxBucket ];
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskStartLatencyStats( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow;
+        const ListItem_t * pxListItem;
+        const ListItem_t * pxListEnd;
+        TCB_t * pxTCB;
+        UBaseType_t uxPriority;
+
+        /* The ready times of the tasks created before the scheduler started
+         * were read before portCONFIGURE_TIMER_FOR_RUN_TIME_STATS(). */
+        taskREAD_RUN_TIME_COUNTER( ulNow );
+
+        for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+        {
+            pxListEnd = listGET_END_MARKER( &( pxReadyTasksLists[ uxPriority ] ) );
+
+            for( pxListItem = listGET_HEAD_ENTRY( &( pxReadyTasksLists[ uxPriority ] ) ); pxListItem != pxListEnd; pxListItem = listGET_NEXT( pxListItem ) )
+            {
+                pxTCB = listGET_LIST_ITEM_OWNER( pxListItem );
+
+                /* The port starts the current task of each core directly, it
+                 * never waited for a switch in. */
+                if( taskLATENCY_IS_RUNNING( pxTCB ) )
+                {
+                    pxTCB->xLatencyPending = pdFALSE;
+                }
+                else
+                {
+                    pxTCB->ulReadyTime = ulNow;
+                    pxTCB->xLatencyPending = pdTRUE;
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskResetLatencyStats( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxBucket;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxTCB->ulLatencyCount = 0;
+            pxTCB->ulTotalLatency = 0;
+            pxTCB->ulMaxLatency = 0;
+
+            for( uxBucket = 0; uxBucket < ( UBaseType_t ) configTASK_LATENCY_BUCKETS; uxBucket++ )
+            {
+                pxTCB->ulLatencyHistogram[ uxBucket ] = 0;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_TASK_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely )
 {
@@ -5345,13 +7751,13 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             {
                 /* Wake time has overflowed.  Place this item in the overflow
                  * list. */
-                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                taskINSERT_DELAYED_TASK( pxOverflowDelayedTaskList, pxCurrentTCB );
             }
             else
             {
                 /* The wake time has not overflowed, so the current block list
                  * is used. */
-                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                taskINSERT_DELAYED_TASK( pxDelayedTaskList, pxCurrentTCB );
 
                 /* If the task entering the blocked state was placed at the
                  * head of the list of blocked tasks then xNextTaskUnblockTime
@@ -5380,12 +7786,12 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         if( xTimeToWake < xConstTickCount )
         {
             /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            taskINSERT_DELAYED_TASK( pxOverflowDelayedTaskList, pxCurrentTCB );
         }
         else
         {
             /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            taskINSERT_DELAYED_TASK( pxDelayedTaskList, pxCurrentTCB );
 
             /* If the task entering the blocked state was placed at the head of the
              * list of blocked tasks then xNextTaskUnblockTime needs to be updated
@@ -39,6 +39,10 @@
 #include "queue.h"
 #include "timers.h"
 
+#if ( configUSE_OBJECT_POOLS == 1 )
+    #include "object_pool.h"
+#endif
+
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
     #error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
 #endif
@@ -70,6 +74,19 @@
     #define tmrSTATUS_IS_ACTIVE                  ( ( uint8_t ) 0x01 )
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
+    #define tmrSTATUS_IS_ISR_CONTEXT             ( ( uint8_t ) 0x08 )
+
+/* Geometry of the timing wheel.  Each level has 32 slots, a slot of level n
+ * covers 32^n ticks so a level covers the range of one slot of the level above
+ * it. */
+    #if ( configUSE_TIMER_WHEEL == 1 )
+        #define tmrWHEEL_SLOT_BITS                ( 5U )
+        #define tmrWHEEL_SLOTS                    ( ( UBaseType_t ) 1U << tmrWHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOT_MASK                ( tmrWHEEL_SLOTS - ( UBaseType_t ) 1U )
+        #define tmrWHEEL_LEVEL_SHIFT( uxLevel )   ( ( uxLevel ) * tmrWHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOT_TICKS( uxLevel )    ( ( TickType_t ) ( ( TickType_t ) 1U << tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) )
+        #define tmrWHEEL_FIRST_SLOT( ulSlots )    ( ( UBaseType_t ) __builtin_ctz( ( unsigned int ) ( ulSlots ) ) )
+    #endif
 
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                  /* The old naming convention is used to prevent breaking kernel aware debuggers. */
@@ -82,6 +99,11 @@
         #if ( configUSE_TRACE_FACILITY == 1 )
             UBaseType_t uxTimerNumber;              /*<< An ID assigned by trace tools such as FreeRTOS+Trace */
         #endif
+        #if ( configUSE_ISR_TIMERS == 1 )
+            configRUN_TIME_COUNTER_TYPE xCallbackBudget;  /*<< The longest time the callback of an ISR context timer is expected to take. */
+            configRUN_TIME_COUNTER_TYPE xLongestCallback; /*<< The longest time the callback of an ISR context timer has taken. */
+            UBaseType_t uxBudgetOverruns;                 /*<< The number of times the callback of an ISR context timer took longer than its budget. */
+        #endif
         uint8_t ucStatus;                           /*<< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
     } xTIMER;
 
@@ -89,6 +111,16 @@
  * name below to enable the use of older kernel aware debuggers. */
     typedef xTIMER Timer_t;
 
+/* The timers created dynamically are taken from a fixed size pool when
+ * configUSE_OBJECT_POOLS is 1. */
+    #if ( configUSE_OBJECT_POOLS == 1 )
+        #define timerALLOCATE_TIMER()         ( ( Timer_t * ) pvObjectPoolAllocate( eObjectPoolTimer, sizeof( Timer_t ) ) )
+        #define timerFREE_TIMER( pxTimer )    vObjectPoolFree( eObjectPoolTimer, ( pxTimer ) )
+    #else
+        #define timerALLOCATE_TIMER()         ( ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) ) )
+        #define timerFREE_TIMER( pxTimer )    vPortFree( pxTimer )
+    #endif
+
 /* The definition of messages that can be sent and received on the timer queue.
  * Two types of message can be queued - messages that manipulate a software timer,
  * and messages that request the execution of a non-timer related callback.  The
@@ -134,10 +166,50 @@
  * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
  * breaks some kernel aware debuggers, and debuggers that reply on removing the
  * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
-    PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
-    PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* The timing wheel in which active timers are stored when configUSE_TIMER_WHEEL
+ * is 1.  A timer is placed in the lowest level that covers its expiry time, in
+ * the slot selected by the bits of the expiry time for that level, so the
+ * timers in a slot of level 0 all expire on the same tick.  When a level wraps
+ * the timers in the next slot of the level above are moved down.  Timers that
+ * are too far away for the wheel wait in xTimerWheelOverflow.  A bit is set in
+ * ulTimerWheelOccupied for each slot that holds a timer, and xTimerWheelTime is
+ * the next tick the wheel has to process.  Only the timer service task is
+ * allowed to access the wheel. */
+        PRIVILEGED_DATA static List_t xTimerWheel[ configTIMER_WHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+        PRIVILEGED_DATA static List_t xTimerWheelOverflow;
+        PRIVILEGED_DATA static uint32_t ulTimerWheelOccupied[ configTIMER_WHEEL_LEVELS ];
+        PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+
+/* The wheel only advances on tick differences, a time is reached once the wheel
+ * would have to process it to catch up with xTimeNow. */
+        #define tmrEXPIRE_TIME_REACHED( xExpireTime, xTimeNow )    ( ( TickType_t ) ( ( xExpireTime ) - xTimerWheelTime ) < ( TickType_t ) ( ( xTimeNow ) + 1U - xTimerWheelTime ) )
+
+    #else /* configUSE_TIMER_WHEEL */
+
+        PRIVILEGED_DATA static List_t xActiveTimerList1;
+        PRIVILEGED_DATA static List_t xActiveTimerList2;
+        PRIVILEGED_DATA static List_t * pxCurrentTimerList;
+        PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+
+        #define tmrEXPIRE_TIME_REACHED( xExpireTime, xTimeNow )    ( ( xExpireTime ) <= ( xTimeNow ) )
+
+    #endif /* configUSE_TIMER_WHEEL */
+
+    #if ( configUSE_ISR_TIMERS == 1 )
+
+/* The lists in which active ISR context timers are stored, in expiry time
+ * order.  As for the delayed task lists the timers whose expiry time has
+ * overflowed the tick count are kept in the second list, the lists are switched
+ * when the tick count overflows.  The lists are accessed from the tick
+ * interrupt so they are only ever accessed from within a critical section. */
+        PRIVILEGED_DATA static List_t xISRTimerList1;
+        PRIVILEGED_DATA static List_t xISRTimerList2;
+        PRIVILEGED_DATA static List_t * pxCurrentISRTimerList = NULL;
+        PRIVILEGED_DATA static List_t * pxOverflowISRTimerList = NULL;
+
+    #endif /* configUSE_ISR_TIMERS */
 
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -168,7 +240,8 @@
 
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * depending on if the expire time causes a timer counter overflow.  When
+ * configUSE_TIMER_WHEEL is 1 the timer is inserted into the timing wheel.
  */
     static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
                                                   const TickType_t xNextExpiryTime,
@@ -191,11 +264,75 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
+/*
+ * Remove an active timer from the list or the wheel slot that holds it.
+ */
+    static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Place a timer, whose list item value already holds its expiry time, in the
+ * slot of the timing wheel that covers that time.
+ */
+        static void prvInsertTimerInWheel( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert all the timers referenced from pxList into the wheel again, relative
+ * to the current wheel time.  Used to move a slot down one level.
+ */
+        static void prvCascadeTimerWheelList( List_t * const pxList ) PRIVILEGED_FUNCTION;
+
+/*
+ * Process the tick xTimerWheelTime: move the higher level slots that start on
+ * this tick down, then expire all the timers of the level 0 slot of the tick.
+ */
+        static void prvProcessTimerWheelTick( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the number of ticks from xTimerWheelTime to the first tick at which a
+ * slot of the wheel has to be processed, or tmrMAX_TIME_BEFORE_OVERFLOW if the
+ * wheel is empty.
+ */
+        static TickType_t prvGetTicksToNextWheelEvent( void ) PRIVILEGED_FUNCTION;
+
+    #else /* configUSE_TIMER_WHEEL */
+
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
  * current timer list does not still reference some timers.
  */
-    static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+        static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_WHEEL */
+
+    #if ( configUSE_ISR_TIMERS == 1 )
+
+/*
+ * Apply a command to an ISR context timer.  ISR context timers are not handled
+ * by the timer service task, their lists are updated from within a critical
+ * section instead.
+ */
+        static BaseType_t prvProcessISRTimerCommand( Timer_t * const pxTimer,
+                                                     const BaseType_t xCommandID,
+                                                     const TickType_t xOptionalValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert an ISR context timer into the current or the overflow ISR timer list,
+ * depending on if the expiry time has overflowed the tick count.  Must be called
+ * from within a critical section.
+ */
+        static void prvInsertTimerInISRList( Timer_t * const pxTimer,
+                                             const TickType_t xNextExpiryTime,
+                                             const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Call the callback of an ISR context timer, time it and record it against the
+ * budget of the timer.
+ */
+        static void prvCallISRTimerCallback( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_ISR_TIMERS */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -293,7 +430,7 @@
         {
             Timer_t * pxNewTimer;
 
-            pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of Timer_t is always a pointer to the timer's mame. */
+            pxNewTimer = timerALLOCATE_TIMER(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of Timer_t is always a pointer to the timer's mame. */
 
             if( pxNewTimer != NULL )
             {
@@ -374,6 +511,14 @@
         pxNewTimer->pxCallbackFunction = pxCallbackFunction;
         vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
 
+        #if ( configUSE_ISR_TIMERS == 1 )
+        {
+            pxNewTimer->xCallbackBudget = 0;
+            pxNewTimer->xLongestCallback = 0;
+            pxNewTimer->uxBudgetOverruns = 0;
+        }
+        #endif
+
         if( xAutoReload != pdFALSE )
         {
             pxNewTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
@@ -394,6 +539,18 @@
 
         configASSERT( xTimer );
 
+        #if ( configUSE_ISR_TIMERS == 1 )
+            if( ( ( ( Timer_t * ) xTimer )->ucStatus & tmrSTATUS_IS_ISR_CONTEXT ) != 0U )
+            {
+                /* The timer is run from the tick interrupt, there is no need to
+                 * go through the timer service task. */
+                xReturn = prvProcessISRTimerCommand( xTimer, xCommandID, xOptionalValue );
+
+                traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
+            }
+            else
+        #endif /* configUSE_ISR_TIMERS */
+
         /* Send a message to the timer service task to perform a particular action
          * on a particular timer definition. */
         if( xTimerQueue != NULL )
@@ -430,6 +587,315 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_ISR_TIMERS == 1 )
+
+        static BaseType_t prvProcessISRTimerCommand( Timer_t * const pxTimer,
+                                                     const BaseType_t xCommandID,
+                                                     const TickType_t xOptionalValue )
+        {
+            TickType_t xTimeNow;
+            UBaseType_t uxSavedInterruptStatus = 0U;
+
+            if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+            {
+                taskENTER_CRITICAL();
+                xTimeNow = xTaskGetTickCount();
+            }
+            else
+            {
+                uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+                xTimeNow = xTaskGetTickCountFromISR();
+            }
+
+            {
+                if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+                {
+                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xOptionalValue );
+
+                switch( xCommandID )
+                {
+                    case tmrCOMMAND_START:
+                    case tmrCOMMAND_START_FROM_ISR:
+                    case tmrCOMMAND_RESET:
+                    case tmrCOMMAND_RESET_FROM_ISR:
+                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+
+                        /* The command time was sampled before the critical
+                         * section was entered.  If the timer would have expired
+                         * since then it expires on the next tick. */
+                        if( ( ( TickType_t ) ( xTimeNow - xOptionalValue ) ) >= pxTimer->xTimerPeriodInTicks )
+                        {
+                            prvInsertTimerInISRList( pxTimer, xTimeNow + ( TickType_t ) 1U, xTimeNow );
+                        }
+                        else
+                        {
+                            prvInsertTimerInISRList( pxTimer, xOptionalValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
+                        }
+
+                        break;
+
+                    case tmrCOMMAND_CHANGE_PERIOD:
+                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                        pxTimer->xTimerPeriodInTicks = xOptionalValue;
+                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+                        prvInsertTimerInISRList( pxTimer, xTimeNow + pxTimer->xTimerPeriodInTicks, xTimeNow );
+                        break;
+
+                    case tmrCOMMAND_STOP:
+                    case tmrCOMMAND_STOP_FROM_ISR:
+                    case tmrCOMMAND_DELETE:
+                        /* The timer has already been removed from the list. */
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        break;
+
+                    default:
+                        /* Don't expect to get here. */
+                        break;
+                }
+            }
+
+            if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+            {
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+            }
+
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                /* The timer is no longer referenced from the tick interrupt, the
+                 * memory can be freed outside of the critical section. */
+                if( ( xCommandID == tmrCOMMAND_DELETE ) && ( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 ) )
+                {
+                    timerFREE_TIMER( pxTimer );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+            return pdPASS;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvInsertTimerInISRList( Timer_t * const pxTimer,
+                                             const TickType_t xNextExpiryTime,
+                                             const TickType_t xTimeNow )
+        {
+            listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+            listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+            if( xNextExpiryTime < xTimeNow )
+            {
+                /* The expiry time has overflowed. */
+                vListInsert( pxOverflowISRTimerList, &( pxTimer->xTimerListItem ) );
+            }
+            else
+            {
+                vListInsert( pxCurrentISRTimerList, &( pxTimer->xTimerListItem ) );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvCallISRTimerCallback( Timer_t * const pxTimer )
+        {
+            configRUN_TIME_COUNTER_TYPE xCallbackStart;
+            configRUN_TIME_COUNTER_TYPE xCallbackTime;
+
+            traceTIMER_EXPIRED( pxTimer );
+            xCallbackStart = portGET_RUN_TIME_COUNTER_VALUE();
+            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+            xCallbackTime = portGET_RUN_TIME_COUNTER_VALUE() - xCallbackStart;
+
+            if( xCallbackTime > pxTimer->xLongestCallback )
+            {
+                pxTimer->xLongestCallback = xCallbackTime;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xCallbackTime > pxTimer->xCallbackBudget )
+            {
+                ( pxTimer->uxBudgetOverruns )++;
+                traceTIMER_BUDGET_EXCEEDED( pxTimer, xCallbackTime );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        void vTimerProcessISRTimers( const TickType_t xTickCount )
+        {
+            Timer_t * pxTimer;
+            List_t * pxTemp;
+            TickType_t xExpiryTime;
+            UBaseType_t uxMissedPeriods;
+
+            /* The lists only exist once the first timer has been created. */
+            if( pxCurrentISRTimerList != NULL )
+            {
+                if( xTickCount == ( TickType_t ) 0U )
+                {
+                    /* The tick count has overflowed.  Every tick is processed so
+                     * the timers of the current list have all expired by now. */
+                    configASSERT( ( listLIST_IS_EMPTY( pxCurrentISRTimerList ) ) );
+                    pxTemp = pxCurrentISRTimerList;
+                    pxCurrentISRTimerList = pxOverflowISRTimerList;
+                    pxOverflowISRTimerList = pxTemp;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                while( listLIST_IS_EMPTY( pxCurrentISRTimerList ) == pdFALSE )
+                {
+                    xExpiryTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentISRTimerList );
+
+                    if( xExpiryTime > xTickCount )
+                    {
+                        /* The timers are in expiry time order, no other timer
+                         * expires on this tick. */
+                        break;
+                    }
+
+                    pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentISRTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+                    uxMissedPeriods = ( UBaseType_t ) 0U;
+
+                    /* The next expiry time follows on from this one so an
+                     * auto-reload timer does not drift.  As in prvReloadTimer()
+                     * a timer that is late by whole periods, because ticks were
+                     * stepped over, is called once for every period it missed
+                     * and carries on from the last one. */
+                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+                    {
+                        while( ( ( TickType_t ) ( xTickCount - xExpiryTime ) ) >= pxTimer->xTimerPeriodInTicks )
+                        {
+                            xExpiryTime += pxTimer->xTimerPeriodInTicks;
+                            uxMissedPeriods++;
+                        }
+
+                        prvInsertTimerInISRList( pxTimer, xExpiryTime + pxTimer->xTimerPeriodInTicks, xTickCount );
+                    }
+                    else
+                    {
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+
+                    /* Call the timer callback and check it kept to its budget.
+                     * The calls for the missed periods stop if a callback stops
+                     * the timer. */
+                    prvCallISRTimerCallback( pxTimer );
+
+                    while( ( uxMissedPeriods > ( UBaseType_t ) 0U ) && ( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) != 0U ) )
+                    {
+                        uxMissedPeriods--;
+                        prvCallISRTimerCallback( pxTimer );
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        TickType_t xTimerGetTicksToNextISRTimer( const TickType_t xTickCount )
+        {
+            TickType_t xReturn = portMAX_DELAY;
+            UBaseType_t uxSavedInterruptStatus;
+
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                /* The expiry times of the overflow list are past the tick
+                 * count overflow, the unsigned difference accounts for it. */
+                if( pxCurrentISRTimerList == NULL )
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+                else if( listLIST_IS_EMPTY( pxCurrentISRTimerList ) == pdFALSE )
+                {
+                    xReturn = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentISRTimerList ) - xTickCount;
+                }
+                else if( listLIST_IS_EMPTY( pxOverflowISRTimerList ) == pdFALSE )
+                {
+                    xReturn = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxOverflowISRTimerList ) - xTickCount;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        void vTimerSetISRContext( TimerHandle_t xTimer,
+                                  const configRUN_TIME_COUNTER_TYPE xCallbackBudget )
+        {
+            Timer_t * pxTimer = xTimer;
+
+            configASSERT( xTimer );
+
+            taskENTER_CRITICAL();
+            {
+                /* An active timer is held by the timer service task, the timer
+                 * can only be moved while it is dormant.  The commands still
+                 * waiting in the timer queue are applied to the lists of the tick
+                 * interrupt once the timer service task receives them. */
+                configASSERT( ( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0U ) );
+
+                pxTimer->ucStatus |= tmrSTATUS_IS_ISR_CONTEXT;
+                pxTimer->xCallbackBudget = xCallbackBudget;
+                pxTimer->xLongestCallback = 0;
+                pxTimer->uxBudgetOverruns = 0;
+            }
+            taskEXIT_CRITICAL();
+        }
+/*-----------------------------------------------------------*/
+
+        void vTimerGetISRCallbackStats( TimerHandle_t xTimer,
+                                        configRUN_TIME_COUNTER_TYPE * const pxLongestCallback,
+                                        UBaseType_t * const puxBudgetOverruns )
+        {
+            Timer_t * pxTimer = xTimer;
+
+            configASSERT( xTimer );
+            configASSERT( pxLongestCallback );
+            configASSERT( puxBudgetOverruns );
+
+            taskENTER_CRITICAL();
+            {
+                *pxLongestCallback = pxTimer->xLongestCallback;
+                *puxBudgetOverruns = pxTimer->uxBudgetOverruns;
+            }
+            taskEXIT_CRITICAL();
+        }
+
+    #endif /* configUSE_ISR_TIMERS */
+/*-----------------------------------------------------------*/
+
     TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
     {
         /* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
@@ -538,6 +1004,41 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
+                                            const TickType_t xTimeNow )
+        {
+            /* The number of ticks the wheel is behind, xTimeNow included. */
+            TickType_t xTicksToProcess = ( TickType_t ) ( xTimeNow - xTimerWheelTime ) + ( TickType_t ) 1U;
+            TickType_t xTicksToNextEvent;
+
+            ( void ) xNextExpireTime;
+
+            /* Catch the wheel up with xTimeNow.  The ticks on which no slot has
+             * to be processed are skipped in one step, every other tick expires
+             * the timers of one slot as a batch. */
+            while( xTicksToProcess > ( TickType_t ) 0U )
+            {
+                xTicksToNextEvent = prvGetTicksToNextWheelEvent();
+
+                if( xTicksToNextEvent >= xTicksToProcess )
+                {
+                    xTimerWheelTime += xTicksToProcess;
+                    xTicksToProcess = ( TickType_t ) 0U;
+                }
+                else
+                {
+                    xTimerWheelTime += xTicksToNextEvent;
+                    prvProcessTimerWheelTick( xTimeNow );
+                    xTimerWheelTime++;
+                    xTicksToProcess -= ( xTicksToNextEvent + ( TickType_t ) 1U );
+                }
+            }
+        }
+
+    #else /* configUSE_TIMER_WHEEL */
+
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow )
     {
@@ -563,6 +1064,8 @@
         traceTIMER_EXPIRED( pxTimer );
         pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
     }
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static portTASK_FUNCTION( prvTimerTask, pvParameters )
@@ -619,7 +1122,7 @@
             if( xTimerListsWereSwitched == pdFALSE )
             {
                 /* The tick count has not overflowed, has the timer expired? */
-                if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+                if( ( xListWasEmpty == pdFALSE ) && ( tmrEXPIRE_TIME_REACHED( xNextExpireTime, xTimeNow ) ) )
                 {
                     ( void ) xTaskResumeAll();
                     prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
@@ -632,12 +1135,16 @@
                      * received - whichever comes first.  The following line cannot
                      * be reached unless xNextExpireTime > xTimeNow, except in the
                      * case when the current timer list is empty. */
-                    if( xListWasEmpty != pdFALSE )
+                    #if ( configUSE_TIMER_WHEEL == 0 )
                     {
-                        /* The current timer list is empty - is the overflow list
-                         * also empty? */
-                        xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        if( xListWasEmpty != pdFALSE )
+                        {
+                            /* The current timer list is empty - is the overflow list
+                             * also empty? */
+                            xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        }
                     }
+                    #endif /* configUSE_TIMER_WHEEL */
 
                     vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
 
@@ -667,24 +1174,47 @@
     {
         TickType_t xNextExpireTime;
 
-        /* Timers are listed in expiry time order, with the head of the list
-         * referencing the task that will expire first.  Obtain the time at which
-         * the timer with the nearest expiry time will expire.  If there are no
-         * active timers then just set the next expire time to 0.  That will cause
-         * this task to unblock when the tick count overflows, at which point the
-         * timer lists will be switched and the next expiry time can be
-         * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-
-        if( *pxListWasEmpty == pdFALSE )
+        #if ( configUSE_TIMER_WHEEL == 1 )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            /* The wheel is processed up to the first tick on which a slot has
+             * to be expired or moved down.  No timer may have expired by then
+             * when a slot is only moved down, in which case the task simply
+             * blocks again. */
+            const TickType_t xTicksToNextEvent = prvGetTicksToNextWheelEvent();
+
+            if( xTicksToNextEvent != tmrMAX_TIME_BEFORE_OVERFLOW )
+            {
+                *pxListWasEmpty = pdFALSE;
+                xNextExpireTime = xTimerWheelTime + xTicksToNextEvent;
+            }
+            else
+            {
+                *pxListWasEmpty = pdTRUE;
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
         }
-        else
+        #else /* configUSE_TIMER_WHEEL */
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            /* Timers are listed in expiry time order, with the head of the list
+             * referencing the task that will expire first.  Obtain the time at which
+             * the timer with the nearest expiry time will expire.  If there are no
+             * active timers then just set the next expire time to 0.  That will cause
+             * this task to unblock when the tick count overflows, at which point the
+             * timer lists will be switched and the next expiry time can be
+             * re-assessed.  */
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
         }
+        #endif /* configUSE_TIMER_WHEEL */
 
         return xNextExpireTime;
     }
@@ -693,21 +1223,42 @@
     static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
     {
         TickType_t xTimeNow;
-        PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
         xTimeNow = xTaskGetTickCount();
 
-        if( xTimeNow < xLastTime )
-        {
-            prvSwitchTimerLists();
-            *pxTimerListsWereSwitched = pdTRUE;
-        }
-        else
+        #if ( configUSE_TIMER_WHEEL == 1 )
         {
+            /* The wheel works on tick differences, an overflow of the tick count
+             * needs no special handling.  An empty wheel is moved up to the
+             * current time so it never falls more than a tick range behind. */
+            if( prvGetTicksToNextWheelEvent() == tmrMAX_TIME_BEFORE_OVERFLOW )
+            {
+                xTimerWheelTime = xTimeNow + ( TickType_t ) 1U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
             *pxTimerListsWereSwitched = pdFALSE;
         }
+        #else /* configUSE_TIMER_WHEEL */
+        {
+            PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
+
+            if( xTimeNow < xLastTime )
+            {
+                prvSwitchTimerLists();
+                *pxTimerListsWereSwitched = pdTRUE;
+            }
+            else
+            {
+                *pxTimerListsWereSwitched = pdFALSE;
+            }
 
-        xLastTime = xTimeNow;
+            xLastTime = xTimeNow;
+        }
+        #endif /* configUSE_TIMER_WHEEL */
 
         return xTimeNow;
     }
@@ -723,6 +1274,21 @@
         listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
         listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            /* Tick differences are compared so the check also holds when the
+             * tick count overflowed since the command was issued. */
+            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= ( ( TickType_t ) ( xNextExpiryTime - xCommandTime ) ) )
+            {
+                /* The expiry time has already been reached. */
+                xProcessTimerNow = pdTRUE;
+            }
+            else
+            {
+                prvInsertTimerInWheel( pxTimer );
+            }
+        }
+        #else /* configUSE_TIMER_WHEEL */
         if( xNextExpiryTime <= xTimeNow )
         {
             /* Has the expiry time elapsed between the command to start/reset a
@@ -752,11 +1318,200 @@
                 vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
             }
         }
+        #endif /* configUSE_TIMER_WHEEL */
 
         return xProcessTimerNow;
     }
 /*-----------------------------------------------------------*/
 
+    static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer )
+    {
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            List_t * const pxList = listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) );
+            UBaseType_t uxSlot;
+
+            if( ( uxListRemove( &( pxTimer->xTimerListItem ) ) == ( UBaseType_t ) 0 ) && ( pxList != &xTimerWheelOverflow ) )
+            {
+                /* The slot is empty now, the searches for the next slot to
+                 * process can skip it. */
+                uxSlot = ( UBaseType_t ) ( pxList - &( xTimerWheel[ 0 ][ 0 ] ) );
+                ulTimerWheelOccupied[ uxSlot / tmrWHEEL_SLOTS ] &= ~( ( uint32_t ) 1U << ( uxSlot & tmrWHEEL_SLOT_MASK ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* configUSE_TIMER_WHEEL */
+        {
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+        }
+        #endif /* configUSE_TIMER_WHEEL */
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvInsertTimerInWheel( Timer_t * const pxTimer )
+        {
+            const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+            const TickType_t xTicksToExpiry = ( TickType_t ) ( xExpiryTime - xTimerWheelTime );
+            UBaseType_t uxLevel = 0U;
+            UBaseType_t uxSlot;
+
+            /* Find the lowest level whose range covers the expiry time. */
+            while( ( uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS ) && ( xTicksToExpiry >= tmrWHEEL_SLOT_TICKS( uxLevel + 1U ) ) )
+            {
+                uxLevel++;
+            }
+
+            if( uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS )
+            {
+                uxSlot = ( UBaseType_t ) ( xExpiryTime >> tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK;
+                vListInsertEnd( &( xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+                ulTimerWheelOccupied[ uxLevel ] |= ( ( uint32_t ) 1U << uxSlot );
+            }
+            else
+            {
+                /* Too far away for the wheel, the timer is inserted again
+                 * each time the whole wheel wraps. */
+                vListInsertEnd( &xTimerWheelOverflow, &( pxTimer->xTimerListItem ) );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvCascadeTimerWheelList( List_t * const pxList )
+        {
+            UBaseType_t uxTimersToMove = listCURRENT_LIST_LENGTH( pxList );
+            Timer_t * pxTimer;
+
+            /* Only the timers present on entry are moved, a timer that is still
+             * out of range of the wheel goes back to the end of the overflow
+             * list. */
+            while( uxTimersToMove > ( UBaseType_t ) 0U )
+            {
+                pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                prvRemoveTimerFromActiveList( pxTimer );
+                prvInsertTimerInWheel( pxTimer );
+                uxTimersToMove--;
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvProcessTimerWheelTick( const TickType_t xTimeNow )
+        {
+            List_t * const pxExpiredList = &( xTimerWheel[ 0 ][ ( UBaseType_t ) xTimerWheelTime & tmrWHEEL_SLOT_MASK ] );
+            Timer_t * pxTimer;
+            UBaseType_t uxLevel;
+            UBaseType_t uxSlot;
+
+            /* Each time a level wraps the slot of the level above that starts on
+             * this tick is moved down.  The overflow list is looked at again when
+             * the whole wheel wraps. */
+            if( ( ( UBaseType_t ) xTimerWheelTime & tmrWHEEL_SLOT_MASK ) == ( UBaseType_t ) 0U )
+            {
+                for( uxLevel = 1U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+                {
+                    uxSlot = ( UBaseType_t ) ( xTimerWheelTime >> tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK;
+                    prvCascadeTimerWheelList( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+
+                    if( uxSlot != ( UBaseType_t ) 0U )
+                    {
+                        break;
+                    }
+                }
+
+                if( uxLevel == ( UBaseType_t ) configTIMER_WHEEL_LEVELS )
+                {
+                    prvCascadeTimerWheelList( &xTimerWheelOverflow );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* All the timers of the level 0 slot expire on this tick.  A timer
+             * that is reloaded always goes to another slot. */
+            while( listLIST_IS_EMPTY( pxExpiredList ) == pdFALSE )
+            {
+                pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxExpiredList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                prvRemoveTimerFromActiveList( pxTimer );
+
+                if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+                {
+                    prvReloadTimer( pxTimer, xTimerWheelTime, xTimeNow );
+                }
+                else
+                {
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                }
+
+                /* Call the timer callback. */
+                traceTIMER_EXPIRED( pxTimer );
+                pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static TickType_t prvGetTicksToNextWheelEvent( void )
+        {
+            TickType_t xTicksToNextEvent = tmrMAX_TIME_BEFORE_OVERFLOW;
+            TickType_t xEventTime;
+            UBaseType_t uxLevel;
+            UBaseType_t uxSlot;
+            uint32_t ulSlotsToCome;
+
+            for( uxLevel = 0U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+            {
+                if( ulTimerWheelOccupied[ uxLevel ] != 0UL )
+                {
+                    /* The first slot of this level that is still to be
+                     * processed starts on the first slot boundary from the
+                     * wheel time on. */
+                    xEventTime = ( TickType_t ) ( xTimerWheelTime + ( tmrWHEEL_SLOT_TICKS( uxLevel ) - 1U ) ) & ( TickType_t ) ~( tmrWHEEL_SLOT_TICKS( uxLevel ) - 1U );
+                    uxSlot = ( UBaseType_t ) ( xEventTime >> tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK;
+                    ulSlotsToCome = ulTimerWheelOccupied[ uxLevel ] & ~( ( ( uint32_t ) 1U << uxSlot ) - 1U );
+
+                    if( ulSlotsToCome != 0UL )
+                    {
+                        xEventTime += ( TickType_t ) ( ( TickType_t ) ( tmrWHEEL_FIRST_SLOT( ulSlotsToCome ) - uxSlot ) << tmrWHEEL_LEVEL_SHIFT( uxLevel ) );
+                    }
+                    else
+                    {
+                        /* The occupied slots are only reached once this level
+                         * wraps, wake up when it does. */
+                        xEventTime = ( xEventTime | ( tmrWHEEL_SLOT_TICKS( uxLevel + 1U ) - 1U ) ) + 1U;
+                    }
+
+                    if( ( TickType_t ) ( xEventTime - xTimerWheelTime ) < xTicksToNextEvent )
+                    {
+                        xTicksToNextEvent = ( TickType_t ) ( xEventTime - xTimerWheelTime );
+                    }
+                }
+            }
+
+            if( listLIST_IS_EMPTY( &xTimerWheelOverflow ) == pdFALSE )
+            {
+                xEventTime = ( TickType_t ) ( xTimerWheelTime + ( tmrWHEEL_SLOT_TICKS( configTIMER_WHEEL_LEVELS ) - 1U ) ) & ( TickType_t ) ~( tmrWHEEL_SLOT_TICKS( configTIMER_WHEEL_LEVELS ) - 1U );
+
+                if( ( TickType_t ) ( xEventTime - xTimerWheelTime ) < xTicksToNextEvent )
+                {
+                    xTicksToNextEvent = ( TickType_t ) ( xEventTime - xTimerWheelTime );
+                }
+            }
+
+            return xTicksToNextEvent;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
     static void prvProcessReceivedCommands( void )
     {
         DaemonTaskMessage_t xMessage;
@@ -788,6 +1543,27 @@
             }
             #endif /* INCLUDE_xTimerPendFunctionCall */
 
+            #if ( configUSE_ISR_TIMERS == 1 )
+                if( ( xMessage.xMessageID >= ( BaseType_t ) 0 ) && ( ( xMessage.u.xTimerParameters.pxTimer->ucStatus & tmrSTATUS_IS_ISR_CONTEXT ) != 0U ) )
+                {
+                    /* The command was queued before the timer was moved to the
+                     * tick interrupt, while the scheduler was not running or was
+                     * suspended.  It is applied to the lists of the tick interrupt,
+                     * from this task, so as the task version of the command. */
+                    if( xMessage.xMessageID >= tmrFIRST_FROM_ISR_COMMAND )
+                    {
+                        xMessage.xMessageID -= ( tmrFIRST_FROM_ISR_COMMAND - tmrCOMMAND_START );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    ( void ) prvProcessISRTimerCommand( xMessage.u.xTimerParameters.pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+                }
+                else
+            #endif /* configUSE_ISR_TIMERS */
+
             /* Commands that are positive are timer commands rather than pended
              * function calls. */
             if( xMessage.xMessageID >= ( BaseType_t ) 0 )
@@ -799,7 +1575,7 @@
                 if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
                 {
                     /* The timer is in a list, remove it. */
-                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    prvRemoveTimerFromActiveList( pxTimer );
                 }
                 else
                 {
@@ -878,7 +1654,7 @@
                              * allocated. */
                             if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
                             {
-                                vPortFree( pxTimer );
+                                timerFREE_TIMER( pxTimer );
                             }
                             else
                             {
@@ -905,6 +1681,8 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
     static void prvSwitchTimerLists( void )
     {
         TickType_t xNextExpireTime;
@@ -928,6 +1706,8 @@
         pxCurrentTimerList = pxOverflowTimerList;
         pxOverflowTimerList = pxTemp;
     }
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvCheckForValidListAndQueue( void )
@@ -937,12 +1717,49 @@
          * initialised. */
         taskENTER_CRITICAL();
         {
+            #if ( configUSE_ISR_TIMERS == 1 )
+            {
+                if( pxCurrentISRTimerList == NULL )
+                {
+                    vListInitialise( &xISRTimerList1 );
+                    vListInitialise( &xISRTimerList2 );
+                    pxCurrentISRTimerList = &xISRTimerList1;
+                    pxOverflowISRTimerList = &xISRTimerList2;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_ISR_TIMERS */
+
             if( xTimerQueue == NULL )
             {
-                vListInitialise( &xActiveTimerList1 );
-                vListInitialise( &xActiveTimerList2 );
-                pxCurrentTimerList = &xActiveTimerList1;
-                pxOverflowTimerList = &xActiveTimerList2;
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    UBaseType_t uxLevel;
+                    UBaseType_t uxSlot;
+
+                    for( uxLevel = 0U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                        {
+                            vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+                        }
+
+                        ulTimerWheelOccupied[ uxLevel ] = 0UL;
+                    }
+
+                    vListInitialise( &xTimerWheelOverflow );
+                }
+                #else /* configUSE_TIMER_WHEEL */
+                {
+                    vListInitialise( &xActiveTimerList1 );
+                    vListInitialise( &xActiveTimerList2 );
+                    pxCurrentTimerList = &xActiveTimerList1;
+                    pxOverflowTimerList = &xActiveTimerList2;
+                }
+                #endif /* configUSE_TIMER_WHEEL */
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
@@ -0,0 +1,78 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "test.h"
+
+static unsigned long ulChecks;
+static unsigned long ulFailures;
+
+/**
+ * @brief Count a check, a failed one is reported on stderr.
+ *
+ */
+void vTestCheck(BaseType_t xPassed, const char *pcCondition, const char *pcFile, int iLine)
+{
+    ulChecks++;
+    if (xPassed == pdFALSE) {
+        ulFailures++;
+        fprintf(stderr, "%s:%d: check failed: %s\n", pcFile, iLine, pcCondition);
+    }
+}
+
+/**
+ * @brief Task that runs the test and ends the scheduler after it.
+ *
+ * @param pvParameters    not used
+ */
+static void prvTestTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    vTestMain();
+    vTaskEndScheduler();
+}
+
+/**
+ * @brief Run the test of the program, the exit code is 0 only when all the
+ * checks passed.
+ *
+ */
+int main(void)
+{
+    if (xTaskCreate(prvTestTask, "test", configMINIMAL_STACK_SIZE, NULL, testMAIN_PRIORITY, NULL) != pdPASS) {
+        fprintf(stderr, "test: not enough memory to start the test\n");
+        return 1;
+    }
+
+    vTaskStartScheduler();
+
+    printf("%lu checks, %lu failed\n", ulChecks, ulFailures);
+    return ((ulChecks > 0) && (ulFailures == 0)) ? 0 : 1;
+}
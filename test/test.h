@@ -0,0 +1,61 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* priority of the task that runs vTestMain(), above everything the tests create */
+#define testMAIN_PRIORITY               ( configMAX_PRIORITIES - 1 )
+
+/* check a condition, a failure is reported with its location and fails the program */
+#define testCHECK(x)                    vTestCheck((x) ? pdTRUE : pdFALSE, #x, __FILE__, __LINE__)
+
+/**
+ * The test itself, provided by every test program. It runs in a task at
+ * testMAIN_PRIORITY once the scheduler is started, the scheduler is ended when
+ * it returns.
+ */
+void vTestMain(void);
+
+/**
+ * Record the result of one check, use testCHECK().
+ *
+ * @param xPassed         pdTRUE when the condition holds
+ * @param pcCondition     the condition, as text
+ * @param pcFile          source file of the check
+ * @param iLine           source line of the check
+ */
+void vTestCheck(BaseType_t xPassed, const char *pcCondition, const char *pcFile, int iLine);
+
+#ifdef __cplusplus
+}
+#endif
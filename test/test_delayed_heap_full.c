@@ -0,0 +1,112 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "test.h"
+
+#if ( configUSE_DELAYED_TASK_HEAP != 1 ) || ( configDELAYED_TASK_HEAP_LENGTH > 16 )
+    #error The test fills the delayed task heap, build it with options_delayed_heap_full.h.
+#endif
+
+#define testMAX_TASKS                   configDELAYED_TASK_HEAP_LENGTH
+#define testPERIOD                      3
+#define testROUNDS                      10UL
+
+static volatile uint32_t ulWakes;
+static volatile uint32_t ulEarlyWakes;
+
+/**
+ * @brief Block with a timeout for ever, every task that exists holds an entry
+ * of the delayed task heap at the same time.
+ *
+ * @param pvParameters    not used
+ */
+static void prvSleeper(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;) {
+        const TickType_t xStart = xTaskGetTickCount();
+
+        vTaskDelay(testPERIOD);
+        if ((TickType_t)(xTaskGetTickCount() - xStart) < testPERIOD) {
+            ulEarlyWakes++;
+        }
+        ulWakes++;
+    }
+}
+
+/**
+ * @brief A task is only created while the heap has an entry left for it, the
+ * entry of a deleted task can be taken again.
+ *
+ */
+static void prvTestCapacity(void)
+{
+    TaskHandle_t xTasks[testMAX_TASKS];
+    const UBaseType_t uxExisting = uxTaskGetNumberOfTasks();
+    UBaseType_t uxCreated = 0;
+
+    testCHECK(uxExisting < configDELAYED_TASK_HEAP_LENGTH);
+
+    while ((uxCreated < testMAX_TASKS) &&
+           (xTaskCreate(prvSleeper, "sleeper", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTasks[uxCreated]) == pdPASS)) {
+        uxCreated++;
+    }
+    testCHECK(uxCreated == configDELAYED_TASK_HEAP_LENGTH - uxExisting);
+    testCHECK(uxTaskGetNumberOfTasks() == configDELAYED_TASK_HEAP_LENGTH);
+    testCHECK(xTaskCreate(prvSleeper, "extra", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL) == errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY);
+
+    /* all the tasks, the timer task and this one included, are delayed together */
+    vTaskDelay(testPERIOD * testROUNDS);
+    testCHECK(ulWakes >= uxCreated * (testROUNDS - 1UL));
+    testCHECK(ulEarlyWakes == 0);
+
+    vTaskDelete(xTasks[0]);
+    testCHECK(xTaskCreate(prvSleeper, "again", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTasks[0]) == pdPASS);
+    testCHECK(xTaskCreate(prvSleeper, "extra", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL) == errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY);
+
+    ulWakes = 0;
+    vTaskDelay(testPERIOD * testROUNDS);
+    testCHECK(ulWakes >= uxCreated * (testROUNDS - 1UL));
+    testCHECK(ulEarlyWakes == 0);
+
+    for (UBaseType_t x = 0; x < uxCreated; x++) {
+        vTaskDelete(xTasks[x]);
+    }
+    testCHECK(uxTaskGetNumberOfTasks() == uxExisting);
+}
+
+/**
+ * @brief Run the tests of a full delayed task heap.
+ *
+ */
+void vTestMain(void)
+{
+    prvTestCapacity();
+}
@@ -0,0 +1,241 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "test.h"
+
+#if ( configUSE_ISR_TIMERS != 1 )
+    #error The test runs timers from the tick interrupt, build it with options_isr_timers.h.
+#endif
+
+#define testPERIOD                      5
+#define testRUN_TICKS                   100
+#define testBUDGET_US                   200
+#define testSLOW_CALLBACK_US            1000
+#define testSLOW_CALLBACKS              3
+
+static volatile uint32_t ulCallbacks;
+static volatile uint32_t ulDaemonCallbacks;
+static volatile uint32_t ulSlowCallbacks;
+
+/**
+ * @brief Monotonic time of the host.
+ *
+ * @return the time in microseconds
+ */
+static uint64_t prvNowUs(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return ((uint64_t)xNow.tv_sec * 1000000ULL) + ((uint64_t)xNow.tv_nsec / 1000ULL);
+}
+
+/**
+ * @brief Count the calls, note the ones made by the timer service task and
+ * overrun the budget while slow calls are asked for.
+ *
+ */
+static void prvCallback(TimerHandle_t xTimer)
+{
+    (void)xTimer;
+
+    ulCallbacks++;
+    if (xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle()) {
+        ulDaemonCallbacks++;
+    }
+
+    if (ulSlowCallbacks > 0) {
+        const uint64_t ullStart = prvNowUs();
+
+        ulSlowCallbacks--;
+        while ((prvNowUs() - ullStart) < testSLOW_CALLBACK_US) {
+        }
+    }
+}
+
+/**
+ * @brief Create an auto-reload timer run from the tick interrupt.
+ *
+ */
+static TimerHandle_t prvCreateISRTimer(void)
+{
+    TimerHandle_t xTimer = xTimerCreate("isr", testPERIOD, pdTRUE, NULL, prvCallback);
+
+    testCHECK(xTimer != NULL);
+    vTimerSetISRContext(xTimer, testBUDGET_US);
+    ulCallbacks = 0;
+    ulDaemonCallbacks = 0;
+    ulSlowCallbacks = 0;
+
+    return xTimer;
+}
+
+/**
+ * @brief An auto-reload timer expires once per period from the tick
+ * interrupt and stops when it is stopped.
+ *
+ */
+static void prvTestPeriodicExpiry(void)
+{
+    TimerHandle_t xTimer = prvCreateISRTimer();
+    TickType_t xTicksToNext;
+    uint32_t ulStopped;
+
+    testCHECK(xTimerGetTicksToNextISRTimer(xTaskGetTickCount()) == portMAX_DELAY);
+    testCHECK(xTimerStart(xTimer, 0) == pdPASS);
+    testCHECK(xTimerIsTimerActive(xTimer) != pdFALSE);
+
+    /* the tickless idle period is clamped to the next expiry */
+    xTicksToNext = xTimerGetTicksToNextISRTimer(xTaskGetTickCount());
+    testCHECK((xTicksToNext > 0) && (xTicksToNext <= testPERIOD));
+
+    vTaskDelay(testRUN_TICKS);
+    testCHECK(ulCallbacks >= (testRUN_TICKS / testPERIOD) - 1);
+    testCHECK(ulCallbacks <= (testRUN_TICKS / testPERIOD) + 1);
+    testCHECK(ulDaemonCallbacks == 0);
+
+    testCHECK(xTimerStop(xTimer, 0) == pdPASS);
+    ulStopped = ulCallbacks;
+    vTaskDelay(4 * testPERIOD);
+    testCHECK(ulCallbacks == ulStopped);
+    testCHECK(xTimerIsTimerActive(xTimer) == pdFALSE);
+    testCHECK(xTimerGetTicksToNextISRTimer(xTaskGetTickCount()) == portMAX_DELAY);
+
+    xTimerDelete(xTimer, 0);
+}
+
+/**
+ * @brief The calls that take longer than the budget are counted, the longest
+ * call is kept.
+ *
+ */
+static void prvTestBudgetOverruns(void)
+{
+    TimerHandle_t xTimer = prvCreateISRTimer();
+    configRUN_TIME_COUNTER_TYPE xLongest;
+    UBaseType_t uxOverruns;
+
+    vTimerGetISRCallbackStats(xTimer, &xLongest, &uxOverruns);
+    testCHECK(xLongest == 0);
+    testCHECK(uxOverruns == 0);
+
+    ulSlowCallbacks = testSLOW_CALLBACKS;
+    xTimerStart(xTimer, 0);
+    vTaskDelay((testSLOW_CALLBACKS + 3) * testPERIOD);
+    xTimerStop(xTimer, 0);
+
+    vTimerGetISRCallbackStats(xTimer, &xLongest, &uxOverruns);
+    testCHECK(ulSlowCallbacks == 0);
+    testCHECK(ulCallbacks > testSLOW_CALLBACKS);
+    testCHECK(uxOverruns == testSLOW_CALLBACKS);
+    testCHECK(xLongest >= testSLOW_CALLBACK_US);
+
+    xTimerDelete(xTimer, 0);
+}
+
+/**
+ * @brief A tick count that jumps over whole periods, as vTaskStepTick() does
+ * after a tickless idle period, calls the timer once for every period it
+ * missed and keeps it on its period.
+ *
+ */
+static void prvTestLateCatchUp(void)
+{
+    TimerHandle_t xTimer = prvCreateISRTimer();
+    TickType_t xTickCount, xTicksToNext;
+    uint32_t ulCalled;
+
+    taskENTER_CRITICAL();
+    {
+        xTimerStart(xTimer, 0);
+        xTickCount = xTaskGetTickCount();
+        xTicksToNext = xTimerGetTicksToNextISRTimer(xTickCount);
+
+        /* the tick of the expiry and two more periods are stepped over */
+        vTimerProcessISRTimers(xTickCount + xTicksToNext + (2 * testPERIOD) + 1);
+        ulCalled = ulCallbacks;
+        xTicksToNext = xTimerGetTicksToNextISRTimer(xTickCount + xTicksToNext + (2 * testPERIOD) + 1);
+
+        xTimerStop(xTimer, 0);
+    }
+    taskEXIT_CRITICAL();
+
+    testCHECK(ulCalled == 3);
+    testCHECK(xTicksToNext == testPERIOD - 1);
+
+    xTimerDelete(xTimer, 0);
+}
+
+/**
+ * @brief A start command that is only queued, because the scheduler is
+ * suspended, is applied to the tick interrupt once the timer is moved there.
+ *
+ */
+static void prvTestQueuedStart(void)
+{
+    TimerHandle_t xTimer = xTimerCreate("queued", testPERIOD, pdTRUE, NULL, prvCallback);
+    uint32_t ulStopped;
+
+    testCHECK(xTimer != NULL);
+    ulCallbacks = 0;
+    ulDaemonCallbacks = 0;
+
+    vTaskSuspendAll();
+    xTimerStart(xTimer, 0);
+    vTimerSetISRContext(xTimer, testBUDGET_US);
+    xTaskResumeAll();
+
+    vTaskDelay(testRUN_TICKS);
+    testCHECK(ulCallbacks >= (testRUN_TICKS / testPERIOD) - 2);
+    testCHECK(ulDaemonCallbacks == 0);
+    testCHECK(xTimerGetTicksToNextISRTimer(xTaskGetTickCount()) <= testPERIOD);
+
+    /* the stop removes the timer from the list of the tick interrupt */
+    testCHECK(xTimerStop(xTimer, 0) == pdPASS);
+    ulStopped = ulCallbacks;
+    vTaskDelay(4 * testPERIOD);
+    testCHECK(ulCallbacks == ulStopped);
+    testCHECK(xTimerGetTicksToNextISRTimer(xTaskGetTickCount()) == portMAX_DELAY);
+
+    xTimerDelete(xTimer, 0);
+}
+
+/**
+ * @brief Run the tests of the timers called from the tick interrupt.
+ *
+ */
+void vTestMain(void)
+{
+    prvTestPeriodicExpiry();
+    prvTestBudgetOverruns();
+    prvTestLateCatchUp();
+    prvTestQueuedStart();
+}
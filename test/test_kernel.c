@@ -0,0 +1,252 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "port.h"
+#include "test.h"
+
+#define testITEMS                       1000UL
+#define testQUEUE_LENGTH                4
+
+static QueueHandle_t xQueue;
+static SemaphoreHandle_t xSemaphore;
+static SemaphoreHandle_t xMutex;
+static volatile uint32_t ulReceived;
+static volatile BaseType_t xInOrder;
+static volatile uint32_t ulSpins[2];
+static volatile BaseType_t xStopSpinning;
+static volatile UBaseType_t uxInheritedPriority;
+
+/**
+ * @brief Send testITEMS numbers through the queue, blocking whenever it is full.
+ *
+ */
+static void prvProducer(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (uint32_t ulItem = 0; ulItem < testITEMS; ulItem++) {
+        xQueueSend(xQueue, &ulItem, portMAX_DELAY);
+    }
+    vTaskSuspend(NULL);
+}
+
+/**
+ * @brief Receive the numbers of prvProducer() and check their order.
+ *
+ */
+static void prvConsumer(void *pvParameters)
+{
+    uint32_t ulItem;
+
+    (void)pvParameters;
+
+    for (;;) {
+        xQueueReceive(xQueue, &ulItem, portMAX_DELAY);
+        if (ulItem != ulReceived) {
+            xInOrder = pdFALSE;
+        }
+        ulReceived++;
+    }
+}
+
+/**
+ * @brief Queue between a producer and a consumer of both priority orders.
+ *
+ */
+static void prvTestQueue(void)
+{
+    TaskHandle_t xProducer, xConsumer;
+
+    for (UBaseType_t uxProducerHigher = 0; uxProducerHigher < 2; uxProducerHigher++) {
+        xQueue = xQueueCreate(testQUEUE_LENGTH, sizeof(uint32_t));
+        ulReceived = 0;
+        xInOrder = pdTRUE;
+
+        xTaskCreate(prvConsumer, "cons", configMINIMAL_STACK_SIZE, NULL, 2 - uxProducerHigher, &xConsumer);
+        xTaskCreate(prvProducer, "prod", configMINIMAL_STACK_SIZE, NULL, 1 + uxProducerHigher, &xProducer);
+        vTaskDelay(pdMS_TO_TICKS(100));
+
+        testCHECK(ulReceived == testITEMS);
+        testCHECK(xInOrder == pdTRUE);
+        testCHECK(uxQueueMessagesWaiting(xQueue) == 0);
+
+        vTaskDelete(xProducer);
+        vTaskDelete(xConsumer);
+        vQueueDelete(xQueue);
+    }
+}
+
+/**
+ * @brief Simulated interrupt that gives the semaphore.
+ *
+ */
+static void prvGiveFromISR(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    xSemaphoreGiveFromISR(xSemaphore, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR();
+}
+
+/**
+ * @brief Take the semaphore for every interrupt.
+ *
+ */
+static void prvSemaphoreTaker(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;) {
+        if (xSemaphoreTake(xSemaphore, portMAX_DELAY) == pdTRUE) {
+            ulReceived++;
+        }
+    }
+}
+
+/**
+ * @brief Binary semaphore given from an interrupt wakes the task blocked on it
+ * before the interrupt returns to the lower priority code.
+ *
+ */
+static void prvTestSemaphoreFromISR(void)
+{
+    TaskHandle_t xTaker;
+
+    xSemaphore = xSemaphoreCreateBinary();
+    ulReceived = 0;
+    xTaskCreate(prvSemaphoreTaker, "take", configMINIMAL_STACK_SIZE, NULL, testMAIN_PRIORITY, &xTaker);
+
+    /* the taker has the priority of this task, the yield of the interrupt switches to it */
+    taskYIELD();
+    for (uint32_t ulInterrupt = 1; ulInterrupt <= 100; ulInterrupt++) {
+        vPortRunAsInterrupt(prvGiveFromISR);
+        taskYIELD();
+        testCHECK(ulReceived == ulInterrupt);
+    }
+    testCHECK(xSemaphoreTake(xSemaphore, 0) == pdFALSE);
+
+    vTaskDelete(xTaker);
+    vSemaphoreDelete(xSemaphore);
+}
+
+/**
+ * @brief Hold the mutex for a while.
+ *
+ */
+static void prvMutexHolder(void *pvParameters)
+{
+    (void)pvParameters;
+
+    xSemaphoreTake(xMutex, portMAX_DELAY);
+    ulReceived = 1;
+    while (xStopSpinning == pdFALSE) {
+    }
+    uxInheritedPriority = uxTaskPriorityGet(NULL);
+    xSemaphoreGive(xMutex);
+    vTaskSuspend(NULL);
+}
+
+/**
+ * @brief The holder of a mutex inherits the priority of the task that waits
+ * for it and gets its own back when giving it.
+ *
+ */
+static void prvTestPriorityInheritance(void)
+{
+    TaskHandle_t xHolder;
+
+    xMutex = xSemaphoreCreateMutex();
+    ulReceived = 0;
+    xStopSpinning = pdFALSE;
+    xTaskCreate(prvMutexHolder, "hold", configMINIMAL_STACK_SIZE, NULL, 1, &xHolder);
+
+    /* the holder runs only while this task is blocked */
+    while (ulReceived == 0) {
+        vTaskDelay(1);
+    }
+
+    testCHECK(xSemaphoreTake(xMutex, 0) == pdFALSE);
+    testCHECK(uxTaskPriorityGet(xHolder) == 1);
+    xStopSpinning = pdTRUE;
+    testCHECK(xSemaphoreTake(xMutex, pdMS_TO_TICKS(100)) == pdTRUE);
+    testCHECK(uxInheritedPriority == testMAIN_PRIORITY);
+    testCHECK(uxTaskPriorityGet(xHolder) == 1);
+    testCHECK(xSemaphoreGetMutexHolder(xMutex) == xTaskGetCurrentTaskHandle());
+    xSemaphoreGive(xMutex);
+
+    vTaskDelete(xHolder);
+    vSemaphoreDelete(xMutex);
+}
+
+/**
+ * @brief Count the slices of time this task gets.
+ *
+ */
+static void prvSpinner(void *pvParameters)
+{
+    volatile uint32_t *pulSpins = (volatile uint32_t *)pvParameters;
+
+    for (;;) {
+        (*pulSpins)++;
+    }
+}
+
+/**
+ * @brief Two busy tasks of the same priority share the processor, the tick
+ * preempts each of them.
+ *
+ */
+static void prvTestTimeSlicing(void)
+{
+    TaskHandle_t xSpinners[2];
+    TickType_t xStart = xTaskGetTickCount();
+
+    ulSpins[0] = 0;
+    ulSpins[1] = 0;
+    xTaskCreate(prvSpinner, "spin0", configMINIMAL_STACK_SIZE, (void *)&ulSpins[0], 1, &xSpinners[0]);
+    xTaskCreate(prvSpinner, "spin1", configMINIMAL_STACK_SIZE, (void *)&ulSpins[1], 1, &xSpinners[1]);
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    testCHECK((xTaskGetTickCount() - xStart) >= pdMS_TO_TICKS(50));
+    testCHECK(ulSpins[0] > 0);
+    testCHECK(ulSpins[1] > 0);
+
+    vTaskDelete(xSpinners[0]);
+    vTaskDelete(xSpinners[1]);
+}
+
+void vTestMain(void)
+{
+    prvTestQueue();
+    prvTestSemaphoreFromISR();
+    prvTestPriorityInheritance();
+    prvTestTimeSlicing();
+}
@@ -0,0 +1,185 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "test.h"
+
+#if ( configUSE_TASK_LATENCY_STATS != 1 )
+    #error The test reads the latency statistics, build it with options_latency.h.
+#endif
+
+#define testWAKE_UPS                    100UL
+#define testSECOND                      1000000ULL
+
+static volatile uint32_t ulWakeUps;
+
+/**
+ * @brief Sum of the buckets of a histogram.
+ *
+ */
+static uint32_t prvHistogramCount(const TaskLatencyStats_t *pxStats)
+{
+    uint32_t ulCount = 0;
+
+    for (uint32_t ulBucket = 0; ulBucket < configTASK_LATENCY_BUCKETS; ulBucket++) {
+        ulCount += pxStats->ulHistogram[ulBucket];
+    }
+
+    return ulCount;
+}
+
+/**
+ * @brief Count every notification, the latency of each wake up is recorded
+ * by the kernel.
+ *
+ * @param pvParameters    not used
+ */
+static void prvWaiterTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        ulWakeUps++;
+    }
+}
+
+/**
+ * @brief The test task was created before the scheduler started, its ready
+ * time must not come from before the run time counter was configured.
+ *
+ */
+static void prvTestFirstTask(void)
+{
+    TaskLatencyStats_t xStats;
+
+    vTaskGetLatencyStats(NULL, &xStats);
+
+#if ( configNUMBER_OF_CORES == 1 )
+    /* the first task is started by the port, it never waited to be switched in */
+    testCHECK(xStats.ulCount == 0);
+#else
+    /* the idle tasks start first, the test task waits for one switch in from
+    the start of the scheduler, a ready time from before it reads as no wait */
+    testCHECK(xStats.ulCount == 1);
+    testCHECK(xStats.ulHistogram[0] == 0);
+#endif
+    testCHECK(prvHistogramCount(&xStats) == xStats.ulCount);
+    testCHECK(xStats.ulMaxLatency < testSECOND);
+}
+
+/**
+ * @brief Every wake up of a task is one sample, the histogram adds up to the
+ * count and a reset clears all of it.
+ *
+ */
+static void prvTestWakeUps(void)
+{
+    TaskLatencyStats_t xStats;
+    TaskHandle_t xWaiter;
+
+    testCHECK(xTaskCreate(prvWaiterTask, "waiter", configMINIMAL_STACK_SIZE, NULL, testMAIN_PRIORITY - 1, &xWaiter) == pdPASS);
+    vTaskDelay(2);
+    vTaskResetLatencyStats(xWaiter);
+    ulWakeUps = 0;
+
+    for (uint32_t ulWakeUp = 0; ulWakeUp < testWAKE_UPS; ulWakeUp++) {
+        xTaskNotifyGive(xWaiter);
+        vTaskDelay(1);
+    }
+
+    vTaskGetLatencyStats(xWaiter, &xStats);
+    testCHECK(ulWakeUps == testWAKE_UPS);
+    testCHECK(xStats.ulCount == testWAKE_UPS);
+    testCHECK(prvHistogramCount(&xStats) == xStats.ulCount);
+    testCHECK(xStats.ulTotalLatency >= xStats.ulMaxLatency);
+    testCHECK(xStats.ulMaxLatency < testSECOND);
+
+    vTaskResetLatencyStats(xWaiter);
+    vTaskGetLatencyStats(xWaiter, &xStats);
+    testCHECK(xStats.ulCount == 0);
+    testCHECK(xStats.ulTotalLatency == 0);
+    testCHECK(xStats.ulMaxLatency == 0);
+    testCHECK(prvHistogramCount(&xStats) == 0);
+
+    vTaskDelete(xWaiter);
+}
+
+#if ( configNUMBER_OF_CORES == 1 )
+
+/**
+ * @brief A ready task moved to another priority keeps its ready time, a ready
+ * task suspended before it ran is not timed.
+ *
+ */
+static void prvTestReadyChanges(void)
+{
+    TaskLatencyStats_t xStats;
+    TaskHandle_t xWaiter;
+
+    /* the test task keeps the processor, the waiter stays ready */
+    testCHECK(xTaskCreate(prvWaiterTask, "waiter", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xWaiter) == pdPASS);
+    vTaskPrioritySet(xWaiter, tskIDLE_PRIORITY + 2);
+    vTaskDelay(2);
+
+    vTaskGetLatencyStats(xWaiter, &xStats);
+    testCHECK(xStats.ulCount == 1);
+    testCHECK(xStats.ulMaxLatency < testSECOND);
+
+    /* made ready and suspended again before it could run */
+    vTaskResetLatencyStats(xWaiter);
+    xTaskNotifyGive(xWaiter);
+    vTaskSuspend(xWaiter);
+    vTaskDelay(2);
+    vTaskGetLatencyStats(xWaiter, &xStats);
+    testCHECK(xStats.ulCount == 0);
+
+    /* resumed, the wait is timed from the resume */
+    vTaskResume(xWaiter);
+    vTaskDelay(2);
+    vTaskGetLatencyStats(xWaiter, &xStats);
+    testCHECK(xStats.ulCount == 1);
+    testCHECK(xStats.ulMaxLatency < testSECOND);
+
+    vTaskDelete(xWaiter);
+}
+
+#endif /* configNUMBER_OF_CORES == 1 */
+
+/**
+ * @brief Run the latency statistics tests.
+ *
+ */
+void vTestMain(void)
+{
+    prvTestFirstTask();
+    prvTestWakeUps();
+#if ( configNUMBER_OF_CORES == 1 )
+    prvTestReadyChanges();
+#endif
+}
@@ -0,0 +1,328 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+#include "event_groups.h"
+#include "object_pool.h"
+#include "test.h"
+
+#if ( configUSE_OBJECT_POOLS != 1 )
+    #error The test takes the kernel objects from the pools, build it with options_object_pools.h.
+#endif
+
+#define testHEAP_OBJECTS                2
+#define testMAX_OBJECTS                 ( configTASK_POOL_SIZE + testHEAP_OBJECTS )
+#define testCLEANUP_TICKS               3
+
+/*
+ * Every create below goes through pvObjectPoolAllocate(), which asserts that
+ * the kernel structure fits the Static*_t slot it is given. The objects of a
+ * full pool sit next to each other, each one is given data of its own and read
+ * back, so a slot that is smaller than the structure it holds fails the test
+ * even when the assert is left out.
+ */
+
+/**
+ * @brief Usage of a pool.
+ *
+ */
+static ObjectPoolStats_t prvPoolStats(eObjectPool ePool)
+{
+    ObjectPoolStats_t xStats;
+
+    vObjectPoolGetStats(ePool, &xStats);
+    return xStats;
+}
+
+/**
+ * @brief Number of objects that can be created before the pool is exhausted.
+ *
+ */
+static UBaseType_t prvFreeSlots(const ObjectPoolStats_t *pxStats)
+{
+    return pxStats->uxCapacity - pxStats->uxInUse;
+}
+
+/**
+ * @brief Check a pool that was filled up and had testHEAP_OBJECTS more objects
+ * created from the heap.
+ *
+ */
+static void prvCheckExhausted(eObjectPool ePool, const ObjectPoolStats_t *pxBefore)
+{
+    ObjectPoolStats_t xStats = prvPoolStats(ePool);
+
+    testCHECK(xStats.uxCapacity == pxBefore->uxCapacity);
+    testCHECK(xStats.uxInUse == xStats.uxCapacity);
+    testCHECK(xStats.uxMaximumInUse == xStats.uxCapacity);
+    testCHECK(xStats.uxHeapAllocations == pxBefore->uxHeapAllocations + testHEAP_OBJECTS);
+}
+
+/**
+ * @brief Check a pool after all the objects of the test were deleted, the
+ * slots are back and the heap objects are not counted again.
+ *
+ */
+static void prvCheckReturned(eObjectPool ePool, const ObjectPoolStats_t *pxBefore)
+{
+    ObjectPoolStats_t xStats = prvPoolStats(ePool);
+
+    testCHECK(xStats.uxInUse == pxBefore->uxInUse);
+    testCHECK(xStats.uxMaximumInUse == xStats.uxCapacity);
+    testCHECK(xStats.uxHeapAllocations == pxBefore->uxHeapAllocations + testHEAP_OBJECTS);
+}
+
+/**
+ * @brief Check that one more object was taken from a returned slot and not
+ * from the heap.
+ *
+ */
+static void prvCheckReused(eObjectPool ePool, const ObjectPoolStats_t *pxBefore)
+{
+    ObjectPoolStats_t xStats = prvPoolStats(ePool);
+
+    testCHECK(xStats.uxInUse == pxBefore->uxInUse + 1);
+    testCHECK(xStats.uxHeapAllocations == pxBefore->uxHeapAllocations + testHEAP_OBJECTS);
+}
+
+/**
+ * @brief Task of the task pool, it suspends itself until it is deleted.
+ *
+ * @param pvParameters    not used
+ */
+static void prvParkedTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;) {
+        vTaskSuspend(NULL);
+    }
+}
+
+/**
+ * @brief The TCBs come from the task pool, the heap once it is exhausted and
+ * go back to the pool when the tasks are deleted.
+ *
+ */
+static void prvTestTaskPool(void)
+{
+    ObjectPoolStats_t xBefore = prvPoolStats(eObjectPoolTask);
+    TaskHandle_t xTasks[testMAX_OBJECTS];
+    char cName[configMAX_TASK_NAME_LEN];
+    UBaseType_t uxCount = prvFreeSlots(&xBefore) + testHEAP_OBJECTS;
+
+    testCHECK(xBefore.uxCapacity == configTASK_POOL_SIZE);
+    testCHECK(uxCount <= testMAX_OBJECTS);
+
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        snprintf(cName, sizeof(cName), "pool%u", (unsigned)x);
+        testCHECK(xTaskCreate(prvParkedTask, cName, configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTasks[x]) == pdPASS);
+    }
+    prvCheckExhausted(eObjectPoolTask, &xBefore);
+
+    /* every task runs up to its suspend before its TCB is looked at */
+    vTaskDelay(1);
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        snprintf(cName, sizeof(cName), "pool%u", (unsigned)x);
+        testCHECK(strcmp(pcTaskGetName(xTasks[x]), cName) == 0);
+        testCHECK(eTaskGetState(xTasks[x]) == eSuspended);
+    }
+
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        vTaskDelete(xTasks[x]);
+    }
+    vTaskDelay(testCLEANUP_TICKS);
+    prvCheckReturned(eObjectPoolTask, &xBefore);
+
+    testCHECK(xTaskCreate(prvParkedTask, "reused", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTasks[0]) == pdPASS);
+    prvCheckReused(eObjectPoolTask, &xBefore);
+    vTaskDelete(xTasks[0]);
+    vTaskDelay(testCLEANUP_TICKS);
+    testCHECK(prvPoolStats(eObjectPoolTask).uxInUse == xBefore.uxInUse);
+}
+
+/**
+ * @brief Queues, semaphores and mutexes share the queue pool.
+ *
+ */
+static void prvTestQueuePool(void)
+{
+    ObjectPoolStats_t xBefore = prvPoolStats(eObjectPoolQueue);
+    QueueHandle_t xQueues[testMAX_OBJECTS];
+    SemaphoreHandle_t xMutex;
+    SemaphoreHandle_t xSemaphore;
+    UBaseType_t uxCount = prvFreeSlots(&xBefore) + testHEAP_OBJECTS;
+    uint32_t ulItem;
+
+    testCHECK(xBefore.uxCapacity == configQUEUE_POOL_SIZE);
+    testCHECK(uxCount <= testMAX_OBJECTS);
+
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        xQueues[x] = xQueueCreate(1, sizeof(uint32_t));
+        testCHECK(xQueues[x] != NULL);
+    }
+    prvCheckExhausted(eObjectPoolQueue, &xBefore);
+
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        testCHECK(xQueueSend(xQueues[x], &(uint32_t){ 0xA5000000UL + x }, 0) == pdPASS);
+    }
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        testCHECK(uxQueueMessagesWaiting(xQueues[x]) == 1);
+        testCHECK(xQueueReceive(xQueues[x], &ulItem, 0) == pdPASS);
+        testCHECK(ulItem == 0xA5000000UL + x);
+    }
+
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        vQueueDelete(xQueues[x]);
+    }
+    prvCheckReturned(eObjectPoolQueue, &xBefore);
+
+    /* the returned slots take the other kinds of queue */
+    xMutex = xSemaphoreCreateMutex();
+    testCHECK(xMutex != NULL);
+    prvCheckReused(eObjectPoolQueue, &xBefore);
+    xSemaphore = xSemaphoreCreateBinary();
+    testCHECK(xSemaphore != NULL);
+    testCHECK(prvPoolStats(eObjectPoolQueue).uxInUse == xBefore.uxInUse + 2);
+
+    testCHECK(xSemaphoreTake(xMutex, 0) == pdPASS);
+    testCHECK(xSemaphoreGetMutexHolder(xMutex) == xTaskGetCurrentTaskHandle());
+    testCHECK(xSemaphoreGive(xMutex) == pdPASS);
+    testCHECK(xSemaphoreTake(xSemaphore, 0) == pdFAIL);
+    testCHECK(xSemaphoreGive(xSemaphore) == pdPASS);
+    testCHECK(xSemaphoreTake(xSemaphore, 0) == pdPASS);
+
+    vSemaphoreDelete(xMutex);
+    vSemaphoreDelete(xSemaphore);
+    testCHECK(prvPoolStats(eObjectPoolQueue).uxInUse == xBefore.uxInUse);
+}
+
+/**
+ * @brief Callback of the pool timers, they are never started.
+ *
+ */
+static void prvTimerCallback(TimerHandle_t xTimer)
+{
+    (void)xTimer;
+}
+
+/**
+ * @brief The timers come from the timer pool, the timer task returns them when
+ * it deletes them.
+ *
+ */
+static void prvTestTimerPool(void)
+{
+    ObjectPoolStats_t xBefore = prvPoolStats(eObjectPoolTimer);
+    TimerHandle_t xTimers[testMAX_OBJECTS];
+    UBaseType_t uxCount = prvFreeSlots(&xBefore) + testHEAP_OBJECTS;
+
+    testCHECK(xBefore.uxCapacity == configTIMER_POOL_SIZE);
+    testCHECK(uxCount <= testMAX_OBJECTS);
+
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        xTimers[x] = xTimerCreate("pool", 10 + x, pdFALSE, (void *)(uintptr_t)(x + 1), prvTimerCallback);
+        testCHECK(xTimers[x] != NULL);
+    }
+    prvCheckExhausted(eObjectPoolTimer, &xBefore);
+
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        testCHECK(pvTimerGetTimerID(xTimers[x]) == (void *)(uintptr_t)(x + 1));
+        testCHECK(xTimerGetPeriod(xTimers[x]) == 10 + x);
+        testCHECK(xTimerIsTimerActive(xTimers[x]) == pdFALSE);
+    }
+
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        testCHECK(xTimerDelete(xTimers[x], portMAX_DELAY) == pdPASS);
+    }
+    vTaskDelay(testCLEANUP_TICKS);
+    prvCheckReturned(eObjectPoolTimer, &xBefore);
+
+    xTimers[0] = xTimerCreate("reused", 10, pdFALSE, NULL, prvTimerCallback);
+    testCHECK(xTimers[0] != NULL);
+    prvCheckReused(eObjectPoolTimer, &xBefore);
+    testCHECK(xTimerDelete(xTimers[0], portMAX_DELAY) == pdPASS);
+    vTaskDelay(testCLEANUP_TICKS);
+    testCHECK(prvPoolStats(eObjectPoolTimer).uxInUse == xBefore.uxInUse);
+}
+
+/**
+ * @brief The event groups come from the event group pool.
+ *
+ */
+static void prvTestEventGroupPool(void)
+{
+    ObjectPoolStats_t xBefore = prvPoolStats(eObjectPoolEventGroup);
+    EventGroupHandle_t xGroups[testMAX_OBJECTS];
+    UBaseType_t uxCount = prvFreeSlots(&xBefore) + testHEAP_OBJECTS;
+
+    testCHECK(xBefore.uxCapacity == configEVENT_GROUP_POOL_SIZE);
+    testCHECK(uxCount <= testMAX_OBJECTS);
+
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        xGroups[x] = xEventGroupCreate();
+        testCHECK(xGroups[x] != NULL);
+    }
+    prvCheckExhausted(eObjectPoolEventGroup, &xBefore);
+
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        xEventGroupSetBits(xGroups[x], (EventBits_t)(0x10 + x));
+    }
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        testCHECK(xEventGroupGetBits(xGroups[x]) == (EventBits_t)(0x10 + x));
+    }
+
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        vEventGroupDelete(xGroups[x]);
+    }
+    prvCheckReturned(eObjectPoolEventGroup, &xBefore);
+
+    xGroups[0] = xEventGroupCreate();
+    testCHECK(xGroups[0] != NULL);
+    prvCheckReused(eObjectPoolEventGroup, &xBefore);
+    testCHECK(xEventGroupGetBits(xGroups[0]) == 0);
+    vEventGroupDelete(xGroups[0]);
+    testCHECK(prvPoolStats(eObjectPoolEventGroup).uxInUse == xBefore.uxInUse);
+}
+
+/**
+ * @brief Run the tests of the object pools.
+ *
+ */
+void vTestMain(void)
+{
+    prvTestTaskPool();
+    prvTestQueuePool();
+    prvTestTimerPool();
+    prvTestEventGroupPool();
+}
@@ -0,0 +1,402 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "test.h"
+
+#if ( configUSE_QUEUE_STATS != 1 ) || ( configQUEUE_REGISTRY_SIZE < 3 )
+    #error The test reads the queue statistics, build it with options_queue_stats.h.
+#endif
+
+#define testQUEUE_LENGTH                4
+#define testBATCH_LENGTH                8
+#define testSTREAM_SIZE                 32
+#define testBLOCK_TICKS                 3
+
+static QueueHandle_t xQueue;
+static StreamBufferHandle_t xStream;
+static UBaseType_t uxISRSent, uxISRReceived;
+static size_t xISRBytesSent, xISRBytesReceived;
+
+/**
+ * @brief Statistics of a queue.
+ *
+ */
+static QueueStats_t prvQueueStats(QueueHandle_t xHandle)
+{
+    QueueStats_t xStats;
+
+    vQueueGetStats(xHandle, &xStats);
+    return xStats;
+}
+
+/**
+ * @brief Statistics of a stream buffer.
+ *
+ */
+static QueueStats_t prvStreamStats(StreamBufferHandle_t xHandle)
+{
+    QueueStats_t xStats;
+
+    vStreamBufferGetStats(xHandle, &xStats);
+    return xStats;
+}
+
+/**
+ * @brief Check that all the counters of the statistics are zero.
+ *
+ */
+static BaseType_t prvStatsAreZero(const QueueStats_t *pxStats)
+{
+    const QueueStats_t xZero = { 0 };
+
+    return (memcmp(pxStats, &xZero, sizeof(xZero)) == 0) ? pdTRUE : pdFALSE;
+}
+
+/**
+ * @brief Items and bytes in both directions, the high water mark, the failed
+ * sends and the blocking of the senders and the receivers of a queue.
+ *
+ */
+static void prvTestQueue(void)
+{
+    QueueStats_t xStats;
+    uint32_t ulItem = 0;
+
+    xQueue = xQueueCreate(testQUEUE_LENGTH, sizeof(uint32_t));
+    testCHECK(xQueue != NULL);
+    xStats = prvQueueStats(xQueue);
+    testCHECK(prvStatsAreZero(&xStats) == pdTRUE);
+
+    for (uint32_t ulSend = 0; ulSend < 3; ulSend++) {
+        testCHECK(xQueueSend(xQueue, &ulSend, 0) == pdPASS);
+    }
+    testCHECK(xQueueReceive(xQueue, &ulItem, 0) == pdPASS);
+    testCHECK(xQueuePeek(xQueue, &ulItem, 0) == pdPASS);
+    for (uint32_t ulSend = 0; ulSend < 3; ulSend++) {
+        xQueueSend(xQueue, &ulSend, 0);
+    }
+
+    xStats = prvQueueStats(xQueue);
+    testCHECK(xStats.ulItemsSent == 5);
+    testCHECK(xStats.ulBytesSent == 5 * sizeof(uint32_t));
+    testCHECK(xStats.ulItemsReceived == 1);
+    testCHECK(xStats.ulBytesReceived == sizeof(uint32_t));
+    testCHECK(xStats.ulHighWaterMark == testQUEUE_LENGTH);
+    testCHECK(xStats.ulFailedSends == 1);
+    testCHECK(xStats.ulSendBlocks == 0);
+
+    /* a send that times out blocks, it is not a failed send */
+    testCHECK(xQueueSend(xQueue, &ulItem, testBLOCK_TICKS) == errQUEUE_FULL);
+    xStats = prvQueueStats(xQueue);
+    testCHECK(xStats.ulSendBlocks == 1);
+    testCHECK(xStats.ulSendBlockedTicks >= testBLOCK_TICKS);
+    testCHECK(xStats.ulFailedSends == 1);
+    testCHECK(xStats.ulReceiveBlocks == 0);
+
+    while (xQueueReceive(xQueue, &ulItem, 0) == pdPASS) {
+    }
+    testCHECK(xQueueReceive(xQueue, &ulItem, testBLOCK_TICKS) == pdFAIL);
+    xStats = prvQueueStats(xQueue);
+    testCHECK(xStats.ulItemsReceived == testQUEUE_LENGTH + 1);
+    testCHECK(xStats.ulReceiveBlocks == 1);
+    testCHECK(xStats.ulReceiveBlockedTicks >= testBLOCK_TICKS);
+    testCHECK(xStats.ulSendBlockedTicks >= testBLOCK_TICKS);
+
+    /* the high water mark starts again from the items held */
+    xQueueSend(xQueue, &ulItem, 0);
+    vQueueResetStats(xQueue);
+    xStats = prvQueueStats(xQueue);
+    testCHECK(xStats.ulHighWaterMark == 1);
+    xStats.ulHighWaterMark = 0;
+    testCHECK(prvStatsAreZero(&xStats) == pdTRUE);
+    xQueueReset(xQueue);
+}
+
+/**
+ * @brief A semaphore give and take count as one item each, without bytes.
+ *
+ */
+static void prvTestSemaphore(void)
+{
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateCounting(2, 0);
+    QueueStats_t xStats;
+
+    testCHECK(xSemaphore != NULL);
+    testCHECK(xSemaphoreGive(xSemaphore) == pdTRUE);
+    testCHECK(xSemaphoreGive(xSemaphore) == pdTRUE);
+    testCHECK(xSemaphoreGive(xSemaphore) == pdFALSE);
+    testCHECK(xSemaphoreTake(xSemaphore, 0) == pdTRUE);
+
+    xStats = prvQueueStats(xSemaphore);
+    testCHECK(xStats.ulItemsSent == 2);
+    testCHECK(xStats.ulItemsReceived == 1);
+    testCHECK(xStats.ulBytesSent == 0);
+    testCHECK(xStats.ulHighWaterMark == 2);
+    testCHECK(xStats.ulFailedSends == 1);
+
+    vSemaphoreDelete(xSemaphore);
+}
+
+/**
+ * @brief A batch counts every item it moves, a batch that waits for space
+ * blocks once.
+ *
+ */
+static void prvTestBatch(void)
+{
+    QueueHandle_t xBatchQueue = xQueueCreate(testBATCH_LENGTH, sizeof(uint16_t));
+    uint16_t usItems[testBATCH_LENGTH] = { 0 };
+    QueueStats_t xStats;
+
+    testCHECK(xBatchQueue != NULL);
+    testCHECK(xQueueSendBatch(xBatchQueue, usItems, 5, 0) == 5);
+    testCHECK(xQueueReceiveBatch(xBatchQueue, usItems, testBATCH_LENGTH, 0) == 5);
+
+    xStats = prvQueueStats(xBatchQueue);
+    testCHECK(xStats.ulItemsSent == 5);
+    testCHECK(xStats.ulBytesSent == 5 * sizeof(uint16_t));
+    testCHECK(xStats.ulItemsReceived == 5);
+    testCHECK(xStats.ulBytesReceived == 5 * sizeof(uint16_t));
+    testCHECK(xStats.ulHighWaterMark == 5);
+
+    testCHECK(xQueueSendBatch(xBatchQueue, usItems, testBATCH_LENGTH, 0) == testBATCH_LENGTH);
+    testCHECK(xQueueSendBatch(xBatchQueue, usItems, 2, testBLOCK_TICKS) == 0);
+    xStats = prvQueueStats(xBatchQueue);
+    testCHECK(xStats.ulItemsSent == 5 + testBATCH_LENGTH);
+    testCHECK(xStats.ulHighWaterMark == testBATCH_LENGTH);
+    testCHECK(xStats.ulSendBlocks == 1);
+    testCHECK(xStats.ulSendBlockedTicks >= testBLOCK_TICKS);
+
+    testCHECK(xQueueReceiveBatch(xBatchQueue, usItems, testBATCH_LENGTH, 0) == testBATCH_LENGTH);
+    testCHECK(xQueueReceiveBatch(xBatchQueue, usItems, testBATCH_LENGTH, testBLOCK_TICKS) == 0);
+    xStats = prvQueueStats(xBatchQueue);
+    testCHECK(xStats.ulItemsReceived == 5 + testBATCH_LENGTH);
+    testCHECK(xStats.ulReceiveBlocks == 1);
+    testCHECK(xStats.ulReceiveBlockedTicks >= testBLOCK_TICKS);
+
+    vQueueDelete(xBatchQueue);
+}
+
+/**
+ * @brief Simulated interrupt that fills and drains the queue and the stream
+ * buffer with the FromISR calls.
+ *
+ */
+static void prvTrafficFromISR(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t ulItems[testQUEUE_LENGTH] = { 0 };
+    uint8_t ucBytes[testSTREAM_SIZE] = { 0 };
+    StreamBufferRegion_t xRegion;
+    size_t xPeeked;
+
+    /* one item, then a batch that only fits in part and a send to the full queue */
+    uxISRSent = (xQueueSendFromISR(xQueue, &ulItems[0], &xHigherPriorityTaskWoken) == pdPASS) ? 1 : 0;
+    uxISRSent += xQueueSendBatchFromISR(xQueue, ulItems, testQUEUE_LENGTH, &xHigherPriorityTaskWoken);
+    xQueueSendFromISR(xQueue, &ulItems[0], &xHigherPriorityTaskWoken);
+    uxISRReceived = (xQueueReceiveFromISR(xQueue, &ulItems[0], &xHigherPriorityTaskWoken) == pdPASS) ? 1 : 0;
+    uxISRReceived += xQueueReceiveBatchFromISR(xQueue, ulItems, testQUEUE_LENGTH, &xHigherPriorityTaskWoken);
+
+    /* the stream buffer is filled up, the last send stores nothing */
+    xISRBytesSent = xStreamBufferSendFromISR(xStream, ucBytes, testSTREAM_SIZE, &xHigherPriorityTaskWoken);
+    xStreamBufferSendFromISR(xStream, ucBytes, 1, &xHigherPriorityTaskWoken);
+    xISRBytesReceived = xStreamBufferReceiveFromISR(xStream, ucBytes, testSTREAM_SIZE / 2, &xHigherPriorityTaskWoken);
+
+    /* the zero-copy calls of an interrupt */
+    xPeeked = xStreamBufferReceivePeek(xStream, &xRegion, 0);
+    xISRBytesReceived += xStreamBufferReceiveReleaseFromISR(xStream, xPeeked, &xHigherPriorityTaskWoken);
+    xISRBytesSent += xStreamBufferSendCommitFromISR(xStream, xStreamBufferSendReserve(xStream, 4, &xRegion, 0), &xHigherPriorityTaskWoken);
+
+    portYIELD_FROM_ISR();
+}
+
+/**
+ * @brief The calls from an interrupt are counted as the calls from a task,
+ * a send from an interrupt that stores nothing is a failed send.
+ *
+ */
+static void prvTestFromISR(void)
+{
+    QueueStats_t xStats;
+
+    xStream = xStreamBufferCreate(testSTREAM_SIZE, 1);
+    testCHECK(xStream != NULL);
+    xQueueReset(xQueue);
+    vQueueResetStats(xQueue);
+
+    vPortRunAsInterrupt(prvTrafficFromISR);
+
+    testCHECK(uxISRSent == testQUEUE_LENGTH);
+    testCHECK(uxISRReceived == testQUEUE_LENGTH);
+    xStats = prvQueueStats(xQueue);
+    testCHECK(xStats.ulItemsSent == testQUEUE_LENGTH);
+    testCHECK(xStats.ulItemsReceived == testQUEUE_LENGTH);
+    testCHECK(xStats.ulBytesSent == testQUEUE_LENGTH * sizeof(uint32_t));
+    testCHECK(xStats.ulHighWaterMark == testQUEUE_LENGTH);
+    testCHECK(xStats.ulFailedSends == 1);
+
+    testCHECK(xISRBytesSent == testSTREAM_SIZE + 4);
+    testCHECK(xISRBytesReceived == testSTREAM_SIZE);
+    xStats = prvStreamStats(xStream);
+    testCHECK(xStats.ulItemsSent == 2);
+    testCHECK(xStats.ulBytesSent == testSTREAM_SIZE + 4);
+    testCHECK(xStats.ulItemsReceived == 2);
+    testCHECK(xStats.ulBytesReceived == testSTREAM_SIZE);
+    testCHECK(xStats.ulHighWaterMark == testSTREAM_SIZE);
+    testCHECK(xStats.ulFailedSends == 1);
+}
+
+/**
+ * @brief A commit and a release of the zero-copy calls count as one write and
+ * one read of the bytes moved, and wait for data or space like the copies.
+ *
+ */
+static void prvTestZeroCopyStream(void)
+{
+    StreamBufferRegion_t xRegion;
+    QueueStats_t xStats;
+    size_t xReserved, xPeeked;
+
+    xStreamBufferReset(xStream);
+    vStreamBufferResetStats(xStream);
+
+    xReserved = xStreamBufferSendReserve(xStream, 10, &xRegion, 0);
+    testCHECK(xReserved == 10);
+    testCHECK(xStreamBufferSendCommit(xStream, xReserved) == 10);
+    xPeeked = xStreamBufferReceivePeek(xStream, &xRegion, 0);
+    testCHECK(xPeeked == 10);
+    testCHECK(xStreamBufferReceiveRelease(xStream, 6) == 6);
+
+    xStats = prvStreamStats(xStream);
+    testCHECK(xStats.ulItemsSent == 1);
+    testCHECK(xStats.ulBytesSent == 10);
+    testCHECK(xStats.ulItemsReceived == 1);
+    testCHECK(xStats.ulBytesReceived == 6);
+    testCHECK(xStats.ulHighWaterMark == 10);
+
+    /* an empty buffer blocks the reader, a full one the writer */
+    testCHECK(xStreamBufferReceiveRelease(xStream, xStreamBufferReceivePeek(xStream, &xRegion, 0)) == 4);
+    testCHECK(xStreamBufferReceivePeek(xStream, &xRegion, testBLOCK_TICKS) == 0);
+    xReserved = xStreamBufferSendReserve(xStream, testSTREAM_SIZE, &xRegion, 0);
+    xStreamBufferSendCommit(xStream, xReserved);
+    testCHECK(xStreamBufferSendReserve(xStream, 1, &xRegion, testBLOCK_TICKS) == 0);
+
+    xStats = prvStreamStats(xStream);
+    testCHECK(xStats.ulItemsReceived == 2);
+    testCHECK(xStats.ulReceiveBlocks == 1);
+    testCHECK(xStats.ulReceiveBlockedTicks >= testBLOCK_TICKS);
+    testCHECK(xStats.ulItemsSent == 2);
+    testCHECK(xStats.ulHighWaterMark == testSTREAM_SIZE);
+    testCHECK(xStats.ulSendBlocks == 1);
+    testCHECK(xStats.ulSendBlockedTicks >= testBLOCK_TICKS);
+}
+
+/**
+ * @brief Find an object in the statistics of the registry.
+ *
+ */
+static const QueueRegistryStats_t *prvFindEntry(const QueueRegistryStats_t *pxEntries, UBaseType_t uxEntries, void *pvHandle)
+{
+    for (UBaseType_t uxEntry = 0; uxEntry < uxEntries; uxEntry++) {
+        if (pxEntries[uxEntry].pvHandle == pvHandle) {
+            return &pxEntries[uxEntry];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief The registry walk returns the queues and the stream buffers added to
+ * the registry, with their statistics, and stops at the size of the array.
+ *
+ */
+static void prvTestRegistry(void)
+{
+    QueueRegistryStats_t xEntries[configQUEUE_REGISTRY_SIZE];
+    const QueueRegistryStats_t *pxEntry;
+    QueueStats_t xStats;
+    UBaseType_t uxEntries, uxBefore;
+
+    /* the timer task registers its queue */
+    uxBefore = uxQueueGetRegistryStats(xEntries, configQUEUE_REGISTRY_SIZE);
+
+    vQueueAddToRegistry(xQueue, "queue");
+    vStreamBufferAddToRegistry(xStream, "stream");
+    uxEntries = uxQueueGetRegistryStats(xEntries, configQUEUE_REGISTRY_SIZE);
+    testCHECK(uxEntries == uxBefore + 2);
+
+    pxEntry = prvFindEntry(xEntries, uxEntries, (void *)xQueue);
+    testCHECK(pxEntry != NULL);
+    if (pxEntry != NULL) {
+        xStats = prvQueueStats(xQueue);
+        testCHECK(strcmp(pxEntry->pcName, "queue") == 0);
+        testCHECK(pxEntry->xIsStreamBuffer == pdFALSE);
+        testCHECK(pxEntry->xCapacity == testQUEUE_LENGTH);
+        testCHECK(memcmp(&pxEntry->xStats, &xStats, sizeof(xStats)) == 0);
+    }
+
+    pxEntry = prvFindEntry(xEntries, uxEntries, (void *)xStream);
+    testCHECK(pxEntry != NULL);
+    if (pxEntry != NULL) {
+        xStats = prvStreamStats(xStream);
+        testCHECK(strcmp(pxEntry->pcName, "stream") == 0);
+        testCHECK(pxEntry->xIsStreamBuffer == pdTRUE);
+        testCHECK(pxEntry->xCapacity == testSTREAM_SIZE);
+        testCHECK(memcmp(&pxEntry->xStats, &xStats, sizeof(xStats)) == 0);
+    }
+
+    testCHECK(uxQueueGetRegistryStats(xEntries, 1) == 1);
+    testCHECK(uxQueueGetRegistryStats(NULL, 0) == 0);
+
+    /* deleting the stream buffer removes it from the registry */
+    vStreamBufferDelete(xStream);
+    vQueueUnregisterQueue(xQueue);
+    testCHECK(uxQueueGetRegistryStats(xEntries, configQUEUE_REGISTRY_SIZE) == uxBefore);
+
+    vQueueDelete(xQueue);
+}
+
+/**
+ * @brief Run the queue and stream buffer statistics tests.
+ *
+ */
+void vTestMain(void)
+{
+    prvTestQueue();
+    prvTestSemaphore();
+    prvTestBatch();
+    prvTestFromISR();
+    prvTestZeroCopyStream();
+    prvTestRegistry();
+}
@@ -0,0 +1,208 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "test.h"
+
+#if ( configUSE_TRACE_FACILITY != 1 ) || ( configGENERATE_RUN_TIME_STATS != 1 )
+    #error The test reads the run time of the tasks, build it with configUSE_TRACE_FACILITY and configGENERATE_RUN_TIME_STATS.
+#endif
+
+#define testMAX_TASKS                   8
+#define testBUSY_TICKS                  50
+/* time of the running task since it was switched in, not in its counter yet */
+#define testSLACK_US                    50000ULL
+
+/**
+ * @brief Take a snapshot of the run time of every task.
+ *
+ * @param pxSnapshot      array of testMAX_TASKS entries
+ * @param pullTotal       run time counter at the snapshot
+ * @param pullSum         sum of the run time of the tasks
+ * @return the number of tasks in the snapshot
+ */
+static UBaseType_t prvSnapshot(TaskRunTime_t *pxSnapshot, uint64_t *pullTotal, uint64_t *pullSum)
+{
+    configRUN_TIME_COUNTER_TYPE ullTotal = 0;
+    UBaseType_t uxCount = uxTaskGetRunTimeSnapshot(pxSnapshot, testMAX_TASKS, &ullTotal);
+
+    *pullTotal = ullTotal;
+    *pullSum = 0;
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        *pullSum += pxSnapshot[x].ulRunTimeCounter;
+    }
+    return uxCount;
+}
+
+/**
+ * @brief Find the entry of a task in a snapshot.
+ *
+ * @return the entry, NULL when the task is not in the snapshot
+ */
+static const TaskRunTime_t *prvFind(const TaskRunTime_t *pxSnapshot, UBaseType_t uxCount, TaskHandle_t xHandle)
+{
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        if (pxSnapshot[x].xHandle == xHandle) {
+            return &pxSnapshot[x];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Task that never blocks, it takes the core whenever the test task
+ * sleeps.
+ *
+ * @param pvParameters    not used
+ */
+static void prvBusyTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;) {
+    }
+}
+
+/**
+ * @brief Task that sleeps with a timeout, it is in the delayed list.
+ *
+ * @param pvParameters    not used
+ */
+static void prvSleepingTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;) {
+        vTaskDelay(portMAX_DELAY - 1);
+    }
+}
+
+/**
+ * @brief Task that suspends itself, it is in the suspended list.
+ *
+ * @param pvParameters    not used
+ */
+static void prvSuspendedTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;) {
+        vTaskSuspend(NULL);
+    }
+}
+
+/**
+ * @brief The snapshot has every task once, whatever its state, and the times of
+ * the tasks add up to the total run time.
+ *
+ */
+static void prvTestTotal(void)
+{
+    TaskRunTime_t xSnapshot[testMAX_TASKS];
+    uint64_t ullTotal, ullSum;
+    UBaseType_t uxCount;
+    TaskHandle_t xSleeping, xSuspended;
+
+    testCHECK(xTaskCreate(prvSleepingTask, "sleeping", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xSleeping) == pdPASS);
+    testCHECK(xTaskCreate(prvSuspendedTask, "suspended", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xSuspended) == pdPASS);
+
+    /* a snapshot into an array that is too small is not taken */
+    testCHECK(uxTaskGetRunTimeSnapshot(xSnapshot, uxTaskGetNumberOfTasks() - 1, NULL) == 0);
+
+    vTaskDelay(1);
+    uxCount = prvSnapshot(xSnapshot, &ullTotal, &ullSum);
+    testCHECK(uxCount == uxTaskGetNumberOfTasks());
+    testCHECK(prvFind(xSnapshot, uxCount, xTaskGetCurrentTaskHandle()) != NULL);
+    testCHECK(eTaskGetState(xSleeping) == eBlocked);
+    testCHECK(prvFind(xSnapshot, uxCount, xSleeping) != NULL);
+    testCHECK(eTaskGetState(xSuspended) == eSuspended);
+    testCHECK(prvFind(xSnapshot, uxCount, xSuspended) != NULL);
+    for (UBaseType_t x = 0; x < uxCount; x++) {
+        testCHECK(prvFind(xSnapshot, uxCount, xSnapshot[x].xHandle) == &xSnapshot[x]);
+    }
+
+    testCHECK(ullTotal > 0);
+    testCHECK(ullSum <= ullTotal);
+    testCHECK(ullTotal - ullSum < testSLACK_US);
+
+    vTaskDelete(xSleeping);
+    vTaskDelete(xSuspended);
+}
+
+/**
+ * @brief The times only grow from one snapshot to the next, the time of the
+ * period goes to the task that ran in it.
+ *
+ */
+static void prvTestIncreasing(void)
+{
+    TaskRunTime_t xFirst[testMAX_TASKS], xSecond[testMAX_TASKS];
+    uint64_t ullFirstTotal, ullFirstSum, ullSecondTotal, ullSecondSum;
+    UBaseType_t uxFirst, uxSecond;
+    const TaskRunTime_t *pxBusyFirst, *pxBusySecond;
+    TaskHandle_t xBusy;
+
+    testCHECK(xTaskCreate(prvBusyTask, "busy", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xBusy) == pdPASS);
+
+    vTaskDelay(1);
+    uxFirst = prvSnapshot(xFirst, &ullFirstTotal, &ullFirstSum);
+    vTaskDelay(testBUSY_TICKS);
+    uxSecond = prvSnapshot(xSecond, &ullSecondTotal, &ullSecondSum);
+
+    testCHECK(uxFirst == uxSecond);
+    testCHECK(ullSecondTotal > ullFirstTotal);
+    testCHECK(ullSecondSum > ullFirstSum);
+    testCHECK(ullSecondSum <= ullSecondTotal);
+    for (UBaseType_t x = 0; x < uxFirst; x++) {
+        const TaskRunTime_t *pxLater = prvFind(xSecond, uxSecond, xFirst[x].xHandle);
+
+        testCHECK(pxLater != NULL);
+        testCHECK((pxLater != NULL) && (pxLater->ulRunTimeCounter >= xFirst[x].ulRunTimeCounter));
+        testCHECK((pxLater != NULL) && (pxLater->xTaskNumber == xFirst[x].xTaskNumber));
+    }
+
+    /* the busy task had the core for most of the period */
+    pxBusyFirst = prvFind(xFirst, uxFirst, xBusy);
+    pxBusySecond = prvFind(xSecond, uxSecond, xBusy);
+    testCHECK((pxBusyFirst != NULL) && (pxBusySecond != NULL));
+    if ((pxBusyFirst != NULL) && (pxBusySecond != NULL)) {
+        testCHECK((pxBusySecond->ulRunTimeCounter - pxBusyFirst->ulRunTimeCounter) * 2 > (ullSecondTotal - ullFirstTotal));
+    }
+
+    vTaskDelete(xBusy);
+}
+
+/**
+ * @brief Run the tests of the run time snapshots.
+ *
+ */
+void vTestMain(void)
+{
+    prvTestTotal();
+    prvTestIncreasing();
+}
@@ -0,0 +1,168 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "test.h"
+
+/* Many tasks that block with a timeout at the same time, and many timers. The
+program is built with the delayed task heap, the priority event lists and the
+timer wheel as well, the same checks apply to all of them. */
+#define testTASKS                       5000UL
+#define testROUNDS                      5UL
+#define testPERIODS                     50UL
+#define testTIMERS                      500UL
+#define testTIMER_RUN_TICKS             pdMS_TO_TICKS(500)
+
+static QueueHandle_t xNeverWritten;
+static volatile uint32_t ulFinished;
+static volatile uint32_t ulEarlyWakes;
+static volatile uint32_t ulUnexpectedItems;
+static volatile uint32_t ulTimerCalls[testTIMERS];
+
+/**
+ * @brief Block for the period of the task, every fourth task waits on an empty
+ * queue instead of a delay.
+ *
+ * @param pvParameters    index of the task
+ */
+static void prvSleeper(void *pvParameters)
+{
+    const uint32_t ulIndex = (uint32_t)(uintptr_t)pvParameters;
+    const TickType_t xPeriod = (TickType_t)(1UL + (ulIndex % testPERIODS));
+    uint32_t ulItem;
+
+    for (uint32_t ulRound = 0; ulRound < testROUNDS; ulRound++) {
+        const TickType_t xStart = xTaskGetTickCount();
+
+        if ((ulIndex % 4UL) == 0UL) {
+            if (xQueueReceive(xNeverWritten, &ulItem, xPeriod) != pdFALSE) {
+                ulUnexpectedItems++;
+            }
+        } else {
+            vTaskDelay(xPeriod);
+        }
+
+        if ((TickType_t)(xTaskGetTickCount() - xStart) < xPeriod) {
+            ulEarlyWakes++;
+        }
+    }
+
+    ulFinished++;
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Count the expiries of a timer.
+ *
+ * @param xTimer      the timer, its ID is its index
+ */
+static void prvTimerCallback(TimerHandle_t xTimer)
+{
+    ulTimerCalls[(uintptr_t)pvTimerGetTimerID(xTimer)]++;
+}
+
+/**
+ * @brief All the tasks wake up after their own timeout, none of them early.
+ *
+ */
+static void prvTestSleepers(void)
+{
+    TickType_t xWaited = 0;
+
+    xNeverWritten = xQueueCreate(1, sizeof(uint32_t));
+    ulFinished = 0;
+    ulEarlyWakes = 0;
+    ulUnexpectedItems = 0;
+
+    for (uint32_t ulIndex = 0; ulIndex < testTASKS; ulIndex++) {
+        const UBaseType_t uxPriority = 1 + (ulIndex % (testMAIN_PRIORITY - 1));
+
+        testCHECK(xTaskCreate(prvSleeper, "sleep", configMINIMAL_STACK_SIZE, (void *)(uintptr_t)ulIndex, uxPriority, NULL) == pdPASS);
+    }
+
+    while ((ulFinished < testTASKS) && (xWaited < pdMS_TO_TICKS(5000))) {
+        vTaskDelay(10);
+        xWaited += 10;
+    }
+
+    testCHECK(ulFinished == testTASKS);
+    testCHECK(ulEarlyWakes == 0);
+    testCHECK(ulUnexpectedItems == 0);
+
+    /* the idle task frees the deleted tasks */
+    vTaskDelay(10);
+    vQueueDelete(xNeverWritten);
+}
+
+/**
+ * @brief Auto reload timers of many periods expire once per period.
+ *
+ */
+static void prvTestTimers(void)
+{
+    TimerHandle_t xTimers[testTIMERS];
+    TickType_t xStarted[testTIMERS];
+    TickType_t xStopped[testTIMERS];
+
+    for (uint32_t ulIndex = 0; ulIndex < testTIMERS; ulIndex++) {
+        const TickType_t xPeriod = (TickType_t)(1UL + (ulIndex % testPERIODS));
+
+        ulTimerCalls[ulIndex] = 0;
+        xTimers[ulIndex] = xTimerCreate("tmr", xPeriod, pdTRUE, (void *)(uintptr_t)ulIndex, prvTimerCallback);
+        testCHECK(xTimers[ulIndex] != NULL);
+        xStarted[ulIndex] = xTaskGetTickCount();
+        xTimerStart(xTimers[ulIndex], portMAX_DELAY);
+    }
+
+    vTaskDelay(testTIMER_RUN_TICKS);
+
+    for (uint32_t ulIndex = 0; ulIndex < testTIMERS; ulIndex++) {
+        xStopped[ulIndex] = xTaskGetTickCount();
+        xTimerStop(xTimers[ulIndex], portMAX_DELAY);
+    }
+
+    /* the stop commands are processed once this task blocks */
+    vTaskDelay(1);
+
+    for (uint32_t ulIndex = 0; ulIndex < testTIMERS; ulIndex++) {
+        const uint32_t ulPeriod = 1UL + (ulIndex % testPERIODS);
+        const uint32_t ulExpected = (uint32_t)(xStopped[ulIndex] - xStarted[ulIndex]) / ulPeriod;
+
+        /* the start and stop commands reach the timer task a little later */
+        testCHECK((ulTimerCalls[ulIndex] + 2UL >= ulExpected) && (ulTimerCalls[ulIndex] <= ulExpected + 2UL));
+        xTimerDelete(xTimers[ulIndex], portMAX_DELAY);
+    }
+}
+
+void vTestMain(void)
+{
+    prvTestSleepers();
+    prvTestTimers();
+}
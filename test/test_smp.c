@@ -0,0 +1,298 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "test.h"
+
+#if ( configNUMBER_OF_CORES != 2 )
+    #error The test runs the scheduler on two cores, build it with options_smp.h.
+#endif
+
+#define testITEMS                       10000UL
+#define testINCREMENTS                  100000UL
+#define testWAIT_TICKS                  pdMS_TO_TICKS(2000)
+
+static volatile uint32_t ulSpins[2];
+static volatile uint32_t ulWrongCore[2];
+static volatile uint32_t ulReceived;
+static volatile BaseType_t xInOrder;
+static volatile uint32_t ulShared;
+static volatile uint32_t ulWorkersDone;
+static SemaphoreHandle_t xSemaphore;
+static QueueHandle_t xQueue;
+
+/**
+ * @brief Core that runs the calling task.
+ *
+ * @return the core number
+ */
+static BaseType_t prvThisCore(void)
+{
+    BaseType_t xCore;
+
+    taskENTER_CRITICAL();
+    xCore = (BaseType_t)portGET_CORE_ID();
+    taskEXIT_CRITICAL();
+
+    return xCore;
+}
+
+/**
+ * @brief Wait until a condition set by the tasks of the other core holds, or
+ * the time runs out.
+ *
+ * @param pxValue     value updated by the other tasks
+ * @param ulExpected  value to wait for
+ */
+static void prvWaitFor(volatile uint32_t *pxValue, uint32_t ulExpected)
+{
+    const TickType_t xStart = xTaskGetTickCount();
+
+    while ((*pxValue != ulExpected) && ((TickType_t)(xTaskGetTickCount() - xStart) < testWAIT_TICKS)) {
+        vTaskDelay(1);
+    }
+}
+
+/**
+ * @brief Count the time this task gets.
+ *
+ * @param pvParameters    the counter
+ */
+static void prvSpinner(void *pvParameters)
+{
+    volatile uint32_t *pulSpins = (volatile uint32_t *)pvParameters;
+
+    for (;;) {
+        (*pulSpins)++;
+    }
+}
+
+/**
+ * @brief The second core runs the ready tasks while the first one runs this
+ * task.
+ *
+ */
+static void prvTestBothCoresRun(void)
+{
+    const BaseType_t xOtherCore = 1 - prvThisCore();
+    TaskHandle_t xSpinners[2];
+    uint32_t ulSpinnerOnOtherCore = 0;
+
+    ulSpins[0] = 0;
+    ulSpins[1] = 0;
+    xTaskCreate(prvSpinner, "spin0", configMINIMAL_STACK_SIZE, (void *)&ulSpins[0], 1, &xSpinners[0]);
+    xTaskCreate(prvSpinner, "spin1", configMINIMAL_STACK_SIZE, (void *)&ulSpins[1], 1, &xSpinners[1]);
+
+    /* the host may run the thread of the other core only once this one blocks */
+    vTaskDelay(pdMS_TO_TICKS(10));
+
+    for (uint32_t ulSample = 0; ulSample < 50; ulSample++) {
+        const TaskHandle_t xOther = xTaskGetCurrentTaskHandleForCore(xOtherCore);
+
+        if ((xOther == xSpinners[0]) || (xOther == xSpinners[1])) {
+            ulSpinnerOnOtherCore++;
+        }
+        vTaskDelay(1);
+    }
+
+    testCHECK(ulSpinnerOnOtherCore == 50);
+    testCHECK(ulSpins[0] > 0);
+    testCHECK(ulSpins[1] > 0);
+
+    vTaskDelete(xSpinners[0]);
+    vTaskDelete(xSpinners[1]);
+}
+
+/**
+ * @brief Move to the core given as parameter and check it is never run on the
+ * other one.
+ *
+ * @param pvParameters    the core of the task
+ */
+static void prvPinnedTask(void *pvParameters)
+{
+    const BaseType_t xCore = (BaseType_t)(uintptr_t)pvParameters;
+
+    vTaskCoreAffinitySet(NULL, (UBaseType_t)1 << xCore);
+    for (;;) {
+        if (prvThisCore() != xCore) {
+            ulWrongCore[xCore]++;
+        }
+        ulSpins[xCore]++;
+        taskYIELD();
+    }
+}
+
+/**
+ * @brief A task runs only on the cores of its affinity mask.
+ *
+ */
+static void prvTestAffinity(void)
+{
+    TaskHandle_t xPinned[2];
+
+    for (uint32_t ulCore = 0; ulCore < 2; ulCore++) {
+        ulSpins[ulCore] = 0;
+        ulWrongCore[ulCore] = 0;
+        xTaskCreate(prvPinnedTask, "pin", configMINIMAL_STACK_SIZE, (void *)(uintptr_t)ulCore, 1, &xPinned[ulCore]);
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    for (uint32_t ulCore = 0; ulCore < 2; ulCore++) {
+        testCHECK(ulSpins[ulCore] > 0);
+        testCHECK(ulWrongCore[ulCore] == 0);
+        vTaskDelete(xPinned[ulCore]);
+    }
+}
+
+/**
+ * @brief Take the semaphore on core 1 for every give of core 0.
+ *
+ */
+static void prvSemaphoreTaker(void *pvParameters)
+{
+    (void)pvParameters;
+
+    vTaskCoreAffinitySet(NULL, (UBaseType_t)1 << 1);
+    for (;;) {
+        if (xSemaphoreTake(xSemaphore, portMAX_DELAY) == pdTRUE) {
+            ulReceived++;
+        }
+    }
+}
+
+/**
+ * @brief A task blocked on core 1 is woken by a give of core 0, through the
+ * doorbell between the cores.
+ *
+ */
+static void prvTestWakeOtherCore(void)
+{
+    TaskHandle_t xTaker;
+
+    xSemaphore = xSemaphoreCreateBinary();
+    ulReceived = 0;
+    xTaskCreate(prvSemaphoreTaker, "take", configMINIMAL_STACK_SIZE, NULL, 2, &xTaker);
+    vTaskDelay(1);
+
+    for (uint32_t ulGive = 1; ulGive <= 100; ulGive++) {
+        const TickType_t xStart = xTaskGetTickCount();
+
+        xSemaphoreGive(xSemaphore);
+
+        /* this task stays on core 0, the taker runs in parallel on core 1 */
+        while ((ulReceived != ulGive) && ((TickType_t)(xTaskGetTickCount() - xStart) < testWAIT_TICKS)) {
+        }
+        testCHECK(ulReceived == ulGive);
+    }
+
+    vTaskDelete(xTaker);
+    vSemaphoreDelete(xSemaphore);
+}
+
+/**
+ * @brief Increment a shared counter inside critical sections, then send
+ * numbers through the queue or receive them, depending on the core.
+ *
+ * @param pvParameters    the core of the task
+ */
+static void prvWorker(void *pvParameters)
+{
+    const BaseType_t xCore = (BaseType_t)(uintptr_t)pvParameters;
+    uint32_t ulItem;
+
+    vTaskCoreAffinitySet(NULL, (UBaseType_t)1 << xCore);
+
+    for (uint32_t ulIncrement = 0; ulIncrement < testINCREMENTS; ulIncrement++) {
+        taskENTER_CRITICAL();
+        ulShared = ulShared + 1;
+        taskEXIT_CRITICAL();
+    }
+
+    for (uint32_t ulCount = 0; ulCount < testITEMS; ulCount++) {
+        if (xCore == 0) {
+            xQueueSend(xQueue, &ulCount, portMAX_DELAY);
+        } else {
+            xQueueReceive(xQueue, &ulItem, portMAX_DELAY);
+            if (ulItem != ulReceived) {
+                xInOrder = pdFALSE;
+            }
+            ulReceived++;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    ulWorkersDone++;
+    taskEXIT_CRITICAL();
+    vTaskSuspend(NULL);
+}
+
+/**
+ * @brief Critical sections exclude the other core, a queue carries data
+ * between the cores in order.
+ *
+ */
+static void prvTestMutualExclusion(void)
+{
+    TaskHandle_t xWorkers[2];
+
+    xQueue = xQueueCreate(8, sizeof(uint32_t));
+    ulShared = 0;
+    ulReceived = 0;
+    ulWorkersDone = 0;
+    xInOrder = pdTRUE;
+
+    for (uint32_t ulCore = 0; ulCore < 2; ulCore++) {
+        xTaskCreate(prvWorker, "work", configMINIMAL_STACK_SIZE, (void *)(uintptr_t)ulCore, 1, &xWorkers[ulCore]);
+    }
+
+    prvWaitFor(&ulWorkersDone, 2);
+
+    testCHECK(ulWorkersDone == 2);
+    testCHECK(ulShared == 2 * testINCREMENTS);
+    testCHECK(ulReceived == testITEMS);
+    testCHECK(xInOrder == pdTRUE);
+
+    vTaskDelete(xWorkers[0]);
+    vTaskDelete(xWorkers[1]);
+    vQueueDelete(xQueue);
+}
+
+void vTestMain(void)
+{
+    vTaskCoreAffinitySet(NULL, (UBaseType_t)1 << 0);
+    testCHECK(prvThisCore() == 0);
+
+    prvTestBothCoresRun();
+    prvTestAffinity();
+    prvTestWakeOtherCore();
+    prvTestMutualExclusion();
+}
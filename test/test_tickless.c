@@ -0,0 +1,158 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#include "FreeRTOS.h"
+#include "test.h"
+#include "../port/port_tickless.h"
+
+#define testUS_PER_TICK                 1000UL
+#define testSLEEPS                      100000UL
+#define testMAX_IDLE_TICKS              50UL
+
+static uint32_t ulSeed = 1;
+
+/* tick count and time into the current tick of the simulated RP2040 */
+static uint64_t ullTicks;
+static uint32_t ulTickPhaseUs;
+
+/**
+ * @brief Small deterministic pseudo random generator.
+ *
+ */
+static uint32_t prvRandom(uint32_t ulRange)
+{
+    ulSeed = (ulSeed * 1103515245UL) + 12345UL;
+    return (ulSeed >> 8) % ulRange;
+}
+
+/**
+ * @brief Let the SysTick run for a while between two sleeps.
+ *
+ */
+static void prvRun(uint64_t *pullTimeUs, uint32_t ulUs)
+{
+    *pullTimeUs += ulUs;
+    ulTickPhaseUs += ulUs;
+    ullTicks += ulTickPhaseUs / testUS_PER_TICK;
+    ulTickPhaseUs %= testUS_PER_TICK;
+}
+
+/**
+ * @brief Sleep like vPortSuppressTicksAndSleep() and apply the correction.
+ *
+ * @return pdTRUE if the step stayed within the idle period, as vTaskStepTick() asserts
+ */
+static BaseType_t prvSleep(uint64_t *pullTimeUs, uint32_t ulExpectedIdleTime, uint32_t ulElapsedUs)
+{
+    PortTicklessCorrection_t xCorrection;
+    uint32_t ulSleepUs = (ulExpectedIdleTime * testUS_PER_TICK) - ulTickPhaseUs;
+
+    vPortTicklessCorrection(ulExpectedIdleTime, testUS_PER_TICK, ulTickPhaseUs, ulSleepUs, ulElapsedUs, &xCorrection);
+
+    *pullTimeUs += ulElapsedUs;
+    ullTicks += xCorrection.ulStepTicks + xCorrection.ulPendTick;
+    ulTickPhaseUs = testUS_PER_TICK - xCorrection.ulRemainingUs;
+
+    return (xCorrection.ulStepTicks <= ulExpectedIdleTime) ? pdTRUE : pdFALSE;
+}
+
+/**
+ * @brief Sleep periods ended by the alarm, late alarms and other interrupts
+ * must not make the tick drift from the timer.
+ *
+ */
+static void prvTestNoDrift(void)
+{
+    uint64_t ullTimeUs = 0;
+    uint32_t ulDrifted = 0, ulStepsTooLong = 0;
+
+    ullTicks = 0;
+    ulTickPhaseUs = 0;
+
+    for (uint32_t ulSleep = 0; ulSleep < testSLEEPS; ulSleep++) {
+        uint32_t ulExpectedIdleTime = 1UL + prvRandom(testMAX_IDLE_TICKS);
+        uint32_t ulSleepUs, ulElapsedUs;
+
+        prvRun(&ullTimeUs, prvRandom(3UL * testUS_PER_TICK));
+
+        ulSleepUs = (ulExpectedIdleTime * testUS_PER_TICK) - ulTickPhaseUs;
+        switch (prvRandom(3)) {
+            case 0:
+                /* woken by another interrupt */
+                ulElapsedUs = prvRandom(ulSleepUs);
+                break;
+            case 1:
+                /* the alarm, served in time */
+                ulElapsedUs = ulSleepUs + prvRandom(testUS_PER_TICK);
+                break;
+            default:
+                /* the alarm, served up to two ticks late */
+                ulElapsedUs = ulSleepUs + prvRandom(2UL * testUS_PER_TICK);
+                break;
+        }
+
+        if (prvSleep(&ullTimeUs, ulExpectedIdleTime, ulElapsedUs) == pdFALSE) {
+            ulStepsTooLong++;
+        }
+        if (((ullTicks * testUS_PER_TICK) + ulTickPhaseUs) != ullTimeUs) {
+            ulDrifted++;
+        }
+    }
+
+    testCHECK(ulStepsTooLong == 0);
+    testCHECK(ulDrifted == 0);
+    testCHECK(ullTicks == (ullTimeUs / testUS_PER_TICK));
+}
+
+/**
+ * @brief A wake up that is many ticks late is bounded to the idle period.
+ *
+ */
+static void prvTestLateWakeUpIsBounded(void)
+{
+    uint64_t ullTimeUs = 0;
+
+    ullTicks = 0;
+    ulTickPhaseUs = 300;
+
+    testCHECK(prvSleep(&ullTimeUs, 10, (10UL * testUS_PER_TICK) - 300UL + (5UL * testUS_PER_TICK) + 40UL) == pdTRUE);
+    testCHECK(ullTicks == 11);
+    testCHECK(ulTickPhaseUs == 40);
+
+    /* a single tick of sleep that ends one tick late steps the whole idle period */
+    ullTicks = 0;
+    ulTickPhaseUs = 0;
+    testCHECK(prvSleep(&ullTimeUs, 1, (2UL * testUS_PER_TICK) + 10UL) == pdTRUE);
+    testCHECK(ullTicks == 2);
+    testCHECK(ulTickPhaseUs == 10);
+}
+
+void vTestMain(void)
+{
+    prvTestNoDrift();
+    prvTestLateWakeUpIsBounded();
+}
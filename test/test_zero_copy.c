@@ -0,0 +1,295 @@
+/*_____________________________________________________________________________
+ │                                                                            |
+ │ COPYRIGHT (C) 2023 Mihai Baneu                                             |
+ │                                                                            |
+ | Permission is hereby  granted,  free of charge,  to any person obtaining a |
+ | copy of this software and associated documentation files (the "Software"), |
+ | to deal in the Software without restriction,  including without limitation |
+ | the rights to  use, copy, modify, merge, publish, distribute,  sublicense, |
+ | and/or sell copies  of  the Software, and to permit  persons to  whom  the |
+ | Software is furnished to do so, subject to the following conditions:       |
+ |                                                                            |
+ | The above  copyright notice  and this permission notice  shall be included |
+ | in all copies or substantial portions of the Software.                     |
+ |                                                                            |
+ | THE SOFTWARE IS PROVIDED  "AS IS",  WITHOUT WARRANTY OF ANY KIND,  EXPRESS |
+ | OR   IMPLIED,   INCLUDING   BUT   NOT   LIMITED   TO   THE  WARRANTIES  OF |
+ | MERCHANTABILITY,  FITNESS FOR  A  PARTICULAR  PURPOSE AND NONINFRINGEMENT. |
+ | IN NO  EVENT SHALL  THE AUTHORS  OR  COPYRIGHT  HOLDERS  BE LIABLE FOR ANY |
+ | CLAIM, DAMAGES OR OTHER LIABILITY,  WHETHER IN AN ACTION OF CONTRACT, TORT |
+ | OR OTHERWISE, ARISING FROM,  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR  |
+ | THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                 |
+ |____________________________________________________________________________|
+ |                                                                            |
+ |  Author: Mihai Baneu                           Last modified: 18.Oct.2026  |
+ |  Tests of the kernel on the Linux simulator                                |
+ |___________________________________________________________________________*/
+
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "test.h"
+
+#define testBUFFER_SIZE                 16
+#define testSTREAM_BYTES                5000UL
+
+static StreamBufferHandle_t xStream;
+static MessageBufferHandle_t xMessages;
+static volatile uint32_t ulReceived;
+static volatile BaseType_t xInOrder;
+
+/**
+ * @brief Write bytes into a region, the wrapped part continues the sequence.
+ *
+ */
+static void prvFillRegion(const StreamBufferRegion_t *pxRegion, size_t xLength, uint8_t *pucNext)
+{
+    for (size_t xByte = 0; xByte < xLength; xByte++) {
+        uint8_t *pucByte = (xByte < pxRegion->xFirstLength) ? &pxRegion->pucFirst[xByte] : &pxRegion->pucSecond[xByte - pxRegion->xFirstLength];
+
+        *pucByte = (*pucNext)++;
+    }
+}
+
+/**
+ * @brief Check that a region holds the expected sequence of bytes.
+ *
+ */
+static BaseType_t prvCheckRegion(const StreamBufferRegion_t *pxRegion, size_t xLength, uint8_t *pucNext)
+{
+    BaseType_t xMatch = pdTRUE;
+
+    for (size_t xByte = 0; xByte < xLength; xByte++) {
+        const uint8_t *pucByte = (xByte < pxRegion->xFirstLength) ? &pxRegion->pucFirst[xByte] : &pxRegion->pucSecond[xByte - pxRegion->xFirstLength];
+
+        if (*pucByte != (*pucNext)++) {
+            xMatch = pdFALSE;
+        }
+    }
+
+    return xMatch;
+}
+
+/**
+ * @brief Reserve, commit, peek and release at every position of the storage
+ * area, the regions that wrap come back in two parts.
+ *
+ */
+static void prvTestStreamWraparound(void)
+{
+    StreamBufferRegion_t xRegion;
+    uint8_t ucWrite = 0, ucRead = 0;
+    uint32_t ulReserveWraps = 0, ulPeekWraps = 0, ulBadRegions = 0;
+    BaseType_t xMatch = pdTRUE;
+
+    xStream = xStreamBufferCreate(testBUFFER_SIZE, 1);
+    testCHECK(xStream != NULL);
+
+    for (uint32_t ulRound = 0; ulRound < 200; ulRound++) {
+        /* lengths that do not divide the storage area walk the write position around it */
+        size_t xLength = 1 + (ulRound % 7), xReserved, xPeeked;
+
+        xReserved = xStreamBufferSendReserve(xStream, xLength, &xRegion, 0);
+        if ((xReserved != xLength) || ((xRegion.xFirstLength + xRegion.xSecondLength) != xLength)) {
+            ulBadRegions++;
+        }
+        if (xRegion.xSecondLength > 0) {
+            ulReserveWraps++;
+            if (xRegion.pucSecond >= xRegion.pucFirst) {
+                ulBadRegions++;
+            }
+        }
+        prvFillRegion(&xRegion, xReserved, &ucWrite);
+        testCHECK(xStreamBufferBytesAvailable(xStream) == 0);
+        xStreamBufferSendCommit(xStream, xReserved);
+
+        xPeeked = xStreamBufferReceivePeek(xStream, &xRegion, 0);
+        if ((xPeeked != xLength) || ((xRegion.xFirstLength + xRegion.xSecondLength) != xLength)) {
+            ulBadRegions++;
+        }
+        if (xRegion.xSecondLength > 0) {
+            ulPeekWraps++;
+        }
+        if (prvCheckRegion(&xRegion, xPeeked, &ucRead) == pdFALSE) {
+            xMatch = pdFALSE;
+        }
+        xStreamBufferReceiveRelease(xStream, xPeeked);
+    }
+
+    testCHECK(ulBadRegions == 0);
+    testCHECK(ulReserveWraps > 0);
+    testCHECK(ulPeekWraps > 0);
+    testCHECK(xMatch == pdTRUE);
+    testCHECK(xStreamBufferIsEmpty(xStream) == pdTRUE);
+}
+
+/**
+ * @brief Partial commits and releases, and the zero-copy calls mixed with the
+ * copying ones.
+ *
+ */
+static void prvTestStreamPartial(void)
+{
+    StreamBufferRegion_t xRegion;
+    uint8_t ucBytes[testBUFFER_SIZE];
+    uint8_t ucWrite = 100, ucRead = 100;
+
+    xStreamBufferReset(xStream);
+
+    /* more than the free space is asked for, what fits is reserved */
+    testCHECK(xStreamBufferSendReserve(xStream, testBUFFER_SIZE + 8, &xRegion, 0) == testBUFFER_SIZE);
+    prvFillRegion(&xRegion, 10, &ucWrite);
+    testCHECK(xStreamBufferSendCommit(xStream, 10) == 10);
+    testCHECK(xStreamBufferBytesAvailable(xStream) == 10);
+
+    /* half of the data is consumed in place, the rest is copied out */
+    testCHECK(xStreamBufferReceivePeek(xStream, &xRegion, 0) == 10);
+    testCHECK(prvCheckRegion(&xRegion, 4, &ucRead) == pdTRUE);
+    testCHECK(xStreamBufferReceiveRelease(xStream, 4) == 4);
+    testCHECK(xStreamBufferReceive(xStream, ucBytes, sizeof(ucBytes), 0) == 6);
+    testCHECK(ucBytes[0] == ucRead);
+    ucRead += 6;
+
+    /* copied in, read in place across the end of the storage area */
+    for (size_t xByte = 0; xByte < 12; xByte++) {
+        ucBytes[xByte] = ucWrite++;
+    }
+    testCHECK(xStreamBufferSend(xStream, ucBytes, 12, 0) == 12);
+    testCHECK(xStreamBufferReceivePeek(xStream, &xRegion, 0) == 12);
+    testCHECK(xRegion.xSecondLength > 0);
+    testCHECK(prvCheckRegion(&xRegion, 12, &ucRead) == pdTRUE);
+    testCHECK(xStreamBufferReceiveRelease(xStream, 12) == 12);
+    testCHECK(xStreamBufferIsEmpty(xStream) == pdTRUE);
+}
+
+/**
+ * @brief Messages are reserved whole or not at all, a commit of zero cancels
+ * the reservation and a release frees the whole message.
+ *
+ */
+static void prvTestMessageWraparound(void)
+{
+    StreamBufferRegion_t xRegion;
+    uint8_t ucWrite = 0, ucRead = 0;
+    uint32_t ulWraps = 0, ulBadRegions = 0;
+    BaseType_t xMatch = pdTRUE;
+
+    xMessages = xMessageBufferCreate(testBUFFER_SIZE + sizeof(configMESSAGE_BUFFER_LENGTH_TYPE));
+    testCHECK(xMessages != NULL);
+
+    /* a message larger than the free space is not reserved */
+    testCHECK(xStreamBufferSendReserve(xMessages, testBUFFER_SIZE + 1, &xRegion, 0) == 0);
+
+    for (uint32_t ulRound = 0; ulRound < 200; ulRound++) {
+        size_t xLength = 1 + (ulRound % 5), xPeeked;
+
+        if (xStreamBufferSendReserve(xMessages, xLength, &xRegion, 0) != xLength) {
+            ulBadRegions++;
+        }
+        if ((ulRound % 10) == 9) {
+            /* cancelled, nothing is written */
+            testCHECK(xStreamBufferSendCommit(xMessages, 0) == 0);
+            testCHECK(xMessageBufferIsEmpty(xMessages) == pdTRUE);
+            continue;
+        }
+        if (xRegion.xSecondLength > 0) {
+            ulWraps++;
+        }
+        prvFillRegion(&xRegion, xLength, &ucWrite);
+        xStreamBufferSendCommit(xMessages, xLength);
+
+        xPeeked = xStreamBufferReceivePeek(xMessages, &xRegion, 0);
+        if (xPeeked != xLength) {
+            ulBadRegions++;
+        }
+        if (prvCheckRegion(&xRegion, xPeeked, &ucRead) == pdFALSE) {
+            xMatch = pdFALSE;
+        }
+
+        /* the length passed is ignored, the whole message goes */
+        xStreamBufferReceiveRelease(xMessages, 1);
+        if (xMessageBufferIsEmpty(xMessages) == pdFALSE) {
+            ulBadRegions++;
+        }
+    }
+
+    testCHECK(ulBadRegions == 0);
+    testCHECK(ulWraps > 0);
+    testCHECK(xMatch == pdTRUE);
+}
+
+/**
+ * @brief Reader of prvTestBlocking(), consumes the stream in place.
+ *
+ */
+static void prvReader(void *pvParameters)
+{
+    StreamBufferRegion_t xRegion;
+    uint8_t ucRead = 0;
+
+    (void)pvParameters;
+
+    while (ulReceived < testSTREAM_BYTES) {
+        size_t xPeeked = xStreamBufferReceivePeek(xStream, &xRegion, portMAX_DELAY);
+
+        /* the reader takes a few bytes at a time, the writer waits for space */
+        if (xPeeked > 3) {
+            xPeeked = 3;
+        }
+        if (prvCheckRegion(&xRegion, xPeeked, &ucRead) == pdFALSE) {
+            xInOrder = pdFALSE;
+        }
+        xStreamBufferReceiveRelease(xStream, xPeeked);
+        ulReceived += xPeeked;
+    }
+    vTaskSuspend(NULL);
+}
+
+/**
+ * @brief A writer and a reader of equal priority block on each other in the
+ * zero-copy calls.
+ *
+ */
+static void prvTestBlocking(void)
+{
+    StreamBufferRegion_t xRegion;
+    TaskHandle_t xReader;
+    uint8_t ucWrite = 0;
+    uint32_t ulSent = 0;
+
+    xStreamBufferReset(xStream);
+    ulReceived = 0;
+    xInOrder = pdTRUE;
+    testCHECK(xTaskCreate(prvReader, "reader", configMINIMAL_STACK_SIZE, NULL, testMAIN_PRIORITY, &xReader) == pdPASS);
+
+    while (ulSent < testSTREAM_BYTES) {
+        size_t xLength = testSTREAM_BYTES - ulSent;
+        size_t xReserved;
+
+        if (xLength > 7) {
+            xLength = 7;
+        }
+        xReserved = xStreamBufferSendReserve(xStream, xLength, &xRegion, portMAX_DELAY);
+        prvFillRegion(&xRegion, xReserved, &ucWrite);
+        xStreamBufferSendCommit(xStream, xReserved);
+        ulSent += xReserved;
+    }
+
+    while (ulReceived < testSTREAM_BYTES) {
+        vTaskDelay(1);
+    }
+
+    testCHECK(ulReceived == testSTREAM_BYTES);
+    testCHECK(xInOrder == pdTRUE);
+    vTaskDelete(xReader);
+}
+
+void vTestMain(void)
+{
+    prvTestStreamWraparound();
+    prvTestStreamPartial();
+    prvTestMessageWraparound();
+    prvTestBlocking();
+}
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+#
+# Convert a RAM dump of the FreeRTOS trace rings (xPortTraceRings, see
+# port/port_trace.c) to the Chrome JSON trace format, which is opened by
+# https://ui.perfetto.dev and chrome://tracing.
+#
+# Dump the rings with gdb while the target is halted:
+#
+#   (gdb) call vPortTraceStop()
+#   (gdb) dump binary value trace.bin xPortTraceRings
+#
+# then convert them:
+#
+#   trace2perfetto.py trace.bin -o trace.json
+#
+# Author: Mihai Baneu
+
+import argparse
+import json
+import struct
+import sys
+
+TRACE_MAGIC = 0x52545246
+TRACE_VERSION = 1
+HEADER = struct.Struct('<IHHIII')
+EVENT = struct.Struct('<II')
+SRAM_BASE = 0x20000000
+
+TASK_SWITCHED_IN = 1
+TICK = 2
+TASK_CREATE = 3
+TASK_NAME = 4
+TASK_DELETE = 5
+TASK_READY = 6
+TASK_NOTIFY = 7
+QUEUE_CREATE = 8
+QUEUE_SEND = 9
+QUEUE_RECEIVE = 10
+QUEUE_SEND_FROM_ISR = 11
+QUEUE_RECEIVE_FROM_ISR = 12
+QUEUE_BLOCK_SEND = 13
+QUEUE_BLOCK_RECEIVE = 14
+TIMER_EXPIRED = 15
+USER = 16
+
+INSTANT_NAMES = {
+    TASK_CREATE: 'task create',
+    TASK_DELETE: 'task delete',
+    TASK_READY: 'task ready',
+    TASK_NOTIFY: 'task notify',
+    QUEUE_CREATE: 'queue create',
+    QUEUE_SEND: 'queue send',
+    QUEUE_RECEIVE: 'queue receive',
+    QUEUE_SEND_FROM_ISR: 'queue send from isr',
+    QUEUE_RECEIVE_FROM_ISR: 'queue receive from isr',
+    QUEUE_BLOCK_SEND: 'block on queue send',
+    QUEUE_BLOCK_RECEIVE: 'block on queue receive',
+    TIMER_EXPIRED: 'timer expired',
+    USER: 'user',
+}
+
+OBJECT_EVENTS = {TASK_SWITCHED_IN, TASK_CREATE, TASK_DELETE, TASK_READY, TASK_NOTIFY, QUEUE_CREATE,
+                 QUEUE_SEND, QUEUE_RECEIVE, QUEUE_SEND_FROM_ISR, QUEUE_RECEIVE_FROM_ISR,
+                 QUEUE_BLOCK_SEND, QUEUE_BLOCK_RECEIVE, TIMER_EXPIRED}
+
+
+def read_rings(data):
+    """Find the rings in the dump and return (core, events) with the events in recording order."""
+    rings = []
+    offset = 0
+    while offset + HEADER.size <= len(data):
+        magic, version, core, count, _stopped, head = HEADER.unpack_from(data, offset)
+        if magic != TRACE_MAGIC:
+            offset += 4
+            continue
+        if version != TRACE_VERSION:
+            sys.exit('unsupported trace version %d' % version)
+
+        base = offset + HEADER.size
+        if base + count * EVENT.size > len(data):
+            sys.exit('ring of core %d is truncated in the dump' % core)
+
+        # before the ring wraps the events start at index 0
+        first = head - count if head > count else 0
+        events = [EVENT.unpack_from(data, base + (index % count) * EVENT.size) for index in range(first, head)]
+        rings.append((core, events))
+        offset = base + count * EVENT.size
+    return rings
+
+
+def unwrap(events):
+    """Extend the 32 bit microsecond timestamps, the rings are written in time order."""
+    result = []
+    high = 0
+    last = None
+    for timestamp, word in events:
+        if last is not None and timestamp < last:
+            high += 1 << 32
+        last = timestamp
+        result.append((high + timestamp, word >> 24, word & 0xffffff))
+    return result
+
+
+def convert(rings, with_ticks):
+    names = {}
+    trace = []
+
+    # the names are needed before the switches are labelled
+    for _core, events in rings:
+        pending = None
+        for _timestamp, event, parameter in events:
+            if event == TASK_CREATE:
+                pending = [SRAM_BASE | parameter, '']
+            elif event == TASK_NAME and pending is not None:
+                pending[1] += bytes(b for b in parameter.to_bytes(3, 'little') if b).decode('ascii', 'replace')
+                names[pending[0]] = pending[1]
+            else:
+                pending = None
+
+    start = min((events[0][0] for _core, events in rings if events), default=0)
+
+    def task_name(address):
+        return names.get(address, 'task 0x%08x' % address)
+
+    for core, events in rings:
+        trace.append({'ph': 'M', 'name': 'process_name', 'pid': core, 'args': {'name': 'core %d' % core}})
+        trace.append({'ph': 'M', 'name': 'thread_name', 'pid': core, 'tid': 0, 'args': {'name': 'tasks'}})
+        trace.append({'ph': 'M', 'name': 'thread_name', 'pid': core, 'tid': 1, 'args': {'name': 'events'}})
+
+        running = None
+        for timestamp, event, parameter in events:
+            ts = timestamp - start
+            address = SRAM_BASE | parameter
+            if event == TASK_SWITCHED_IN:
+                if running is not None and running[0] != address:
+                    trace.append({'ph': 'X', 'pid': core, 'tid': 0, 'name': task_name(running[0]),
+                                  'ts': running[1], 'dur': ts - running[1]})
+                    running = None
+                if running is None:
+                    running = (address, ts)
+            elif event == TICK:
+                if with_ticks:
+                    trace.append({'ph': 'i', 's': 't', 'pid': core, 'tid': 1, 'name': 'tick', 'ts': ts,
+                                  'args': {'tick': parameter}})
+            elif event in INSTANT_NAMES:
+                args = {'object': '0x%08x' % address} if event in OBJECT_EVENTS else {'value': parameter}
+                if event in (TASK_CREATE, TASK_DELETE, TASK_READY, TASK_NOTIFY):
+                    args['task'] = task_name(address)
+                trace.append({'ph': 'i', 's': 't', 'pid': core, 'tid': 1, 'name': INSTANT_NAMES[event], 'ts': ts,
+                              'args': args})
+
+        if running is not None and events:
+            end = events[-1][0] - start
+            trace.append({'ph': 'X', 'pid': core, 'tid': 0, 'name': task_name(running[0]),
+                          'ts': running[1], 'dur': end - running[1]})
+
+    return {'traceEvents': trace}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a FreeRTOS trace ring dump to a Perfetto/Chrome JSON trace.')
+    parser.add_argument('dump', help='binary dump of xPortTraceRings')
+    parser.add_argument('-o', '--output', default='-', help='output file, stdout by default')
+    parser.add_argument('--ticks', action='store_true', help='include the tick events')
+    args = parser.parse_args()
+
+    with open(args.dump, 'rb') as dump:
+        rings = [(core, unwrap(events)) for core, events in read_rings(dump.read())]
+    if not rings:
+        sys.exit('no trace ring found in %s' % args.dump)
+
+    result = convert(rings, args.ticks)
+    if args.output == '-':
+        json.dump(result, sys.stdout)
+    else:
+        with open(args.output, 'w') as output:
+            json.dump(result, output)
+
+
+if __name__ == '__main__':
+    main()